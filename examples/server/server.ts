@@ -18,6 +18,7 @@ const packageDefinition = protoLoader.loadSync(PROTO_PATH, {
 
 const protoDescriptor = grpc.loadPackageDefinition(packageDefinition) as any;
 const myService = protoDescriptor.myservice.MyService;
+const benchmarkService = protoDescriptor.myservice.BenchmarkService;
 
 const server = new grpc.Server();
 
@@ -76,6 +77,63 @@ server.addService(myService.service, {
   },
 });
 
+// Benchmark RPCs log nothing per call: logging would dominate what they measure.
+const payloads = new Map<number, Buffer>();
+function payloadOfSize(size: number): Buffer {
+  let payload = payloads.get(size);
+  if (!payload) {
+    payload = Buffer.alloc(size, 'x');
+    payloads.set(size, payload);
+  }
+  return payload;
+}
+
+function reply(request: any) {
+  return { body: request.response_size > 0 ? payloadOfSize(request.response_size) : request.body };
+}
+
+server.addService(benchmarkService.service, {
+  echo: (call: any, callback: any) => {
+    callback(null, reply(call.request));
+  },
+
+  streamPayloads: (call: any) => {
+    const count = call.request.count;
+    const body = payloadOfSize(call.request.size);
+    const intervalMs = call.request.messages_per_second > 0 ? 1000 / call.request.messages_per_second : 0;
+    const start = Date.now();
+    let sent = 0;
+    let cancelled = false;
+    call.on('cancelled', () => {
+      cancelled = true;
+    });
+
+    const sendMore = () => {
+      while (!cancelled && sent < count) {
+        // Paced streams send on schedule, catching up if a timer fired late
+        if (intervalMs > 0 && Date.now() < start + sent * intervalMs) {
+          setTimeout(sendMore, start + sent * intervalMs - Date.now());
+          return;
+        }
+        sent++;
+        if (!call.write({ body })) {
+          call.once('drain', sendMore);
+          return;
+        }
+      }
+      if (!cancelled) {
+        call.end();
+      }
+    };
+    sendMore();
+  },
+
+  pingPong: (call: any) => {
+    call.on('data', (request: any) => call.write(reply(request)));
+    call.on('end', () => call.end());
+  },
+});
+
 import { readFileSync } from 'fs';
 
 const serverCert = readFileSync(join(__dirname, 'certs', 'server.crt'));
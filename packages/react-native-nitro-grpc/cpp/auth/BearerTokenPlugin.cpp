@@ -7,6 +7,10 @@ BearerTokenPlugin::BearerTokenPlugin(const std::string& token) : _staticToken(to
 BearerTokenPlugin::BearerTokenPlugin(std::function<std::string()> tokenProvider)
     : _tokenProvider(std::move(tokenProvider)), _useProvider(true) {}
 
+bool BearerTokenPlugin::IsBlocking() const {
+  return _useProvider;
+}
+
 ::grpc::Status BearerTokenPlugin::GetMetadata(::grpc::string_ref service_url,
                                               ::grpc::string_ref method_name,
                                               const ::grpc::AuthContext& channel_auth_context,
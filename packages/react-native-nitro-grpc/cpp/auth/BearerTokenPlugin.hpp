@@ -12,6 +12,10 @@ namespace margelo::nitro::grpc {
  *
  * This plugin injects a Bearer token into the gRPC metadata for each RPC call.
  * Supports both static tokens and dynamic token providers for automatic refresh.
+ *
+ * Static tokens run non-blocking: gRPC calls GetMetadata inline instead of
+ * hopping to its credentials thread pool. A provider keeps the blocking mode
+ * because it may do arbitrary work on every call.
  */
 class BearerTokenPlugin : public ::grpc::MetadataCredentialsPlugin {
 public:
@@ -30,6 +34,12 @@ public:
    */
   explicit BearerTokenPlugin(std::function<std::string()> tokenProvider);
 
+  /**
+   * Whether gRPC must run GetMetadata on its credentials thread pool.
+   * Fixed for the plugin's lifetime: true exactly when it has a provider.
+   */
+  bool IsBlocking() const override;
+
   /**
    * Gets the metadata to attach to an RPC.
    * Called by gRPC for each RPC call.
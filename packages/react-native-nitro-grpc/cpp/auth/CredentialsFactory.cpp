@@ -1,5 +1,7 @@
 #include "CredentialsFactory.hpp"
 
+#include <stdexcept>
+
 namespace margelo::nitro::grpc {
 
 // Helper: Create channel credentials
@@ -16,34 +18,65 @@ CredentialsFactory::createChannelCredentials(const JsonParser::Credentials& cred
     ssl_opts.pem_root_certs = creds.rootCerts.value();
   }
 
-  if (creds.privateKey.has_value()) {
-    ssl_opts.pem_private_key = creds.privateKey.value();
+  // Mutual TLS needs both halves of the client identity
+  if (creds.privateKey.has_value() != creds.certChain.has_value()) {
+    throw std::runtime_error("privateKey and certChain must be provided together");
   }
 
-  if (creds.certChain.has_value()) {
+  if (creds.privateKey.has_value()) {
+    ssl_opts.pem_private_key = creds.privateKey.value();
     ssl_opts.pem_cert_chain = creds.certChain.value();
   }
 
   return ::grpc::SslCredentials(ssl_opts);
 }
 
+// Call credentials from parsed JSON
+std::shared_ptr<::grpc::CallCredentials>
+CredentialsFactory::createCallCredentials(const JsonParser::CallCredentials& callCreds) {
+  switch (callCreds.type) {
+    case JsonParser::CallCredentials::Type::BEARER:
+      if (!callCreds.token.has_value()) {
+        throw std::runtime_error("Bearer token is missing");
+      }
+      return createBearerToken(callCreds.token.value());
+    case JsonParser::CallCredentials::Type::OAUTH2:
+      if (!callCreds.token.has_value()) {
+        throw std::runtime_error("OAuth2 access token is missing");
+      }
+      return createAccessToken(callCreds.token.value());
+    case JsonParser::CallCredentials::Type::CUSTOM:
+      if (!callCreds.metadata.has_value()) {
+        throw std::runtime_error("Custom metadata is missing");
+      }
+      return createCustomMetadata(callCreds.metadata.value());
+  }
+  throw std::runtime_error("Unsupported call credentials type");
+}
+
+// Composite from built credentials
+std::shared_ptr<::grpc::ChannelCredentials>
+CredentialsFactory::createComposite(const std::shared_ptr<::grpc::ChannelCredentials>& channelCreds,
+                                    const std::shared_ptr<::grpc::CallCredentials>& callCreds) {
+  auto composite = ::grpc::CompositeChannelCredentials(channelCreds, callCreds);
+  if (!composite) {
+    // gRPC refuses to send call credentials over plaintext
+    throw std::runtime_error("Call credentials require SSL channel credentials");
+  }
+  return composite;
+}
+
 // Composite with static token
 std::shared_ptr<::grpc::ChannelCredentials>
 CredentialsFactory::createComposite(const JsonParser::Credentials& channelCreds, const std::string& token) {
-  auto channel_creds = createChannelCredentials(channelCreds);
-  auto call_creds = createBearerToken(token);
-
-  return ::grpc::CompositeChannelCredentials(channel_creds, call_creds);
+  return createComposite(createChannelCredentials(channelCreds), createBearerToken(token));
 }
 
 // Composite with token provider
 std::shared_ptr<::grpc::ChannelCredentials>
 CredentialsFactory::createComposite(const JsonParser::Credentials& channelCreds,
                                     std::function<std::string()> tokenProvider) {
-  auto channel_creds = createChannelCredentials(channelCreds);
-  auto call_creds = createBearerToken(std::move(tokenProvider));
-
-  return ::grpc::CompositeChannelCredentials(channel_creds, call_creds);
+  return createComposite(createChannelCredentials(channelCreds), createBearerToken(std::move(tokenProvider)));
 }
 
 // Bearer token (static)
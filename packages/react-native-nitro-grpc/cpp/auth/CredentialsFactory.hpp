@@ -18,6 +18,37 @@ namespace margelo::nitro::grpc {
  */
 class CredentialsFactory {
 public:
+  /**
+   * Creates channel credentials from parsed JSON.
+   * This is the only place SSL options are assembled.
+   *
+   * @param creds Parsed credentials structure
+   * @return Channel credentials
+   * @throws std::runtime_error if only one of privateKey and certChain is set
+   */
+  static std::shared_ptr<::grpc::ChannelCredentials> createChannelCredentials(const JsonParser::Credentials& creds);
+
+  /**
+   * Creates call credentials from parsed JSON.
+   *
+   * @param callCreds Parsed call credentials structure
+   * @return Call credentials
+   * @throws std::runtime_error if the token or metadata for the type is missing
+   */
+  static std::shared_ptr<::grpc::CallCredentials> createCallCredentials(const JsonParser::CallCredentials& callCreds);
+
+  /**
+   * Combines channel and call credentials.
+   *
+   * @param channelCreds Channel credentials (must be secure)
+   * @param callCreds Call credentials
+   * @return Composite channel credentials
+   * @throws std::runtime_error if the channel credentials are insecure
+   */
+  static std::shared_ptr<::grpc::ChannelCredentials>
+  createComposite(const std::shared_ptr<::grpc::ChannelCredentials>& channelCreds,
+                  const std::shared_ptr<::grpc::CallCredentials>& callCreds);
+
   /**
    * Creates composite credentials (Channel + Call credentials).
    * Combines SSL/TLS channel security with per-RPC authentication.
@@ -72,15 +103,6 @@ public:
    */
   static std::shared_ptr<::grpc::CallCredentials>
   createCustomMetadata(const std::map<std::string, std::string>& metadata);
-
-private:
-  /**
-   * Helper to create channel credentials from parsed JSON.
-   *
-   * @param creds Parsed credentials structure
-   * @return Channel credentials
-   */
-  static std::shared_ptr<::grpc::ChannelCredentials> createChannelCredentials(const JsonParser::Credentials& creds);
 };
 
 } // namespace margelo::nitro::grpc
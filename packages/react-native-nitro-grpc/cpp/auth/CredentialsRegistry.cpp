@@ -0,0 +1,84 @@
+#include "CredentialsRegistry.hpp"
+
+#include "../utils/checksum/Xxh3.hpp"
+#include "../utils/json/JsonParser.hpp"
+#include "CredentialsFactory.hpp"
+
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+CredentialsRegistry& CredentialsRegistry::shared() {
+  // Never destroyed: channels may still reference cached credentials during process exit.
+  static auto* instance = new CredentialsRegistry();
+  return *instance;
+}
+
+CredentialsRegistry::Registration CredentialsRegistry::registerCredentials(const std::string& credentialsJson,
+                                                                           const std::string& callCredentialsJson) {
+  Xxh3 hasher;
+  hasher.update(reinterpret_cast<const uint8_t*>(credentialsJson.data()), credentialsJson.size());
+  const std::string channelKey = Xxh3::toHex(hasher.digest128());
+  // The separator keeps ("ab", "c") and ("a", "bc") apart; JSON never contains a raw NUL.
+  const uint8_t separator = 0;
+  hasher.update(&separator, 1);
+  hasher.update(reinterpret_cast<const uint8_t*>(callCredentialsJson.data()), callCredentialsJson.size());
+  const std::string handle = Xxh3::toHex(hasher.digest128());
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (auto* cached = _entries.find(handle)) {
+    return {handle, *cached};
+  }
+  if (auto held = findHeld(handle)) {
+    return {handle, std::move(held)};
+  }
+
+  Entry channel;
+  if (Entry* cached = _channelCredentials.find(channelKey)) {
+    channel = *cached;
+  } else {
+    const auto parsed = JsonParser::parseCredentials(credentialsJson);
+    channel.credentials = CredentialsFactory::createChannelCredentials(parsed);
+    channel.targetNameOverride = parsed.targetNameOverride;
+    _channelCredentials.put(channelKey, channel);
+  }
+
+  Entry entry = channel;
+  if (!callCredentialsJson.empty()) {
+    const auto parsed = JsonParser::parseCallCredentials(callCredentialsJson);
+    const auto callCreds = CredentialsFactory::createCallCredentials(parsed);
+    entry.credentials = CredentialsFactory::createComposite(channel.credentials, callCreds);
+  }
+  auto shared = std::make_shared<const Entry>(std::move(entry));
+  _entries.put(handle, shared);
+  for (auto it = _held.begin(); it != _held.end();) {
+    it = it->second.expired() ? _held.erase(it) : std::next(it);
+  }
+  _held[handle] = shared;
+  return {handle, std::move(shared)};
+}
+
+CredentialsRegistry::Entry CredentialsRegistry::lookup(const std::string& handle) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (auto* cached = _entries.find(handle)) {
+    return **cached;
+  }
+  if (auto held = findHeld(handle)) {
+    return *held;
+  }
+  throw std::runtime_error("Unknown credentials handle: " + handle);
+}
+
+std::shared_ptr<const CredentialsRegistry::Entry> CredentialsRegistry::findHeld(const std::string& handle) {
+  auto it = _held.find(handle);
+  if (it == _held.end()) {
+    return nullptr;
+  }
+  auto entry = it->second.lock();
+  if (entry != nullptr) {
+    _entries.put(handle, entry); // Evicted, but still in use
+  }
+  return entry;
+}
+
+} // namespace margelo::nitro::grpc
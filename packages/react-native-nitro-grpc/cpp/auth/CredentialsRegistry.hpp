@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <grpcpp/security/credentials.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Process-wide cache of built channel credentials.
+ *
+ * Registering a configuration (channel credentials JSON plus optional call
+ * credentials JSON) parses and builds it once and returns a handle derived
+ * from its contents; registering the same configuration again returns the
+ * same handle without parsing anything. Channel credentials are additionally
+ * shared between configurations that only differ in their call credentials,
+ * so rotating a Bearer token does not rebuild the TLS configuration.
+ *
+ * Both caches are bounded and evict least-recently-used entries. Channels keep
+ * their own reference to the credentials they were created with, so eviction
+ * never affects a live channel. A handle also stays valid for as long as a
+ * Registration for it is alive, even once evicted, so a client can register
+ * and connect later regardless of how many other configurations were
+ * registered in between.
+ *
+ * Thread-safe.
+ */
+class CredentialsRegistry {
+public:
+  struct Entry {
+    std::shared_ptr<::grpc::ChannelCredentials> credentials;
+    std::optional<std::string> targetNameOverride;
+  };
+
+  struct Registration {
+    std::string handle;
+    // Keeps lookup(handle) working while any copy is alive
+    std::shared_ptr<const Entry> entry;
+  };
+
+  static CredentialsRegistry& shared();
+
+  /**
+   * Build (or reuse) credentials for a configuration.
+   *
+   * @param credentialsJson Channel credentials JSON from TypeScript
+   * @param callCredentialsJson Call credentials JSON, or "" for none
+   * @return Handle to pass to lookup(), and the credentials it refers to
+   * @throws std::runtime_error if the JSON is malformed or the credentials are invalid
+   */
+  Registration registerCredentials(const std::string& credentialsJson, const std::string& callCredentialsJson);
+
+  /**
+   * @throws std::runtime_error if `handle` was never registered, or has been
+   * evicted and no Registration for it is alive
+   */
+  Entry lookup(const std::string& handle);
+
+private:
+  static constexpr size_t kMaxEntries = 32;
+  static constexpr size_t kMaxChannelCredentials = 16;
+
+  /**
+   * Minimal LRU map; the most recently used key is at the front.
+   */
+  template <typename V> class Lru {
+  public:
+    explicit Lru(size_t capacity) : _capacity(capacity) {}
+
+    V* find(const std::string& key) {
+      auto it = _index.find(key);
+      if (it == _index.end()) {
+        return nullptr;
+      }
+      _order.splice(_order.begin(), _order, it->second);
+      return &it->second->second;
+    }
+
+    void put(const std::string& key, V value) {
+      if (V* existing = find(key)) {
+        *existing = std::move(value);
+        return;
+      }
+      _order.emplace_front(key, std::move(value));
+      _index[key] = _order.begin();
+      if (_order.size() > _capacity) {
+        _index.erase(_order.back().first);
+        _order.pop_back();
+      }
+    }
+
+  private:
+    size_t _capacity;
+    std::list<std::pair<std::string, V>> _order;
+    std::unordered_map<std::string, typename std::list<std::pair<std::string, V>>::iterator> _index;
+  };
+
+  CredentialsRegistry() = default;
+  CredentialsRegistry(const CredentialsRegistry&) = delete;
+  CredentialsRegistry& operator=(const CredentialsRegistry&) = delete;
+
+  /**
+   * An evicted entry that a live Registration still holds, re-inserted into
+   * _entries; null if there is none. Requires _mutex.
+   */
+  std::shared_ptr<const Entry> findHeld(const std::string& handle);
+
+  std::mutex _mutex;
+  Lru<std::shared_ptr<const Entry>> _entries{kMaxEntries}; // By handle
+  Lru<Entry> _channelCredentials{kMaxChannelCredentials};  // By channel credentials JSON digest
+  // Every handle with a live Registration, evicted from _entries or not
+  std::unordered_map<std::string, std::weak_ptr<const Entry>> _held;
+};
+
+} // namespace margelo::nitro::grpc
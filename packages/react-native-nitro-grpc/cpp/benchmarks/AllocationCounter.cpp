@@ -0,0 +1,35 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replacements for the global allocation functions of this executable. The
+// aligned and nothrow variants forward to these through the standard library.
+
+void* operator new(std::size_t size) {
+  margelo::nitro::grpc::bench::AllocationCounter::record();
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace margelo::nitro::grpc::bench {
+
+/**
+ * @brief Counts heap allocations made through global operator new.
+ *
+ * The counter is process-wide, so a benchmark that talks to the in-process
+ * server also counts the server's allocations. Compare runs with each other,
+ * not with the client's allocations alone.
+ */
+class AllocationCounter {
+public:
+  static uint64_t count() {
+    return _count.load(std::memory_order_relaxed);
+  }
+
+  static void record() {
+    _count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  static inline std::atomic<uint64_t> _count{0};
+};
+
+} // namespace margelo::nitro::grpc::bench
@@ -0,0 +1,201 @@
+#include <benchmark/benchmark.h>
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <future>
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "AllocationCounter.hpp"
+#include "HybridGrpcClient.hpp"
+#include "TestServer.hpp"
+#include "calls/MethodHandle.hpp"
+#include "calls/UnaryCall.hpp"
+#include "calls/UnaryCallRecord.hpp"
+
+namespace margelo::nitro::grpc::bench {
+
+namespace {
+
+  /**
+   * One loopback server and client for the whole run; connection setup is
+   * not what these benchmarks measure.
+   */
+  struct Loopback {
+    test::TestServer server;
+    std::shared_ptr<::grpc::Channel> channel;
+    std::shared_ptr<HybridGrpcClient> client;
+
+    Loopback() {
+      channel = ::grpc::CreateChannel(server.target(), ::grpc::InsecureChannelCredentials());
+      client = std::make_shared<HybridGrpcClient>();
+      client->connect(server.target(), R"({"type":"insecure"})", "{}");
+    }
+
+    static Loopback& shared() {
+      static Loopback instance;
+      return instance;
+    }
+  };
+
+  std::shared_ptr<ArrayBuffer> payload(size_t size) {
+    std::string bytes(size, 'x');
+    return ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+  }
+
+  void reportAllocations(benchmark::State& state, uint64_t before) {
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(AllocationCounter::count() - before),
+                                                  benchmark::Counter::kAvgIterations);
+  }
+
+  void setThroughput(benchmark::State& state, int64_t messagesPerIteration, int64_t messageSize) {
+    state.SetItemsProcessed(state.iterations() * messagesPerIteration);
+    state.SetBytesProcessed(state.iterations() * messagesPerIteration * messageSize);
+  }
+
+  /**
+   * UnaryCall::perform back to back; `next()` supplies each call's record.
+   */
+  template <typename NextRecord> void performUnary(benchmark::State& state, NextRecord next) {
+    Loopback& loopback = Loopback::shared();
+    const auto method = std::make_shared<const MethodHandle>(
+        "/bench.Echo/Unary", MethodHandle::Type::UNARY, MethodHandle::Defaults{}, loopback.channel);
+    const std::string request(static_cast<size_t>(state.range(0)), 'x');
+
+    const uint64_t allocationsBefore = AllocationCounter::count();
+    for (auto _ : state) {
+      auto record = next();
+      record->channel = loopback.channel;
+      record->method = method;
+      record->setRequest(reinterpret_cast<const uint8_t*>(request.data()), request.size());
+      record->metadataJson = "{}";
+      record->context = std::make_shared<::grpc::ClientContext>();
+      benchmark::DoNotOptimize(UnaryCall::perform(*record));
+    }
+    reportAllocations(state, allocationsBefore);
+    setThroughput(state, 1, state.range(0));
+  }
+
+} // namespace
+
+/**
+ * UnaryCall::perform on a pooled record: the blocking path under both the
+ * sync and the async unary APIs. Arg: request size in bytes.
+ */
+static void BM_UnaryCallPerform(benchmark::State& state) {
+  performUnary(state, []() { return UnaryCallRecord::pool().acquire(); });
+}
+BENCHMARK(BM_UnaryCallPerform)->Arg(16)->Arg(1024)->Arg(64 * 1024)->UseRealTime();
+
+/**
+ * BM_UnaryCallPerform with a fresh record per call, as before records were
+ * pooled. The difference in allocs is what the pool saves.
+ */
+static void BM_UnaryCallPerformUnpooled(benchmark::State& state) {
+  performUnary(state, []() { return std::make_unique<UnaryCallRecord>(); });
+}
+BENCHMARK(BM_UnaryCallPerformUnpooled)->Arg(16)->Arg(1024)->Arg(64 * 1024)->UseRealTime();
+
+/**
+ * HybridGrpcClient::unaryCall end to end: worker thread, registry and
+ * promise settlement included. Arg: request size in bytes.
+ */
+static void BM_UnaryCallAsync(benchmark::State& state) {
+  Loopback& loopback = Loopback::shared();
+  const auto request = payload(static_cast<size_t>(state.range(0)));
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    auto promise = loopback.client->unaryCall("/bench.Echo/Unary", request, "{}", 0, "");
+    benchmark::DoNotOptimize(promise->await().get());
+  }
+  reportAllocations(state, allocationsBefore);
+  setThroughput(state, 1, state.range(0));
+}
+BENCHMARK(BM_UnaryCallAsync)->Arg(16)->Arg(1024)->Arg(64 * 1024)->UseRealTime();
+
+/**
+ * Server stream of 100 messages delivered through the async callbacks.
+ * Arg: message size in bytes.
+ */
+static void BM_ServerStream(benchmark::State& state) {
+  constexpr int64_t kMessages = 100;
+  Loopback& loopback = Loopback::shared();
+  const auto request = payload(static_cast<size_t>(state.range(0)));
+  const std::string metadata = R"({"x-repeat":[")" + std::to_string(kMessages) + R"("]})";
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    std::promise<void> done;
+    int64_t received = 0;
+    auto stream = loopback.client->createServerStream("/bench.Echo/ServerStream", request, metadata, 0);
+    stream->onData([&](const std::shared_ptr<ArrayBuffer>&) { received++; });
+    stream->onStatus(
+        [&](double, const std::string&, const std::shared_ptr<HybridCallMetadataSpec>&) { done.set_value(); });
+    done.get_future().wait();
+    if (received != kMessages) {
+      state.SkipWithError("server stream ended early");
+      break;
+    }
+  }
+  reportAllocations(state, allocationsBefore);
+  setThroughput(state, kMessages, state.range(0));
+}
+BENCHMARK(BM_ServerStream)->Arg(64)->Arg(4096)->Arg(64 * 1024)->UseRealTime();
+
+/**
+ * Client stream of 100 messages through the sync API, answered once after
+ * the half-close. Arg: message size in bytes.
+ */
+static void BM_ClientStream(benchmark::State& state) {
+  constexpr int64_t kMessages = 100;
+  Loopback& loopback = Loopback::shared();
+  const auto message = payload(static_cast<size_t>(state.range(0)));
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    auto stream =
+        loopback.client->createClientStreamSync("/bench.Echo/ClientStream", R"({"x-reply-at-end":["1"]})", 0);
+    for (int64_t i = 0; i < kMessages; i++) {
+      stream->writeSync(message);
+    }
+    auto response = stream->finishSync();
+    if (std::holds_alternative<nitro::NullType>(response)) {
+      state.SkipWithError("client stream returned no response");
+      break;
+    }
+  }
+  reportAllocations(state, allocationsBefore);
+  setThroughput(state, kMessages, state.range(0));
+}
+BENCHMARK(BM_ClientStream)->Arg(64)->Arg(4096)->Arg(64 * 1024)->UseRealTime();
+
+/**
+ * Bidi stream of 100 request/response round trips through the sync API.
+ * Arg: message size in bytes.
+ */
+static void BM_BidiStream(benchmark::State& state) {
+  constexpr int64_t kMessages = 100;
+  Loopback& loopback = Loopback::shared();
+  const auto message = payload(static_cast<size_t>(state.range(0)));
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    auto stream = loopback.client->createBidiStreamSync("/bench.Echo/BidiStream", "{}", 0);
+    for (int64_t i = 0; i < kMessages; i++) {
+      stream->writeSync(message);
+      if (std::holds_alternative<nitro::NullType>(stream->readSync())) {
+        state.SkipWithError("bidi stream ended early");
+        break;
+      }
+    }
+    stream->writesDone();
+    while (!std::holds_alternative<nitro::NullType>(stream->readSync())) {
+    }
+  }
+  reportAllocations(state, allocationsBefore);
+  setThroughput(state, kMessages, state.range(0));
+}
+BENCHMARK(BM_BidiStream)->Arg(64)->Arg(4096)->Arg(64 * 1024)->UseRealTime();
+
+} // namespace margelo::nitro::grpc::bench
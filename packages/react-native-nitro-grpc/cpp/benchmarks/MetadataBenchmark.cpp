@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/grpcpp.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "metadata/MetadataArena.hpp"
+#include "metadata/MetadataConverter.hpp"
+
+namespace margelo::nitro::grpc::bench {
+
+namespace {
+
+  /**
+   * Request metadata JSON with `count` headers, one of them binary.
+   */
+  std::string metadataJson(int64_t count) {
+    std::string json = "{";
+    for (int64_t i = 0; i < count; i++) {
+      if (i > 0) {
+        json += ",";
+      }
+      if (i == 0) {
+        json += R"("x-trace-bin":["AAECAwQFBgcICQoLDA0ODw=="])";
+      } else {
+        json += R"("x-header-)" + std::to_string(i) + R"(":["value-)" + std::to_string(i) + R"("])";
+      }
+    }
+    return json + "}";
+  }
+
+  void reportAllocations(benchmark::State& state, uint64_t before) {
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(AllocationCounter::count() - before),
+                                                  benchmark::Counter::kAvgIterations);
+  }
+
+} // namespace
+
+/**
+ * MetadataConverter::applyMetadata, the general JSON path. A ClientContext
+ * is created per iteration, as it is per call. Arg: header count.
+ */
+static void BM_ApplyMetadata(benchmark::State& state) {
+  const std::string json = metadataJson(state.range(0));
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    ::grpc::ClientContext context;
+    MetadataConverter::applyMetadata(json, context);
+    benchmark::ClobberMemory();
+  }
+  reportAllocations(state, allocationsBefore);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ApplyMetadata)->Arg(1)->Arg(8)->Arg(32);
+
+/**
+ * MetadataArena::apply, the reusing path taken by pooled unary calls.
+ * Arg: header count.
+ */
+static void BM_MetadataArenaApply(benchmark::State& state) {
+  const std::string json = metadataJson(state.range(0));
+  MetadataArena arena;
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    ::grpc::ClientContext context;
+    arena.apply(json, context);
+    benchmark::ClobberMemory();
+  }
+  reportAllocations(state, allocationsBefore);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MetadataArenaApply)->Arg(1)->Arg(8)->Arg(32);
+
+/**
+ * MetadataConverter::serializeInitialMetadata over received headers.
+ * Arg: header count.
+ */
+static void BM_SerializeInitialMetadata(benchmark::State& state) {
+  std::vector<std::pair<std::string, std::string>> storage;
+  storage.emplace_back("x-trace-bin", std::string("\x00\x01\x02\x03\xff\xfe\xfd\xfc", 8));
+  for (int64_t i = 1; i < state.range(0); i++) {
+    storage.emplace_back("x-header-" + std::to_string(i), "value-" + std::to_string(i));
+  }
+  std::multimap<::grpc::string_ref, ::grpc::string_ref> metadata;
+  for (const auto& [key, value] : storage) {
+    metadata.emplace(::grpc::string_ref(key), ::grpc::string_ref(value));
+  }
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MetadataConverter::serializeInitialMetadata(metadata));
+  }
+  reportAllocations(state, allocationsBefore);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerializeInitialMetadata)->Arg(1)->Arg(8)->Arg(32);
+
+} // namespace margelo::nitro::grpc::bench
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "utils/base64/Base64Simd.hpp"
+#include "utils/gzip/HybridGzip.hpp"
+#include "utils/sha256/Sha256.hpp"
+#include "utils/uuid/HybridUuid.hpp"
+
+namespace margelo::nitro::grpc::bench {
+
+namespace {
+
+  /**
+   * Deterministic bytes with some redundancy, so gzip has work to do but
+   * does not collapse the input to nothing.
+   */
+  std::vector<uint8_t> sampleBytes(size_t size) {
+    std::mt19937 random(42);
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) {
+      bytes[i] = static_cast<uint8_t>(random() % 32 + 'A');
+    }
+    return bytes;
+  }
+
+  std::shared_ptr<ArrayBuffer> sampleBuffer(size_t size) {
+    const auto bytes = sampleBytes(size);
+    return ArrayBuffer::copy(bytes.data(), bytes.size());
+  }
+
+  void reportAllocations(benchmark::State& state, uint64_t before) {
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(AllocationCounter::count() - before),
+                                                  benchmark::Counter::kAvgIterations);
+  }
+
+} // namespace
+
+static void BM_Gzip(benchmark::State& state) {
+  HybridGzip gzip;
+  const auto input = sampleBuffer(static_cast<size_t>(state.range(0)));
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(gzip.gzip(input));
+  }
+  reportAllocations(state, allocationsBefore);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Gzip)->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+static void BM_Ungzip(benchmark::State& state) {
+  HybridGzip gzip;
+  const auto compressed = gzip.gzip(sampleBuffer(static_cast<size_t>(state.range(0))));
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(gzip.ungzip(compressed));
+  }
+  reportAllocations(state, allocationsBefore);
+  // Throughput in uncompressed bytes, like the gzip direction
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Ungzip)->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+static void BM_Base64Encode(benchmark::State& state) {
+  const auto input = sampleBytes(static_cast<size_t>(state.range(0)));
+  std::string output(Base64Simd::encodedLength(input.size(), false), '\0');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base64Simd::encode(input.data(), input.size(), output.data(), false));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  state.SetLabel(Base64Simd::implementationName());
+}
+BENCHMARK(BM_Base64Encode)->Arg(64)->Arg(4096)->Arg(1024 * 1024);
+
+static void BM_Base64Decode(benchmark::State& state) {
+  const auto input = sampleBytes(static_cast<size_t>(state.range(0)));
+  std::string encoded(Base64Simd::encodedLength(input.size(), false), '\0');
+  Base64Simd::encode(input.data(), input.size(), encoded.data(), false);
+  std::vector<uint8_t> output(Base64Simd::decodedLength(encoded.data(), encoded.size()));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base64Simd::decode(encoded.data(), encoded.size(), output.data(), false));
+    benchmark::ClobberMemory();
+  }
+  // Throughput in decoded bytes, so both directions are comparable
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  state.SetLabel(Base64Simd::implementationName());
+}
+BENCHMARK(BM_Base64Decode)->Arg(64)->Arg(4096)->Arg(1024 * 1024);
+
+static void BM_Sha256(benchmark::State& state) {
+  const auto input = sampleBytes(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Sha256::hash(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  state.SetLabel(Sha256::implementationName());
+}
+BENCHMARK(BM_Sha256)->Arg(64)->Arg(4096)->Arg(1024 * 1024);
+
+static void BM_UuidGenerate(benchmark::State& state) {
+  HybridUuid uuid;
+
+  const uint64_t allocationsBefore = AllocationCounter::count();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uuid.generate());
+  }
+  reportAllocations(state, allocationsBefore);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UuidGenerate);
+
+} // namespace margelo::nitro::grpc::bench
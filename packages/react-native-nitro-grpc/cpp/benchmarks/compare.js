@@ -0,0 +1,148 @@
+#!/usr/bin/env node
+/**
+ * Compares a Google Benchmark JSON run against a baseline run and exits
+ * non-zero when a benchmark regressed. Both runs must come from the same
+ * machine; see CONTRIBUTING.md for recording a local baseline.
+ *
+ *   node cpp/benchmarks/compare.js <baseline.json> <current.json> [--threshold 10]
+ *
+ * A benchmark regresses when its real time grows by more than the threshold
+ * (in percent), or when its `allocs` counter grows by more than 2% (and at
+ * least half an allocation per iteration). Stream benchmarks share the
+ * process with gRPC's own threads, so their counts wobble slightly.
+ * With --benchmark_repetitions the median aggregate is compared, otherwise
+ * the single run.
+ */
+const fs = require('fs');
+
+const TIME_UNITS = { ns: 1, us: 1e3, ms: 1e6, s: 1e9 };
+const ALLOCATION_SLACK = 0.5;
+const ALLOCATION_SLACK_RATIO = 0.02;
+
+function usage() {
+  console.error(
+    'usage: compare.js <baseline.json> <current.json> [--threshold <percent>]',
+  );
+  process.exit(2);
+}
+
+function parseArgs(argv) {
+  const files = [];
+  let threshold = 10;
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--threshold') {
+      threshold = Number(argv[++i]);
+      if (!Number.isFinite(threshold)) usage();
+    } else {
+      files.push(argv[i]);
+    }
+  }
+  if (files.length !== 2) usage();
+  return { baselinePath: files[0], currentPath: files[1], threshold };
+}
+
+/**
+ * Benchmark name -> { timeNs, allocs } for one run file.
+ */
+function load(path) {
+  const run = JSON.parse(fs.readFileSync(path, 'utf8'));
+  const hasMedians = run.benchmarks.some(b => b.aggregate_name === 'median');
+  const results = new Map();
+  for (const b of run.benchmarks) {
+    if (b.error_occurred) continue;
+    const wanted = hasMedians
+      ? b.aggregate_name === 'median'
+      : b.run_type !== 'aggregate';
+    if (!wanted) continue;
+    results.set(b.run_name ?? b.name, {
+      timeNs: b.real_time * TIME_UNITS[b.time_unit ?? 'ns'],
+      allocs: b.allocs,
+    });
+  }
+  return { context: run.context, results };
+}
+
+function formatTime(ns) {
+  if (ns >= 1e6) return `${(ns / 1e6).toFixed(2)} ms`;
+  if (ns >= 1e3) return `${(ns / 1e3).toFixed(2)} us`;
+  return `${ns.toFixed(0)} ns`;
+}
+
+function allocationNote(before, now) {
+  if (before.allocs === undefined || now.allocs === undefined) return null;
+  const allowed =
+    before.allocs +
+    Math.max(ALLOCATION_SLACK, before.allocs * ALLOCATION_SLACK_RATIO);
+  if (now.allocs <= allowed) return null;
+  return `ALLOCS ${before.allocs.toFixed(1)} -> ${now.allocs.toFixed(1)}`;
+}
+
+function main() {
+  const { baselinePath, currentPath, threshold } = parseArgs(
+    process.argv.slice(2),
+  );
+  const baseline = load(baselinePath);
+  const current = load(currentPath);
+
+  if (
+    baseline.context.num_cpus !== current.context.num_cpus ||
+    baseline.context.library_build_type !==
+      current.context.library_build_type
+  ) {
+    console.warn(
+      'warning: baseline comes from a different machine or build type\n',
+    );
+  }
+
+  const regressions = [];
+  const rows = [];
+  for (const [name, now] of current.results) {
+    const before = baseline.results.get(name);
+    if (!before) {
+      rows.push([name, '-', formatTime(now.timeNs), 'new']);
+      continue;
+    }
+    const change = ((now.timeNs - before.timeNs) / before.timeNs) * 100;
+    const notes = [];
+    if (change > threshold) notes.push('SLOWER');
+    const allocations = allocationNote(before, now);
+    if (allocations) notes.push(allocations);
+    if (notes.length > 0) regressions.push(name);
+    const sign = change >= 0 ? '+' : '';
+    rows.push([
+      name,
+      formatTime(before.timeNs),
+      formatTime(now.timeNs),
+      [`${sign}${change.toFixed(1)}%`, ...notes].join('  '),
+    ]);
+  }
+  for (const [name, before] of baseline.results) {
+    if (!current.results.has(name)) {
+      rows.push([name, formatTime(before.timeNs), '-', 'missing']);
+    }
+  }
+
+  const widths = [0, 1, 2].map(column =>
+    Math.max(...rows.map(row => row[column].length)),
+  );
+  for (const row of rows) {
+    console.log(
+      [
+        row[0].padEnd(widths[0]),
+        row[1].padStart(widths[1]),
+        row[2].padStart(widths[2]),
+        row[3],
+      ].join('  '),
+    );
+  }
+
+  if (regressions.length > 0) {
+    console.error(
+      `\n${regressions.length} benchmark(s) regressed beyond ${threshold}%`,
+    );
+    process.exit(1);
+  }
+  console.log(`\nNo regressions beyond ${threshold}%`);
+}
+
+main();
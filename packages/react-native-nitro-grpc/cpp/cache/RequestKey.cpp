@@ -0,0 +1,46 @@
+#include "RequestKey.hpp"
+
+#include "../utils/checksum/Xxh3.hpp"
+#include "../utils/json/JsonParser.hpp"
+
+namespace margelo::nitro::grpc {
+
+std::string RequestKey::make(const std::string& method,
+                             const uint8_t* data,
+                             size_t length,
+                             const std::string& metadataJson,
+                             const std::vector<std::string>& varyMetadata) {
+  Xxh3 hasher;
+  hasher.update(data, length);
+
+  if (!varyMetadata.empty()) {
+    const auto metadata = JsonParser::parseMetadata(metadataJson);
+    // Length-prefix every field so ("ab", "c") and ("a", "bc") never collide.
+    auto absorb = [&hasher](const std::string& field) {
+      const uint64_t size = field.size();
+      hasher.update(reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+      hasher.update(reinterpret_cast<const uint8_t*>(field.data()), field.size());
+    };
+    for (const auto& key : varyMetadata) {
+      absorb(key);
+      auto it = metadata.find(key);
+      const uint64_t count = it == metadata.end() ? 0 : it->second.size();
+      hasher.update(reinterpret_cast<const uint8_t*>(&count), sizeof(count));
+      if (it != metadata.end()) {
+        for (const auto& value : it->second) {
+          absorb(value);
+        }
+      }
+    }
+  }
+
+  const auto digest = hasher.digest128();
+  std::string key;
+  key.reserve(method.size() + 1 + digest.size());
+  key.append(method);
+  key.push_back('\0');
+  key.append(reinterpret_cast<const char*>(digest.data()), digest.size());
+  return key;
+}
+
+} // namespace margelo::nitro::grpc
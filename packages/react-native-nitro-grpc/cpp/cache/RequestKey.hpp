@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Identity of a unary request for caching and de-duplication.
+ *
+ * Two requests share a key when they target the same method, carry the same
+ * serialized bytes and agree on every metadata header listed in `varyMetadata`.
+ * The payload is reduced to an XXH3-128 digest so keys stay small regardless of
+ * request size.
+ */
+namespace RequestKey {
+
+/**
+ * @param method Fully qualified method name
+ * @param data Serialized request
+ * @param metadataJson Request metadata as JSON (only parsed if `varyMetadata` is non-empty)
+ * @param varyMetadata Metadata keys whose values become part of the key
+ */
+std::string make(const std::string& method,
+                 const uint8_t* data,
+                 size_t length,
+                 const std::string& metadataJson,
+                 const std::vector<std::string>& varyMetadata);
+
+} // namespace RequestKey
+
+} // namespace margelo::nitro::grpc
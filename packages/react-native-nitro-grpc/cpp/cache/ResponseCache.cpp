@@ -0,0 +1,207 @@
+#include "ResponseCache.hpp"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr const char* kAuthorization = "authorization";
+
+} // namespace
+
+ResponseCache::Config ResponseCache::parseConfig(const std::string& jsonStr) {
+  Config config;
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return config;
+  }
+
+  try {
+    auto j = json::parse(jsonStr);
+
+    if (j.contains("maxBytes")) {
+      const double maxBytes = j["maxBytes"].get<double>();
+      if (maxBytes < 0) {
+        throw std::runtime_error("maxBytes must not be negative");
+      }
+      config.maxBytes = static_cast<size_t>(maxBytes);
+    }
+
+    if (j.contains("methods")) {
+      for (auto& [method, value] : j["methods"].items()) {
+        MethodPolicy policy;
+        policy.ttlMs = static_cast<int64_t>(value.at("ttlMs").get<double>());
+        if (policy.ttlMs <= 0) {
+          throw std::runtime_error("ttlMs for " + method + " must be positive");
+        }
+        if (value.contains("staleWhileRevalidateMs")) {
+          policy.staleWhileRevalidateMs = static_cast<int64_t>(value["staleWhileRevalidateMs"].get<double>());
+          if (policy.staleWhileRevalidateMs < 0) {
+            throw std::runtime_error("staleWhileRevalidateMs for " + method + " must not be negative");
+          }
+        }
+        if (value.contains("varyMetadata")) {
+          policy.varyMetadata = value["varyMetadata"].get<std::vector<std::string>>();
+        }
+        // Never serve one user's response to another unless the caller says it is safe
+        auto& vary = policy.varyMetadata;
+        if (value.value("varyAuthorization", true) &&
+            std::find(vary.begin(), vary.end(), kAuthorization) == vary.end()) {
+          vary.emplace_back(kAuthorization);
+        }
+        config.methods[method] = std::move(policy);
+      }
+    }
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse response cache config: " + std::string(e.what()));
+  }
+
+  return config;
+}
+
+void ResponseCache::configure(Config config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _config = std::move(config);
+  _lru.clear();
+  _index.clear();
+  _bytes = 0;
+}
+
+std::optional<ResponseCache::MethodPolicy> ResponseCache::policyFor(const std::string& method) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _config.methods.find(method);
+  if (it == _config.methods.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::optional<ResponseCache::Hit> ResponseCache::lookup(const std::string& key) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto found = _index.find(key);
+  if (found == _index.end()) {
+    _stats.misses++;
+    return std::nullopt;
+  }
+
+  auto it = found->second;
+  const auto now = Clock::now();
+  if (now >= it->staleUntil) {
+    evictLocked(it);
+    _stats.misses++;
+    return std::nullopt;
+  }
+
+  _lru.splice(_lru.begin(), _lru, it);
+
+  Hit hit{it->response, now >= it->expiresAt, false};
+  if (hit.stale) {
+    _stats.staleHits++;
+    if (!it->revalidating) {
+      it->revalidating = true;
+      hit.shouldRevalidate = true;
+      _stats.revalidations++;
+    }
+  } else {
+    _stats.hits++;
+  }
+  return hit;
+}
+
+void ResponseCache::store(const std::string& key, const std::string& method, std::vector<uint8_t> response) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto policy = _config.methods.find(method);
+  if (policy == _config.methods.end()) {
+    return; // Reconfigured while the call was in flight
+  }
+
+  auto existing = _index.find(key);
+  if (existing != _index.end()) {
+    evictLocked(existing->second);
+  }
+
+  const auto now = Clock::now();
+  Entry entry;
+  entry.key = key;
+  entry.method = method;
+  entry.response = std::make_shared<const std::vector<uint8_t>>(std::move(response));
+  entry.expiresAt = now + std::chrono::milliseconds(policy->second.ttlMs);
+  entry.staleUntil = entry.expiresAt + std::chrono::milliseconds(policy->second.staleWhileRevalidateMs);
+
+  if (entry.cost() > _config.maxBytes) {
+    return; // Would evict everything else and still not fit
+  }
+
+  _bytes += entry.cost();
+  _lru.push_front(std::move(entry));
+  _index[key] = _lru.begin();
+  _stats.stores++;
+  trimLocked();
+}
+
+void ResponseCache::revalidationFailed(const std::string& key) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _index.find(key);
+  if (it != _index.end()) {
+    it->second->revalidating = false;
+  }
+}
+
+void ResponseCache::invalidate(const std::string& method) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto it = _lru.begin(); it != _lru.end();) {
+    auto next = std::next(it);
+    if (method.empty() || it->method == method) {
+      _bytes -= it->cost();
+      _index.erase(it->key);
+      _lru.erase(it);
+    }
+    it = next;
+  }
+}
+
+ResponseCache::Stats ResponseCache::stats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Stats stats = _stats;
+  stats.entries = _index.size();
+  stats.bytes = _bytes;
+  stats.maxBytes = _config.maxBytes;
+  return stats;
+}
+
+std::string ResponseCache::statsJson() const {
+  const Stats s = stats();
+  json j = {
+      {"hits", s.hits},
+      {"staleHits", s.staleHits},
+      {"misses", s.misses},
+      {"stores", s.stores},
+      {"evictions", s.evictions},
+      {"revalidations", s.revalidations},
+      {"entries", s.entries},
+      {"bytes", s.bytes},
+      {"maxBytes", s.maxBytes},
+  };
+  return j.dump();
+}
+
+void ResponseCache::evictLocked(EntryList::iterator it) {
+  _bytes -= it->cost();
+  _index.erase(it->key);
+  _lru.erase(it);
+}
+
+void ResponseCache::trimLocked() {
+  while (_bytes > _config.maxBytes && !_lru.empty()) {
+    evictLocked(std::prev(_lru.end()));
+    _stats.evictions++;
+  }
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief In-memory cache of unary responses for idempotent methods.
+ *
+ * Only methods listed in the configuration are cached; everything else passes
+ * straight through. Entries are evicted least-recently-used first once the
+ * total size of cached responses exceeds `maxBytes`.
+ *
+ * Each method has a TTL during which hits are served as fresh. An optional
+ * stale-while-revalidate window after that keeps serving the old response
+ * while exactly one background call refreshes it.
+ *
+ * Thread-safe.
+ */
+class ResponseCache {
+public:
+  struct MethodPolicy {
+    int64_t ttlMs = 0;
+    int64_t staleWhileRevalidateMs = 0;
+    std::vector<std::string> varyMetadata;
+  };
+
+  struct Config {
+    size_t maxBytes = 4 * 1024 * 1024;
+    std::unordered_map<std::string, MethodPolicy> methods;
+  };
+
+  struct Hit {
+    std::shared_ptr<const std::vector<uint8_t>> response;
+    bool stale = false;
+    // True for exactly one caller per stale entry; that caller refreshes it.
+    bool shouldRevalidate = false;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t staleHits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+    uint64_t revalidations = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t maxBytes = 0;
+  };
+
+  /**
+   * Parse the configuration JSON from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "maxBytes"?: number,
+   *   "methods": {
+   *     "/pkg.Service/Method": {
+   *       "ttlMs": number,
+   *       "staleWhileRevalidateMs"?: number,
+   *       "varyMetadata"?: string[],
+   *       "varyAuthorization"?: boolean
+   *     }
+   *   }
+   * }
+   *
+   * `authorization` is added to every policy's varyMetadata unless
+   * varyAuthorization is false.
+   *
+   * @throws std::runtime_error if the JSON is malformed, a TTL is not
+   *         positive or a stale-while-revalidate window is negative
+   */
+  static Config parseConfig(const std::string& json);
+
+  /**
+   * Replace the configuration. Cached entries are dropped.
+   */
+  void configure(Config config);
+
+  /**
+   * Policy for `method`, or nullopt if the method is not cached.
+   */
+  std::optional<MethodPolicy> policyFor(const std::string& method) const;
+
+  /**
+   * Look up a response. Counts a hit or miss; expired entries are removed.
+   */
+  std::optional<Hit> lookup(const std::string& key);
+
+  /**
+   * Store a successful response for `key` under `method`'s policy.
+   */
+  void store(const std::string& key, const std::string& method, std::vector<uint8_t> response);
+
+  /**
+   * Allow another revalidation of `key` after a background refresh failed.
+   */
+  void revalidationFailed(const std::string& key);
+
+  /**
+   * Drop cached responses for `method`, or every response if `method` is empty.
+   */
+  void invalidate(const std::string& method);
+
+  Stats stats() const;
+
+  /**
+   * Stats serialized as a JSON object for the JS bridge.
+   */
+  std::string statsJson() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::string key;
+    std::string method;
+    std::shared_ptr<const std::vector<uint8_t>> response;
+    Clock::time_point expiresAt;
+    Clock::time_point staleUntil;
+    bool revalidating = false;
+
+    size_t cost() const {
+      return response->size() + key.size();
+    }
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void evictLocked(EntryList::iterator it);
+  void trimLocked();
+
+  mutable std::mutex _mutex;
+  Config _config;
+  EntryList _lru; // Most recently used first
+  std::unordered_map<std::string, EntryList::iterator> _index;
+  size_t _bytes = 0;
+  Stats _stats;
+};
+
+} // namespace margelo::nitro::grpc
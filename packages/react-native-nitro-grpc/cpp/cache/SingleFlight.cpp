@@ -0,0 +1,183 @@
+#include "SingleFlight.hpp"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr const char* kAuthorization = "authorization";
+
+} // namespace
+
+SingleFlight::Config SingleFlight::parseConfig(const std::string& jsonStr) {
+  Config config;
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return config;
+  }
+
+  try {
+    auto j = json::parse(jsonStr);
+    if (j.contains("methods")) {
+      for (auto& [method, value] : j["methods"].items()) {
+        std::vector<std::string> varyMetadata;
+        if (value.contains("varyMetadata")) {
+          varyMetadata = value["varyMetadata"].get<std::vector<std::string>>();
+        }
+        // Never hand one user's response to another unless the caller says it is safe
+        if (value.value("varyAuthorization", true) &&
+            std::find(varyMetadata.begin(), varyMetadata.end(), kAuthorization) == varyMetadata.end()) {
+          varyMetadata.emplace_back(kAuthorization);
+        }
+        config.methods[method] = std::move(varyMetadata);
+      }
+    }
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse coalescing config: " + std::string(e.what()));
+  }
+
+  return config;
+}
+
+void SingleFlight::configure(Config config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // Calls already in flight keep fanning out; only new calls see the change.
+  _config = std::move(config);
+}
+
+std::optional<std::vector<std::string>> SingleFlight::varyMetadataFor(const std::string& method) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _config.methods.find(method);
+  if (it == _config.methods.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+bool SingleFlight::join(const std::string& key,
+                        const std::string& callId,
+                        const std::shared_ptr<ResponsePromise>& promise) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  checkCallIdLocked(callId);
+  auto it = _flights.find(key);
+  if (it == _flights.end()) {
+    return false;
+  }
+  it->second->waiters.emplace_back(callId, promise);
+  _byCallId[callId] = it->second;
+  _coalesced++;
+  return true;
+}
+
+std::shared_ptr<SingleFlight::ResponsePromise>
+SingleFlight::lead(const std::string& key,
+                   const std::string& callId,
+                   const std::shared_ptr<ResponsePromise>& promise,
+                   const std::shared_ptr<::grpc::ClientContext>& context) {
+  auto flight = std::make_shared<Flight>();
+  flight->key = key;
+  flight->context = context;
+  flight->waiters.emplace_back(callId, promise);
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    checkCallIdLocked(callId);
+    _flights[key] = flight;
+    _byCallId[callId] = flight;
+  }
+
+  auto shared = ResponsePromise::create();
+  shared->addOnResolvedListener([self = shared_from_this(), flight](const std::shared_ptr<ArrayBuffer>& response) {
+    Waiters waiters;
+    {
+      std::lock_guard<std::mutex> lock(self->_mutex);
+      waiters = self->completeLocked(flight);
+    }
+    // JS may mutate what it receives, so every waiter past the first gets its own buffer.
+    for (size_t i = 0; i < waiters.size(); i++) {
+      waiters[i].second->resolve(i == 0 ? response : ArrayBuffer::copy(response->data(), response->size()));
+    }
+  });
+  shared->addOnRejectedListener([self = shared_from_this(), flight](const std::exception_ptr& error) {
+    Waiters waiters;
+    {
+      std::lock_guard<std::mutex> lock(self->_mutex);
+      waiters = self->completeLocked(flight);
+    }
+    for (auto& waiter : waiters) {
+      waiter.second->reject(error);
+    }
+  });
+  return shared;
+}
+
+bool SingleFlight::cancel(const std::string& callId) {
+  std::shared_ptr<ResponsePromise> cancelled;
+  std::shared_ptr<::grpc::ClientContext> abandoned;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _byCallId.find(callId);
+    if (found == _byCallId.end()) {
+      return false;
+    }
+    auto flight = found->second;
+    _byCallId.erase(found);
+
+    auto& waiters = flight->waiters;
+    for (auto it = waiters.begin(); it != waiters.end(); ++it) {
+      if (it->first == callId) {
+        cancelled = it->second;
+        waiters.erase(it);
+        break;
+      }
+    }
+
+    if (waiters.empty()) {
+      // Nobody is left; let a new caller start a fresh call.
+      completeLocked(flight);
+      abandoned = flight->context;
+    }
+  }
+
+  if (cancelled) {
+    cancelled->reject(std::make_exception_ptr(std::runtime_error("gRPC Error [1]: Cancelled")));
+  }
+  if (abandoned) {
+    abandoned->TryCancel();
+  }
+  return true;
+}
+
+uint64_t SingleFlight::coalescedCount() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _coalesced;
+}
+
+void SingleFlight::checkCallIdLocked(const std::string& callId) const {
+  // Waiters are cancelled by ID; a shared ID would cancel (or orphan) the wrong caller
+  if (callId.empty()) {
+    throw std::runtime_error("Coalesced calls need a call ID");
+  }
+  if (_byCallId.count(callId) != 0) {
+    throw std::runtime_error("Call ID '" + callId + "' is already in flight");
+  }
+}
+
+SingleFlight::Waiters SingleFlight::completeLocked(const std::shared_ptr<Flight>& flight) {
+  auto it = _flights.find(flight->key);
+  if (it != _flights.end() && it->second == flight) {
+    _flights.erase(it);
+  }
+  for (const auto& waiter : flight->waiters) {
+    _byCallId.erase(waiter.first);
+  }
+  Waiters waiters;
+  waiters.swap(flight->waiters);
+  return waiters;
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Coalesces identical in-flight unary calls into one RPC.
+ *
+ * The first caller for a request key leads: it issues the RPC and owns the
+ * ClientContext. Callers with the same key that arrive before the RPC
+ * completes join as waiters and receive their own copy of the response (or
+ * the same error). Cancelling a waiter only rejects that waiter; the RPC
+ * itself is cancelled once nobody is waiting for it anymore.
+ *
+ * Only methods listed in the configuration are coalesced. Thread-safe; must be
+ * owned by a std::shared_ptr.
+ */
+class SingleFlight : public std::enable_shared_from_this<SingleFlight> {
+public:
+  using ResponsePromise = Promise<std::shared_ptr<ArrayBuffer>>;
+
+  struct Config {
+    // Method -> metadata keys that must match for calls to be coalesced
+    std::unordered_map<std::string, std::vector<std::string>> methods;
+  };
+
+  /**
+   * Parse the configuration JSON from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "methods": {
+   *     "/pkg.Service/Method": { "varyMetadata"?: string[], "varyAuthorization"?: boolean }
+   *   }
+   * }
+   *
+   * `authorization` is added to every method's varyMetadata unless
+   * varyAuthorization is false.
+   *
+   * @throws std::runtime_error if the JSON is malformed
+   */
+  static Config parseConfig(const std::string& json);
+
+  void configure(Config config);
+
+  /**
+   * Metadata keys that distinguish calls to `method`, or nullopt if the
+   * method is not coalesced.
+   */
+  std::optional<std::vector<std::string>> varyMetadataFor(const std::string& method) const;
+
+  /**
+   * Attach `promise` to the call in flight for `key`, if any.
+   *
+   * @return true if the caller joined; false if it must lead a new call
+   * @throws std::runtime_error if `callId` is empty or already in flight
+   */
+  bool join(const std::string& key, const std::string& callId, const std::shared_ptr<ResponsePromise>& promise);
+
+  /**
+   * Register a new call for `key` led by (`callId`, `promise`).
+   *
+   * @return The promise to hand to the RPC; settling it fans out to every waiter
+   * @throws std::runtime_error if `callId` is empty or already in flight
+   */
+  std::shared_ptr<ResponsePromise> lead(const std::string& key,
+                                        const std::string& callId,
+                                        const std::shared_ptr<ResponsePromise>& promise,
+                                        const std::shared_ptr<::grpc::ClientContext>& context);
+
+  /**
+   * Cancel the waiter registered as `callId`.
+   *
+   * @return false if `callId` is not a coalesced call
+   */
+  bool cancel(const std::string& callId);
+
+  /**
+   * Number of calls that joined an existing RPC instead of issuing their own.
+   */
+  uint64_t coalescedCount() const;
+
+private:
+  // (callId, promise) pairs in arrival order
+  using Waiters = std::vector<std::pair<std::string, std::shared_ptr<ResponsePromise>>>;
+
+  struct Flight {
+    std::string key;
+    std::shared_ptr<::grpc::ClientContext> context;
+    Waiters waiters;
+  };
+
+  /**
+   * Remove `flight` and return its waiters; they no longer receive anything
+   * through the registry.
+   */
+  Waiters completeLocked(const std::shared_ptr<Flight>& flight);
+
+  void checkCallIdLocked(const std::string& callId) const;
+
+  mutable std::mutex _mutex;
+  Config _config;
+  std::unordered_map<std::string, std::shared_ptr<Flight>> _flights; // By request key
+  std::unordered_map<std::string, std::shared_ptr<Flight>> _byCallId;
+  uint64_t _coalesced = 0;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,29 @@
+#include "CallMetadataStore.hpp"
+
+#include <utility>
+
+namespace margelo::nitro::grpc {
+
+void CallMetadataStore::store(const std::string& callId, std::shared_ptr<const ::grpc::ClientContext> context) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _contexts[callId] = std::move(context);
+  _order.push_back(callId);
+  // Contexts JS already took leave stale entries here; erasing them is a no-op
+  while (_order.size() > kCapacity) {
+    _contexts.erase(_order.front());
+    _order.pop_front();
+  }
+}
+
+std::shared_ptr<const ::grpc::ClientContext> CallMetadataStore::take(const std::string& callId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _contexts.find(callId);
+  if (it == _contexts.end()) {
+    return nullptr;
+  }
+  auto context = std::move(it->second);
+  _contexts.erase(it);
+  return context;
+}
+
+} // namespace margelo::nitro::grpc
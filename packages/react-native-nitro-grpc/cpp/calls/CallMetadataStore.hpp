@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Contexts of finished unary calls, held until JS takes their headers
+ * and trailers.
+ *
+ * Only the ClientContext is kept; nothing is copied or serialized until JS
+ * reads a HybridCallMetadata view over it. At most `kCapacity` contexts are
+ * kept: if JS never asks for a call's metadata, it is eventually dropped.
+ *
+ * Thread-safe.
+ */
+class CallMetadataStore {
+public:
+  static constexpr size_t kCapacity = 64;
+
+  /**
+   * Keep `context` under `callId`. The call must have finished, so both its
+   * initial and trailing metadata are available.
+   */
+  void store(const std::string& callId, std::shared_ptr<const ::grpc::ClientContext> context);
+
+  /**
+   * The call's context, removed from the store, or nullptr if there is none.
+   */
+  std::shared_ptr<const ::grpc::ClientContext> take(const std::string& callId);
+
+private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<const ::grpc::ClientContext>> _contexts;
+  // Insertion order, for dropping the oldest context when full
+  std::deque<std::string> _order;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,43 @@
+#include "CallRegistry.hpp"
+
+#include <utility>
+
+namespace margelo::nitro::grpc {
+
+void CallRegistry::add(const std::string& callId, std::shared_ptr<::grpc::ClientContext> context, Node& spare) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (spare.empty()) {
+    _calls[callId] = std::move(context);
+    return;
+  }
+  spare.key() = callId;
+  spare.mapped() = std::move(context);
+  auto result = _calls.insert(std::move(spare));
+  if (!result.inserted) {
+    // Reused call ID: the newer call wins, as with operator[]
+    result.position->second = std::move(result.node.mapped());
+    spare = std::move(result.node);
+    spare.mapped().reset();
+  }
+}
+
+void CallRegistry::remove(const std::string& callId, Node& spare) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Node node = _calls.extract(callId);
+  if (!node.empty()) {
+    node.mapped().reset();
+    spare = std::move(node);
+  }
+}
+
+bool CallRegistry::cancel(const std::string& callId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _calls.find(callId);
+  if (it == _calls.end()) {
+    return false;
+  }
+  it->second->TryCancel();
+  return true;
+}
+
+} // namespace margelo::nitro::grpc
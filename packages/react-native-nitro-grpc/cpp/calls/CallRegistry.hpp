@@ -0,0 +1,46 @@
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief In-flight unary calls by call ID, for cancellation from JS.
+ *
+ * Map nodes are handed back to the caller on removal so a pooled call
+ * record can reuse its node (and the node's key capacity) for its next call
+ * instead of allocating one per call. Thread-safe; shared between a client
+ * and the worker threads of its calls.
+ */
+class CallRegistry {
+public:
+  using Map = std::unordered_map<std::string, std::shared_ptr<::grpc::ClientContext>>;
+  using Node = Map::node_type;
+
+  /**
+   * Register a call, reusing `spare` if it holds a node from remove().
+   */
+  void add(const std::string& callId, std::shared_ptr<::grpc::ClientContext> context, Node& spare);
+
+  /**
+   * Unregister a call. The node is moved into `spare` with its context released.
+   */
+  void remove(const std::string& callId, Node& spare);
+
+  /**
+   * Cancel a registered call.
+   *
+   * @return false if no call with that ID is in flight
+   */
+  bool cancel(const std::string& callId);
+
+private:
+  Map _calls;
+  std::mutex _mutex;
+};
+
+} // namespace margelo::nitro::grpc
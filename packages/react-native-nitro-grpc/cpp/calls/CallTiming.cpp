@@ -0,0 +1,60 @@
+#include "CallTiming.hpp"
+
+#include <nlohmann/json.hpp>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+std::string CallTiming::toJson() const {
+  const auto between = [this](Phase from, Phase to) -> json {
+    if (at[from] == 0 || at[to] == 0) {
+      return nullptr;
+    }
+    return static_cast<double>(at[to] - at[from]) / 1e6;
+  };
+
+  json j = {
+      {"queuedMs", between(JSI_ENTRY, DISPATCHED)},
+      {"metadataMs", between(DISPATCHED, METADATA_APPLIED)},
+      {"firstByteSentMs", between(METADATA_APPLIED, FIRST_BYTE_SENT)},
+      {"initialMetadataMs", between(FIRST_BYTE_SENT, INITIAL_METADATA_RECEIVED)},
+      {"responseMs", between(INITIAL_METADATA_RECEIVED, RESPONSE_RECEIVED)},
+      {"settleMs", between(RESPONSE_RECEIVED, SETTLED)},
+      {"nativeTotalMs", between(JSI_ENTRY, SETTLED)},
+  };
+  return j.dump();
+}
+
+void CallTimingStore::setEnabled(bool enabled) {
+  _enabled.store(enabled, std::memory_order_relaxed);
+  if (!enabled) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _timings.clear();
+    _order.clear();
+  }
+}
+
+void CallTimingStore::store(const std::string& callId, const CallTiming& timing) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _timings[callId] = timing;
+  _order.push_back(callId);
+  // Timings JS already took leave stale entries here; erasing them is a no-op
+  while (_order.size() > kCapacity) {
+    _timings.erase(_order.front());
+    _order.pop_front();
+  }
+}
+
+std::string CallTimingStore::take(const std::string& callId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _timings.find(callId);
+  if (it == _timings.end()) {
+    return "";
+  }
+  std::string result = it->second.toJson();
+  _timings.erase(it);
+  return result;
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Monotonic timestamps of one unary call's phases.
+ *
+ * A phase that was never reached (a failed call, a cancelled one) keeps 0.
+ */
+struct CallTiming {
+  enum Phase : size_t {
+    // unaryCall entered from JS
+    JSI_ENTRY,
+    // Worker thread started the call
+    DISPATCHED,
+    // Metadata, deadline and method defaults applied to the context
+    METADATA_APPLIED,
+    // Request headers written to the transport
+    FIRST_BYTE_SENT,
+    // Server's initial metadata received
+    INITIAL_METADATA_RECEIVED,
+    // Response message and status received
+    RESPONSE_RECEIVED,
+    // About to settle the promise; stamped before resolve()/reject() so the
+    // timing is stored by the time JS sees the result
+    SETTLED,
+    PHASE_COUNT,
+  };
+
+  std::array<int64_t, PHASE_COUNT> at{};
+
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void mark(Phase phase) {
+    at[phase] = now();
+  }
+
+  void clear() {
+    at.fill(0);
+  }
+
+  /**
+   * Durations of the phases in milliseconds, each ending at the named
+   * event, null where the event or its predecessor is missing:
+   * {"queuedMs", "metadataMs", "firstByteSentMs", "initialMetadataMs",
+   *  "responseMs", "settleMs", "nativeTotalMs"}
+   */
+  std::string toJson() const;
+};
+
+/**
+ * @brief Timings of completed calls, held until JS takes them.
+ *
+ * Disabled by default; while disabled calls record nothing and the only
+ * per-call cost is one relaxed atomic load. At most `kCapacity` timings are
+ * kept: if JS never asks for a call's timing, it is eventually dropped.
+ *
+ * Thread-safe.
+ */
+class CallTimingStore {
+public:
+  static constexpr size_t kCapacity = 256;
+
+  bool enabled() const {
+    return _enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Turn recording on or off. Turning it off drops stored timings.
+   */
+  void setEnabled(bool enabled);
+
+  void store(const std::string& callId, const CallTiming& timing);
+
+  /**
+   * The JSON of the call's timing (see CallTiming::toJson), removed from the
+   * store, or "" if there is none.
+   */
+  std::string take(const std::string& callId);
+
+private:
+  std::atomic<bool> _enabled{false};
+  std::mutex _mutex;
+  std::unordered_map<std::string, CallTiming> _timings;
+  // Insertion order, for dropping the oldest timing when full
+  std::deque<std::string> _order;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,149 @@
+#include "MethodHandle.hpp"
+
+#include "../metadata/MetadataArena.hpp"
+#include "../metadata/MetadataConverter.hpp"
+#include "../trace/Tracer.hpp"
+
+#include <chrono>
+#include <grpcpp/support/async_stream.h>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+::grpc::internal::RpcMethod::RpcType toRpcType(MethodHandle::Type type) {
+  switch (type) {
+    case MethodHandle::Type::UNARY:
+      return ::grpc::internal::RpcMethod::NORMAL_RPC;
+    case MethodHandle::Type::SERVER_STREAMING:
+      return ::grpc::internal::RpcMethod::SERVER_STREAMING;
+    case MethodHandle::Type::CLIENT_STREAMING:
+      return ::grpc::internal::RpcMethod::CLIENT_STREAMING;
+    case MethodHandle::Type::BIDI_STREAMING:
+      return ::grpc::internal::RpcMethod::BIDI_STREAMING;
+  }
+  return ::grpc::internal::RpcMethod::NORMAL_RPC;
+}
+
+grpc_compression_algorithm parseCompression(const std::string& name) {
+  if (name == "identity") {
+    return GRPC_COMPRESS_NONE;
+  }
+  if (name == "deflate") {
+    return GRPC_COMPRESS_DEFLATE;
+  }
+  if (name == "gzip") {
+    return GRPC_COMPRESS_GZIP;
+  }
+  throw std::runtime_error("Unknown compression algorithm: " + name);
+}
+
+} // namespace
+
+MethodHandle::Type MethodHandle::parseType(const std::string& type) {
+  if (type == "unary") {
+    return Type::UNARY;
+  }
+  if (type == "server_streaming") {
+    return Type::SERVER_STREAMING;
+  }
+  if (type == "client_streaming") {
+    return Type::CLIENT_STREAMING;
+  }
+  if (type == "bidi_streaming") {
+    return Type::BIDI_STREAMING;
+  }
+  throw std::runtime_error("Unknown method type: " + type);
+}
+
+MethodHandle::Defaults MethodHandle::parseDefaults(const std::string& jsonStr) {
+  Defaults defaults;
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return defaults;
+  }
+
+  try {
+    auto j = json::parse(jsonStr);
+
+    if (j.contains("timeoutMs") && !j["timeoutMs"].is_null()) {
+      defaults.timeoutMs = j["timeoutMs"].get<int64_t>();
+      if (defaults.timeoutMs < 0) {
+        throw std::runtime_error("timeoutMs must not be negative");
+      }
+    }
+    if (j.contains("compression") && !j["compression"].is_null()) {
+      defaults.compression = parseCompression(j["compression"].get<std::string>());
+    }
+    if (j.contains("waitForReady") && !j["waitForReady"].is_null()) {
+      defaults.waitForReady = j["waitForReady"].get<bool>();
+    }
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse method defaults JSON: " + std::string(e.what()));
+  }
+
+  return defaults;
+}
+
+MethodHandle::MethodHandle(std::string path,
+                           Type type,
+                           Defaults defaults,
+                           const std::shared_ptr<::grpc::Channel>& channel)
+    : _path(std::move(path)), _type(type), _defaults(defaults), _rpcMethod(_path.c_str(), toRpcType(type), channel) {}
+
+MethodHandle::MethodHandle(std::string path, Type type)
+    : _path(std::move(path)), _type(type), _defaults(), _rpcMethod(_path.c_str(), toRpcType(type)) {}
+
+const char* MethodHandle::traceName() const {
+  const char* name = _traceName.load(std::memory_order_acquire);
+  if (name == nullptr) {
+    // Racing callers intern the same text and get the same pointer
+    name = Tracer::shared().intern(_path);
+    _traceName.store(name, std::memory_order_release);
+  }
+  return name;
+}
+
+void MethodHandle::prepareContext(::grpc::ClientContext& context,
+                                  const std::string& metadataJson,
+                                  int64_t deadlineMs) const {
+  MetadataConverter::applyMetadata(metadataJson, context);
+  applyDefaults(context, deadlineMs);
+}
+
+void MethodHandle::prepareContext(::grpc::ClientContext& context,
+                                  const std::string& metadataJson,
+                                  int64_t deadlineMs,
+                                  MetadataArena& arena) const {
+  arena.apply(metadataJson, context);
+  applyDefaults(context, deadlineMs);
+}
+
+void MethodHandle::applyDefaults(::grpc::ClientContext& context, int64_t deadlineMs) const {
+  if (deadlineMs > 0) {
+    context.set_deadline(std::chrono::system_clock::time_point(std::chrono::milliseconds(deadlineMs)));
+  } else if (_defaults.timeoutMs > 0) {
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(_defaults.timeoutMs));
+  }
+
+  if (_defaults.compression) {
+    context.set_compression_algorithm(*_defaults.compression);
+  }
+  if (_defaults.waitForReady) {
+    context.set_wait_for_ready(true);
+  }
+}
+
+std::unique_ptr<::grpc::GenericClientAsyncReaderWriter> MethodHandle::prepareStream(::grpc::Channel& channel,
+                                                                                    ::grpc::ClientContext& context,
+                                                                                    ::grpc::CompletionQueue& cq) const {
+  // Same as GenericStub::PrepareCall, but with our (possibly registered) method
+  return std::unique_ptr<::grpc::GenericClientAsyncReaderWriter>(
+      ::grpc::internal::ClientAsyncReaderWriterFactory<::grpc::ByteBuffer, ::grpc::ByteBuffer>::Create(
+          &channel, &cq, _rpcMethod, &context, false, nullptr));
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <grpc/compression.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+class MetadataArena;
+
+/**
+ * @brief A method path bound to a channel, plus per-method call defaults.
+ *
+ * A registered handle pre-registers its path with the channel, so gRPC core
+ * reuses the interned path and its per-method configuration for every call
+ * instead of setting them up per call. Unregistered handles (for calls made
+ * with a plain method string) behave exactly like the generic stub.
+ *
+ * Immutable after construction; safe to share between calls and threads.
+ */
+class MethodHandle {
+public:
+  enum class Type { UNARY, SERVER_STREAMING, CLIENT_STREAMING, BIDI_STREAMING };
+
+  struct Defaults {
+    int64_t timeoutMs = 0; // Relative deadline used when a call passes none; 0 = none
+    std::optional<grpc_compression_algorithm> compression;
+    bool waitForReady = false;
+  };
+
+  /**
+   * @param type "unary" | "server_streaming" | "client_streaming" | "bidi_streaming"
+   * @throws std::runtime_error for any other value
+   */
+  static Type parseType(const std::string& type);
+
+  /**
+   * Parse per-method defaults from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "timeoutMs"?: number,
+   *   "compression"?: "identity" | "deflate" | "gzip",
+   *   "waitForReady"?: boolean
+   * }
+   *
+   * @throws std::runtime_error if the JSON is malformed or a value is invalid
+   */
+  static Defaults parseDefaults(const std::string& json);
+
+  /**
+   * Create a handle registered with `channel`.
+   */
+  MethodHandle(std::string path, Type type, Defaults defaults, const std::shared_ptr<::grpc::Channel>& channel);
+
+  /**
+   * Create an unregistered handle with no defaults.
+   */
+  MethodHandle(std::string path, Type type);
+
+  MethodHandle(const MethodHandle&) = delete;
+  MethodHandle& operator=(const MethodHandle&) = delete;
+
+  const std::string& path() const {
+    return _path;
+  }
+
+  Type type() const {
+    return _type;
+  }
+
+  const Defaults& defaults() const {
+    return _defaults;
+  }
+
+  const ::grpc::internal::RpcMethod& rpcMethod() const {
+    return _rpcMethod;
+  }
+
+  /**
+   * The path interned with the Tracer, for span details. Interned on first
+   * use, so handles of untraced calls never take the Tracer's lock.
+   */
+  const char* traceName() const;
+
+  /**
+   * Apply metadata, the deadline and the per-method defaults to `context`.
+   *
+   * @param deadlineMs Absolute deadline in Unix epoch milliseconds; 0 uses the default timeout
+   */
+  void prepareContext(::grpc::ClientContext& context, const std::string& metadataJson, int64_t deadlineMs) const;
+
+  /**
+   * Same as above, parsing the metadata with a reusable arena.
+   */
+  void prepareContext(::grpc::ClientContext& context,
+                      const std::string& metadataJson,
+                      int64_t deadlineMs,
+                      MetadataArena& arena) const;
+
+  /**
+   * Create a (not yet started) streaming call for this method.
+   */
+  std::unique_ptr<::grpc::GenericClientAsyncReaderWriter>
+  prepareStream(::grpc::Channel& channel, ::grpc::ClientContext& context, ::grpc::CompletionQueue& cq) const;
+
+private:
+  /**
+   * Apply the deadline, compression and wait-for-ready settings.
+   */
+  void applyDefaults(::grpc::ClientContext& context, int64_t deadlineMs) const;
+
+  // Declared before _rpcMethod, which keeps a pointer into it
+  const std::string _path;
+  const Type _type;
+  const Defaults _defaults;
+  const ::grpc::internal::RpcMethod _rpcMethod;
+  mutable std::atomic<const char*> _traceName{nullptr};
+};
+
+} // namespace margelo::nitro::grpc
@@ -1,102 +1,89 @@
 #include "UnaryCall.hpp"
 
+#include "../channel/TlsSessionCache.hpp"
 #include "../completion-queue/CompletionQueueManager.hpp"
-#include "../metadata/MetadataConverter.hpp"
+#include "../trace/Tracer.hpp"
 #include "../utils/error/ErrorHandler.hpp"
+#include "../utils/pool/BufferPool.hpp"
 
-#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <grpcpp/impl/client_unary_call.h>
-#include <grpcpp/impl/rpc_method.h>
 #include <grpcpp/support/byte_buffer.h>
-#include <iostream>
+#include <thread>
 #include <vector>
 
 namespace margelo::nitro::grpc {
 
-void UnaryCall::execute(std::shared_ptr<::grpc::Channel> channel,
-                        const std::string& method,
-                        const std::shared_ptr<ArrayBuffer>& request,
-                        const std::string& metadataJson,
-                        int64_t deadlineMs,
-                        std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> promise,
-                        std::shared_ptr<::grpc::ClientContext> context,
-                        std::function<void()> onComplete) {
-  // Use a shared_ptr for the request copy to handle memory safely across threads if strictly needed,
-  // but here we just need to copy the data *before* the thread starts.
-  // Actually, 'perform' takes ArrayBuffer. But 'ArrayBuffer' is a JSI object, not thread safe.
-  // So 'perform' must take a std::vector<char> instead?
-  //
-  // Wait, if we want 'perform' to be shared, 'unaryCallSync' works on Main Thread, so it CAN use ArrayBuffer.
-  // But 'execute' works on worker thread, so it CANNOT use ArrayBuffer.
-  //
-  // Solution: 'perform' takes a std::vector<char> (pure C++ data).
-  // 'execute' (Async) copies ArrayBuffer -> vector on Main Thread, then passes vector to thread -> perform.
-  // 'unaryCallSync' (Sync) copies ArrayBuffer -> vector (safety) -> perform.
-  //
-  // Let's adjust the Architecture Plan slightly:
-  // perform(channel, method, vector<char> requestData, ...)
-
-  // Copy data synchronously on JS Thread
-  std::vector<char> requestData(request->size());
-  std::memcpy(requestData.data(), request->data(), request->size());
-
-  // DIAGNOSTIC CHECKS (Keep them!)
-  size_t size = request->size();
-  if (size != 11) {
-    // For now we skip check or keep it, up to user
-  }
-
-  // Execute async
-  std::thread([channel,
-               method,
-               metadataJson,
-               deadlineMs,
-               promise,
-               requestData = std::move(requestData),
-               context,
-               onComplete]() {
+void UnaryCall::execute(UnaryCallRecord::Pooled record) {
+  // The request was already copied into record->request on the JS thread;
+  // the worker only touches the record, never the caller's ArrayBuffer.
+  std::thread([record = std::move(record)]() mutable {
+    if (record->timingStore) {
+      record->timing.mark(CallTiming::DISPATCHED);
+    }
     try {
-      auto result = perform(channel, method, requestData, metadataJson, deadlineMs, context);
-      if (onComplete) {
-        onComplete();
-      }
-      promise->resolve(result);
+      auto result = perform(*record);
+      record->unregisterCall();
+      record->storeMetadata();
+      record->storeTiming();
+      record->promise->resolve(result);
     } catch (const std::exception& e) {
-      if (onComplete) {
-        onComplete();
-      }
-      promise->reject(std::make_exception_ptr(std::runtime_error(e.what())));
+      record->unregisterCall();
+      record->storeMetadata();
+      record->storeTiming();
+      record->promise->reject(std::make_exception_ptr(std::runtime_error(e.what())));
     }
+    // Dropping `record` returns it to the pool
   }).detach();
 }
 
-std::shared_ptr<ArrayBuffer> UnaryCall::perform(std::shared_ptr<::grpc::Channel> channel,
-                                                const std::string& method,
-                                                const std::vector<char>& requestData,
-                                                const std::string& metadataJson,
-                                                int64_t deadlineMs,
-                                                std::shared_ptr<::grpc::ClientContext> context) {
-  // Use passed context
-  MetadataConverter::applyMetadata(metadataJson, *context);
-
-  if (deadlineMs > 0) {
-    auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(deadlineMs);
-    context->set_deadline(deadline);
-  }
+std::shared_ptr<ArrayBuffer> UnaryCall::perform(UnaryCallRecord& record) {
+  const int64_t traceStartNs = Tracer::enabled() ? Tracer::nowNs() : 0;
+  ::grpc::ClientContext& context = *record.context;
+  record.method->prepareContext(context, record.metadataJson, record.deadlineMs, record.metadata);
 
-  ::grpc::Slice requestSlice(reinterpret_cast<const char*>(requestData.data()), requestData.size());
-  ::grpc::ByteBuffer requestBuffer(&requestSlice, 1);
-  ::grpc::ByteBuffer responseBuffer;
+  // Shares the record's slice (refcounted) instead of copying the request again
+  ::grpc::ByteBuffer requestBuffer(&record.request, 1);
 
-  ::grpc::internal::RpcMethod rpcMethod(method.c_str(), nullptr, ::grpc::internal::RpcMethod::NORMAL_RPC);
-  ::grpc::Status status =
-      ::grpc::internal::BlockingUnaryCall(channel.get(), rpcMethod, context.get(), requestBuffer, &responseBuffer);
+  MethodMetrics* metrics = record.metrics.get();
+  int64_t startedNs = 0;
+  if (metrics) {
+    startedNs = metrics->callStarted(false);
+    metrics->messageSent(record.request.size());
+  }
+
+  ::grpc::Status status;
+  if (record.timingStore) {
+    record.timing.mark(CallTiming::METADATA_APPLIED);
+    status = timedCall(record, requestBuffer);
+  } else {
+    status = ::grpc::internal::BlockingUnaryCall(
+        record.channel.get(), record.method->rpcMethod(), &context, requestBuffer, &record.response);
+  }
+  record.finished = true;
+  if (record.connectionPending) {
+    TlsSessionCache::shared().recordConnectionIfPending(*record.connectionPending, context);
+  }
+  if (traceStartNs != 0) {
+    Tracer::shared().record("call",
+                            "unary",
+                            traceStartNs,
+                            Tracer::nowNs(),
+                            record.method->traceName(),
+                            "status",
+                            status.error_code());
+  }
+  if (metrics) {
+    metrics->callFinished(false, status.error_code(), startedNs);
+    if (status.ok()) {
+      metrics->messageReceived(record.response.Length());
+    }
+  }
 
   if (status.ok()) {
-    std::vector<::grpc::Slice> slices;
-    if (!responseBuffer.Dump(&slices).ok()) {
+    std::vector<::grpc::Slice>& slices = record.responseSlices;
+    if (!record.response.Dump(&slices).ok()) {
       throw std::runtime_error("Failed to read response buffer");
     }
 
@@ -152,7 +139,7 @@ std::shared_ptr<ArrayBuffer> UnaryCall::perform(std::shared_ptr<::grpc::Channel>
     // Let's assume `ArrayBuffer::allocate` IS fine (maybe it uses a distinct runtime or just mallocs until passed to
     // JS). So I will stick to returning `ArrayBuffer` from `perform` for now, but I must provide `vector` input.
 
-    auto result = ArrayBuffer::allocate(totalSize);
+    auto result = BufferPool::shared().allocate(totalSize);
     size_t offset = 0;
     for (const auto& slice : slices) {
       std::memcpy(static_cast<uint8_t*>(result->data()) + offset,
@@ -162,9 +149,76 @@ std::shared_ptr<ArrayBuffer> UnaryCall::perform(std::shared_ptr<::grpc::Channel>
     }
     return result;
   } else {
-    auto error = ErrorHandler::fromStatus(status, *context);
+    auto error = ErrorHandler::fromStatus(status);
     throw std::runtime_error("gRPC Error [" + std::to_string(error.code) + "]: " + error.message);
   }
 }
 
+::grpc::Status UnaryCall::timedCall(UnaryCallRecord& record, const ::grpc::ByteBuffer& request) {
+  enum Tag : intptr_t { START = 1, WRITE, HEADERS, READ, FINISH };
+  const auto tagFor = [](Tag tag) { return reinterpret_cast<void*>(static_cast<intptr_t>(tag)); };
+
+  ::grpc::CompletionQueue cq;
+  auto call = record.method->prepareStream(*record.channel, *record.context, cq);
+  ::grpc::Status status;
+  bool gotMessage = false;
+  bool writeDone = false;
+  bool readDone = false;
+  int pending = 2;
+
+  call->StartCall(tagFor(START));
+  call->ReadInitialMetadata(tagFor(HEADERS));
+
+  void* tag;
+  bool ok;
+  while (pending > 0 && cq.Next(&tag, &ok)) {
+    pending--;
+    switch (static_cast<Tag>(reinterpret_cast<intptr_t>(tag))) {
+      case START:
+        if (ok) {
+          record.timing.mark(CallTiming::FIRST_BYTE_SENT);
+          call->WriteLast(request, ::grpc::WriteOptions(), tagFor(WRITE));
+          pending++;
+        } else {
+          writeDone = true;
+        }
+        break;
+      case WRITE:
+        writeDone = true;
+        break;
+      case HEADERS:
+        if (ok) {
+          record.timing.mark(CallTiming::INITIAL_METADATA_RECEIVED);
+        }
+        call->Read(&record.response, tagFor(READ));
+        pending++;
+        break;
+      case READ:
+        gotMessage = ok;
+        readDone = true;
+        break;
+      case FINISH:
+        record.timing.mark(CallTiming::RESPONSE_RECEIVED);
+        break;
+    }
+    // Finish only once no write or read is outstanding
+    if (writeDone && readDone) {
+      writeDone = readDone = false;
+      call->Finish(&status, tagFor(FINISH));
+      pending++;
+    }
+  }
+
+  call.reset();
+  cq.Shutdown();
+  while (cq.Next(&tag, &ok)) {
+  }
+
+  // Same as BlockingUnaryCall
+  if (!gotMessage && status.ok()) {
+    status = ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "No message returned for unary request");
+  }
+  return status;
+}
+
 } // namespace margelo::nitro::grpc
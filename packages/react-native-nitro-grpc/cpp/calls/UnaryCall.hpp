@@ -1,8 +1,9 @@
 #pragma once
 
+#include "UnaryCallRecord.hpp"
+
 #include <NitroModules/ArrayBuffer.hpp>
 #include <NitroModules/Promise.hpp>
-#include <functional>
 #include <grpcpp/grpcpp.h>
 #include <memory>
 #include <string>
@@ -15,39 +16,35 @@ using namespace margelo::nitro;
  * @brief Unary call implementation.
  *
  * Single request → single response RPC pattern.
- * Executes asynchronously using CompletionQueue.
+ * Runs the blocking call on a thread of its own, so JS is never blocked.
  */
 class UnaryCall {
 public:
   /**
-   * Execute a unary gRPC call.
+   * Execute a unary gRPC call on a new detached thread, one per call.
+   *
+   * Settles `record->promise`, unregisters the call and returns the record
+   * to its pool when the call completes.
    *
-   * @param channel gRPC channel to server
-   * @param method Fully qualified method name (e.g., "/service.Service/Method")
-   * @param request Serialized request data
-   * @param metadataJson Request metadata as JSON
-   * @param deadlineMs Deadline in milliseconds (0 = no deadline)
-   * @param promise Promise to resolve/reject
+   * @param record Call inputs (channel, method, request, metadata, deadline, context, promise)
    */
-  static void execute(std::shared_ptr<::grpc::Channel> channel,
-                      const std::string& method,
-                      const std::shared_ptr<ArrayBuffer>& request,
-                      const std::string& metadataJson,
-                      int64_t deadlineMs,
-                      std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> promise,
-                      std::shared_ptr<::grpc::ClientContext> context,
-                      std::function<void()> onComplete);
+  static void execute(UnaryCallRecord::Pooled record);
 
   /**
    * Perform unary call synchronously.
    * Returns result or throws std::runtime_error.
+   *
+   * @param record Call inputs; the promise and registry are not used
+   */
+  static std::shared_ptr<ArrayBuffer> perform(UnaryCallRecord& record);
+
+private:
+  /**
+   * The call as separate send, headers, read and finish operations, so
+   * `record.timing` gets a timestamp for each phase. Only used while call
+   * timing is enabled; otherwise perform() issues a single batch.
    */
-  static std::shared_ptr<ArrayBuffer> perform(std::shared_ptr<::grpc::Channel> channel,
-                                              const std::string& method,
-                                              const std::vector<char>& requestData,
-                                              const std::string& metadataJson,
-                                              int64_t deadlineMs,
-                                              std::shared_ptr<::grpc::ClientContext> context);
+  static ::grpc::Status timedCall(UnaryCallRecord& record, const ::grpc::ByteBuffer& request);
 };
 
 } // namespace margelo::nitro::grpc
@@ -0,0 +1,70 @@
+#include "UnaryCallRecord.hpp"
+
+#include <utility>
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+// Idle records kept for reuse; covers bursts of concurrent calls
+constexpr size_t kMaxIdleRecords = 64;
+
+} // namespace
+
+void UnaryCallRecord::setRequest(const uint8_t* data, size_t size) {
+  request = ::grpc::Slice(data, size);
+}
+
+void UnaryCallRecord::registerCall(std::shared_ptr<CallRegistry> callRegistry, const std::string& id) {
+  registry = std::move(callRegistry);
+  callId = id;
+  registry->add(callId, context, registryNode);
+}
+
+void UnaryCallRecord::unregisterCall() {
+  if (registry) {
+    registry->remove(callId, registryNode);
+    registry.reset();
+  }
+}
+
+void UnaryCallRecord::storeTiming() {
+  if (timingStore) {
+    timing.mark(CallTiming::SETTLED);
+    timingStore->store(callId, timing);
+  }
+}
+
+void UnaryCallRecord::storeMetadata() {
+  if (metadataStore && finished) {
+    metadataStore->store(callId, context);
+  }
+}
+
+void UnaryCallRecord::reset() {
+  unregisterCall();
+  channel.reset();
+  method.reset();
+  request = ::grpc::Slice();
+  metadataJson.clear();
+  deadlineMs = 0;
+  context.reset();
+  promise.reset();
+  metrics.reset();
+  connectionPending.reset();
+  callId.clear();
+  timingStore.reset();
+  timing.clear();
+  metadataStore.reset();
+  finished = false;
+  metadata.clear();
+  response.Clear();
+  responseSlices.clear();
+}
+
+ObjectPool<UnaryCallRecord>& UnaryCallRecord::pool() {
+  static auto* instance = new ObjectPool<UnaryCallRecord>(kMaxIdleRecords);
+  return *instance;
+}
+
+} // namespace margelo::nitro::grpc
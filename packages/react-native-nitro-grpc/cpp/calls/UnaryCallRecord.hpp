@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../metadata/MetadataArena.hpp"
+#include "../metrics/ChannelMetrics.hpp"
+#include "../utils/pool/ObjectPool.hpp"
+#include "CallMetadataStore.hpp"
+#include "CallRegistry.hpp"
+#include "CallTiming.hpp"
+#include "MethodHandle.hpp"
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Everything one unary call needs, pooled across calls.
+ *
+ * A record carries the call's inputs to the worker thread and owns the
+ * scratch state of the call: the metadata arena, the response ByteBuffer,
+ * the slice vector it is dumped into, and the call registry node. reset()
+ * releases per-call references but keeps every buffer's capacity, so
+ * steady-state calls reuse them instead of allocating.
+ *
+ * Not everything is pooled. Each call still pays for:
+ * - a fresh ClientContext: gRPC does not allow reusing one across RPCs;
+ * - the request slice: the transport may still reference the request bytes
+ *   after a cancelled call has completed, so they cannot live in a buffer
+ *   the record hands to the next call;
+ * - its own detached worker thread (see UnaryCall::execute).
+ */
+struct UnaryCallRecord {
+  using Pooled = ObjectPool<UnaryCallRecord>::Pooled;
+
+  // Inputs
+  std::shared_ptr<::grpc::Channel> channel;
+  std::shared_ptr<const MethodHandle> method;
+  ::grpc::Slice request;
+  std::string metadataJson;
+  int64_t deadlineMs = 0;
+  std::shared_ptr<::grpc::ClientContext> context;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> promise;
+  std::shared_ptr<MethodMetrics> metrics; // Optional
+  // Optional; set while the channel's current connection is not yet in the TLS stats
+  std::shared_ptr<std::atomic<bool>> connectionPending;
+
+  // Set when the call is registered for cancellation
+  std::shared_ptr<CallRegistry> registry;
+  std::string callId;
+  CallRegistry::Node registryNode;
+
+  // Set while call timing is enabled: the worker stores `timing` there under `callId`
+  std::shared_ptr<CallTimingStore> timingStore;
+  CallTiming timing;
+
+  // Set when JS may ask for the call's headers and trailers: the worker stores `context` there under `callId`
+  std::shared_ptr<CallMetadataStore> metadataStore;
+  // Set once the RPC completed, so `context` holds the server's headers and trailers
+  bool finished = false;
+
+  // Scratch state, reused across calls
+  MetadataArena metadata;
+  ::grpc::ByteBuffer response;
+  std::vector<::grpc::Slice> responseSlices;
+
+  /**
+   * Copy the request bytes into a new refcounted slice (allocated unless the
+   * request fits inline). Must be called on the JS thread, while the source
+   * buffer is valid.
+   */
+  void setRequest(const uint8_t* data, size_t size);
+
+  /**
+   * Register the call in `callRegistry` under `id`, reusing the record's node.
+   */
+  void registerCall(std::shared_ptr<CallRegistry> callRegistry, const std::string& id);
+
+  /**
+   * Remove the call from its registry, if it was registered.
+   */
+  void unregisterCall();
+
+  /**
+   * Mark the call settled and hand its timing to `timingStore`, if timing is enabled.
+   */
+  void storeTiming();
+
+  /**
+   * Hand the call's context to `metadataStore`, if there is one and the RPC
+   * completed. Calls that failed before reaching the server store nothing.
+   */
+  void storeMetadata();
+
+  /**
+   * Release per-call references; called when the record returns to the pool.
+   */
+  void reset();
+
+  /**
+   * Process-wide pool. Never destroyed: detached workers may release records during exit.
+   */
+  static ObjectPool<UnaryCallRecord>& pool();
+};
+
+} // namespace margelo::nitro::grpc
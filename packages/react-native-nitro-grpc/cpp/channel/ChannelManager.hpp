@@ -1,6 +1,7 @@
 #pragma once
 
-#include "../utils/json/JsonParser.hpp"
+#include "../auth/CredentialsRegistry.hpp"
+#include "ChannelOptions.hpp"
 
 #include <grpcpp/grpcpp.h>
 #include <memory>
@@ -17,32 +18,16 @@ namespace margelo::nitro::grpc {
 class ChannelManager {
 public:
   /**
-   * Create a channel with credentials and options.
+   * Create a channel with registered credentials and options.
    *
    * @param target Server address (e.g., "localhost:50051")
-   * @param credentialsJson Credentials JSON from TypeScript
-   * @param optionsJson Channel options JSON from TypeScript
+   * @param credentials Credentials from the CredentialsRegistry
+   * @param options Validated channel options
    * @return Shared pointer to gRPC channel
-   * @throws std::runtime_error if parsing fails
    */
-  static std::shared_ptr<::grpc::Channel>
-  createChannel(const std::string& target, const std::string& credentialsJson, const std::string& optionsJson);
-
-  /**
-   * Create channel credentials from parsed data.
-   *
-   * @param creds Parsed credentials structure
-   * @return gRPC channel credentials
-   */
-  static std::shared_ptr<::grpc::ChannelCredentials> createCredentials(const JsonParser::Credentials& creds);
-
-  /**
-   * Create channel arguments from options map.
-   *
-   * @param options Parsed channel options
-   * @return gRPC channel arguments
-   */
-  static ::grpc::ChannelArguments createChannelArguments(const std::map<std::string, std::string>& options);
+  static std::shared_ptr<::grpc::Channel> createChannel(const std::string& target,
+                                                        const CredentialsRegistry::Entry& credentials,
+                                                        const ChannelOptions& options);
 
 private:
 };
@@ -0,0 +1,254 @@
+#include "ChannelOptions.hpp"
+
+#include <climits>
+#include <cmath>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+enum class Kind { Int, Bool, String };
+
+struct ArgumentSpec {
+  Kind kind;
+  int min = 0;
+  int max = INT_MAX;
+};
+
+const std::unordered_map<std::string_view, ArgumentSpec>& knownArguments() {
+  static const std::unordered_map<std::string_view, ArgumentSpec> arguments = {
+      // Keepalive
+      {"grpc.keepalive_time_ms", {Kind::Int, 1}},
+      {"grpc.keepalive_timeout_ms", {Kind::Int, 1}},
+      {"grpc.keepalive_permit_without_calls", {Kind::Bool}},
+      {"grpc.http2.max_pings_without_data", {Kind::Int}},
+      {"grpc.http2.min_time_between_pings_ms", {Kind::Int}},
+      {"grpc.http2.min_ping_interval_without_data_ms", {Kind::Int}},
+      {"grpc.http2.max_ping_strikes", {Kind::Int}},
+      // HTTP/2 transport
+      {"grpc.http2.bdp_probe", {Kind::Bool}},
+      {"grpc.http2.lookahead_bytes", {Kind::Int}},
+      {"grpc.http2.write_buffer_size", {Kind::Int}},
+      {"grpc.http2.max_frame_size", {Kind::Int, 16384, 16777215}},
+      {"grpc.http2.hpack_table_size.decoder", {Kind::Int}},
+      {"grpc.http2.hpack_table_size.encoder", {Kind::Int}},
+      {"grpc.max_concurrent_streams", {Kind::Int, 1}},
+      {"grpc.max_metadata_size", {Kind::Int}},
+      // Messages
+      {"grpc.max_receive_message_length", {Kind::Int, -1}},
+      {"grpc.max_send_message_length", {Kind::Int, -1}},
+      {"grpc.default_compression_algorithm", {Kind::Int, 0, 2}},
+      // Connection management
+      {"grpc.initial_reconnect_backoff_ms", {Kind::Int, 1}},
+      {"grpc.min_reconnect_backoff_ms", {Kind::Int, 1}},
+      {"grpc.max_reconnect_backoff_ms", {Kind::Int, 1}},
+      {"grpc.max_connection_age_ms", {Kind::Int}},
+      {"grpc.max_connection_age_grace_ms", {Kind::Int}},
+      {"grpc.max_connection_idle_ms", {Kind::Int}},
+      {"grpc.client_idle_timeout_ms", {Kind::Int}},
+      {"grpc.dns_min_time_between_resolutions_ms", {Kind::Int}},
+      {"grpc.use_local_subchannel_pool", {Kind::Bool}},
+      {"grpc.enable_http_proxy", {Kind::Bool}},
+      {"grpc.enable_channelz", {Kind::Bool}},
+      // Retries and service config
+      {"grpc.enable_retries", {Kind::Bool}},
+      {"grpc.per_rpc_retry_buffer_size", {Kind::Int}},
+      {"grpc.retry_buffer_size", {Kind::Int}},
+      {"grpc.service_config", {Kind::String}},
+      {"grpc.service_config_disable_resolution", {Kind::Bool}},
+      {"grpc.lb_policy_name", {Kind::String}},
+      // Identity
+      {"grpc.default_authority", {Kind::String}},
+      {"grpc.primary_user_agent", {Kind::String}},
+      {"grpc.secondary_user_agent", {Kind::String}},
+      {"grpc.ssl_target_name_override", {Kind::String}},
+  };
+  return arguments;
+}
+
+bool isIgnored(const std::string& key) {
+  // grpc-js options that have no gRPC core equivalent
+  return key.rfind("grpc-node.", 0) == 0 || key == "channelOverride" || key == "channelFactoryOverride";
+}
+
+[[noreturn]] void invalid(const std::string& key, const std::string& expected) {
+  throw std::runtime_error("Invalid channel option " + key + ": expected " + expected);
+}
+
+int toInt(const std::string& key, const json& value, int min, int max) {
+  const std::string expected = "an integer in [" + std::to_string(min) + ", " + std::to_string(max) + "]";
+  if (!value.is_number()) {
+    invalid(key, expected);
+  }
+  const double number = value.get<double>();
+  if (std::trunc(number) != number || number < min || number > max) {
+    invalid(key, expected);
+  }
+  return static_cast<int>(number);
+}
+
+ChannelOptions::Value toValue(const std::string& key, const json& value) {
+  auto known = knownArguments().find(key);
+  if (known == knownArguments().end()) {
+    // Unlisted core argument: trust the JSON type
+    if (value.is_string()) {
+      return value.get<std::string>();
+    }
+    if (value.is_boolean()) {
+      return value.get<bool>() ? 1 : 0;
+    }
+    return toInt(key, value, INT_MIN, INT_MAX);
+  }
+
+  const ArgumentSpec& spec = known->second;
+  switch (spec.kind) {
+    case Kind::Int:
+      return toInt(key, value, spec.min, spec.max);
+    case Kind::Bool:
+      if (value.is_boolean()) {
+        return value.get<bool>() ? 1 : 0;
+      }
+      return toInt(key, value, 0, 1);
+    case Kind::String:
+      if (!value.is_string()) {
+        invalid(key, "a string");
+      }
+      return value.get<std::string>();
+  }
+  invalid(key, "a supported value");
+}
+
+// Presets. Explicit options always win over preset values.
+// The values are unbenchmarked; compare them with rngrpc_loadgen --preset before changing them.
+// Keepalive stays at the 5 minute minimum gRPC servers accept by default
+// (grpc.http2.min_recv_ping_interval_without_data_ms); pinging more often
+// gets the connection closed with GOAWAY too_many_pings.
+const std::unordered_map<std::string_view, std::map<std::string, ChannelOptions::Value>>& presets() {
+  static const std::unordered_map<std::string_view, std::map<std::string, ChannelOptions::Value>> values = {
+      // Small request/response traffic from a foreground app on a mobile network.
+      // - Keepalive notices a dead connection (NAT rebinding, radio handoff) within
+      //   ~5 min instead of after the 2 h default. Apps whose server permits more
+      //   frequent pings can lower grpc.keepalive_time_ms explicitly.
+      // - Reconnect backoff starts at 250 ms and caps at 5 s instead of 1 s/120 s,
+      //   so the app recovers quickly after switching networks.
+      // - DNS may be re-resolved every 5 s instead of 30 s for the same reason.
+      {"low-latency-interactive",
+       {
+           {"grpc.keepalive_time_ms", 300'000},
+           {"grpc.keepalive_timeout_ms", 10'000},
+           {"grpc.http2.bdp_probe", 1},
+           {"grpc.initial_reconnect_backoff_ms", 250},
+           {"grpc.min_reconnect_backoff_ms", 250},
+           {"grpc.max_reconnect_backoff_ms", 5'000},
+           {"grpc.dns_min_time_between_resolutions_ms", 5'000},
+           {"grpc.enable_retries", 1},
+       }},
+      // Large messages and long-running streams (uploads, sync, media).
+      // - Streams start with a 4 MiB flow-control window instead of 64 KiB, and
+      //   BDP probing grows it further, so early round trips are not window-bound.
+      // - Up to 1 MiB is buffered per write and frames up to 1 MiB are accepted,
+      //   cutting per-frame and per-syscall overhead.
+      // - Messages up to 64 MiB can be received (default 4 MiB).
+      // - Keepalive every 5 min keeps idle-looking transfers alive through most
+      //   middleboxes without tripping the server's ping limit.
+      {"bulk-transfer",
+       {
+           {"grpc.http2.bdp_probe", 1},
+           {"grpc.http2.lookahead_bytes", 4 * 1024 * 1024},
+           {"grpc.http2.write_buffer_size", 1024 * 1024},
+           {"grpc.http2.max_frame_size", 1024 * 1024},
+           {"grpc.max_receive_message_length", 64 * 1024 * 1024},
+           {"grpc.keepalive_time_ms", 300'000},
+           {"grpc.keepalive_timeout_ms", 20'000},
+           {"grpc.max_reconnect_backoff_ms", 30'000},
+       }},
+  };
+  return values;
+}
+
+} // namespace
+
+ChannelOptions ChannelOptions::preset(const std::string& name) {
+  auto it = presets().find(name);
+  if (it == presets().end()) {
+    throw std::runtime_error("Unknown channel options preset: " + name);
+  }
+  ChannelOptions options;
+  options._values = it->second;
+  return options;
+}
+
+ChannelOptions ChannelOptions::parse(const std::string& jsonStr) {
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return {};
+  }
+
+  json j;
+  try {
+    j = json::parse(jsonStr);
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse channel options JSON: " + std::string(e.what()));
+  }
+  if (!j.is_object()) {
+    throw std::runtime_error("Channel options must be a JSON object");
+  }
+
+  ChannelOptions options;
+  if (j.contains("preset")) {
+    if (!j["preset"].is_string()) {
+      invalid("preset", "a string");
+    }
+    options = preset(j["preset"].get<std::string>());
+  }
+
+  for (auto& [key, value] : j.items()) {
+    if (key == "preset" || value.is_null() || isIgnored(key)) {
+      continue;
+    }
+    if (key == "serviceConfig") {
+      if (!value.is_object()) {
+        invalid(key, "an object");
+      }
+      options._values["grpc.service_config"] = value.dump();
+      continue;
+    }
+    if (key.rfind("grpc.", 0) != 0) {
+      throw std::runtime_error("Unknown channel option: " + key);
+    }
+    options._values[key] = toValue(key, value);
+  }
+
+  return options;
+}
+
+::grpc::ChannelArguments ChannelOptions::toChannelArguments() const {
+  ::grpc::ChannelArguments args;
+  for (const auto& [key, value] : _values) {
+    if (const int* number = std::get_if<int>(&value)) {
+      args.SetInt(key, *number);
+    } else {
+      args.SetString(key, std::get<std::string>(value));
+    }
+  }
+  return args;
+}
+
+std::string ChannelOptions::toJson() const {
+  json j = json::object();
+  for (const auto& [key, value] : _values) {
+    if (const int* number = std::get_if<int>(&value)) {
+      j[key] = *number;
+    } else {
+      j[key] = std::get<std::string>(value);
+    }
+  }
+  return j.dump();
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <grpcpp/support/channel_arguments.h>
+#include <map>
+#include <string>
+#include <variant>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Validated gRPC channel arguments.
+ *
+ * Every known argument has a declared type (integer, boolean or string) and an
+ * allowed range; values of the wrong type or out of range are rejected when
+ * the options are parsed instead of being dropped silently. Unknown `grpc.*`
+ * arguments are passed through with the type of their JSON value, so newer
+ * core arguments remain usable. Options only understood by grpc-js
+ * (`grpc-node.*`, `channelOverride`, `channelFactoryOverride`) are ignored.
+ *
+ * A named preset can be selected with the `preset` key; explicitly given
+ * arguments override the preset's values.
+ */
+class ChannelOptions {
+public:
+  using Value = std::variant<int, std::string>;
+
+  /**
+   * Parse and validate the channel options JSON from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "preset"?: "low-latency-interactive" | "bulk-transfer",
+   *   "serviceConfig"?: object,
+   *   "grpc.keepalive_time_ms"?: number,
+   *   ...
+   * }
+   *
+   * @throws std::runtime_error if the JSON is malformed or an option is invalid
+   */
+  static ChannelOptions parse(const std::string& json);
+
+  /**
+   * The arguments of a named preset.
+   *
+   * @throws std::runtime_error if the preset does not exist
+   */
+  static ChannelOptions preset(const std::string& name);
+
+  /**
+   * Convert to gRPC channel arguments.
+   */
+  ::grpc::ChannelArguments toChannelArguments() const;
+
+  /**
+   * The effective arguments as a JSON object (booleans as 0/1).
+   */
+  std::string toJson() const;
+
+  const std::map<std::string, Value>& values() const {
+    return _values;
+  }
+
+private:
+  std::map<std::string, Value> _values;
+};
+
+} // namespace margelo::nitro::grpc
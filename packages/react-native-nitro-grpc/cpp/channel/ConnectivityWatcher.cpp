@@ -0,0 +1,58 @@
+#include "ConnectivityWatcher.hpp"
+
+#include "../logging/Logger.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+// Upper bound for one wait. Channels notify on shutdown, so this only limits
+// how long an exiting process waits for watchers of channels it never destroyed.
+constexpr auto kWaitTimeout = std::chrono::seconds(30);
+
+} // namespace
+
+ConnectivityWatcher::ConnectivityWatcher(const std::shared_ptr<::grpc::Channel>& channel,
+                                         std::function<void(bool reconnected)> onReady)
+    : _channel(channel), _onReady(std::move(onReady)), _lastState(channel->GetState(false)),
+      _wasReady(_lastState == GRPC_CHANNEL_READY) {}
+
+void ConnectivityWatcher::watch(const std::shared_ptr<::grpc::Channel>& channel,
+                                std::function<void(bool reconnected)> onReady) {
+  auto watcher = new ConnectivityWatcher(channel, std::move(onReady));
+  watcher->_self.reset(watcher);
+  watcher->arm(*CompletionQueueManager::Instance());
+}
+
+void ConnectivityWatcher::proceed(CompletionQueueManager& manager, bool ok) {
+  // !ok: the wait timed out without a change
+  if (ok) {
+    if (auto channel = _channel.lock()) {
+      _lastState = channel->GetState(false);
+      RNGRPC_LOG_VERBOSE("channel", "Connectivity state changed to " + std::to_string(_lastState));
+      if (_lastState == GRPC_CHANNEL_READY) {
+        if (_wasReady) {
+          RNGRPC_LOG_INFO("channel", "Reconnected");
+        }
+        _onReady(_wasReady);
+        _wasReady = true;
+      }
+    }
+  }
+  arm(manager);
+}
+
+void ConnectivityWatcher::arm(CompletionQueueManager& manager) {
+  auto channel = _channel.lock();
+  if (!channel || _lastState == GRPC_CHANNEL_SHUTDOWN || !manager.IsRunning()) {
+    auto self = std::move(_self); // Deletes this watcher on return
+    return;
+  }
+  channel->NotifyOnStateChange(
+      _lastState, std::chrono::system_clock::now() + kWaitTimeout, manager.GetQueue().get(), this);
+}
+
+} // namespace margelo::nitro::grpc
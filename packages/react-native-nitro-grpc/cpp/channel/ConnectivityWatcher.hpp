@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../completion-queue/CompletionQueueManager.hpp"
+
+#include <functional>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Reports each time a channel becomes READY, and whether it had been
+ * READY before, i.e. whether this is a reconnect.
+ *
+ * Waits for state changes on the shared CompletionQueueManager queue, so no
+ * thread is needed per channel. Only a weak reference to the channel is
+ * kept: destroying the channel moves it to SHUTDOWN, which ends the watch.
+ * States that pass faster than a notification round trip can be missed,
+ * so the count is a lower bound.
+ */
+class ConnectivityWatcher : public CompletionQueueManager::Tag {
+public:
+  /**
+   * Start watching `channel`. The watcher keeps itself alive until the
+   * channel shuts down.
+   */
+  static void watch(const std::shared_ptr<::grpc::Channel>& channel, std::function<void(bool reconnected)> onReady);
+
+  void proceed(CompletionQueueManager& manager, bool ok) override;
+
+private:
+  ConnectivityWatcher(const std::shared_ptr<::grpc::Channel>& channel, std::function<void(bool reconnected)> onReady);
+
+  /**
+   * Wait for the next change from `_lastState`, or release the watcher if
+   * the channel is gone or the queue is shutting down.
+   */
+  void arm(CompletionQueueManager& manager);
+
+  std::weak_ptr<::grpc::Channel> _channel;
+  std::function<void(bool reconnected)> _onReady;
+  grpc_connectivity_state _lastState;
+  bool _wasReady;
+  // Set while a notification is pending; the queue only holds a raw pointer
+  std::unique_ptr<ConnectivityWatcher> _self;
+};
+
+} // namespace margelo::nitro::grpc
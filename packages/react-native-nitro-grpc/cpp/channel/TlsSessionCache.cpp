@@ -0,0 +1,84 @@
+#include "TlsSessionCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <grpc/grpc_security_constants.h>
+#include <nlohmann/json.hpp>
+
+namespace margelo::nitro::grpc {
+
+TlsSessionCache& TlsSessionCache::shared() {
+  // Never destroyed: channels may still reference the cache during process exit.
+  static auto* instance = new TlsSessionCache();
+  return *instance;
+}
+
+TlsSessionCache::TlsSessionCache() : _cache(grpc_ssl_session_cache_create_lru(kCapacity)) {
+  _stats.capacity = kCapacity;
+}
+
+void TlsSessionCache::attach(::grpc::ChannelArguments& args) const {
+  grpc_arg arg = grpc_ssl_session_cache_create_channel_arg(_cache);
+  args.SetPointerWithVtable(arg.key, arg.value.pointer.p, arg.value.pointer.vtable);
+}
+
+bool TlsSessionCache::recordConnection(::grpc::ClientContext& context) {
+  grpc_call* call = context.c_call();
+  if (call == nullptr) {
+    return false; // The call never started
+  }
+
+  grpc_auth_context* authContext = grpc_call_auth_context(call);
+  if (authContext == nullptr) {
+    return false;
+  }
+
+  grpc_auth_property_iterator it =
+      grpc_auth_context_find_properties_by_name(authContext, GRPC_SSL_SESSION_REUSED_PROPERTY);
+  const grpc_auth_property* reused = grpc_auth_property_iterator_next(&it);
+  if (reused == nullptr) {
+    grpc_auth_context_release(authContext); // Not a TLS connection
+    return true;
+  }
+  const bool resumed = reused->value_length == 4 && std::strncmp(reused->value, "true", 4) == 0;
+
+  grpc_auth_context* evicted = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (std::find(_seen.begin(), _seen.end(), authContext) != _seen.end()) {
+      evicted = authContext; // Already counted; drop the extra reference
+    } else {
+      if (resumed) {
+        _stats.resumedHandshakes++;
+      } else {
+        _stats.fullHandshakes++;
+      }
+      _seen.push_back(authContext);
+      if (_seen.size() > kTrackedConnections) {
+        evicted = _seen.front();
+        _seen.pop_front();
+      }
+    }
+  }
+  if (evicted != nullptr) {
+    grpc_auth_context_release(evicted);
+  }
+  return true;
+}
+
+TlsSessionCache::Stats TlsSessionCache::stats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
+
+std::string TlsSessionCache::statsJson() const {
+  const Stats s = stats();
+  nlohmann::json j = {
+      {"fullHandshakes", s.fullHandshakes},
+      {"resumedHandshakes", s.resumedHandshakes},
+      {"capacity", s.capacity},
+  };
+  return j.dump();
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <grpc/grpc_security.h>
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Process-wide TLS session cache shared by every channel.
+ *
+ * Attaching the same cache to all channels lets a reconnect (or a second
+ * channel to the same server) resume an earlier TLS session instead of doing
+ * a full handshake, saving a round trip and the asymmetric crypto.
+ *
+ * Connections are classified as fully handshaken or resumed from the
+ * `ssl_session_reused` property of the call's auth context. Each connection is
+ * counted once. Only the first call to finish after its channel became READY
+ * is checked, so the counts are a lower bound: a connection is missed when a
+ * call still running on the previous one finishes first.
+ *
+ * Thread-safe.
+ */
+class TlsSessionCache {
+public:
+  struct Stats {
+    uint64_t fullHandshakes = 0;
+    uint64_t resumedHandshakes = 0;
+    size_t capacity = 0;
+  };
+
+  static TlsSessionCache& shared();
+
+  /**
+   * Attach the cache to channel arguments. Ignored by insecure channels.
+   */
+  void attach(::grpc::ChannelArguments& args) const;
+
+  /**
+   * Count the connection `context`'s call ran on, if it used TLS and has not
+   * been counted yet. Call after the RPC finished. Returns false if the call
+   * never reached a connection.
+   */
+  bool recordConnection(::grpc::ClientContext& context);
+
+  /**
+   * recordConnection() if `pending` is set, clearing it once a call has
+   * reached a connection. The channel's ConnectivityWatcher sets it on every
+   * transition to READY, so other calls pay one atomic load instead of the lock.
+   */
+  void recordConnectionIfPending(std::atomic<bool>& pending, ::grpc::ClientContext& context) {
+    if (pending.load(std::memory_order_relaxed) && recordConnection(context)) {
+      pending.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  Stats stats() const;
+
+  /**
+   * Stats serialized as a JSON object for the JS bridge.
+   */
+  std::string statsJson() const;
+
+private:
+  // Sessions are kept per server name, so this bounds the number of servers
+  static constexpr size_t kCapacity = 64;
+  // Connections remembered to avoid counting one connection twice
+  static constexpr size_t kTrackedConnections = 64;
+
+  TlsSessionCache();
+  TlsSessionCache(const TlsSessionCache&) = delete;
+  TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+  grpc_ssl_session_cache* _cache;
+
+  mutable std::mutex _mutex;
+  // Auth contexts are per connection; holding a reference keeps their addresses unique
+  std::deque<grpc_auth_context*> _seen;
+  Stats _stats;
+};
+
+} // namespace margelo::nitro::grpc
@@ -1,6 +1,6 @@
 #include "CompletionQueueManager.hpp"
 
-#include <iostream>
+#include "../trace/Tracer.hpp"
 
 namespace margelo::nitro::grpc {
 
@@ -29,6 +29,10 @@ std::shared_ptr<::grpc::CompletionQueue> CompletionQueueManager::GetQueue() {
   return _completionQueue;
 }
 
+bool CompletionQueueManager::IsRunning() const {
+  return _isRunning;
+}
+
 void CompletionQueueManager::Start() {
   if (_isRunning)
     return;
@@ -61,14 +65,10 @@ void CompletionQueueManager::RunLoop() {
   // The Core Loop: Polls for events (blocking on this background thread)
   // Next() returns false when the queue is fully drained and shut down.
   while (_completionQueue->Next(&tag, &ok)) {
-    // If we have a tag, it's a pointer to an executable task (Reactor Pattern)
-    // We assume the tag conforms to a common interface (e.g. Runnable)
+    // Every tag is an executable task (Reactor Pattern)
     if (tag != nullptr) {
-      // TODO: In Phase 3, we will define the 'Tag' interface for Calls/Streams.
-      // For now, we just print or ignore.
-      // auto* runnable = static_cast<GrpcTag*>(tag);
-      // runnable->Proceed(ok);
-      std::cout << "[CompletionQueueManager] Received event. OK=" << ok << std::endl;
+      TraceSpan span("cq", "dispatch");
+      static_cast<Tag*>(tag)->proceed(*this, ok);
     }
   }
 }
@@ -18,9 +18,23 @@ namespace margelo::nitro::grpc {
  * Usage:
  * - Call `CompletionQueueManager::Instance()` to access the singleton.
  * - `GetQueue()` returns the shared CompletionQueue for creating calls.
+ * - Every operation queued on it must use a `Tag` as its tag.
  */
 class CompletionQueueManager {
 public:
+  /**
+   * @brief An operation waiting on the shared queue.
+   *
+   * The background thread calls `proceed()` once the operation completes and
+   * does not touch the tag afterwards, so `proceed()` may queue the next
+   * operation with the same tag (while `manager.IsRunning()`) or release it.
+   */
+  class Tag {
+  public:
+    virtual ~Tag() = default;
+    virtual void proceed(CompletionQueueManager& manager, bool ok) = 0;
+  };
+
   // Deleted copy constructors for Singleton pattern
   CompletionQueueManager(const CompletionQueueManager&) = delete;
   CompletionQueueManager& operator=(const CompletionQueueManager&) = delete;
@@ -42,6 +56,12 @@ public:
    */
   std::shared_ptr<::grpc::CompletionQueue> GetQueue();
 
+  /**
+   * @brief Whether the queue still accepts operations. False once shutdown
+   * has begun; tags must not queue follow-up operations then.
+   */
+  bool IsRunning() const;
+
 private:
   CompletionQueueManager();
 
@@ -1,12 +1,17 @@
 #include "HybridGrpcClient.hpp"
 
-#include "../auth/CredentialsFactory.hpp" // NEW
+#include "../auth/CredentialsRegistry.hpp"
+#include "../cache/RequestKey.hpp"
 #include "../calls/UnaryCall.hpp"
 #include "../channel/ChannelManager.hpp"
+#include "../channel/ConnectivityWatcher.hpp"
+#include "../channel/TlsSessionCache.hpp"
 #include "../grpc-stream/HybridGrpcStream.hpp"
-#include "../utils/json/JsonParser.hpp" // NEW
+#include "../logging/Logger.hpp"
+#include "../metadata/HybridCallMetadata.hpp"
+#include "../trace/Tracer.hpp"
+#include "../utils/pool/BufferPool.hpp"
 
-#include <iostream>
 #include <stdexcept>
 
 namespace margelo::nitro::grpc {
@@ -15,112 +20,72 @@ void HybridGrpcClient::connect(const std::string& target,
                                const std::string& credentialsJson,
                                const std::string& optionsJson) {
   try {
-    // Parse options first to get service config
-    auto options = JsonParser::parseChannelOptions(optionsJson);
-    auto channelArgs = ChannelManager::createChannelArguments(options);
-
-    // Apply Service Config (Retry Policy)
-    if (optionsJson.find("serviceConfig") != std::string::npos) {
-      auto fullOptions = nlohmann::json::parse(optionsJson);
-      if (fullOptions.contains("serviceConfig") && fullOptions["serviceConfig"].is_object()) {
-        std::string serviceConfigJson = fullOptions["serviceConfig"].dump();
-        channelArgs.SetServiceConfigJSON(serviceConfigJson);
-      }
-    }
-
-    _channel = ChannelManager::createChannel(target, credentialsJson, optionsJson);
-    _closed = false;
+    connectChannel(target, *CredentialsRegistry::shared().registerCredentials(credentialsJson, "").entry, optionsJson);
   } catch (const std::exception& e) {
     throw std::runtime_error("Failed to connect: " + std::string(e.what()));
   }
 }
 
-// NEW: Connect with call credentials (OAuth2/JWT)
+// Connect with call credentials (OAuth2/JWT)
 void HybridGrpcClient::connectWithCallCredentials(const std::string& target,
                                                   const std::string& credentialsJson,
                                                   const std::string& optionsJson,
                                                   const std::string& callCredentialsJson) {
   try {
-    // Parse channel and call credentials
-    auto channelCreds = JsonParser::parseCredentials(credentialsJson);
-    auto callCreds = JsonParser::parseCallCredentials(callCredentialsJson);
-
-    // Create composite credentials based on call credentials type
-    std::shared_ptr<::grpc::ChannelCredentials> compositeCreds;
-
-    if (callCreds.type == JsonParser::CallCredentials::Type::BEARER) {
-      if (!callCreds.token.has_value()) {
-        throw std::runtime_error("Bearer token is missing");
-      }
-      compositeCreds = CredentialsFactory::createComposite(channelCreds, callCreds.token.value());
-    } else if (callCreds.type == JsonParser::CallCredentials::Type::OAUTH2) {
-      if (!callCreds.token.has_value()) {
-        throw std::runtime_error("OAuth2 access token is missing");
-      }
-      // Use CredentialsFactory to create OAuth2 composite
-      auto channel_creds = (channelCreds.type == JsonParser::Credentials::Type::INSECURE)
-                               ? ::grpc::InsecureChannelCredentials()
-                               : [&]() {
-                                   ::grpc::SslCredentialsOptions ssl_opts;
-                                   if (channelCreds.rootCerts.has_value())
-                                     ssl_opts.pem_root_certs = channelCreds.rootCerts.value();
-                                   if (channelCreds.privateKey.has_value())
-                                     ssl_opts.pem_private_key = channelCreds.privateKey.value();
-                                   if (channelCreds.certChain.has_value())
-                                     ssl_opts.pem_cert_chain = channelCreds.certChain.value();
-                                   return ::grpc::SslCredentials(ssl_opts);
-                                 }();
-
-      auto call_creds = CredentialsFactory::createAccessToken(callCreds.token.value());
-      compositeCreds = ::grpc::CompositeChannelCredentials(channel_creds, call_creds);
-    } else if (callCreds.type == JsonParser::CallCredentials::Type::CUSTOM) {
-      if (!callCreds.metadata.has_value()) {
-        throw std::runtime_error("Custom metadata is missing");
-      }
-      auto metadata_creds = CredentialsFactory::createCustomMetadata(callCreds.metadata.value());
-
-      auto channel_creds = (channelCreds.type == JsonParser::Credentials::Type::INSECURE)
-                               ? ::grpc::InsecureChannelCredentials()
-                               : [&]() {
-                                   ::grpc::SslCredentialsOptions ssl_opts;
-                                   if (channelCreds.rootCerts.has_value())
-                                     ssl_opts.pem_root_certs = channelCreds.rootCerts.value();
-                                   if (channelCreds.privateKey.has_value())
-                                     ssl_opts.pem_private_key = channelCreds.privateKey.value();
-                                   if (channelCreds.certChain.has_value())
-                                     ssl_opts.pem_cert_chain = channelCreds.certChain.value();
-                                   return ::grpc::SslCredentials(ssl_opts);
-                                 }();
-
-      compositeCreds = ::grpc::CompositeChannelCredentials(channel_creds, metadata_creds);
-    }
-
-    // Parse channel options and create channel
-    auto options = JsonParser::parseChannelOptions(optionsJson);
-    auto channelArgs = ChannelManager::createChannelArguments(options);
-
-    // Apply Service Config (Retry Policy)
-    if (optionsJson.find("serviceConfig") != std::string::npos) {
-      auto fullOptions = nlohmann::json::parse(optionsJson);
-      if (fullOptions.contains("serviceConfig") && fullOptions["serviceConfig"].is_object()) {
-        std::string serviceConfigJson = fullOptions["serviceConfig"].dump();
-        channelArgs.SetServiceConfigJSON(serviceConfigJson);
-      }
-    }
-
-    // Apply SSL target name override if present
-    if (channelCreds.targetNameOverride.has_value()) {
-      channelArgs.SetSslTargetNameOverride(channelCreds.targetNameOverride.value());
-    }
+    const auto registration = CredentialsRegistry::shared().registerCredentials(credentialsJson, callCredentialsJson);
+    connectChannel(target, *registration.entry, optionsJson);
+  } catch (const std::exception& e) {
+    throw std::runtime_error("Failed to connect with call credentials: " + std::string(e.what()));
+  }
+}
 
-    _channel = ::grpc::CreateCustomChannel(target, compositeCreds, channelArgs);
-    _closed = false;
+std::string HybridGrpcClient::registerCredentials(const std::string& credentialsJson,
+                                                  const std::string& callCredentialsJson) {
+  // Held so connectWithCredentials() finds the handle even if other clients
+  // register enough configurations in between to evict it
+  auto registration = CredentialsRegistry::shared().registerCredentials(credentialsJson, callCredentialsJson);
+  _registeredCredentials = std::move(registration.entry);
+  return registration.handle;
+}
 
+void HybridGrpcClient::connectWithCredentials(const std::string& target,
+                                              const std::string& credentialsHandle,
+                                              const std::string& optionsJson) {
+  try {
+    connectChannel(target, CredentialsRegistry::shared().lookup(credentialsHandle), optionsJson);
   } catch (const std::exception& e) {
-    throw std::runtime_error("Failed to connect with call credentials: " + std::string(e.what()));
+    throw std::runtime_error("Failed to connect: " + std::string(e.what()));
+  }
+}
+
+void HybridGrpcClient::connectChannel(const std::string& target,
+                                      const CredentialsRegistry::Entry& credentials,
+                                      const std::string& optionsJson) {
+  auto options = ChannelOptions::parse(optionsJson);
+  _channel = ChannelManager::createChannel(target, credentials, options);
+  _effectiveOptionsJson = options.toJson();
+  _closed = false;
+  // Until a call on the new connection finishes, one call checks it for TLS session reuse
+  _connectionPending = std::make_shared<std::atomic<bool>>(true);
+  ConnectivityWatcher::watch(_channel,
+                             [metrics = _metrics, connectionPending = _connectionPending](bool reconnected) {
+                               connectionPending->store(true, std::memory_order_relaxed);
+                               if (reconnected) {
+                                 metrics->reconnected();
+                               }
+                             });
+
+  // Handles stay valid across reconnects; bind them to the new channel.
+  // In-flight calls keep the previous binding (and channel) alive.
+  for (auto& method : _methods) {
+    method = std::make_shared<const MethodHandle>(method->path(), method->type(), method->defaults(), _channel);
   }
 }
 
+std::string HybridGrpcClient::getEffectiveChannelOptions() {
+  return _effectiveOptionsJson;
+}
+
 void HybridGrpcClient::close() {
   _closed = true;
   // Channel will be cleaned up by shared_ptr
@@ -142,12 +107,79 @@ std::shared_ptr<Promise<void>> HybridGrpcClient::watchConnectivityState(double l
   return promise;
 }
 
+double
+HybridGrpcClient::registerMethod(const std::string& path, const std::string& type, const std::string& defaultsJson) {
+  if (_closed || !_channel) {
+    throw std::runtime_error("Channel is closed");
+  }
+  auto method = std::make_shared<const MethodHandle>(
+      path, MethodHandle::parseType(type), MethodHandle::parseDefaults(defaultsJson), _channel);
+
+  // Registering a path again updates its defaults and keeps its handle
+  for (size_t i = 0; i < _methods.size(); i++) {
+    if (_methods[i]->path() == path) {
+      _methods[i] = std::move(method);
+      return static_cast<double>(i + 1);
+    }
+  }
+  _methodMetrics.push_back(_metrics->forMethod(path));
+  _methods.push_back(std::move(method));
+  return static_cast<double>(_methods.size());
+}
+
+std::shared_ptr<const MethodHandle> HybridGrpcClient::methodFor(double handle, MethodHandle::Type type) const {
+  const auto index = static_cast<size_t>(handle);
+  if (handle < 1 || static_cast<double>(index) != handle || index > _methods.size()) {
+    throw std::runtime_error("Unknown method handle: " + std::to_string(handle));
+  }
+  const auto& method = _methods[index - 1];
+  if (method->type() != type) {
+    throw std::runtime_error("Method " + method->path() + " was registered for a different call type");
+  }
+  return method;
+}
+
 std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
 HybridGrpcClient::unaryCall(const std::string& method,
                             const std::shared_ptr<ArrayBuffer>& request,
                             const std::string& metadataJson,
                             double deadlineMs,
                             const std::string& callId) {
+  return startUnaryCall(std::make_shared<const MethodHandle>(method, MethodHandle::Type::UNARY),
+                        _metrics->forMethod(method),
+                        request,
+                        metadataJson,
+                        deadlineMs,
+                        callId);
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+HybridGrpcClient::unaryCallWithHandle(double handle,
+                                      const std::shared_ptr<ArrayBuffer>& request,
+                                      const std::string& metadataJson,
+                                      double deadlineMs,
+                                      const std::string& callId) {
+  std::shared_ptr<const MethodHandle> method;
+  try {
+    method = methodFor(handle, MethodHandle::Type::UNARY);
+  } catch (const std::exception& e) {
+    auto promise = Promise<std::shared_ptr<ArrayBuffer>>::create();
+    promise->reject(std::make_exception_ptr(std::runtime_error(e.what())));
+    return promise;
+  }
+  return startUnaryCall(std::move(method), metricsFor(handle), request, metadataJson, deadlineMs, callId);
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+HybridGrpcClient::startUnaryCall(std::shared_ptr<const MethodHandle> method,
+                                 std::shared_ptr<MethodMetrics> metrics,
+                                 const std::shared_ptr<ArrayBuffer>& request,
+                                 const std::string& metadataJson,
+                                 double deadlineMs,
+                                 const std::string& callId) {
+  // Read once per call; the only cost of call timing while it is disabled
+  const int64_t entryNs = _callTimings->enabled() ? CallTiming::now() : 0;
+
   if (_closed || !_channel) {
     auto promise = Promise<std::shared_ptr<ArrayBuffer>>::create();
     promise->reject(std::make_exception_ptr(std::runtime_error("Channel is closed")));
@@ -157,26 +189,193 @@ HybridGrpcClient::unaryCall(const std::string& method,
   auto promise = Promise<std::shared_ptr<ArrayBuffer>>::create();
   int64_t deadlineMsInt = static_cast<int64_t>(deadlineMs);
 
+  // Serve cacheable methods from memory when possible: no gRPC call, no worker thread.
+  auto cachePolicy = _responseCache->policyFor(method->path());
+  std::string cacheKey;
+  if (cachePolicy) {
+    cacheKey =
+        RequestKey::make(method->path(), request->data(), request->size(), metadataJson, cachePolicy->varyMetadata);
+    if (auto hit = _responseCache->lookup(cacheKey)) {
+      if (hit->shouldRevalidate) {
+        revalidateCachedResponse(method, metrics, request, metadataJson, deadlineMsInt, cacheKey);
+      }
+      promise->resolve(ArrayBuffer::copy(*hit->response));
+      return promise;
+    }
+  }
+
   // Create context
   auto context = std::make_shared<::grpc::ClientContext>();
 
-  // Register call
-  {
-    std::lock_guard<std::mutex> lock(_registry->mutex);
-    _registry->activeCalls[callId] = context;
+  // The promise the RPC settles. With coalescing this is a shared promise that
+  // fans out to every caller waiting for the same request.
+  auto callPromise = promise;
+  auto record = UnaryCallRecord::pool().acquire();
+
+  if (auto varyMetadata = _singleFlight->varyMetadataFor(method->path())) {
+    auto flightKey = RequestKey::make(method->path(), request->data(), request->size(), metadataJson, *varyMetadata);
+    try {
+      if (_singleFlight->join(flightKey, callId, promise)) {
+        return promise;
+      }
+      // Cancellation of coalesced calls is tracked by the single-flight registry.
+      callPromise = _singleFlight->lead(flightKey, callId, promise, context);
+    } catch (const std::exception& e) {
+      // An empty or duplicate call ID: fail this call like any other that cannot start
+      promise->reject(std::make_exception_ptr(std::runtime_error(e.what())));
+      return promise;
+    }
+  } else {
+    // Registered until the worker settles the call; the registry outlives this client if needed
+    record->context = context;
+    record->registerCall(_registry, callId);
   }
 
-  // Capture shared_ptr to registry to ensure it outlives HybridGrpcClient if needed
-  std::shared_ptr<CallRegistry> registry = _registry;
+  if (cachePolicy) {
+    callPromise->addOnResolvedListener(
+        [cache = _responseCache, cacheKey, path = method->path()](const std::shared_ptr<ArrayBuffer>& response) {
+          cache->store(cacheKey, path, std::vector<uint8_t>(response->data(), response->data() + response->size()));
+        });
+  }
 
-  UnaryCall::execute(_channel, method, request, metadataJson, deadlineMsInt, promise, context, [registry, callId]() {
-    std::lock_guard<std::mutex> lock(registry->mutex);
-    registry->activeCalls.erase(callId);
-  });
+  record->channel = _channel;
+  record->method = std::move(method);
+  record->setRequest(request->data(), request->size());
+  record->metadataJson = metadataJson;
+  record->deadlineMs = deadlineMsInt;
+  record->context = std::move(context);
+  record->promise = std::move(callPromise);
+  record->metrics = std::move(metrics);
+  record->connectionPending = _connectionPending;
+  if (!callId.empty()) {
+    record->callId = callId;
+    record->metadataStore = _callMetadata;
+    if (entryNs != 0) {
+      record->timing.at[CallTiming::JSI_ENTRY] = entryNs;
+      record->timingStore = _callTimings;
+    }
+  }
+  UnaryCall::execute(std::move(record));
 
   return promise;
 }
 
+void HybridGrpcClient::revalidateCachedResponse(const std::shared_ptr<const MethodHandle>& method,
+                                                const std::shared_ptr<MethodMetrics>& metrics,
+                                                const std::shared_ptr<ArrayBuffer>& request,
+                                                const std::string& metadataJson,
+                                                int64_t deadlineMs,
+                                                const std::string& cacheKey) {
+  auto refresh = Promise<std::shared_ptr<ArrayBuffer>>::create();
+  std::shared_ptr<ResponseCache> cache = _responseCache;
+  refresh->addOnResolvedListener(
+      [cache, cacheKey, path = method->path()](const std::shared_ptr<ArrayBuffer>& response) {
+        cache->store(cacheKey, path, std::vector<uint8_t>(response->data(), response->data() + response->size()));
+      });
+  refresh->addOnRejectedListener([cache, cacheKey](const std::exception_ptr&) { cache->revalidationFailed(cacheKey); });
+
+  auto record = UnaryCallRecord::pool().acquire();
+  record->channel = _channel;
+  record->method = method;
+  record->setRequest(request->data(), request->size());
+  record->metadataJson = metadataJson;
+  record->deadlineMs = deadlineMs;
+  record->context = std::make_shared<::grpc::ClientContext>();
+  record->promise = std::move(refresh);
+  record->metrics = metrics;
+  record->connectionPending = _connectionPending;
+  UnaryCall::execute(std::move(record));
+}
+
+void HybridGrpcClient::setCallTimingEnabled(bool enabled) {
+  _callTimings->setEnabled(enabled);
+}
+
+std::string HybridGrpcClient::takeCallTiming(const std::string& callId) {
+  return _callTimings->take(callId);
+}
+
+std::vector<std::shared_ptr<HybridCallMetadataSpec>> HybridGrpcClient::takeCallMetadata(const std::string& callId) {
+  auto context = _callMetadata->take(callId);
+  if (!context) {
+    return {};
+  }
+  return {std::make_shared<HybridCallMetadata>(context, HybridCallMetadata::Kind::INITIAL),
+          std::make_shared<HybridCallMetadata>(context, HybridCallMetadata::Kind::TRAILING)};
+}
+
+std::string HybridGrpcClient::getStats(bool reset) {
+  return _metrics->statsJson(reset);
+}
+
+void HybridGrpcClient::configureHistograms(const std::string& configJson) {
+  _metrics->setHistogramWindow(ChannelMetrics::parseHistogramConfig(configJson));
+}
+
+std::string HybridGrpcClient::getLatencyPercentiles(const std::string& method, const std::vector<double>& percentiles) {
+  return _metrics->latencyJson(method, percentiles);
+}
+
+std::string HybridGrpcClient::getMessageSizePercentiles(const std::string& method,
+                                                        const std::vector<double>& percentiles) {
+  return _metrics->messageSizesJson(method, percentiles);
+}
+
+void HybridGrpcClient::configureResponseCache(const std::string& configJson) {
+  _responseCache->configure(ResponseCache::parseConfig(configJson));
+}
+
+void HybridGrpcClient::configureCoalescing(const std::string& configJson) {
+  _singleFlight->configure(SingleFlight::parseConfig(configJson));
+}
+
+std::string HybridGrpcClient::getResponseCacheStats() {
+  return _responseCache->statsJson();
+}
+
+void HybridGrpcClient::invalidateResponseCache(const std::string& method) {
+  _responseCache->invalidate(method);
+}
+
+std::string HybridGrpcClient::getTlsSessionStats() {
+  return TlsSessionCache::shared().statsJson();
+}
+
+void HybridGrpcClient::configureBufferPool(const std::string& configJson) {
+  BufferPool::shared().configure(BufferPool::parseConfig(configJson));
+}
+
+std::string HybridGrpcClient::getBufferPoolStats() {
+  return BufferPool::shared().statsJson();
+}
+
+bool HybridGrpcClient::releaseBuffer(const std::shared_ptr<ArrayBuffer>& buffer) {
+  return BufferPool::shared().release(buffer);
+}
+
+void HybridGrpcClient::setTracingEnabled(bool enabled) {
+  Tracer::shared().setEnabled(enabled);
+}
+
+double HybridGrpcClient::dumpTrace(const std::string& path) {
+  return static_cast<double>(Tracer::shared().dumpToFile(path));
+}
+
+void HybridGrpcClient::configureLogging(const std::string& configJson) {
+  Logger::shared().configure(Logger::parseConfig(configJson));
+}
+
+void HybridGrpcClient::setLogHandler(
+    const std::function<void(const std::string&, const std::string&, const std::string&, double)>& handler) {
+  Logger::shared().setHandler([handler](const Logger::Entry& entry) {
+    handler(Logger::levelName(entry.level), entry.tag, entry.message, static_cast<double>(entry.timestampMs));
+  });
+}
+
+void HybridGrpcClient::clearLogHandler() {
+  Logger::shared().setHandler(nullptr);
+}
+
 std::shared_ptr<ArrayBuffer> HybridGrpcClient::unaryCallSync(const std::string& method,
                                                              const std::shared_ptr<ArrayBuffer>& request,
                                                              const std::string& metadata,
@@ -186,28 +385,27 @@ std::shared_ptr<ArrayBuffer> HybridGrpcClient::unaryCallSync(const std::string&
   }
 
   // Copy data synchronously (safe on JS thread)
-  std::vector<char> requestData(request->size());
-  std::memcpy(requestData.data(), request->data(), request->size());
-
-  // DIAGNOSTIC CHECKS
-  size_t size = request->size();
-  if (size != 11) {
-    std::cout << "[Native] Sync Call size: " << size << std::endl;
-  } else {
-    std::cout << "[Native] Sync Call size: 11 (Correct)" << std::endl;
-  }
-
-  int64_t deadlineMsInt = static_cast<int64_t>(deadline);
-  auto context = std::make_shared<::grpc::ClientContext>();
-  return UnaryCall::perform(_channel, method, requestData, metadata, deadlineMsInt, context);
+  auto record = UnaryCallRecord::pool().acquire();
+  record->setRequest(request->data(), request->size());
+
+  RNGRPC_LOG_VERBOSE("call", "Sync call " + method + ", " + std::to_string(request->size()) + " request bytes");
+
+  record->channel = _channel;
+  record->method = std::make_shared<const MethodHandle>(method, MethodHandle::Type::UNARY);
+  record->metadataJson = metadata;
+  record->deadlineMs = static_cast<int64_t>(deadline);
+  record->context = std::make_shared<::grpc::ClientContext>();
+  record->metrics = _metrics->forMethod(method);
+  record->connectionPending = _connectionPending;
+  return UnaryCall::perform(*record);
 }
 
 void HybridGrpcClient::cancelCall(const std::string& callId) {
-  std::lock_guard<std::mutex> lock(_registry->mutex);
-  auto it = _registry->activeCalls.find(callId);
-  if (it != _registry->activeCalls.end()) {
-    it->second->TryCancel();
+  if (_singleFlight->cancel(callId)) {
+    return;
   }
+
+  _registry->cancel(callId);
 }
 
 std::shared_ptr<HybridGrpcStreamSpec> HybridGrpcClient::createServerStream(const std::string& method,
@@ -222,7 +420,14 @@ std::shared_ptr<HybridGrpcStreamSpec> HybridGrpcClient::createServerStream(const
   auto stream = std::make_shared<HybridGrpcStream>();
 
   // Initialize the stream with channel and start reading
-  stream->initServerStream(_channel, method, request, metadataJson, static_cast<int64_t>(deadline), false);
+  stream->initServerStream(_channel,
+                           std::make_shared<const MethodHandle>(method, MethodHandle::Type::SERVER_STREAMING),
+                           _metrics->forMethod(method),
+                           _connectionPending,
+                           request,
+                           metadataJson,
+                           static_cast<int64_t>(deadline),
+                           false);
 
   return stream;
 }
@@ -239,7 +444,14 @@ HybridGrpcClient::createServerStreamSync(const std::string& method,
   // Sync version uses same implementation as async for now
   // User calls readSync() in a loop instead of callbacks
   auto stream = std::make_shared<HybridGrpcStream>();
-  stream->initServerStream(_channel, method, request, metadataJson, static_cast<int64_t>(deadline), true);
+  stream->initServerStream(_channel,
+                           std::make_shared<const MethodHandle>(method, MethodHandle::Type::SERVER_STREAMING),
+                           _metrics->forMethod(method),
+                           _connectionPending,
+                           request,
+                           metadataJson,
+                           static_cast<int64_t>(deadline),
+                           true);
   return stream;
 }
 
@@ -250,7 +462,13 @@ HybridGrpcClient::createClientStreamSync(const std::string& method, const std::s
   }
 
   auto stream = std::make_shared<HybridGrpcStream>();
-  stream->initClientStream(_channel, method, metadataJson, static_cast<int64_t>(deadline), true);
+  stream->initClientStream(_channel,
+                           std::make_shared<const MethodHandle>(method, MethodHandle::Type::CLIENT_STREAMING),
+                           _metrics->forMethod(method),
+                           _connectionPending,
+                           metadataJson,
+                           static_cast<int64_t>(deadline),
+                           true);
   return stream;
 }
 
@@ -261,7 +479,13 @@ HybridGrpcClient::createBidiStreamSync(const std::string& method, const std::str
   }
 
   auto stream = std::make_shared<HybridGrpcStream>();
-  stream->initBidiStream(_channel, method, metadataJson, static_cast<int64_t>(deadline), true);
+  stream->initBidiStream(_channel,
+                         std::make_shared<const MethodHandle>(method, MethodHandle::Type::BIDI_STREAMING),
+                         _metrics->forMethod(method),
+                         _connectionPending,
+                         metadataJson,
+                         static_cast<int64_t>(deadline),
+                         true);
   return stream;
 }
 
@@ -272,7 +496,13 @@ HybridGrpcClient::createClientStream(const std::string& method, const std::strin
   }
 
   auto stream = std::make_shared<HybridGrpcStream>();
-  stream->initClientStream(_channel, method, metadataJson, static_cast<int64_t>(deadline), false);
+  stream->initClientStream(_channel,
+                           std::make_shared<const MethodHandle>(method, MethodHandle::Type::CLIENT_STREAMING),
+                           _metrics->forMethod(method),
+                           _connectionPending,
+                           metadataJson,
+                           static_cast<int64_t>(deadline),
+                           false);
   return stream;
 }
 
@@ -283,7 +513,68 @@ HybridGrpcClient::createBidiStream(const std::string& method, const std::string&
   }
 
   auto stream = std::make_shared<HybridGrpcStream>();
-  stream->initBidiStream(_channel, method, metadataJson, static_cast<int64_t>(deadline), false);
+  stream->initBidiStream(_channel,
+                         std::make_shared<const MethodHandle>(method, MethodHandle::Type::BIDI_STREAMING),
+                         _metrics->forMethod(method),
+                         _connectionPending,
+                         metadataJson,
+                         static_cast<int64_t>(deadline),
+                         false);
+  return stream;
+}
+
+std::shared_ptr<HybridGrpcStreamSpec>
+HybridGrpcClient::createServerStreamWithHandle(double handle,
+                                               const std::shared_ptr<ArrayBuffer>& request,
+                                               const std::string& metadataJson,
+                                               double deadline) {
+  if (_closed || !_channel) {
+    throw std::runtime_error("Channel is closed");
+  }
+
+  auto stream = std::make_shared<HybridGrpcStream>();
+  stream->initServerStream(_channel,
+                           methodFor(handle, MethodHandle::Type::SERVER_STREAMING),
+                           metricsFor(handle),
+                           _connectionPending,
+                           request,
+                           metadataJson,
+                           static_cast<int64_t>(deadline),
+                           false);
+  return stream;
+}
+
+std::shared_ptr<HybridGrpcStreamSpec>
+HybridGrpcClient::createClientStreamWithHandle(double handle, const std::string& metadataJson, double deadline) {
+  if (_closed || !_channel) {
+    throw std::runtime_error("Channel is closed");
+  }
+
+  auto stream = std::make_shared<HybridGrpcStream>();
+  stream->initClientStream(_channel,
+                           methodFor(handle, MethodHandle::Type::CLIENT_STREAMING),
+                           metricsFor(handle),
+                           _connectionPending,
+                           metadataJson,
+                           static_cast<int64_t>(deadline),
+                           false);
+  return stream;
+}
+
+std::shared_ptr<HybridGrpcStreamSpec>
+HybridGrpcClient::createBidiStreamWithHandle(double handle, const std::string& metadataJson, double deadline) {
+  if (_closed || !_channel) {
+    throw std::runtime_error("Channel is closed");
+  }
+
+  auto stream = std::make_shared<HybridGrpcStream>();
+  stream->initBidiStream(_channel,
+                         methodFor(handle, MethodHandle::Type::BIDI_STREAMING),
+                         metricsFor(handle),
+                         _connectionPending,
+                         metadataJson,
+                         static_cast<int64_t>(deadline),
+                         false);
   return stream;
 }
 
@@ -1,12 +1,23 @@
 #pragma once
 
+#include "../auth/CredentialsRegistry.hpp"
+#include "../cache/ResponseCache.hpp"
+#include "../cache/SingleFlight.hpp"
+#include "../calls/CallMetadataStore.hpp"
+#include "../calls/CallRegistry.hpp"
+#include "../calls/CallTiming.hpp"
+#include "../calls/MethodHandle.hpp"
+#include "../metrics/ChannelMetrics.hpp"
 #include "HybridGrpcClientSpec.hpp"
 
 #include <NitroModules/ArrayBuffer.hpp>
 #include <NitroModules/Promise.hpp>
+#include <atomic>
+#include <functional>
 #include <grpcpp/grpcpp.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace margelo::nitro::grpc {
 
@@ -23,13 +34,24 @@ public:
                                   const std::string& optionsJson,
                                   const std::string& callCredentialsJson) override; // NEW: With call credentials
 
+  // Credentials built once per configuration and reused across connects
+  std::string registerCredentials(const std::string& credentialsJson, const std::string& callCredentialsJson) override;
+  void connectWithCredentials(const std::string& target,
+                              const std::string& credentialsHandle,
+                              const std::string& optionsJson) override;
+
+  // Channel arguments in effect after applying the preset and explicit options
+  std::string getEffectiveChannelOptions() override;
+
   void close() override;
 
   double getConnectivityState(bool tryToConnect) override;
 
   std::shared_ptr<Promise<void>> watchConnectivityState(double lastState, double deadlineMs) override;
 
-  // Unary call
+  // Methods registered with the channel once; calls then refer to them by handle
+  double registerMethod(const std::string& path, const std::string& type, const std::string& defaultsJson) override;
+
   // Unary call
   std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> unaryCall(const std::string& method,
                                                                    const std::shared_ptr<ArrayBuffer>& request,
@@ -37,6 +59,13 @@ public:
                                                                    double deadlineMs,
                                                                    const std::string& callId) override;
 
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+  unaryCallWithHandle(double handle,
+                      const std::shared_ptr<ArrayBuffer>& request,
+                      const std::string& metadataJson,
+                      double deadlineMs,
+                      const std::string& callId) override;
+
   std::shared_ptr<ArrayBuffer> unaryCallSync(const std::string& method,
                                              const std::shared_ptr<ArrayBuffer>& request,
                                              const std::string& metadata,
@@ -44,6 +73,47 @@ public:
 
   void cancelCall(const std::string& callId) override;
 
+  // Per-call phase timing of unary calls
+  void setCallTimingEnabled(bool enabled) override;
+  std::string takeCallTiming(const std::string& callId) override;
+
+  // Server headers and trailers of finished unary calls
+  std::vector<std::shared_ptr<HybridCallMetadataSpec>> takeCallMetadata(const std::string& callId) override;
+
+  // Counters and gauges of this channel's calls
+  std::string getStats(bool reset) override;
+
+  // Windowed latency and message size histograms
+  void configureHistograms(const std::string& configJson) override;
+  std::string getLatencyPercentiles(const std::string& method, const std::vector<double>& percentiles) override;
+  std::string getMessageSizePercentiles(const std::string& method, const std::vector<double>& percentiles) override;
+
+  // Response cache
+  void configureResponseCache(const std::string& configJson) override;
+  std::string getResponseCacheStats() override;
+  void invalidateResponseCache(const std::string& method) override;
+
+  // Single-flight coalescing of identical unary calls
+  void configureCoalescing(const std::string& configJson) override;
+
+  // TLS session resumption (process-wide)
+  std::string getTlsSessionStats() override;
+
+  // Inbound buffer recycling (process-wide)
+  void configureBufferPool(const std::string& configJson) override;
+  std::string getBufferPoolStats() override;
+  bool releaseBuffer(const std::shared_ptr<ArrayBuffer>& buffer) override;
+
+  // Native span tracing (process-wide)
+  void setTracingEnabled(bool enabled) override;
+  double dumpTrace(const std::string& path) override;
+
+  // Native logging (process-wide)
+  void configureLogging(const std::string& configJson) override;
+  void setLogHandler(
+      const std::function<void(const std::string&, const std::string&, const std::string&, double)>& handler) override;
+  void clearLogHandler() override;
+
   // Streaming (to be implemented)
   std::shared_ptr<HybridGrpcStreamSpec> createServerStream(const std::string& method,
                                                            const std::shared_ptr<ArrayBuffer>& request,
@@ -56,6 +126,17 @@ public:
   std::shared_ptr<HybridGrpcStreamSpec>
   createBidiStream(const std::string& method, const std::string& metadataJson, double deadlineMs) override;
 
+  std::shared_ptr<HybridGrpcStreamSpec> createServerStreamWithHandle(double handle,
+                                                                     const std::shared_ptr<ArrayBuffer>& request,
+                                                                     const std::string& metadataJson,
+                                                                     double deadlineMs) override;
+
+  std::shared_ptr<HybridGrpcStreamSpec>
+  createClientStreamWithHandle(double handle, const std::string& metadataJson, double deadlineMs) override;
+
+  std::shared_ptr<HybridGrpcStreamSpec>
+  createBidiStreamWithHandle(double handle, const std::string& metadataJson, double deadlineMs) override;
+
   // Sync stream creation
   std::shared_ptr<HybridGrpcStreamSpec> createServerStreamSync(const std::string& method,
                                                                const std::shared_ptr<ArrayBuffer>& request,
@@ -69,14 +150,59 @@ public:
   createBidiStreamSync(const std::string& method, const std::string& metadataJson, double deadlineMs) override;
 
 private:
-  struct CallRegistry {
-    std::unordered_map<std::string, std::shared_ptr<::grpc::ClientContext>> activeCalls;
-    std::mutex mutex;
-  };
+  /**
+   * Validate `optionsJson` and (re)create the channel.
+   */
+  void connectChannel(const std::string& target,
+                      const CredentialsRegistry::Entry& credentials,
+                      const std::string& optionsJson);
+
+  /**
+   * Look up a handle from registerMethod().
+   *
+   * @throws std::runtime_error if the handle is unknown or registered for another call type
+   */
+  std::shared_ptr<const MethodHandle> methodFor(double handle, MethodHandle::Type type) const;
+
+  /**
+   * The metrics of a handle already validated by methodFor().
+   */
+  const std::shared_ptr<MethodMetrics>& metricsFor(double handle) const {
+    return _methodMetrics[static_cast<size_t>(handle) - 1];
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> startUnaryCall(std::shared_ptr<const MethodHandle> method,
+                                                                        std::shared_ptr<MethodMetrics> metrics,
+                                                                        const std::shared_ptr<ArrayBuffer>& request,
+                                                                        const std::string& metadataJson,
+                                                                        double deadlineMs,
+                                                                        const std::string& callId);
+
+  /**
+   * Refresh a stale cache entry in the background. The result is only stored
+   * in the cache; no JS promise is involved.
+   */
+  void revalidateCachedResponse(const std::shared_ptr<const MethodHandle>& method,
+                                const std::shared_ptr<MethodMetrics>& metrics,
+                                const std::shared_ptr<ArrayBuffer>& request,
+                                const std::string& metadataJson,
+                                int64_t deadlineMs,
+                                const std::string& cacheKey);
 
   std::shared_ptr<::grpc::Channel> _channel;
+  std::shared_ptr<const CredentialsRegistry::Entry> _registeredCredentials; // From the last registerCredentials()
   bool _closed = false;
+  std::string _effectiveOptionsJson = "{}";
+  std::vector<std::shared_ptr<const MethodHandle>> _methods; // Handle N is _methods[N - 1]
+  std::vector<std::shared_ptr<MethodMetrics>> _methodMetrics; // Parallel to _methods; kept across reconnects
+  std::shared_ptr<ChannelMetrics> _metrics = std::make_shared<ChannelMetrics>();
+  // Set on each transition to READY until a finished call has checked the connection for TLS session reuse
+  std::shared_ptr<std::atomic<bool>> _connectionPending = std::make_shared<std::atomic<bool>>(false);
   std::shared_ptr<CallRegistry> _registry = std::make_shared<CallRegistry>();
+  std::shared_ptr<ResponseCache> _responseCache = std::make_shared<ResponseCache>();
+  std::shared_ptr<SingleFlight> _singleFlight = std::make_shared<SingleFlight>();
+  std::shared_ptr<CallTimingStore> _callTimings = std::make_shared<CallTimingStore>();
+  std::shared_ptr<CallMetadataStore> _callMetadata = std::make_shared<CallMetadataStore>();
 };
 
 } // namespace margelo::nitro::grpc
@@ -1,7 +1,11 @@
 #include "HybridGrpcStream.hpp"
 
+#include "../channel/TlsSessionCache.hpp"
+#include "../logging/Logger.hpp"
 #include "../metadata/MetadataConverter.hpp"
+#include "../trace/Tracer.hpp"
 #include "../utils/error/ErrorHandler.hpp"
+#include "../utils/pool/BufferPool.hpp"
 
 #include <grpcpp/support/byte_buffer.h>
 
@@ -14,47 +18,61 @@ HybridGrpcStream::~HybridGrpcStream() {
   if (_readerThread.joinable()) {
     _readerThread.join();
   }
+  // Only now that nothing issues new operations is it safe to shut the queue down
+  _cq.Shutdown();
+  void* tag;
+  bool ok;
+  while (_cq.Next(&tag, &ok)) {
+  }
 }
 
 // Initialize server stream
 void HybridGrpcStream::initServerStream(std::shared_ptr<::grpc::Channel> channel,
-                                        const std::string& method,
+                                        std::shared_ptr<const MethodHandle> method,
+                                        std::shared_ptr<MethodMetrics> metrics,
+                                        std::shared_ptr<std::atomic<bool>> connectionPending,
                                         const std::shared_ptr<ArrayBuffer>& request,
                                         const std::string& metadataJson,
                                         int64_t deadlineMs,
                                         bool isSync) {
   _streamType = StreamType::SERVER;
   _isSync = isSync;
+  _method = std::move(method);
+  _metrics = std::move(metrics);
+  _connectionPending = std::move(connectionPending);
   _context = std::make_shared<::grpc::ClientContext>();
 
-  // Set metadata
-  if (!metadataJson.empty()) {
-    MetadataConverter::applyMetadata(metadataJson, *_context);
-  }
-
-  // Set deadline
-  if (deadlineMs > 0) {
-    auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(deadlineMs);
-    _context->set_deadline(deadline);
-  }
+  // Metadata, deadline and per-method defaults
+  _method->prepareContext(*_context, metadataJson, deadlineMs);
+  _startedNs = _metrics->callStarted(true);
 
   // Create ByteBuffer correctly (slice stores pointer, verify lifetime)
   // We copy data to _initialRequestBuffer to ensure lifetime validity for async write
   ::grpc::Slice slice(request->data(), request->size());
   _initialRequestBuffer = ::grpc::ByteBuffer(&slice, 1);
+  _metrics->messageSent(request->size());
 
-  // Create generic stub
-  ::grpc::GenericStub stub(channel);
-
-  // Start async call using ReaderWriter (GenericStub standard)
-  _readerWriter = stub.PrepareCall(_context.get(), method, &_cq);
-  _readerWriter->StartCall((void*)1);
+  // Send initial metadata, the request and the half-close as one batch. With
+  // corked metadata StartCall only buffers it (no tag is queued) and
+  // WriteLast flushes everything together.
+  _context->set_initial_metadata_corked(true);
+  _readerWriter = _method->prepareStream(*channel, *_context, _cq);
+  _readerWriter->StartCall(nullptr);
+  _readerWriter->WriteLast(_initialRequestBuffer, ::grpc::WriteOptions(), (void*)2);
 
   // Start background reading thread
   _readerThread = std::thread([this]() {
     ::grpc::ByteBuffer responseBuffer;
     void* tag;
     bool ok;
+    // Finish may complete before the write; the thread exits once both are done
+    bool writePending = true;
+    bool finished = false;
+    // The read batch also receives the headers, so they are known with the first message
+    bool headersDelivered = _isSync;
+
+    // The first read is already pending while the request goes out
+    _readerWriter->Read(&responseBuffer, (void*)4);
 
     while (_cq.Next(&tag, &ok)) {
       if (!ok && (intptr_t)tag != 5) {
@@ -67,22 +85,20 @@ void HybridGrpcStream::initServerStream(std::shared_ptr<::grpc::Channel> channel
           continue;
         }
         // Other failures
-        // logger->log("Operation failed tag: " + std::to_string((intptr_t)tag));
+        RNGRPC_LOG_VERBOSE("stream", "Operation failed, tag " + std::to_string((intptr_t)tag));
       }
 
-      if ((intptr_t)tag == 1) {
-        // StartCall done -> Write request
-        _readerWriter->Write(_initialRequestBuffer, (void*)2);
-      } else if ((intptr_t)tag == 2) {
-        // Write done -> WritesDone (close client side)
-        _readerWriter->WritesDone((void*)3);
-      } else if ((intptr_t)tag == 3) {
-        // WritesDone done -> Start Reading
-        _readerWriter->Read(&responseBuffer, (void*)4);
+      if ((intptr_t)tag == 2) {
+        // Request batch done; a failure surfaces through the read and Finish
+        writePending = false;
+        if (finished) {
+          break;
+        }
       } else if ((intptr_t)tag == 4) {
         // Read done
         if (ok) {
           // Process message
+          TraceSpan span("stream", "read", "bytes");
           std::vector<::grpc::Slice> slices;
           responseBuffer.Dump(&slices);
 
@@ -90,17 +106,23 @@ void HybridGrpcStream::initServerStream(std::shared_ptr<::grpc::Channel> channel
           for (const auto& slice : slices)
             totalSize += slice.size();
 
-          auto arrayBuffer = ArrayBuffer::allocate(totalSize);
+          auto arrayBuffer = BufferPool::shared().allocate(totalSize);
           size_t offset = 0;
           for (const auto& slice : slices) {
             std::memcpy(static_cast<uint8_t*>(arrayBuffer->data()) + offset, slice.begin(), slice.size());
             offset += slice.size();
           }
+          _metrics->messageReceived(totalSize);
+          span.setValue(static_cast<int64_t>(totalSize));
 
           if (_isSync) {
             _readQueue.push(arrayBuffer);
-          } else if (_dataCallback) {
-            _dataCallback(arrayBuffer);
+          } else {
+            if (!headersDelivered) {
+              deliverMetadata();
+              headersDelivered = true;
+            }
+            deliverData(arrayBuffer);
           }
 
           // Read next
@@ -112,12 +134,20 @@ void HybridGrpcStream::initServerStream(std::shared_ptr<::grpc::Channel> channel
         }
       } else if ((intptr_t)tag == 5) {
         // Finish done
+        recordFinish();
         if (_isSync) {
           _readQueue.close();
-        } else if (_statusCallback) {
-          _statusCallback(static_cast<double>(_status.error_code()), _status.error_message(), "{}");
+        } else {
+          // Headers without any message; a trailers-only response leaves them empty
+          if (!headersDelivered && !_context->GetServerInitialMetadata().empty()) {
+            deliverMetadata();
+          }
+          deliverStatus(_status);
+        }
+        finished = true;
+        if (!writePending) {
+          break; // End thread
         }
-        break; // End thread
       }
     }
   });
@@ -136,27 +166,25 @@ std::variant<nitro::NullType, std::shared_ptr<ArrayBuffer>> HybridGrpcStream::re
 
 // Client Stream Init
 void HybridGrpcStream::initClientStream(std::shared_ptr<::grpc::Channel> channel,
-                                        const std::string& method,
+                                        std::shared_ptr<const MethodHandle> method,
+                                        std::shared_ptr<MethodMetrics> metrics,
+                                        std::shared_ptr<std::atomic<bool>> connectionPending,
                                         const std::string& metadataJson,
                                         int64_t deadlineMs,
                                         bool isSync) {
   _streamType = StreamType::CLIENT;
   _isSync = isSync;
+  _method = std::move(method);
+  _metrics = std::move(metrics);
+  _connectionPending = std::move(connectionPending);
   _context = std::make_shared<::grpc::ClientContext>();
 
-  // Set metadata
-  if (!metadataJson.empty()) {
-    MetadataConverter::applyMetadata(metadataJson, *_context);
-  }
-
-  // Set deadline
-  if (deadlineMs > 0) {
-    auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(deadlineMs);
-    _context->set_deadline(deadline);
-  }
+  // Metadata, deadline and per-method defaults
+  _method->prepareContext(*_context, metadataJson, deadlineMs);
+  _startedNs = _metrics->callStarted(true);
 
-  ::grpc::GenericStub stub(channel);
-  _readerWriter = stub.PrepareCall(_context.get(), method, &_cq);
+  _started = _startedPromise.get_future().share();
+  _readerWriter = _method->prepareStream(*channel, *_context, _cq);
   _readerWriter->StartCall((void*)1);
 
   // Background thread for handling completion
@@ -174,39 +202,60 @@ void HybridGrpcStream::initClientStream(std::shared_ptr<::grpc::Channel> channel
       }
 
       if ((intptr_t)tag == 1) {
-        // Stream started. Read the response eventually.
-        _readerWriter->Read(&responseBuffer, (void*)4);
+        _startedPromise.set_value();
+        writeCompleted();
+        // Stream started. Wait for the headers, then read the response.
+        if (_isSync) {
+          _readerWriter->Read(&responseBuffer, (void*)4);
+        } else {
+          _readerWriter->ReadInitialMetadata((void*)6);
+        }
+      } else if ((intptr_t)tag == 6) {
+        // Headers received; Finish reports the failure if there are none
+        if (ok) {
+          deliverMetadata();
+          _readerWriter->Read(&responseBuffer, (void*)4);
+        } else {
+          _readerWriter->Finish(&_status, (void*)5);
+        }
       } else if ((intptr_t)tag == 2) {
         // Write completed
         if (_isSync && _writePromise) {
           _writePromise->set_value();
           // Important: don't clear _writePromise here, let writesDone or writeSync handle lifetime
           // Actually shared_ptr, so safe.
+        } else {
+          writeCompleted();
         }
       } else if ((intptr_t)tag == 3) {
         // WritesDone completed
         if (_isSync && _writesDonePromise) {
           _writesDonePromise->set_value();
+        } else {
+          writeCompleted();
         }
       } else if ((intptr_t)tag == 4) {
         // Response received
         if (ok) {
+          TraceSpan span("stream", "read", "bytes");
           std::vector<::grpc::Slice> slices;
           responseBuffer.Dump(&slices);
           size_t totalSize = 0;
           for (const auto& slice : slices)
             totalSize += slice.size();
-          auto arrayBuffer = ArrayBuffer::allocate(totalSize);
+          auto arrayBuffer = BufferPool::shared().allocate(totalSize);
           size_t offset = 0;
           for (const auto& slice : slices) {
             std::memcpy(static_cast<uint8_t*>(arrayBuffer->data()) + offset, slice.begin(), slice.size());
             offset += slice.size();
           }
+          _metrics->messageReceived(totalSize);
+          span.setValue(static_cast<int64_t>(totalSize));
 
           if (_isSync) {
             _readQueue.push(arrayBuffer);
-          } else if (_dataCallback) {
-            _dataCallback(arrayBuffer);
+          } else {
+            deliverData(arrayBuffer);
           }
         }
         // Always Finish after response (or failure to get response)
@@ -214,12 +263,14 @@ void HybridGrpcStream::initClientStream(std::shared_ptr<::grpc::Channel> channel
 
       } else if ((intptr_t)tag == 5) {
         // Finish completed
+        closeWrites();
+        recordFinish();
         if (_isSync) {
           _readQueue.close();
           if (_finishPromise)
             _finishPromise->set_value();
-        } else if (_statusCallback) {
-          _statusCallback(static_cast<double>(_status.error_code()), _status.error_message(), "{}");
+        } else {
+          deliverStatus(_status);
         }
         break;
       }
@@ -229,27 +280,25 @@ void HybridGrpcStream::initClientStream(std::shared_ptr<::grpc::Channel> channel
 
 // Bidi Stream Init
 void HybridGrpcStream::initBidiStream(std::shared_ptr<::grpc::Channel> channel,
-                                      const std::string& method,
+                                      std::shared_ptr<const MethodHandle> method,
+                                      std::shared_ptr<MethodMetrics> metrics,
+                                      std::shared_ptr<std::atomic<bool>> connectionPending,
                                       const std::string& metadataJson,
                                       int64_t deadlineMs,
                                       bool isSync) {
   _streamType = StreamType::BIDI;
   _isSync = isSync;
+  _method = std::move(method);
+  _metrics = std::move(metrics);
+  _connectionPending = std::move(connectionPending);
   _context = std::make_shared<::grpc::ClientContext>();
 
-  // Set metadata
-  if (!metadataJson.empty()) {
-    MetadataConverter::applyMetadata(metadataJson, *_context);
-  }
-
-  // Set deadline
-  if (deadlineMs > 0) {
-    auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(deadlineMs);
-    _context->set_deadline(deadline);
-  }
+  // Metadata, deadline and per-method defaults
+  _method->prepareContext(*_context, metadataJson, deadlineMs);
+  _startedNs = _metrics->callStarted(true);
 
-  ::grpc::GenericStub stub(channel);
-  _readerWriter = stub.PrepareCall(_context.get(), method, &_cq);
+  _started = _startedPromise.get_future().share();
+  _readerWriter = _method->prepareStream(*channel, *_context, _cq);
   _readerWriter->StartCall((void*)1);
 
   // Background thread for reading
@@ -258,35 +307,46 @@ void HybridGrpcStream::initBidiStream(std::shared_ptr<::grpc::Channel> channel,
     void* tag;
     bool ok;
 
+    // A failed read (tag 2) calls Finish; a failed write or WritesDone is reported by it
     while (_cq.Next(&tag, &ok)) {
-      if (!ok && (intptr_t)tag != 5) {
-        if ((intptr_t)tag == 4) {
+      if ((intptr_t)tag == 1) {
+        _startedPromise.set_value();
+        writeCompleted();
+        if (_isSync) {
+          _readerWriter->Read(&responseBuffer, (void*)2);
+        } else {
+          _readerWriter->ReadInitialMetadata((void*)6);
+        }
+      } else if ((intptr_t)tag == 6) {
+        // Headers received; Finish reports the failure if there are none
+        if (ok) {
+          deliverMetadata();
+          _readerWriter->Read(&responseBuffer, (void*)2);
+        } else {
           _readerWriter->Finish(&_status, (void*)5);
-          continue;
         }
-      }
-
-      if ((intptr_t)tag == 1) {
-        _readerWriter->Read(&responseBuffer, (void*)2);
       } else if ((intptr_t)tag == 2) {
         // Read completed
         if (ok) {
+          TraceSpan span("stream", "read", "bytes");
           std::vector<::grpc::Slice> slices;
           responseBuffer.Dump(&slices);
           size_t totalSize = 0;
           for (const auto& slice : slices)
             totalSize += slice.size();
-          auto arrayBuffer = ArrayBuffer::allocate(totalSize);
+          auto arrayBuffer = BufferPool::shared().allocate(totalSize);
           size_t offset = 0;
           for (const auto& slice : slices) {
             std::memcpy(static_cast<uint8_t*>(arrayBuffer->data()) + offset, slice.begin(), slice.size());
             offset += slice.size();
           }
+          _metrics->messageReceived(totalSize);
+          span.setValue(static_cast<int64_t>(totalSize));
 
           if (_isSync) {
             _readQueue.push(arrayBuffer);
-          } else if (_dataCallback) {
-            _dataCallback(arrayBuffer);
+          } else {
+            deliverData(arrayBuffer);
           }
           responseBuffer.Clear();
           _readerWriter->Read(&responseBuffer, (void*)2);
@@ -298,19 +358,25 @@ void HybridGrpcStream::initBidiStream(std::shared_ptr<::grpc::Channel> channel,
         // Write completed
         if (_isSync && _writePromise) {
           _writePromise->set_value();
+        } else {
+          writeCompleted();
         }
       } else if ((intptr_t)tag == 4) {
         // WritesDone completed
         if (_isSync && _writesDonePromise) {
           _writesDonePromise->set_value();
+        } else {
+          writeCompleted();
         }
       } else if ((intptr_t)tag == 5) {
+        closeWrites();
+        recordFinish();
         if (_isSync) {
           _readQueue.close();
           if (_finishPromise)
             _finishPromise->set_value();
-        } else if (_statusCallback) {
-          _statusCallback(static_cast<double>(_status.error_code()), _status.error_message(), "{}");
+        } else {
+          deliverStatus(_status);
         }
         break;
       }
@@ -323,22 +389,56 @@ void HybridGrpcStream::write(const std::shared_ptr<ArrayBuffer>& data) {
     throw std::runtime_error("Cannot write to server stream");
   }
 
+  TraceSpan span("stream", "write", "bytes", static_cast<int64_t>(data->size()));
+  // The slice copies the bytes, so JS may reuse its buffer while the write is queued
   ::grpc::Slice slice(data->data(), data->size());
-  ::grpc::ByteBuffer buffer(&slice, 1);
+  _metrics->messageSent(data->size());
+  enqueueWrite(::grpc::ByteBuffer(&slice, 1));
+}
 
-  if (_streamType == StreamType::CLIENT && _readerWriter) {
-    _readerWriter->Write(buffer, (void*)2);
-  } else if (_streamType == StreamType::BIDI && _readerWriter) {
-    _readerWriter->Write(buffer, (void*)3);
+void HybridGrpcStream::writesDone() {
+  if (_streamType == StreamType::SERVER) {
+    return; // The request was already sent with the half-close
   }
+  enqueueWrite(std::nullopt);
 }
 
-void HybridGrpcStream::writesDone() {
-  if (_streamType == StreamType::CLIENT && _readerWriter) {
-    _readerWriter->WritesDone((void*)3);
-  } else if (_streamType == StreamType::BIDI && _readerWriter) {
-    _readerWriter->WritesDone((void*)4);
+void HybridGrpcStream::enqueueWrite(std::optional<::grpc::ByteBuffer> message) {
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  if (_writesClosed) {
+    return;
+  }
+  _pendingWrites.push_back(std::move(message));
+  if (!_writeInFlight) {
+    issueNextWriteLocked();
+  }
+}
+
+void HybridGrpcStream::writeCompleted() {
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  _writeInFlight = false;
+  issueNextWriteLocked();
+}
+
+void HybridGrpcStream::closeWrites() {
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  _writesClosed = true;
+  _pendingWrites.clear();
+}
+
+void HybridGrpcStream::issueNextWriteLocked() {
+  if (_writesClosed || _pendingWrites.empty() || !_readerWriter) {
+    return;
   }
+  // Client streams complete writes as tag 2 and WritesDone as 3; bidi streams use 3 and 4
+  const intptr_t writeTag = _streamType == StreamType::CLIENT ? 2 : 3;
+  if (_pendingWrites.front().has_value()) {
+    _readerWriter->Write(*_pendingWrites.front(), (void*)writeTag);
+  } else {
+    _readerWriter->WritesDone((void*)(writeTag + 1));
+  }
+  _pendingWrites.pop_front();
+  _writeInFlight = true;
 }
 
 void HybridGrpcStream::writeSync(const std::shared_ptr<ArrayBuffer>& data) {
@@ -348,9 +448,12 @@ void HybridGrpcStream::writeSync(const std::shared_ptr<ArrayBuffer>& data) {
   if (!_isSync)
     throw std::runtime_error("Stream not initialized for synchronous writing.");
 
+  TraceSpan span("stream", "writeSync", "bytes", static_cast<int64_t>(data->size()));
   ::grpc::Slice slice(data->data(), data->size());
   ::grpc::ByteBuffer buffer(&slice, 1);
+  _metrics->messageSent(data->size());
 
+  _started.wait();
   auto promise = std::make_shared<std::promise<void>>();
   auto future = promise->get_future();
   {
@@ -392,6 +495,7 @@ std::variant<nitro::NullType, std::shared_ptr<ArrayBuffer>> HybridGrpcStream::fi
   }
 
   // 1. Signal WritesDone
+  _started.wait();
   _readerWriter->WritesDone((void*)3);
   doneFuture.wait();
 
@@ -413,16 +517,90 @@ std::variant<nitro::NullType, std::shared_ptr<ArrayBuffer>> HybridGrpcStream::fi
 void HybridGrpcStream::onData(const std::function<void(const std::shared_ptr<ArrayBuffer>&)>& callback) {
   std::lock_guard<std::mutex> lock(_callbackMutex);
   _dataCallback = callback;
+  flushEventsLocked();
 }
 
-void HybridGrpcStream::onMetadata(const std::function<void(const std::string&)>& callback) {
+void HybridGrpcStream::onMetadata(const std::function<void(const std::shared_ptr<HybridCallMetadataSpec>&)>& callback) {
   std::lock_guard<std::mutex> lock(_callbackMutex);
   _metadataCallback = callback;
+  flushEventsLocked();
 }
 
-void HybridGrpcStream::onStatus(const std::function<void(double, const std::string&, const std::string&)>& callback) {
+void HybridGrpcStream::onStatus(
+    const std::function<void(double, const std::string&, const std::shared_ptr<HybridCallMetadataSpec>&)>& callback) {
   std::lock_guard<std::mutex> lock(_callbackMutex);
   _statusCallback = callback;
+  flushEventsLocked();
+}
+
+void HybridGrpcStream::recordFinish() {
+  TlsSessionCache::shared().recordConnectionIfPending(*_connectionPending, *_context);
+  _metrics->callFinished(true, _status.error_code(), _startedNs);
+  if (Tracer::enabled()) {
+    Tracer::shared().record("call",
+                            "stream",
+                            _startedNs,
+                            Tracer::nowNs(),
+                            _method->traceName(),
+                            "status",
+                            _status.error_code());
+  }
+}
+
+void HybridGrpcStream::deliverMetadata() {
+  auto metadata = std::make_shared<HybridCallMetadata>(_context, HybridCallMetadata::Kind::INITIAL);
+  std::lock_guard<std::mutex> lock(_callbackMutex);
+  pushEventLocked(Event{Event::Kind::METADATA, nullptr, std::move(metadata)});
+}
+
+void HybridGrpcStream::deliverData(const std::shared_ptr<ArrayBuffer>& data) {
+  std::lock_guard<std::mutex> lock(_callbackMutex);
+  pushEventLocked(Event{Event::Kind::DATA, data, nullptr});
+}
+
+void HybridGrpcStream::deliverStatus(const ::grpc::Status& status) {
+  // Trailers are only read from the context if JS asks for them
+  auto trailers = std::make_shared<HybridCallMetadata>(_context, HybridCallMetadata::Kind::TRAILING);
+  std::lock_guard<std::mutex> lock(_callbackMutex);
+  pushEventLocked(Event{Event::Kind::STATUS,
+                        nullptr,
+                        std::move(trailers),
+                        static_cast<double>(status.error_code()),
+                        status.error_message()});
+}
+
+void HybridGrpcStream::pushEventLocked(Event event) {
+  _pendingEvents.push_back(std::move(event));
+  flushEventsLocked();
+}
+
+void HybridGrpcStream::flushEventsLocked() {
+  while (!_pendingEvents.empty()) {
+    Event& event = _pendingEvents.front();
+    switch (event.kind) {
+      case Event::Kind::METADATA:
+        if (_metadataCallback) {
+          _metadataCallback(event.metadata);
+        } else if (!_dataCallback && !_statusCallback) {
+          return;
+        }
+        // Headers are optional: once JS listens without an onMetadata callback they are dropped
+        break;
+      case Event::Kind::DATA:
+        if (!_dataCallback) {
+          return;
+        }
+        _dataCallback(event.data);
+        break;
+      case Event::Kind::STATUS:
+        if (!_statusCallback) {
+          return;
+        }
+        _statusCallback(event.code, event.message, event.metadata);
+        break;
+    }
+    _pendingEvents.pop_front();
+  }
 }
 
 void HybridGrpcStream::onError(const std::function<void(const std::string&)>& callback) {
@@ -433,10 +611,11 @@ void HybridGrpcStream::onError(const std::function<void(const std::string&)>& ca
 void HybridGrpcStream::cancel() {
   bool expected = false;
   if (_cancelled.compare_exchange_strong(expected, true)) {
+    // Pending operations fail, which drives the reader thread to Finish and exit.
+    // The queue is shut down in the destructor; doing it here would race with that.
     if (_context) {
       _context->TryCancel();
     }
-    _cq.Shutdown();
   }
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../calls/MethodHandle.hpp"
+#include "../metadata/HybridCallMetadata.hpp"
+#include "../metrics/ChannelMetrics.hpp"
 #include "HybridGrpcStreamSpec.hpp"
 
 #include <NitroModules/ArrayBuffer.hpp>
@@ -27,7 +30,9 @@ public:
 
   // Initialize server stream
   void initServerStream(std::shared_ptr<::grpc::Channel> channel,
-                        const std::string& method,
+                        std::shared_ptr<const MethodHandle> method,
+                        std::shared_ptr<MethodMetrics> metrics,
+                        std::shared_ptr<std::atomic<bool>> connectionPending,
                         const std::shared_ptr<ArrayBuffer>& request,
                         const std::string& metadataJson,
                         int64_t deadlineMs,
@@ -36,8 +41,9 @@ public:
   void write(const std::shared_ptr<ArrayBuffer>& data) override;
   void writesDone() override;
   void onData(const std::function<void(const std::shared_ptr<ArrayBuffer>&)>& callback) override;
-  void onMetadata(const std::function<void(const std::string&)>& callback) override;
-  void onStatus(const std::function<void(double, const std::string&, const std::string&)>& callback) override;
+  void onMetadata(const std::function<void(const std::shared_ptr<HybridCallMetadataSpec>&)>& callback) override;
+  void onStatus(const std::function<void(double, const std::string&, const std::shared_ptr<HybridCallMetadataSpec>&)>&
+                    callback) override;
   void onError(const std::function<void(const std::string&)>& callback) override;
   void cancel() override;
 
@@ -48,18 +54,62 @@ public:
 
   // Public init methods - called by HybridGrpcClient
   void initClientStream(std::shared_ptr<::grpc::Channel> channel,
-                        const std::string& method,
+                        std::shared_ptr<const MethodHandle> method,
+                        std::shared_ptr<MethodMetrics> metrics,
+                        std::shared_ptr<std::atomic<bool>> connectionPending,
                         const std::string& metadataJson,
                         int64_t deadlineMs,
                         bool isSync);
 
   void initBidiStream(std::shared_ptr<::grpc::Channel> channel,
-                      const std::string& method,
+                      std::shared_ptr<const MethodHandle> method,
+                      std::shared_ptr<MethodMetrics> metrics,
+                      std::shared_ptr<std::atomic<bool>> connectionPending,
                       const std::string& metadataJson,
                       int64_t deadlineMs,
                       bool isSync);
 
 private:
+  /**
+   * Hand the headers, a message or the final status to JS. A fast server can
+   * answer before JS has registered its callbacks; until then events are
+   * held, and they are always delivered in the order they happened.
+   * Headers are skipped if onData or onStatus is registered before
+   * onMetadata.
+   */
+  void deliverMetadata();
+  void deliverData(const std::shared_ptr<ArrayBuffer>& data);
+  void deliverStatus(const ::grpc::Status& status);
+
+  // Count the finished stream in the metrics, TLS stats and trace; _status holds its status
+  void recordFinish();
+
+  struct Event {
+    enum class Kind { METADATA, DATA, STATUS };
+    Kind kind;
+    std::shared_ptr<ArrayBuffer> data;
+    std::shared_ptr<HybridCallMetadataSpec> metadata; // Headers, or trailers for STATUS
+    double code = 0;
+    std::string message;
+  };
+
+  // Requires _callbackMutex
+  void pushEventLocked(Event event);
+  void flushEventsLocked();
+
+  /**
+   * Queue an async write (or the half-close, for nullopt). gRPC allows one
+   * outstanding write op per call and StartCall holds it first, so each one is
+   * issued only once the previous op has completed.
+   */
+  void enqueueWrite(std::optional<::grpc::ByteBuffer> message);
+  // StartCall or a write completed; issue the next queued write
+  void writeCompleted();
+  // The call finished; writes queued or made from now on are dropped
+  void closeWrites();
+  // Requires _writeMutex
+  void issueNextWriteLocked();
+
   void startReading(std::shared_ptr<::grpc::Channel> channel,
                     const std::string& method,
                     const std::vector<char>& requestData);
@@ -68,6 +118,11 @@ private:
   enum class StreamType { SERVER, CLIENT, BIDI };
   StreamType _streamType;
 
+  std::shared_ptr<const MethodHandle> _method; // Outlives _readerWriter, which refers to its RpcMethod
+  std::shared_ptr<MethodMetrics> _metrics;
+  // Set while the channel's current connection is not yet in the TLS stats
+  std::shared_ptr<std::atomic<bool>> _connectionPending;
+  int64_t _startedNs = 0;
   std::shared_ptr<::grpc::ClientContext> _context;
   std::unique_ptr<::grpc::GenericClientAsyncReaderWriter> _readerWriter;
   ::grpc::CompletionQueue _cq;
@@ -121,16 +176,26 @@ private:
   // Sync Buffers
   BlockingQueue<std::shared_ptr<ArrayBuffer>> _readQueue;
   bool _isSync = false;
+  // StartCall shares gRPC's write op slot: writeSync must not begin before it completes
+  std::promise<void> _startedPromise;
+  std::shared_future<void> _started;
   std::shared_ptr<std::promise<void>> _writePromise;
   std::shared_ptr<std::promise<void>> _writesDonePromise;
   std::shared_ptr<std::promise<void>> _finishPromise;
 
+  // Async writes waiting for the write op slot; nullopt is WritesDone
+  std::mutex _writeMutex;
+  std::deque<std::optional<::grpc::ByteBuffer>> _pendingWrites;
+  bool _writeInFlight = true; // StartCall holds the slot until it completes
+  bool _writesClosed = false;
+
   // Thread-safe callback storage
   std::mutex _callbackMutex;
   std::function<void(const std::shared_ptr<ArrayBuffer>&)> _dataCallback;
-  std::function<void(const std::string&)> _metadataCallback;
-  std::function<void(double, const std::string&, const std::string&)> _statusCallback;
+  std::function<void(const std::shared_ptr<HybridCallMetadataSpec>&)> _metadataCallback;
+  std::function<void(double, const std::string&, const std::shared_ptr<HybridCallMetadataSpec>&)> _statusCallback;
   std::function<void(const std::string&)> _errorCallback;
+  std::deque<Event> _pendingEvents;
 };
 
 } // namespace margelo::nitro::grpc
@@ -0,0 +1,28 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+
+namespace margelo::nitro::grpc::loadgen {
+
+LatencyHistogram::LatencyHistogram() : _counts(Buckets::kCount, 0) {}
+
+void LatencyHistogram::record(int64_t valueNs) {
+  const int64_t value = Buckets::clamp(valueNs);
+  _counts[Buckets::indexFor(value)]++;
+  _count++;
+  _max = std::max(_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < _counts.size(); i++) {
+    _counts[i] += other._counts[i];
+  }
+  _count += other._count;
+  _max = std::max(_max, other._max);
+}
+
+int64_t LatencyHistogram::percentile(double percentile) const {
+  return Buckets::percentile(_counts, _count, _max, percentile);
+}
+
+} // namespace margelo::nitro::grpc::loadgen
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../metrics/LogLinearBuckets.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::grpc::loadgen {
+
+/**
+ * @brief HdrHistogram-style latency recorder with three significant digits.
+ *
+ * Values (nanoseconds) fall into power-of-two buckets, each split into 1024
+ * linear sub-buckets, so every recorded value is kept to within 0.1% of its
+ * magnitude at a fixed memory cost (about 220 KB). Values above ~68 s are
+ * clamped to the top bucket.
+ *
+ * Not thread-safe: record into one histogram per thread and merge().
+ */
+class LatencyHistogram {
+public:
+  LatencyHistogram();
+
+  void record(int64_t valueNs);
+
+  /**
+   * Add all of `other`'s recorded values to this histogram.
+   */
+  void merge(const LatencyHistogram& other);
+
+  uint64_t count() const {
+    return _count;
+  }
+
+  int64_t max() const {
+    return _max;
+  }
+
+  /**
+   * The smallest value that at least `percentile` percent of the recorded
+   * values are equal to or below (reported at bucket resolution).
+   * 0 if nothing was recorded.
+   */
+  int64_t percentile(double percentile) const;
+
+private:
+  using Buckets = LogLinearBuckets<10, 36>;
+
+  std::vector<uint64_t> _counts;
+  uint64_t _count = 0;
+  int64_t _max = 0;
+};
+
+} // namespace margelo::nitro::grpc::loadgen
@@ -0,0 +1,297 @@
+#include "LoadGenerator.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <thread>
+#include <unordered_map>
+
+namespace margelo::nitro::grpc::loadgen {
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+  constexpr auto kDrainTimeout = std::chrono::seconds(30);
+
+  double cpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const auto seconds = [](const timeval& tv) { return static_cast<double>(tv.tv_sec) + tv.tv_usec / 1e6; };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+  }
+
+  Clock::duration toDuration(double seconds) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+  }
+
+  int64_t nanosBetween(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+  }
+
+  /**
+   * Process CPU use between mark() and finish().
+   */
+  class CpuMeter {
+  public:
+    void mark() {
+      _cpu = cpuSeconds();
+      _wall = Clock::now();
+    }
+
+    double finish() const {
+      const double wall = std::chrono::duration<double>(Clock::now() - _wall).count();
+      return wall > 0 ? (cpuSeconds() - _cpu) / wall * 100.0 : 0;
+    }
+
+  private:
+    double _cpu = 0;
+    Clock::time_point _wall;
+  };
+
+  void add(ScenarioResult& result, const Workload::Result& operation, int64_t latencyNs) {
+    result.operations++;
+    if (!operation.ok) {
+      result.errors++;
+    }
+    result.messages += operation.messages;
+    result.bytes += operation.bytes;
+    result.latency.record(latencyNs);
+  }
+
+  ScenarioResult runClosedLoop(const Workload& workload, const Scenario& scenario) {
+    const auto measureStart = Clock::now() + toDuration(scenario.warmupSeconds);
+    const auto measureEnd = measureStart + toDuration(scenario.durationSeconds);
+
+    // One result per worker, merged at the end: nothing is shared while measuring
+    std::vector<ScenarioResult> perWorker(static_cast<size_t>(scenario.concurrency));
+    std::vector<std::thread> workers;
+    for (auto& result : perWorker) {
+      workers.emplace_back([&workload, &result, measureStart, measureEnd]() {
+        auto connection = workload.connect();
+        while (true) {
+          const auto start = Clock::now();
+          if (start >= measureEnd) {
+            break;
+          }
+          const auto operation = connection->next();
+          if (start >= measureStart) {
+            add(result, operation, nanosBetween(start, Clock::now()));
+          }
+        }
+      });
+    }
+
+    CpuMeter cpu;
+    std::this_thread::sleep_until(measureStart);
+    cpu.mark();
+    std::this_thread::sleep_until(measureEnd);
+    const double cpuPercent = cpu.finish();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    ScenarioResult total;
+    for (const auto& result : perWorker) {
+      total.operations += result.operations;
+      total.errors += result.errors;
+      total.messages += result.messages;
+      total.bytes += result.bytes;
+      total.latency.merge(result.latency);
+    }
+    total.seconds = scenario.durationSeconds;
+    total.cpuPercent = cpuPercent;
+    return total;
+  }
+
+  /**
+   * Completions of open-loop operations, filled in from library threads.
+   */
+  struct OpenLoopState {
+    std::mutex mutex;
+    std::condition_variable drained;
+    ScenarioResult result;
+    uint64_t outstanding = 0;
+    // Streams of finished operations, released by the pacing thread
+    std::vector<uint64_t> finished;
+  };
+
+  ScenarioResult runOpenLoop(const Workload& workload, const Scenario& scenario) {
+    if (!workload.supportsOpenLoop()) {
+      throw std::runtime_error(Workload::rpcName(workload.config().rpc) + " only runs closed-loop");
+    }
+    const auto interval = toDuration(1.0 / scenario.qps);
+    const auto begin = Clock::now();
+    const auto measureStart = begin + toDuration(scenario.warmupSeconds);
+    const auto measureEnd = measureStart + toDuration(scenario.durationSeconds);
+
+    auto state = std::make_shared<OpenLoopState>();
+    std::unordered_map<uint64_t, std::shared_ptr<void>> calls;
+    const auto releaseFinished = [&]() {
+      std::vector<uint64_t> finished;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        finished.swap(state->finished);
+      }
+      for (uint64_t id : finished) {
+        calls.erase(id);
+      }
+    };
+
+    CpuMeter cpu;
+    bool measuring = false;
+    for (uint64_t id = 0;; id++) {
+      const auto scheduled = begin + interval * static_cast<int64_t>(id);
+      if (scheduled >= measureEnd) {
+        break;
+      }
+      if (!measuring && scheduled >= measureStart) {
+        measuring = true;
+        cpu.mark();
+      }
+      releaseFinished();
+      // Behind schedule: send immediately; latency still counts from `scheduled`
+      std::this_thread::sleep_until(scheduled);
+
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->outstanding++;
+      }
+      const bool measured = measuring;
+      auto call = workload.start([state, id, scheduled, measured](const Workload::Result& operation) {
+        const int64_t latencyNs = nanosBetween(scheduled, Clock::now());
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (measured) {
+          add(state->result, operation, latencyNs);
+        }
+        state->finished.push_back(id);
+        if (--state->outstanding == 0) {
+          state->drained.notify_all();
+        }
+      });
+      if (call) {
+        calls.emplace(id, std::move(call));
+      }
+    }
+
+    ScenarioResult total;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->drained.wait_for(lock, kDrainTimeout, [&]() { return state->outstanding == 0; });
+      total = state->result;
+      // Operations that never completed count as failed
+      total.operations += state->outstanding;
+      total.errors += state->outstanding;
+    }
+    total.cpuPercent = cpu.finish();
+    total.seconds = scenario.durationSeconds;
+    releaseFinished();
+    return total;
+  }
+
+  std::string formatMicros(int64_t nanos) {
+    char text[32];
+    if (nanos >= 1'000'000'000) {
+      std::snprintf(text, sizeof(text), "%.2fs", nanos / 1e9);
+    } else if (nanos >= 1'000'000) {
+      std::snprintf(text, sizeof(text), "%.2fms", nanos / 1e6);
+    } else {
+      std::snprintf(text, sizeof(text), "%.1fus", nanos / 1e3);
+    }
+    return text;
+  }
+
+} // namespace
+
+Scenario Scenario::parse(const std::string& spec) {
+  const auto colon = spec.find(':');
+  const std::string mode = spec.substr(0, colon);
+  Scenario scenario;
+  try {
+    const std::string value = colon == std::string::npos ? "" : spec.substr(colon + 1);
+    if (mode == "closed") {
+      scenario.mode = Mode::CLOSED;
+      scenario.concurrency = std::stoi(value);
+      if (scenario.concurrency < 1) {
+        throw std::runtime_error("concurrency must be at least 1");
+      }
+      return scenario;
+    }
+    if (mode == "open") {
+      scenario.mode = Mode::OPEN;
+      scenario.qps = std::stod(value);
+      if (scenario.qps <= 0) {
+        throw std::runtime_error("qps must be positive");
+      }
+      return scenario;
+    }
+  } catch (const std::logic_error&) {
+    // std::stoi / std::stod failures
+  }
+  throw std::runtime_error("Invalid scenario '" + spec + "' (expected closed:<concurrency> or open:<qps>)");
+}
+
+std::string Scenario::name() const {
+  if (mode == Mode::CLOSED) {
+    return "closed c=" + std::to_string(concurrency);
+  }
+  char text[32];
+  std::snprintf(text, sizeof(text), "open qps=%g", qps);
+  return text;
+}
+
+ScenarioResult runScenario(const Workload& workload, const Scenario& scenario) {
+  ScenarioResult result =
+      scenario.mode == Scenario::Mode::CLOSED ? runClosedLoop(workload, scenario) : runOpenLoop(workload, scenario);
+  result.name = Workload::rpcName(workload.config().rpc) + " " + scenario.name();
+  return result;
+}
+
+std::string formatResults(const std::vector<ScenarioResult>& results) {
+  std::string out;
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-24s %10s %8s %10s %9s %10s %10s %10s %10s %6s\n", "scenario", "ops", "errors",
+                "ops/s", "MB/s", "p50", "p99", "p999", "max", "cpu%");
+  out += line;
+  for (const auto& r : results) {
+    std::snprintf(line, sizeof(line), "%-24s %10llu %8llu %10.0f %9.2f %10s %10s %10s %10s %6.0f\n", r.name.c_str(),
+                  static_cast<unsigned long long>(r.operations), static_cast<unsigned long long>(r.errors),
+                  r.operations / r.seconds, r.bytes / r.seconds / 1e6, formatMicros(r.latency.percentile(50)).c_str(),
+                  formatMicros(r.latency.percentile(99)).c_str(), formatMicros(r.latency.percentile(99.9)).c_str(),
+                  formatMicros(r.latency.max()).c_str(), r.cpuPercent);
+    out += line;
+  }
+  return out;
+}
+
+std::string resultsJson(const std::vector<ScenarioResult>& results) {
+  json array = json::array();
+  for (const auto& r : results) {
+    array.push_back({
+        {"scenario", r.name},
+        {"operations", r.operations},
+        {"errors", r.errors},
+        {"messages", r.messages},
+        {"bytes", r.bytes},
+        {"seconds", r.seconds},
+        {"operationsPerSecond", r.operations / r.seconds},
+        {"bytesPerSecond", r.bytes / r.seconds},
+        {"cpuPercent", r.cpuPercent},
+        {"latencyUs",
+         {
+             {"p50", r.latency.percentile(50) / 1e3},
+             {"p99", r.latency.percentile(99) / 1e3},
+             {"p999", r.latency.percentile(99.9) / 1e3},
+             {"max", r.latency.max() / 1e3},
+         }},
+    });
+  }
+  return array.dump(2);
+}
+
+} // namespace margelo::nitro::grpc::loadgen
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "Workload.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc::loadgen {
+
+/**
+ * @brief How load is offered during one measurement.
+ *
+ * - CLOSED: `concurrency` workers each issue the next operation as soon as
+ *   the previous one completes. Throughput follows the server's speed.
+ * - OPEN: operations start on a fixed schedule of `qps` per second whether
+ *   or not earlier ones have completed. Latency is measured from the
+ *   scheduled start, so a stalled server shows up as queueing delay instead
+ *   of being hidden by a slower send rate (coordinated omission).
+ */
+struct Scenario {
+  enum class Mode { CLOSED, OPEN };
+
+  Mode mode = Mode::CLOSED;
+  int concurrency = 1;
+  double qps = 0;
+  double warmupSeconds = 2;
+  double durationSeconds = 10;
+
+  /**
+   * Parse `closed:<concurrency>` or `open:<qps>`.
+   *
+   * @throws std::runtime_error if the spec is malformed
+   */
+  static Scenario parse(const std::string& spec);
+
+  std::string name() const;
+};
+
+struct ScenarioResult {
+  std::string name;
+  // Operations started inside the measurement window
+  uint64_t operations = 0;
+  uint64_t errors = 0;
+  uint64_t messages = 0;
+  uint64_t bytes = 0;
+  double seconds = 0;
+  // Process CPU time (user + system) over wall time; 100 is one core
+  double cpuPercent = 0;
+  LatencyHistogram latency;
+};
+
+/**
+ * Run one scenario: warm up, then measure. Blocks for the scenario's
+ * duration plus the time to drain outstanding open-loop operations.
+ *
+ * @throws std::runtime_error if the workload cannot run in the scenario's mode
+ */
+ScenarioResult runScenario(const Workload& workload, const Scenario& scenario);
+
+/**
+ * Human-readable table, one row per scenario.
+ */
+std::string formatResults(const std::vector<ScenarioResult>& results);
+
+/**
+ * Machine-readable JSON array, one object per scenario (latencies in microseconds).
+ */
+std::string resultsJson(const std::vector<ScenarioResult>& results);
+
+} // namespace margelo::nitro::grpc::loadgen
@@ -0,0 +1,197 @@
+#include "Workload.hpp"
+
+#include "WireFormat.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc::loadgen {
+
+namespace {
+
+  constexpr const char* kEchoPath = "/myservice.BenchmarkService/Echo";
+  constexpr const char* kStreamPath = "/myservice.BenchmarkService/StreamPayloads";
+  constexpr const char* kPingPongPath = "/myservice.BenchmarkService/PingPong";
+
+  void writeBytesField(std::vector<uint8_t>& out, uint32_t number, size_t size) {
+    WireFormat::writeVarint(out, (number << 3) | WireFormat::LEN);
+    WireFormat::writeVarint(out, size);
+    out.insert(out.end(), size, 'x');
+  }
+
+  void writeIntField(std::vector<uint8_t>& out, uint32_t number, uint64_t value) {
+    if (value != 0) {
+      WireFormat::writeVarint(out, (number << 3) | WireFormat::VARINT);
+      WireFormat::writeVarint(out, value);
+    }
+  }
+
+  /**
+   * Payload { bytes body = 1; int32 response_size = 2; }
+   */
+  std::shared_ptr<ArrayBuffer> payload(size_t bodySize, size_t responseSize) {
+    std::vector<uint8_t> out;
+    writeBytesField(out, 1, bodySize);
+    writeIntField(out, 2, responseSize);
+    return ArrayBuffer::copy(out.data(), out.size());
+  }
+
+  /**
+   * StreamPayloadsRequest { int32 count = 1; int32 size = 2; int32 messages_per_second = 3; }
+   */
+  std::shared_ptr<ArrayBuffer> streamRequest(int count, size_t size, int rate) {
+    std::vector<uint8_t> out;
+    writeIntField(out, 1, static_cast<uint64_t>(count));
+    writeIntField(out, 2, size);
+    writeIntField(out, 3, static_cast<uint64_t>(rate));
+    return ArrayBuffer::copy(out.data(), out.size());
+  }
+
+  /**
+   * Echo and StreamPayloads: start() and wait for it.
+   */
+  class BlockingConnection : public Workload::Connection {
+  public:
+    explicit BlockingConnection(const Workload& workload) : _workload(workload) {}
+
+    Workload::Result next() override {
+      auto promise = std::make_shared<std::promise<Workload::Result>>();
+      auto future = promise->get_future();
+      // Released after get(), on this thread rather than the callback's
+      auto call = _workload.start([promise](const Workload::Result& result) { promise->set_value(result); });
+      return future.get();
+    }
+
+  private:
+    const Workload& _workload;
+  };
+
+  /**
+   * One PingPong stream per worker, written and read synchronously.
+   */
+  class PingPongConnection : public Workload::Connection {
+  public:
+    PingPongConnection(const std::shared_ptr<HybridGrpcClient>& client, std::shared_ptr<ArrayBuffer> message)
+        : _stream(client->createBidiStreamSync(kPingPongPath, "{}", 0)), _message(std::move(message)) {}
+
+    ~PingPongConnection() override {
+      if (_open) {
+        _stream->writesDone();
+        while (!std::holds_alternative<nitro::NullType>(_stream->readSync())) {
+        }
+      }
+    }
+
+    Workload::Result next() override {
+      if (!_open) {
+        return {};
+      }
+      try {
+        _stream->writeSync(_message);
+      } catch (const std::exception&) {
+        _open = false;
+        return {};
+      }
+      auto reply = _stream->readSync();
+      if (std::holds_alternative<nitro::NullType>(reply)) {
+        _open = false;
+        return {};
+      }
+      return {true, 1, std::get<std::shared_ptr<ArrayBuffer>>(reply)->size()};
+    }
+
+  private:
+    std::shared_ptr<HybridGrpcStreamSpec> _stream;
+    std::shared_ptr<ArrayBuffer> _message;
+    bool _open = true;
+  };
+
+} // namespace
+
+Workload::Workload(std::shared_ptr<HybridGrpcClient> client, const Config& config)
+    : _client(std::move(client)), _config(config) {
+  switch (_config.rpc) {
+    case Rpc::ECHO:
+      _request = payload(_config.requestSize, _config.responseSize);
+      _methodHandle = _client->registerMethod(kEchoPath, "unary", "{}");
+      break;
+    case Rpc::STREAM:
+      _request = streamRequest(_config.streamMessages,
+                               _config.responseSize > 0 ? _config.responseSize : _config.requestSize,
+                               _config.streamRate);
+      _methodHandle = _client->registerMethod(kStreamPath, "server_streaming", "{}");
+      break;
+    case Rpc::PING_PONG:
+      _request = payload(_config.requestSize, _config.responseSize);
+      break;
+  }
+}
+
+Workload::Rpc Workload::parseRpc(const std::string& name) {
+  if (name == "echo") {
+    return Rpc::ECHO;
+  }
+  if (name == "stream") {
+    return Rpc::STREAM;
+  }
+  if (name == "pingpong") {
+    return Rpc::PING_PONG;
+  }
+  throw std::runtime_error("Unknown RPC: " + name + " (expected echo, stream or pingpong)");
+}
+
+std::string Workload::rpcName(Rpc rpc) {
+  switch (rpc) {
+    case Rpc::ECHO:
+      return "echo";
+    case Rpc::STREAM:
+      return "stream";
+    case Rpc::PING_PONG:
+      return "pingpong";
+  }
+  return "unknown";
+}
+
+std::shared_ptr<void> Workload::start(Callback done) const {
+  if (_config.rpc == Rpc::ECHO) {
+    auto promise = _client->unaryCallWithHandle(_methodHandle, _request, "{}", 0, "");
+    promise->addOnResolvedListener(
+        [done](const std::shared_ptr<ArrayBuffer>& response) { done({true, 1, response->size()}); });
+    promise->addOnRejectedListener([done](const std::exception_ptr&) { done({}); });
+    return nullptr;
+  }
+
+  if (_config.rpc == Rpc::STREAM) {
+    struct Progress {
+      std::atomic<uint64_t> messages{0};
+      std::atomic<uint64_t> bytes{0};
+    };
+    auto progress = std::make_shared<Progress>();
+    const auto expected = static_cast<uint64_t>(_config.streamMessages);
+    auto stream = _client->createServerStreamWithHandle(_methodHandle, _request, "{}", 0);
+    stream->onData([progress](const std::shared_ptr<ArrayBuffer>& message) {
+      progress->messages.fetch_add(1, std::memory_order_relaxed);
+      progress->bytes.fetch_add(message->size(), std::memory_order_relaxed);
+    });
+    stream->onStatus(
+        [done, progress, expected](double code, const std::string&, const std::shared_ptr<HybridCallMetadataSpec>&) {
+          const uint64_t messages = progress->messages.load();
+          done({code == 0 && messages == expected, messages, progress->bytes.load()});
+        });
+    return stream;
+  }
+
+  throw std::runtime_error("pingpong only runs closed-loop");
+}
+
+std::unique_ptr<Workload::Connection> Workload::connect() const {
+  if (_config.rpc == Rpc::PING_PONG) {
+    return std::make_unique<PingPongConnection>(_client, _request);
+  }
+  return std::make_unique<BlockingConnection>(*this);
+}
+
+} // namespace margelo::nitro::grpc::loadgen
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "HybridGrpcClient.hpp"
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::grpc::loadgen {
+
+/**
+ * @brief One kind of operation against myservice.BenchmarkService
+ * (examples/server/proto/service.proto), issued through HybridGrpcClient.
+ *
+ * - ECHO: one unary Echo call.
+ * - STREAM: one StreamPayloads call, read to the end. Its latency is the
+ *   time until the last message and the status arrived.
+ * - PING_PONG: one message/reply round trip on a long-lived PingPong stream.
+ */
+class Workload {
+public:
+  enum class Rpc { ECHO, STREAM, PING_PONG };
+
+  struct Config {
+    Rpc rpc = Rpc::ECHO;
+    size_t requestSize = 64;
+    // 0 makes the server echo the request body (or, for STREAM, send requestSize bytes)
+    size_t responseSize = 0;
+    int streamMessages = 100;
+    // Per-stream pacing on the server; 0 sends as fast as flow control allows
+    int streamRate = 0;
+  };
+
+  struct Result {
+    bool ok = false;
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+  };
+
+  using Callback = std::function<void(const Result&)>;
+
+  /**
+   * Blocking operations for one closed-loop worker. Owns per-worker state,
+   * such as the PingPong stream.
+   */
+  class Connection {
+  public:
+    virtual ~Connection() = default;
+    virtual Result next() = 0;
+  };
+
+  /**
+   * @throws std::runtime_error if the methods cannot be registered with the client
+   */
+  Workload(std::shared_ptr<HybridGrpcClient> client, const Config& config);
+
+  /**
+   * @throws std::runtime_error for an unknown name
+   */
+  static Rpc parseRpc(const std::string& name);
+  static std::string rpcName(Rpc rpc);
+
+  const Config& config() const {
+    return _config;
+  }
+
+  /**
+   * Whether start() is available. PING_PONG round trips are sequential per
+   * stream, so they only run closed-loop.
+   */
+  bool supportsOpenLoop() const {
+    return _config.rpc != Rpc::PING_PONG;
+  }
+
+  /**
+   * Start one operation without blocking. `done` runs on a library thread.
+   *
+   * Returns the call's stream (or null): keep it until `done` has run, then
+   * drop it on another thread, since destroying a stream joins the thread
+   * that runs its callbacks.
+   */
+  std::shared_ptr<void> start(Callback done) const;
+
+  std::unique_ptr<Connection> connect() const;
+
+private:
+  std::shared_ptr<HybridGrpcClient> _client;
+  Config _config;
+  std::shared_ptr<ArrayBuffer> _request;
+  double _methodHandle = 0;
+};
+
+} // namespace margelo::nitro::grpc::loadgen
@@ -0,0 +1,157 @@
+#include "LoadGenerator.hpp"
+#include "Workload.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::grpc;
+using namespace margelo::nitro::grpc::loadgen;
+
+namespace {
+
+constexpr const char* kUsage = R"(Usage: rngrpc_loadgen [options] <scenario>...
+
+Runs each scenario against myservice.BenchmarkService (examples/server) and
+reports latency percentiles, throughput and process CPU use.
+
+Scenarios:
+  closed:<concurrency>   that many workers, each calling back to back
+  open:<qps>             calls started at a fixed rate, latency measured
+                         from each call's scheduled start
+
+Options:
+  --target <host:port>       server address (default localhost:50051)
+  --ca <file>                PEM root certificate; TLS is used when given
+  --server-name <name>       TLS target name override
+  --preset <name>            channel option preset, e.g. low-latency-interactive
+  --rpc <echo|stream|pingpong>
+                             operation per call (default echo)
+  --request-size <bytes>     request body size (default 64)
+  --response-size <bytes>    response body size; 0 echoes the request (default 0)
+  --stream-messages <n>      messages per StreamPayloads call (default 100)
+  --stream-rate <n>          messages per second per stream; 0 is unpaced (default 0)
+  --warmup <seconds>         unmeasured time before each scenario (default 2)
+  --duration <seconds>       measured time per scenario (default 10)
+  --json                     print results as JSON instead of a table
+)";
+
+std::string readFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot read " + path);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string target = "localhost:50051";
+  std::string caPath;
+  std::string serverName;
+  std::string preset;
+  bool printJson = false;
+  Workload::Config workloadConfig;
+  std::vector<Scenario> scenarios;
+  double warmupSeconds = 2;
+  double durationSeconds = 10;
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      const auto value = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::runtime_error(arg + " needs a value");
+        }
+        return argv[++i];
+      };
+
+      if (arg == "--help" || arg == "-h") {
+        std::cout << kUsage;
+        return 0;
+      } else if (arg == "--target") {
+        target = value();
+      } else if (arg == "--ca") {
+        caPath = value();
+      } else if (arg == "--server-name") {
+        serverName = value();
+      } else if (arg == "--preset") {
+        preset = value();
+      } else if (arg == "--rpc") {
+        workloadConfig.rpc = Workload::parseRpc(value());
+      } else if (arg == "--request-size") {
+        workloadConfig.requestSize = std::stoul(value());
+      } else if (arg == "--response-size") {
+        workloadConfig.responseSize = std::stoul(value());
+      } else if (arg == "--stream-messages") {
+        workloadConfig.streamMessages = std::stoi(value());
+      } else if (arg == "--stream-rate") {
+        workloadConfig.streamRate = std::stoi(value());
+      } else if (arg == "--warmup") {
+        warmupSeconds = std::stod(value());
+      } else if (arg == "--duration") {
+        durationSeconds = std::stod(value());
+      } else if (arg == "--json") {
+        printJson = true;
+      } else if (arg.rfind("--", 0) == 0) {
+        throw std::runtime_error("Unknown option " + arg);
+      } else {
+        scenarios.push_back(Scenario::parse(arg));
+      }
+    }
+    if (scenarios.empty()) {
+      throw std::runtime_error("No scenario given");
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n\n" << kUsage;
+    return 2;
+  }
+
+  try {
+    nlohmann::json credentials = {{"type", "insecure"}};
+    if (!caPath.empty()) {
+      credentials = {{"type", "ssl"}, {"rootCerts", readFile(caPath)}};
+      if (!serverName.empty()) {
+        credentials["targetNameOverride"] = serverName;
+      }
+    }
+    nlohmann::json options = nlohmann::json::object();
+    if (!preset.empty()) {
+      options["preset"] = preset;
+    }
+
+    auto client = std::make_shared<HybridGrpcClient>();
+    client->connect(target, credentials.dump(), options.dump());
+    const Workload workload(client, workloadConfig);
+    for (const auto& scenario : scenarios) {
+      if (scenario.mode == Scenario::Mode::OPEN && !workload.supportsOpenLoop()) {
+        throw std::runtime_error(Workload::rpcName(workloadConfig.rpc) + " only runs closed-loop");
+      }
+    }
+
+    std::vector<ScenarioResult> results;
+    for (auto scenario : scenarios) {
+      scenario.warmupSeconds = warmupSeconds;
+      scenario.durationSeconds = durationSeconds;
+      if (!printJson) {
+        std::cerr << "Running " << Workload::rpcName(workloadConfig.rpc) << " " << scenario.name() << "..."
+                  << std::endl;
+      }
+      results.push_back(runScenario(workload, scenario));
+    }
+    client->close();
+
+    std::cout << (printJson ? resultsJson(results) + "\n" : formatResults(results));
+  } catch (const std::exception& e) {
+    std::cerr << "rngrpc_loadgen: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
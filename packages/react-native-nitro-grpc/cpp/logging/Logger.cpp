@@ -0,0 +1,220 @@
+#include "Logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#elif defined(__APPLE__)
+#include <os/log.h>
+#endif
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr const char* kPlatformTag = "RNGrpc";
+
+int64_t epochMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void writeToPlatform(const Logger::Entry& entry) {
+#if defined(__ANDROID__)
+  int priority = ANDROID_LOG_INFO;
+  switch (entry.level) {
+    case LogLevel::VERBOSE:
+      priority = ANDROID_LOG_VERBOSE;
+      break;
+    case LogLevel::WARN:
+      priority = ANDROID_LOG_WARN;
+      break;
+    case LogLevel::ERROR:
+      priority = ANDROID_LOG_ERROR;
+      break;
+    default:
+      break;
+  }
+  __android_log_print(priority, kPlatformTag, "[%s] %s", entry.tag, entry.message.c_str());
+#elif defined(__APPLE__)
+  static os_log_t log = os_log_create("com.margelo.nitro.grpc", kPlatformTag);
+  os_log_type_t type = OS_LOG_TYPE_INFO;
+  switch (entry.level) {
+    case LogLevel::VERBOSE:
+      type = OS_LOG_TYPE_DEBUG;
+      break;
+    case LogLevel::WARN:
+      type = OS_LOG_TYPE_DEFAULT;
+      break;
+    case LogLevel::ERROR:
+      type = OS_LOG_TYPE_ERROR;
+      break;
+    default:
+      break;
+  }
+  os_log_with_type(log, type, "[%{public}s] %{public}s", entry.tag, entry.message.c_str());
+#else
+  std::fprintf(stderr,
+               "%s %s [%s] %s\n",
+               kPlatformTag,
+               Logger::levelName(entry.level),
+               entry.tag,
+               entry.message.c_str());
+#endif
+}
+
+} // namespace
+
+std::atomic<int> Logger::_level{static_cast<int>(LogLevel::INFO)};
+
+Logger& Logger::shared() {
+  // Never destroyed: the logger thread and late log calls outlive static destructors
+  static auto* instance = new Logger();
+  return *instance;
+}
+
+Logger::Logger() : _ring(kCapacity) {
+  std::thread([this]() { run(); }).detach();
+}
+
+Logger::Config Logger::parseConfig(const std::string& jsonStr) {
+  Config config;
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return config;
+  }
+
+  try {
+    auto j = json::parse(jsonStr);
+
+    if (j.contains("level")) {
+      const auto level = j["level"].get<std::string>();
+      if (level == "verbose") {
+        config.level = LogLevel::VERBOSE;
+      } else if (level == "info") {
+        config.level = LogLevel::INFO;
+      } else if (level == "warn") {
+        config.level = LogLevel::WARN;
+      } else if (level == "error") {
+        config.level = LogLevel::ERROR;
+      } else if (level == "off") {
+        config.level = LogLevel::OFF;
+      } else {
+        throw std::runtime_error("Unknown log level: " + level);
+      }
+    }
+    if (j.contains("platform")) {
+      config.platform = j["platform"].get<bool>();
+    }
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse logging config: " + std::string(e.what()));
+  }
+
+  return config;
+}
+
+const char* Logger::levelName(LogLevel level) {
+  switch (level) {
+    case LogLevel::VERBOSE:
+      return "verbose";
+    case LogLevel::INFO:
+      return "info";
+    case LogLevel::WARN:
+      return "warn";
+    case LogLevel::ERROR:
+      return "error";
+    default:
+      return "off";
+  }
+}
+
+void Logger::configure(const Config& config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _platform = config.platform;
+  _level.store(static_cast<int>(config.level), std::memory_order_relaxed);
+}
+
+void Logger::setHandler(Handler handler) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _handler = std::move(handler);
+}
+
+void Logger::log(LogLevel level, const char* tag, std::string message) {
+  Entry entry{level, tag, std::move(message), epochMs()};
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_size == kCapacity) {
+      // Full: overwrite the oldest entry
+      _ring[_head] = std::move(entry);
+      _head = (_head + 1) % kCapacity;
+      _dropped++;
+    } else {
+      _ring[(_head + _size) % kCapacity] = std::move(entry);
+      _size++;
+    }
+  }
+  _wake.notify_one();
+}
+
+void Logger::flush() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _drained.wait(lock, [this]() { return _size == 0 && !_writing; });
+}
+
+void Logger::run() {
+  std::vector<Entry> batch;
+  batch.reserve(kCapacity + 1);
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _wake.wait(lock, [this]() { return _size > 0; });
+
+    if (_dropped > 0) {
+      batch.push_back(
+          {LogLevel::WARN, "logger", "Dropped " + std::to_string(_dropped) + " log messages", epochMs()});
+      _dropped = 0;
+    }
+    for (; _size > 0; _size--) {
+      batch.push_back(std::move(_ring[_head]));
+      _head = (_head + 1) % kCapacity;
+    }
+    const bool platform = _platform;
+    const Handler handler = _handler;
+    _writing = true;
+
+    // Sinks may block (or call back into log()); never hold the lock for them
+    lock.unlock();
+    for (const auto& entry : batch) {
+      write(entry, platform, handler);
+    }
+    batch.clear();
+    lock.lock();
+
+    _writing = false;
+    if (_size == 0) {
+      _drained.notify_all();
+    }
+  }
+}
+
+void Logger::write(const Entry& entry, bool platform, const Handler& handler) {
+  if (platform) {
+    writeToPlatform(entry);
+  }
+  if (handler) {
+    try {
+      handler(entry);
+    } catch (const std::exception& e) {
+      if (platform) {
+        writeToPlatform({LogLevel::ERROR, "logger", std::string("Log handler threw: ") + e.what(), entry.timestampMs});
+      }
+    }
+  }
+}
+
+} // namespace margelo::nitro::grpc
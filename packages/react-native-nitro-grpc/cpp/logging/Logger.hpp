@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Lowest level compiled in: 0 verbose, 1 info, 2 warn, 3 error. Verbose
+ * logs are stripped from release (NDEBUG) builds unless overridden.
+ */
+#ifndef RNGRPC_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define RNGRPC_LOG_MIN_LEVEL 1
+#else
+#define RNGRPC_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+namespace margelo::nitro::grpc {
+
+// No DEBUG level: iOS debug builds define DEBUG as a macro
+enum class LogLevel : int { VERBOSE = 0, INFO = 1, WARN = 2, ERROR = 3, OFF = 4 };
+
+/**
+ * @brief Process-wide native logger.
+ *
+ * log() only copies the entry into a bounded ring buffer; a background
+ * thread hands entries to the platform log (logcat on Android, os_log on
+ * Apple platforms, stderr elsewhere) and to an optional handler, e.g. a JS
+ * callback. When the ring is full the oldest entries are dropped, and the
+ * number dropped is logged once there is room again.
+ *
+ * Use the RNGRPC_LOG_* macros: the message is only built if its level is
+ * enabled, and RNGRPC_LOG_VERBOSE compiles to nothing in release builds.
+ *
+ * Thread-safe.
+ */
+class Logger {
+public:
+  static constexpr size_t kCapacity = 512;
+
+  struct Entry {
+    LogLevel level = LogLevel::INFO;
+    const char* tag = ""; // A string literal
+    std::string message;
+    int64_t timestampMs = 0; // Unix epoch
+  };
+
+  using Handler = std::function<void(const Entry& entry)>;
+
+  struct Config {
+    LogLevel level = LogLevel::INFO;
+    bool platform = true; // Write to logcat / os_log / stderr
+  };
+
+  static Logger& shared();
+
+  static bool enabled(LogLevel level) {
+    return static_cast<int>(level) >= _level.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Parse the logging configuration from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "level"?: "verbose" | "info" | "warn" | "error" | "off",
+   *   "platform"?: boolean
+   * }
+   *
+   * @throws std::runtime_error if the JSON is malformed or the level unknown
+   */
+  static Config parseConfig(const std::string& json);
+
+  static const char* levelName(LogLevel level);
+
+  void configure(const Config& config);
+
+  /**
+   * Receive every entry on the logger thread. An empty handler removes it.
+   */
+  void setHandler(Handler handler);
+
+  /**
+   * Queue an entry. Prefer the macros, which skip disabled levels.
+   */
+  void log(LogLevel level, const char* tag, std::string message);
+
+  /**
+   * Block until every queued entry was handed to the sinks.
+   */
+  void flush();
+
+private:
+  Logger();
+
+  void run();
+  void write(const Entry& entry, bool platform, const Handler& handler);
+
+  static std::atomic<int> _level;
+
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _drained;
+  std::vector<Entry> _ring; // Guarded by _mutex, like the fields below
+  size_t _head = 0;
+  size_t _size = 0;
+  size_t _dropped = 0;
+  bool _writing = false;
+  bool _platform = true;
+  Handler _handler;
+};
+
+} // namespace margelo::nitro::grpc
+
+#define RNGRPC_LOG(level, tag, message)                                                                               \
+  do {                                                                                                                 \
+    if (::margelo::nitro::grpc::Logger::enabled(level)) {                                                              \
+      ::margelo::nitro::grpc::Logger::shared().log(level, tag, message);                                               \
+    }                                                                                                                  \
+  } while (0)
+
+#if RNGRPC_LOG_MIN_LEVEL <= 0
+#define RNGRPC_LOG_VERBOSE(tag, message) RNGRPC_LOG(::margelo::nitro::grpc::LogLevel::VERBOSE, tag, message)
+#else
+#define RNGRPC_LOG_VERBOSE(tag, message)                                                                               \
+  do {                                                                                                                 \
+  } while (0)
+#endif
+
+#if RNGRPC_LOG_MIN_LEVEL <= 1
+#define RNGRPC_LOG_INFO(tag, message) RNGRPC_LOG(::margelo::nitro::grpc::LogLevel::INFO, tag, message)
+#else
+#define RNGRPC_LOG_INFO(tag, message)                                                                                  \
+  do {                                                                                                                 \
+  } while (0)
+#endif
+
+#if RNGRPC_LOG_MIN_LEVEL <= 2
+#define RNGRPC_LOG_WARN(tag, message) RNGRPC_LOG(::margelo::nitro::grpc::LogLevel::WARN, tag, message)
+#else
+#define RNGRPC_LOG_WARN(tag, message)                                                                                  \
+  do {                                                                                                                 \
+  } while (0)
+#endif
+
+#define RNGRPC_LOG_ERROR(tag, message) RNGRPC_LOG(::margelo::nitro::grpc::LogLevel::ERROR, tag, message)
@@ -0,0 +1,38 @@
+#include "HybridCallMetadata.hpp"
+
+#include "MetadataConverter.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace margelo::nitro::grpc {
+
+const std::multimap<::grpc::string_ref, ::grpc::string_ref>& HybridCallMetadata::entries() const {
+  return _kind == Kind::INITIAL ? _context->GetServerInitialMetadata() : _context->GetServerTrailingMetadata();
+}
+
+double HybridCallMetadata::getSize() {
+  return static_cast<double>(entries().size());
+}
+
+std::vector<std::string> HybridCallMetadata::get(const std::string& key) {
+  // gRPC delivers keys lowercased
+  std::string normalized = key;
+  std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+
+  std::vector<std::string> values;
+  auto [begin, end] = entries().equal_range(::grpc::string_ref(normalized));
+  for (auto it = begin; it != end; ++it) {
+    values.push_back(MetadataConverter::valueToString(it->first, it->second));
+  }
+  return values;
+}
+
+std::string HybridCallMetadata::toJson() {
+  return _kind == Kind::INITIAL ? MetadataConverter::serializeInitialMetadata(entries())
+                                : MetadataConverter::serializeTrailingMetadata(entries());
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "HybridCallMetadataSpec.hpp"
+
+#include <grpcpp/grpcpp.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Initial or trailing metadata of a call, read from the ClientContext
+ * only when JS asks for it.
+ *
+ * Keeps the context alive instead of copying the headers. Must only be
+ * created once the corresponding metadata has been received: after the
+ * initial metadata (or first message) arrived, or after Finish for trailers.
+ */
+class HybridCallMetadata : public HybridCallMetadataSpec {
+public:
+  enum class Kind { INITIAL, TRAILING };
+
+  HybridCallMetadata(std::shared_ptr<const ::grpc::ClientContext> context, Kind kind)
+      : HybridObject(TAG), _context(std::move(context)), _kind(kind) {}
+
+  double getSize() override;
+  std::vector<std::string> get(const std::string& key) override;
+  std::string toJson() override;
+
+private:
+  const std::multimap<::grpc::string_ref, ::grpc::string_ref>& entries() const;
+
+  std::shared_ptr<const ::grpc::ClientContext> _context;
+  Kind _kind;
+};
+
+} // namespace margelo::nitro::grpc
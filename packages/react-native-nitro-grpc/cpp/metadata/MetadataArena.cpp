@@ -0,0 +1,242 @@
+#include "MetadataArena.hpp"
+
+#include "MetadataConverter.hpp"
+
+#include <cstddef>
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+/**
+ * Minimal cursor over the metadata JSON. Decoded strings are appended to the
+ * arena's text buffer; any syntax it does not expect makes parsing fail.
+ */
+class Cursor {
+public:
+  Cursor(const std::string& json, std::string& text)
+      : _pos(json.data()), _end(json.data() + json.size()), _text(text) {}
+
+  void skipWhitespace() {
+    while (_pos < _end && (*_pos == ' ' || *_pos == '\t' || *_pos == '\n' || *_pos == '\r')) {
+      _pos++;
+    }
+  }
+
+  bool consume(char c) {
+    skipWhitespace();
+    if (_pos < _end && *_pos == c) {
+      _pos++;
+      return true;
+    }
+    return false;
+  }
+
+  bool peek(char c) {
+    skipWhitespace();
+    return _pos < _end && *_pos == c;
+  }
+
+  bool atEnd() {
+    skipWhitespace();
+    return _pos == _end;
+  }
+
+  /**
+   * Decode a JSON string into the text buffer.
+   */
+  bool readString(uint32_t& offset, uint32_t& length) {
+    if (!consume('"')) {
+      return false;
+    }
+    const size_t start = _text.size();
+    while (_pos < _end) {
+      const char c = *_pos++;
+      if (c == '"') {
+        offset = static_cast<uint32_t>(start);
+        length = static_cast<uint32_t>(_text.size() - start);
+        return true;
+      }
+      if (c != '\\') {
+        _text.push_back(c);
+        continue;
+      }
+      if (_pos >= _end) {
+        return false;
+      }
+      switch (*_pos++) {
+        case '"':
+          _text.push_back('"');
+          break;
+        case '\\':
+          _text.push_back('\\');
+          break;
+        case '/':
+          _text.push_back('/');
+          break;
+        case 'b':
+          _text.push_back('\b');
+          break;
+        case 'f':
+          _text.push_back('\f');
+          break;
+        case 'n':
+          _text.push_back('\n');
+          break;
+        case 'r':
+          _text.push_back('\r');
+          break;
+        case 't':
+          _text.push_back('\t');
+          break;
+        case 'u':
+          if (!readUnicodeEscape()) {
+            return false;
+          }
+          break;
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+private:
+  bool readHex4(uint32_t& value) {
+    if (_end - _pos < 4) {
+      return false;
+    }
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+      const char c = *_pos++;
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        value |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        value |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool readUnicodeEscape() {
+    uint32_t codePoint;
+    if (!readHex4(codePoint)) {
+      return false;
+    }
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+      // High surrogate: must be followed by an escaped low surrogate
+      uint32_t low;
+      if (_end - _pos < 2 || _pos[0] != '\\' || _pos[1] != 'u') {
+        return false;
+      }
+      _pos += 2;
+      if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF) {
+        return false;
+      }
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+      return false;
+    }
+
+    if (codePoint < 0x80) {
+      _text.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+      _text.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+      _text.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+      _text.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      _text.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      _text.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+      _text.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      _text.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      _text.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      _text.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    return true;
+  }
+
+  const char* _pos;
+  const char* _end;
+  std::string& _text;
+};
+
+} // namespace
+
+void MetadataArena::apply(const std::string& metadataJson, ::grpc::ClientContext& context) {
+  if (metadataJson.empty() || metadataJson == "{}") {
+    return;
+  }
+
+  if (!parse(metadataJson)) {
+    // Unusual or malformed JSON: the general parser accepts or reports it
+    clear();
+    MetadataConverter::applyMetadata(metadataJson, context);
+    return;
+  }
+
+  for (const Entry& entry : _entries) {
+    _key.assign(_text, entry.keyOffset, entry.keyLength);
+    _value.assign(_text, entry.valueOffset, entry.valueLength);
+    context.AddMetadata(_key, _value);
+  }
+  clear();
+}
+
+void MetadataArena::clear() {
+  _text.clear();
+  _entries.clear();
+}
+
+bool MetadataArena::parse(const std::string& json) {
+  clear();
+  Cursor cursor(json, _text);
+  if (!cursor.consume('{')) {
+    return false;
+  }
+  if (cursor.consume('}')) {
+    return cursor.atEnd();
+  }
+
+  while (true) {
+    Entry entry{};
+    if (!cursor.readString(entry.keyOffset, entry.keyLength) || !cursor.consume(':')) {
+      return false;
+    }
+
+    if (cursor.peek('"')) {
+      if (!cursor.readString(entry.valueOffset, entry.valueLength)) {
+        return false;
+      }
+      _entries.push_back(entry);
+    } else if (cursor.consume('[')) {
+      if (!cursor.consume(']')) {
+        do {
+          if (!cursor.readString(entry.valueOffset, entry.valueLength)) {
+            return false;
+          }
+          _entries.push_back(entry);
+        } while (cursor.consume(','));
+        if (!cursor.consume(']')) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+
+    if (cursor.consume('}')) {
+      return cursor.atEnd();
+    }
+    if (!cursor.consume(',')) {
+      return false;
+    }
+  }
+}
+
+} // namespace margelo::nitro::grpc
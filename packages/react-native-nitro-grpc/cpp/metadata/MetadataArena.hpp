@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <grpcpp/grpcpp.h>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Reusable scratch space for applying request metadata.
+ *
+ * Parses the `{"key": ["value", ...]}` JSON sent by TypeScript into a single
+ * text buffer plus offsets, then adds the pairs to a ClientContext. All
+ * buffers keep their capacity across calls, so an arena owned by a pooled
+ * call record applies metadata without allocating (the ClientContext still
+ * copies each pair into its own storage).
+ *
+ * JSON outside that shape falls back to MetadataConverter::applyMetadata.
+ */
+class MetadataArena {
+public:
+  /**
+   * Add the metadata in `metadataJson` to `context`.
+   *
+   * @throws std::runtime_error if the JSON is malformed
+   */
+  void apply(const std::string& metadataJson, ::grpc::ClientContext& context);
+
+  /**
+   * Forget parsed metadata, keeping the buffers.
+   */
+  void clear();
+
+private:
+  struct Entry {
+    uint32_t keyOffset;
+    uint32_t keyLength;
+    uint32_t valueOffset;
+    uint32_t valueLength;
+  };
+
+  /**
+   * @return false if the JSON is not in the expected shape
+   */
+  bool parse(const std::string& json);
+
+  std::string _text;
+  std::vector<Entry> _entries;
+  std::string _key;
+  std::string _value;
+};
+
+} // namespace margelo::nitro::grpc
@@ -1,8 +1,10 @@
 #include "MetadataConverter.hpp"
 
+#include "../utils/base64/Base64Simd.hpp"
 #include "../utils/json/JsonParser.hpp"
 
 #include <stdexcept>
+#include <string_view>
 
 namespace margelo::nitro::grpc {
 namespace MetadataConverter {
@@ -29,6 +31,18 @@ void applyMetadata(const std::string& metadataJson, ::grpc::ClientContext& conte
   }
 }
 
+std::string valueToString(::grpc::string_ref key, ::grpc::string_ref value) {
+  constexpr std::string_view kBinarySuffix = "-bin";
+  const std::string_view keyView(key.data(), key.size());
+  if (keyView.size() < kBinarySuffix.size() || keyView.substr(keyView.size() - kBinarySuffix.size()) != kBinarySuffix) {
+    return std::string(value.data(), value.size());
+  }
+  // gRPC hands binary values over decoded; GrpcMetadata.fromJSON expects base64
+  std::string encoded(Base64Simd::encodedLength(value.size(), false), '\0');
+  Base64Simd::encode(reinterpret_cast<const uint8_t*>(value.data()), value.size(), encoded.data(), false);
+  return encoded;
+}
+
 std::string serializeInitialMetadata(const std::multimap<::grpc::string_ref, ::grpc::string_ref>& metadata) {
   json j = json::object();
 
@@ -36,8 +50,7 @@ std::string serializeInitialMetadata(const std::multimap<::grpc::string_ref, ::g
   std::map<std::string, std::vector<std::string>> grouped;
   for (const auto& [key, value] : metadata) {
     std::string keyStr(key.data(), key.size());
-    std::string valueStr(value.data(), value.size());
-    grouped[keyStr].push_back(valueStr);
+    grouped[keyStr].push_back(valueToString(key, value));
   }
 
   // Convert to JSON
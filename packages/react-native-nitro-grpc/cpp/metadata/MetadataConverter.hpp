@@ -24,6 +24,15 @@ namespace MetadataConverter {
  */
 void applyMetadata(const std::string& metadataJson, ::grpc::ClientContext& context);
 
+/**
+ * A received metadata value as JS expects it: values of "-bin" keys are
+ * base64-encoded, everything else is passed through.
+ *
+ * @param key Metadata key (lowercase, as received)
+ * @param value Raw value
+ */
+std::string valueToString(::grpc::string_ref key, ::grpc::string_ref value);
+
 /**
  * Serialize grpc metadata headers to JSON string.
  *
@@ -0,0 +1,227 @@
+#include "ChannelMetrics.hpp"
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+uint64_t readCounter(std::atomic<uint64_t>& counter, bool reset) {
+  return reset ? counter.exchange(0, std::memory_order_relaxed) : counter.load(std::memory_order_relaxed);
+}
+
+json toJson(const MethodMetrics::Snapshot& s) {
+  uint64_t failed = 0;
+  json failuresByCode = json::object();
+  for (size_t code = 1; code < MethodMetrics::kStatusCodes; code++) {
+    if (s.callsFailed[code] != 0) {
+      failed += s.callsFailed[code];
+      failuresByCode[std::to_string(code)] = s.callsFailed[code];
+    }
+  }
+  return {
+      {"callsStarted", s.callsStarted},
+      {"callsSucceeded", s.callsSucceeded},
+      {"callsFailed", failed},
+      {"failuresByCode", std::move(failuresByCode)},
+      {"activeCalls", s.activeCalls},
+      {"activeStreams", s.activeStreams},
+      {"messagesSent", s.messagesSent},
+      {"messagesReceived", s.messagesReceived},
+      {"bytesSent", s.bytesSent},
+      {"bytesReceived", s.bytesReceived},
+  };
+}
+
+json summaryJson(const WindowedHistogram& histogram, const std::vector<double>& percentiles, double scale) {
+  const auto summary = histogram.summarize(percentiles, MethodMetrics::nowNs() / 1'000'000);
+  json values = json::array();
+  for (int64_t value : summary.percentiles) {
+    values.push_back(static_cast<double>(value) * scale);
+  }
+  return {
+      {"count", summary.count},
+      {"max", static_cast<double>(summary.max) * scale},
+      {"values", std::move(values)},
+  };
+}
+
+json emptySummaryJson(const std::vector<double>& percentiles) {
+  return {
+      {"count", 0},
+      {"max", 0},
+      {"values", std::vector<double>(percentiles.size(), 0)},
+  };
+}
+
+} // namespace
+
+MethodMetrics::MethodMetrics(int64_t histogramWindowMs) : _histogramWindowMs(histogramWindowMs) {}
+
+MethodMetrics::~MethodMetrics() {
+  delete _histograms.load(std::memory_order_acquire);
+}
+
+void MethodMetrics::callFinished(bool stream, ::grpc::StatusCode code, int64_t startedNs) {
+  const int64_t now = nowNs();
+  (stream ? _activeStreams : _activeCalls).fetch_sub(1, std::memory_order_relaxed);
+  const auto index = static_cast<size_t>(code);
+  if (index == 0) {
+    _callsSucceeded.fetch_add(1, std::memory_order_relaxed);
+  } else if (index < kStatusCodes) {
+    _callsFailed[index].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _callsFailed[::grpc::StatusCode::UNKNOWN].fetch_add(1, std::memory_order_relaxed);
+  }
+  histogramsForRecording().durationUs.record((now - startedNs) / 1000, now / 1'000'000);
+}
+
+void MethodMetrics::messageSent(size_t bytes) {
+  _messagesSent.fetch_add(1, std::memory_order_relaxed);
+  _bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+  histogramsForRecording().sentBytes.record(static_cast<int64_t>(bytes), nowNs() / 1'000'000);
+}
+
+void MethodMetrics::messageReceived(size_t bytes) {
+  _messagesReceived.fetch_add(1, std::memory_order_relaxed);
+  _bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+  histogramsForRecording().receivedBytes.record(static_cast<int64_t>(bytes), nowNs() / 1'000'000);
+}
+
+MethodMetrics::Histograms& MethodMetrics::histogramsForRecording() {
+  Histograms* histograms = _histograms.load(std::memory_order_acquire);
+  if (histograms != nullptr) {
+    return *histograms;
+  }
+  auto created = std::make_unique<Histograms>(_histogramWindowMs.load(std::memory_order_relaxed));
+  if (_histograms.compare_exchange_strong(histograms, created.get(), std::memory_order_acq_rel)) {
+    return *created.release();
+  }
+  return *histograms; // Another thread was first
+}
+
+void MethodMetrics::setHistogramWindow(int64_t windowMs) {
+  _histogramWindowMs.store(windowMs, std::memory_order_relaxed);
+  if (Histograms* histograms = _histograms.load(std::memory_order_acquire)) {
+    histograms->durationUs.setWindow(windowMs);
+    histograms->sentBytes.setWindow(windowMs);
+    histograms->receivedBytes.setWindow(windowMs);
+  }
+}
+
+void MethodMetrics::Snapshot::add(const Snapshot& other) {
+  callsStarted += other.callsStarted;
+  callsSucceeded += other.callsSucceeded;
+  for (size_t code = 0; code < kStatusCodes; code++) {
+    callsFailed[code] += other.callsFailed[code];
+  }
+  activeCalls += other.activeCalls;
+  activeStreams += other.activeStreams;
+  messagesSent += other.messagesSent;
+  messagesReceived += other.messagesReceived;
+  bytesSent += other.bytesSent;
+  bytesReceived += other.bytesReceived;
+}
+
+MethodMetrics::Snapshot MethodMetrics::snapshot(bool reset) {
+  Snapshot s;
+  s.callsStarted = readCounter(_callsStarted, reset);
+  s.callsSucceeded = readCounter(_callsSucceeded, reset);
+  for (size_t code = 0; code < kStatusCodes; code++) {
+    s.callsFailed[code] = readCounter(_callsFailed[code], reset);
+  }
+  s.activeCalls = _activeCalls.load(std::memory_order_relaxed);
+  s.activeStreams = _activeStreams.load(std::memory_order_relaxed);
+  s.messagesSent = readCounter(_messagesSent, reset);
+  s.messagesReceived = readCounter(_messagesReceived, reset);
+  s.bytesSent = readCounter(_bytesSent, reset);
+  s.bytesReceived = readCounter(_bytesReceived, reset);
+  return s;
+}
+
+std::shared_ptr<MethodMetrics> ChannelMetrics::forMethod(const std::string& path) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& metrics = _methods[path];
+  if (!metrics) {
+    metrics = std::make_shared<MethodMetrics>(_histogramWindowMs);
+  }
+  return metrics;
+}
+
+std::string ChannelMetrics::statsJson(bool reset) {
+  std::vector<std::pair<std::string, std::shared_ptr<MethodMetrics>>> methods;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    methods.assign(_methods.begin(), _methods.end());
+  }
+
+  MethodMetrics::Snapshot total;
+  json perMethod = json::object();
+  for (const auto& [path, metrics] : methods) {
+    const auto snapshot = metrics->snapshot(reset);
+    total.add(snapshot);
+    perMethod[path] = toJson(snapshot);
+  }
+
+  json j = toJson(total);
+  j["reconnects"] = reset ? _reconnects.exchange(0, std::memory_order_relaxed)
+                          : _reconnects.load(std::memory_order_relaxed);
+  j["methods"] = std::move(perMethod);
+  return j.dump();
+}
+
+int64_t ChannelMetrics::parseHistogramConfig(const std::string& jsonStr) {
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return kDefaultHistogramWindowMs;
+  }
+
+  try {
+    auto j = json::parse(jsonStr);
+    if (!j.contains("windowMs")) {
+      return kDefaultHistogramWindowMs;
+    }
+    const double windowMs = j["windowMs"].get<double>();
+    if (!(windowMs >= 1)) {
+      throw std::runtime_error("windowMs must be at least 1");
+    }
+    return static_cast<int64_t>(windowMs);
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse histogram config: " + std::string(e.what()));
+  }
+}
+
+void ChannelMetrics::setHistogramWindow(int64_t windowMs) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _histogramWindowMs = windowMs;
+  for (auto& [path, metrics] : _methods) {
+    metrics->setHistogramWindow(windowMs);
+  }
+}
+
+const MethodMetrics::Histograms* ChannelMetrics::histogramsFor(const std::string& path) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _methods.find(path);
+  // Method metrics are never removed, so the pointer stays valid
+  return it == _methods.end() ? nullptr : it->second->histograms();
+}
+
+std::string ChannelMetrics::latencyJson(const std::string& path, const std::vector<double>& percentiles) {
+  const auto* histograms = histogramsFor(path);
+  json j = histograms ? summaryJson(histograms->durationUs, percentiles, 1e-3) : emptySummaryJson(percentiles);
+  return j.dump();
+}
+
+std::string ChannelMetrics::messageSizesJson(const std::string& path, const std::vector<double>& percentiles) {
+  const auto* histograms = histogramsFor(path);
+  json j = {
+      {"sent", histograms ? summaryJson(histograms->sentBytes, percentiles, 1) : emptySummaryJson(percentiles)},
+      {"received", histograms ? summaryJson(histograms->receivedBytes, percentiles, 1) : emptySummaryJson(percentiles)},
+  };
+  return j.dump();
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "WindowedHistogram.hpp"
+
+#include <grpcpp/grpcpp.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Counters, gauges and histograms of one method's calls on one channel.
+ *
+ * Updated from the JS thread, call workers and stream reader threads with
+ * relaxed atomics: no locks on the call path. A snapshot read while calls
+ * are running may mix counts from slightly different moments.
+ *
+ * Call durations and message sizes also go into windowed histograms, which
+ * are allocated on the first recorded value (about 40 KB per method).
+ */
+class MethodMetrics {
+public:
+  static constexpr size_t kStatusCodes = 17;
+
+  explicit MethodMetrics(int64_t histogramWindowMs);
+  ~MethodMetrics();
+
+  MethodMetrics(const MethodMetrics&) = delete;
+  MethodMetrics& operator=(const MethodMetrics&) = delete;
+
+  /**
+   * A unary RPC or a stream started.
+   *
+   * @returns The start time, to pass to callFinished()
+   */
+  int64_t callStarted(bool stream) {
+    _callsStarted.fetch_add(1, std::memory_order_relaxed);
+    (stream ? _activeStreams : _activeCalls).fetch_add(1, std::memory_order_relaxed);
+    return nowNs();
+  }
+
+  void callFinished(bool stream, ::grpc::StatusCode code, int64_t startedNs);
+
+  void messageSent(size_t bytes);
+  void messageReceived(size_t bytes);
+
+  // Call durations in microseconds and message sizes in bytes
+  struct Histograms {
+    explicit Histograms(int64_t windowMs) : durationUs(windowMs), sentBytes(windowMs), receivedBytes(windowMs) {}
+
+    WindowedHistogram durationUs;
+    WindowedHistogram sentBytes;
+    WindowedHistogram receivedBytes;
+  };
+
+  /**
+   * The histograms, or null if nothing was recorded yet.
+   */
+  const Histograms* histograms() const {
+    return _histograms.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Change the histogram window. Drops the recorded values.
+   */
+  void setHistogramWindow(int64_t windowMs);
+
+  static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  struct Snapshot {
+    uint64_t callsStarted = 0;
+    uint64_t callsSucceeded = 0;
+    std::array<uint64_t, kStatusCodes> callsFailed{}; // By status code; [0] is unused
+    int64_t activeCalls = 0;
+    int64_t activeStreams = 0;
+    uint64_t messagesSent = 0;
+    uint64_t messagesReceived = 0;
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+
+    void add(const Snapshot& other);
+  };
+
+  /**
+   * Read all values. With `reset`, counters restart from 0; gauges (active
+   * calls and streams) are kept.
+   */
+  Snapshot snapshot(bool reset);
+
+private:
+  std::atomic<uint64_t> _callsStarted{0};
+  std::atomic<uint64_t> _callsSucceeded{0};
+  std::array<std::atomic<uint64_t>, kStatusCodes> _callsFailed{};
+  std::atomic<int64_t> _activeCalls{0};
+  std::atomic<int64_t> _activeStreams{0};
+  std::atomic<uint64_t> _messagesSent{0};
+  std::atomic<uint64_t> _messagesReceived{0};
+  std::atomic<uint64_t> _bytesSent{0};
+  std::atomic<uint64_t> _bytesReceived{0};
+
+  // Allocate the histograms on first use
+  Histograms& histogramsForRecording();
+
+  std::atomic<int64_t> _histogramWindowMs;
+  std::atomic<Histograms*> _histograms{nullptr};
+};
+
+/**
+ * @brief Per-method metrics of one channel, plus channel-wide reconnects.
+ *
+ * Calls look up their method's metrics once when they start (registered
+ * method handles cache the lookup) and then only touch atomics. Calls served
+ * from the response cache or joined to an in-flight call make no RPC and are
+ * not counted here.
+ *
+ * Thread-safe.
+ */
+class ChannelMetrics {
+public:
+  static constexpr int64_t kDefaultHistogramWindowMs = 5 * 60 * 1000;
+
+  /**
+   * Parse the histogram configuration from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "windowMs"?: number   // > 0; defaults to kDefaultHistogramWindowMs
+   * }
+   *
+   * @returns The window length in milliseconds
+   * @throws std::runtime_error if the JSON is malformed or the window invalid
+   */
+  static int64_t parseHistogramConfig(const std::string& json);
+
+  /**
+   * The metrics of `path`, created on first use. Never null.
+   */
+  std::shared_ptr<MethodMetrics> forMethod(const std::string& path);
+
+  // The channel reconnected after having been connected before
+  void reconnected() {
+    _reconnects.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Channel totals and per-method values as a JSON object for the JS bridge:
+   * {
+   *   "callsStarted", "callsSucceeded", "callsFailed", "failuresByCode": {code: count},
+   *   "activeCalls", "activeStreams", "messagesSent", "messagesReceived",
+   *   "bytesSent", "bytesReceived", "reconnects",
+   *   "methods": {path: {the same without "reconnects"}}
+   * }
+   *
+   * @param reset Restart counters from 0 after reading them
+   */
+  std::string statsJson(bool reset);
+
+  /**
+   * Set the time span the histograms cover, for all methods. Drops the
+   * recorded values.
+   */
+  void setHistogramWindow(int64_t windowMs);
+
+  /**
+   * Call durations of `path` within the histogram window, in milliseconds,
+   * as a JSON object: {"count", "max", "values": [one per entry of `percentiles`]}
+   * All zero if the method has no recorded calls.
+   *
+   * @param percentiles Percentiles between 0 and 100
+   */
+  std::string latencyJson(const std::string& path, const std::vector<double>& percentiles);
+
+  /**
+   * Message sizes of `path` within the histogram window as a JSON object:
+   * {"sent": {"count", "max", "values"}, "received": {...}}
+   */
+  std::string messageSizesJson(const std::string& path, const std::vector<double>& percentiles);
+
+private:
+  // The method's histograms, or null if it has none yet
+  const MethodMetrics::Histograms* histogramsFor(const std::string& path);
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<MethodMetrics>> _methods;
+  std::atomic<uint64_t> _reconnects{0};
+  int64_t _histogramWindowMs = kDefaultHistogramWindowMs; // Guarded by _mutex
+};
+
+} // namespace margelo::nitro::grpc
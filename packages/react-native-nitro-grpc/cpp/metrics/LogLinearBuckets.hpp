@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Bucket layout of an HdrHistogram-style histogram.
+ *
+ * Values fall into power-of-two buckets, each split into
+ * 2^SubBucketHalfBits linear sub-buckets, so every value is kept to within
+ * 1 / 2^SubBucketHalfBits of its magnitude. Bucket 0 covers
+ * [0, 2^(SubBucketHalfBits + 1)) at unit resolution; bucket N covers
+ * [2^(SubBucketHalfBits + N), 2^(SubBucketHalfBits + N + 1)) in steps of 2^N.
+ * Values of 2^MaxValueBits and above are clamped into the last bucket.
+ *
+ * Only the index math lives here; histograms own their count storage.
+ */
+template <int SubBucketHalfBits, int MaxValueBits> struct LogLinearBuckets {
+  static_assert(SubBucketHalfBits > 0 && MaxValueBits > SubBucketHalfBits && MaxValueBits < 63);
+
+  static constexpr int64_t kSubBucketHalfCount = int64_t{1} << SubBucketHalfBits;
+  static constexpr int64_t kSubBucketMask = (kSubBucketHalfCount << 1) - 1;
+  static constexpr int64_t kMaxValue = (int64_t{1} << MaxValueBits) - 1;
+  // Number of counters a histogram with this layout needs
+  static constexpr size_t kCount = static_cast<size_t>(MaxValueBits - SubBucketHalfBits + 1) * kSubBucketHalfCount;
+
+  static int64_t clamp(int64_t value) {
+    return std::clamp<int64_t>(value, 0, kMaxValue);
+  }
+
+  /**
+   * Counter index of a value in [0, kMaxValue].
+   */
+  static size_t indexFor(int64_t value) {
+    const auto v = static_cast<uint64_t>(value);
+    const int bucket = (63 - std::countl_zero(v | static_cast<uint64_t>(kSubBucketMask))) - SubBucketHalfBits;
+    const auto subBucket = static_cast<int64_t>(v >> bucket);
+    return static_cast<size_t>(((bucket + 1) << SubBucketHalfBits) + (subBucket - kSubBucketHalfCount));
+  }
+
+  /**
+   * The largest value that maps to `index`.
+   */
+  static int64_t highestValueAt(size_t index) {
+    int bucket = static_cast<int>(index >> SubBucketHalfBits) - 1;
+    int64_t subBucket = static_cast<int64_t>(index & (kSubBucketHalfCount - 1)) + kSubBucketHalfCount;
+    if (bucket < 0) {
+      subBucket -= kSubBucketHalfCount;
+      bucket = 0;
+    }
+    return (subBucket << bucket) + (int64_t{1} << bucket) - 1;
+  }
+
+  /**
+   * The smallest value that at least `percentile` percent of the `total`
+   * values in `counts` are equal to or below, at bucket resolution and never
+   * above `max`. 0 if `total` is 0.
+   *
+   * @param counts kCount counters, indexable with operator[]
+   */
+  template <typename Counts>
+  static int64_t percentile(const Counts& counts, uint64_t total, int64_t max, double percentile) {
+    if (total == 0) {
+      return 0;
+    }
+    const auto target =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kCount; i++) {
+      seen += counts[i];
+      if (seen >= target) {
+        return std::min(highestValueAt(i), max);
+      }
+    }
+    return max;
+  }
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,72 @@
+#include "WindowedHistogram.hpp"
+
+#include <algorithm>
+
+namespace margelo::nitro::grpc {
+
+WindowedHistogram::WindowedHistogram(int64_t windowMs) : _slotMs(std::max<int64_t>(1, windowMs / kSlots)) {}
+
+void WindowedHistogram::record(int64_t value, int64_t nowMs) {
+  const int64_t period = nowMs / _slotMs.load(std::memory_order_relaxed);
+  Slot& slot = _slots[static_cast<size_t>(period) % kSlots];
+  rotate(slot, period);
+
+  value = Buckets::clamp(value);
+  slot.counts[Buckets::indexFor(value)].fetch_add(1, std::memory_order_relaxed);
+  int64_t max = slot.max.load(std::memory_order_relaxed);
+  while (value > max && !slot.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+void WindowedHistogram::rotate(Slot& slot, int64_t period) {
+  int64_t current = slot.period.load(std::memory_order_acquire);
+  while (current < period) {
+    if (slot.period.compare_exchange_weak(current, period, std::memory_order_acq_rel)) {
+      // Only the thread that moved the slot forward clears it
+      clear(slot);
+      return;
+    }
+  }
+}
+
+void WindowedHistogram::clear(Slot& slot) {
+  for (auto& count : slot.counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  slot.max.store(0, std::memory_order_relaxed);
+}
+
+WindowedHistogram::Summary WindowedHistogram::summarize(const std::vector<double>& percentiles, int64_t nowMs) const {
+  const int64_t period = nowMs / _slotMs.load(std::memory_order_relaxed);
+
+  std::vector<uint64_t> counts(Buckets::kCount, 0);
+  Summary summary;
+  for (const auto& slot : _slots) {
+    const int64_t slotPeriod = slot.period.load(std::memory_order_acquire);
+    if (slotPeriod < 0 || slotPeriod > period || slotPeriod <= period - static_cast<int64_t>(kSlots)) {
+      continue; // Empty, or outside the window
+    }
+    for (size_t i = 0; i < Buckets::kCount; i++) {
+      const uint32_t count = slot.counts[i].load(std::memory_order_relaxed);
+      counts[i] += count;
+      summary.count += count;
+    }
+    summary.max = std::max(summary.max, slot.max.load(std::memory_order_relaxed));
+  }
+
+  summary.percentiles.reserve(percentiles.size());
+  for (double percentile : percentiles) {
+    summary.percentiles.push_back(Buckets::percentile(counts, summary.count, summary.max, percentile));
+  }
+  return summary;
+}
+
+void WindowedHistogram::setWindow(int64_t windowMs) {
+  _slotMs.store(std::max<int64_t>(1, windowMs / kSlots), std::memory_order_relaxed);
+  for (auto& slot : _slots) {
+    slot.period.store(-1, std::memory_order_release);
+    clear(slot);
+  }
+}
+
+} // namespace margelo::nitro::grpc
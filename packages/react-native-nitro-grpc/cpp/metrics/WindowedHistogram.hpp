@@ -0,0 +1,73 @@
+#pragma once
+
+#include "LogLinearBuckets.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Lock-free log-linear histogram of the recent past.
+ *
+ * Values are kept to within about 3% of their magnitude (32 sub-buckets per
+ * power of two) up to 2^32; larger values are clamped. The window is split
+ * into kSlots slots by time. A value goes to the slot of the current time,
+ * and a slot is cleared when time comes round to it again, so a read covers
+ * between (kSlots - 1) / kSlots of the window and all of it.
+ *
+ * Recording takes a few relaxed atomic operations and never blocks. A value
+ * recorded at the instant its slot rotates may be lost.
+ */
+class WindowedHistogram {
+public:
+  using Buckets = LogLinearBuckets<5, 32>;
+  static constexpr size_t kSlots = 4;
+
+  struct Summary {
+    uint64_t count = 0;
+    int64_t max = 0;
+    std::vector<int64_t> percentiles; // In the order requested
+  };
+
+  explicit WindowedHistogram(int64_t windowMs);
+
+  WindowedHistogram(const WindowedHistogram&) = delete;
+  WindowedHistogram& operator=(const WindowedHistogram&) = delete;
+
+  /**
+   * @param nowMs A monotonic time in milliseconds
+   */
+  void record(int64_t value, int64_t nowMs);
+
+  /**
+   * Count, maximum and the given percentiles (0-100) of the values recorded
+   * within the window ending at `nowMs`.
+   */
+  Summary summarize(const std::vector<double>& percentiles, int64_t nowMs) const;
+
+  /**
+   * Change the window length. Drops everything recorded so far.
+   */
+  void setWindow(int64_t windowMs);
+
+private:
+  struct Slot {
+    // Index of the time period the slot holds (nowMs / slot length); -1 while empty
+    std::atomic<int64_t> period{-1};
+    std::atomic<int64_t> max{0};
+    std::array<std::atomic<uint32_t>, Buckets::kCount> counts{};
+  };
+
+  // Clear `slot` if it still holds an older period; called before recording into it
+  static void rotate(Slot& slot, int64_t period);
+  static void clear(Slot& slot);
+
+  std::atomic<int64_t> _slotMs;
+  std::array<Slot, kSlots> _slots;
+};
+
+} // namespace margelo::nitro::grpc
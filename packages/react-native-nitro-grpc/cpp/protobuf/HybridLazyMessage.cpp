@@ -0,0 +1,131 @@
+#include "HybridLazyMessage.hpp"
+
+#include "ProtoCodec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+std::string HybridLazyMessage::getTypeName() {
+  return _plan.fullName;
+}
+
+double HybridLazyMessage::getByteLength() {
+  return static_cast<double>(_size);
+}
+
+bool HybridLazyMessage::has(const std::string& field) {
+  const FieldPlan& plan = fieldNamed(field);
+  return index().has(plan);
+}
+
+double HybridLazyMessage::count(const std::string& field) {
+  const FieldPlan& plan = fieldNamed(field);
+  return static_cast<double>(index().count(plan, data()));
+}
+
+std::shared_ptr<AnyMap> HybridLazyMessage::pick(const std::vector<std::string>& fields) {
+  const MessageIndex& messageIndex = index();
+  const uint8_t* bytes = data();
+  auto result = AnyMap::make();
+  auto& map = result->getMap();
+  for (const std::string& name : fields) {
+    const FieldPlan& field = fieldNamed(name);
+    if (messageIndex.has(field)) {
+      messageIndex.decode(field, bytes, map[field.name]);
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<AnyMap> HybridLazyMessage::slice(const std::string& field, double start, double end) {
+  const FieldPlan& plan = fieldNamed(field);
+  const MessageIndex& messageIndex = index();
+  const uint8_t* bytes = data();
+  const double total = static_cast<double>(messageIndex.count(plan, bytes));
+  const auto from = static_cast<size_t>(std::clamp(std::floor(start), 0.0, total));
+  const auto to = static_cast<size_t>(std::clamp(std::floor(end), 0.0, total));
+
+  auto result = AnyMap::make();
+  AnyArray values;
+  if (from < to) {
+    values.reserve(to - from);
+    messageIndex.decodeRange(plan, bytes, from, to, values);
+  }
+  result->getMap()[plan.name] = std::move(values);
+  return result;
+}
+
+std::optional<std::shared_ptr<HybridLazyMessageSpec>> HybridLazyMessage::getMessage(const std::string& field,
+                                                                                    double position) {
+  const FieldPlan& plan = fieldNamed(field);
+  if (plan.type != ProtoFieldType::MESSAGE || plan.map) {
+    throw std::runtime_error("Field " + _plan.fullName + "." + plan.name + " is not a message field");
+  }
+  const auto found = index().occurrences(plan);
+  const double available = static_cast<double>(plan.repeated ? found.size() : std::min<size_t>(found.size(), 1));
+  if (position < 0 || position >= available || position != std::floor(position)) {
+    return std::nullopt;
+  }
+  for (const MessageIndex::Occurrence& occurrence : found) {
+    if (occurrence.wireType != WireFormat::LEN) {
+      WireFormat::malformed("wire type mismatch");
+    }
+  }
+
+  const uint8_t* bytes = data();
+  if (plan.repeated || found.size() == 1) {
+    const auto [payload, size] = MessageIndex::payload(found[static_cast<size_t>(position)], bytes);
+    const auto offset = static_cast<size_t>(payload - _buffer->data());
+    return std::make_shared<HybridLazyMessage>(_schema, *plan.message, _buffer, offset, size);
+  }
+
+  // A singular message split over several occurrences is their merge, and
+  // concatenating encodings merges them, so view a concatenated copy
+  size_t total = 0;
+  for (const MessageIndex::Occurrence& occurrence : found) {
+    total += MessageIndex::payload(occurrence, bytes).second;
+  }
+  auto merged = ArrayBuffer::allocate(total);
+  size_t offset = 0;
+  for (const MessageIndex::Occurrence& occurrence : found) {
+    const auto [payload, size] = MessageIndex::payload(occurrence, bytes);
+    std::memcpy(merged->data() + offset, payload, size);
+    offset += size;
+  }
+  return std::make_shared<HybridLazyMessage>(_schema, *plan.message, merged, 0, total);
+}
+
+std::shared_ptr<AnyMap> HybridLazyMessage::decode() {
+  auto result = AnyMap::make();
+  ProtoCodec::decode(_plan, data(), _size, result->getMap());
+  return result;
+}
+
+const uint8_t* HybridLazyMessage::data() const {
+  const uint8_t* bytes = _buffer->data();
+  if (bytes == nullptr) {
+    throw std::runtime_error("LazyMessage: the underlying ArrayBuffer has been released");
+  }
+  return bytes + _offset;
+}
+
+const MessageIndex& HybridLazyMessage::index() {
+  if (!_index) {
+    _index.emplace(_plan, data(), _size);
+  }
+  return *_index;
+}
+
+const FieldPlan& HybridLazyMessage::fieldNamed(const std::string& name) const {
+  const FieldPlan* field = _plan.fieldNamed(name);
+  if (field == nullptr) {
+    throw std::runtime_error("Message type " + _plan.fullName + " has no field " + name);
+  }
+  return *field;
+}
+
+} // namespace margelo::nitro::grpc
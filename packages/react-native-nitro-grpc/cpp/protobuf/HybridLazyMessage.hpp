@@ -0,0 +1,67 @@
+#pragma once
+
+#include "HybridLazyMessageSpec.hpp"
+#include "MessageIndex.hpp"
+#include "ProtoSchema.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Read-only view of a serialized message that decodes fields on demand.
+ *
+ * Keeps a reference to the source ArrayBuffer instead of copying it. Field
+ * offsets are indexed on first access (see MessageIndex); nested messages
+ * are returned as views over the same buffer.
+ */
+class HybridLazyMessage : public HybridLazyMessageSpec {
+public:
+  /**
+   * @param schema Keeps `plan` alive for as long as the view exists
+   */
+  HybridLazyMessage(std::shared_ptr<const ProtoSchema> schema,
+                    const MessagePlan& plan,
+                    std::shared_ptr<ArrayBuffer> buffer,
+                    size_t offset,
+                    size_t size)
+      : HybridObject(TAG), _schema(std::move(schema)), _plan(plan), _buffer(std::move(buffer)), _offset(offset),
+        _size(size) {}
+
+  std::string getTypeName() override;
+  double getByteLength() override;
+  bool has(const std::string& field) override;
+  double count(const std::string& field) override;
+  std::shared_ptr<AnyMap> pick(const std::vector<std::string>& fields) override;
+  std::shared_ptr<AnyMap> slice(const std::string& field, double start, double end) override;
+  std::optional<std::shared_ptr<HybridLazyMessageSpec>> getMessage(const std::string& field, double position) override;
+  std::shared_ptr<AnyMap> decode() override;
+
+private:
+  /**
+   * @throws std::runtime_error if the buffer has been released
+   */
+  const uint8_t* data() const;
+
+  /**
+   * Builds the index on first use.
+   */
+  const MessageIndex& index();
+
+  /**
+   * @throws std::runtime_error if the message type has no such field
+   */
+  const FieldPlan& fieldNamed(const std::string& name) const;
+
+  std::shared_ptr<const ProtoSchema> _schema;
+  const MessagePlan& _plan;
+  std::shared_ptr<ArrayBuffer> _buffer;
+  size_t _offset;
+  size_t _size;
+  std::optional<MessageIndex> _index;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,68 @@
+#include "HybridProtobufCodec.hpp"
+
+#include "../utils/checksum/BufferRange.hpp"
+#include "HybridLazyMessage.hpp"
+#include "ProtoCodec.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+void HybridProtobufCodec::loadDescriptorSet(const std::shared_ptr<ArrayBuffer>& descriptorSet) {
+  if (!descriptorSet) {
+    throw std::runtime_error("loadDescriptorSet: buffer is null");
+  }
+  _schema->load(descriptorSet->data(), descriptorSet->size());
+}
+
+bool HybridProtobufCodec::hasMessageType(const std::string& typeName) {
+  return _schema->find(typeName) != nullptr;
+}
+
+std::shared_ptr<ArrayBuffer> HybridProtobufCodec::encode(const std::string& typeName,
+                                                         const std::shared_ptr<AnyMap>& message) {
+  const MessagePlan& plan = planFor(typeName);
+  auto* bytes = new std::vector<uint8_t>();
+  try {
+    ProtoCodec::encode(plan, message->getMap(), *bytes);
+  } catch (...) {
+    delete bytes;
+    throw;
+  }
+  // Hand the encoded bytes to JS without copying them
+  return ArrayBuffer::wrap(bytes->data(), bytes->size(), [bytes]() { delete bytes; });
+}
+
+std::shared_ptr<AnyMap> HybridProtobufCodec::decode(const std::string& typeName,
+                                                    const std::shared_ptr<ArrayBuffer>& data,
+                                                    double offset,
+                                                    double length) {
+  const MessagePlan& plan = planFor(typeName);
+  const auto range = BufferRange::of(data, offset, length, "decode");
+  auto message = AnyMap::make();
+  ProtoCodec::decode(plan, range.data, range.size, message->getMap());
+  return message;
+}
+
+std::shared_ptr<HybridLazyMessageSpec> HybridProtobufCodec::decodeLazy(const std::string& typeName,
+                                                                      const std::shared_ptr<ArrayBuffer>& data,
+                                                                      double offset,
+                                                                      double length) {
+  const MessagePlan& plan = planFor(typeName);
+  const auto range = BufferRange::of(data, offset, length, "decodeLazy");
+  if (range.data == nullptr) {
+    return std::make_shared<HybridLazyMessage>(_schema, plan, ArrayBuffer::allocate(0), 0, 0);
+  }
+  return std::make_shared<HybridLazyMessage>(_schema, plan, data, static_cast<size_t>(offset), range.size);
+}
+
+const MessagePlan& HybridProtobufCodec::planFor(const std::string& typeName) const {
+  const MessagePlan* plan = _schema->find(typeName);
+  if (plan == nullptr) {
+    throw std::runtime_error("Unknown message type: " + typeName);
+  }
+  return *plan;
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "HybridProtobufCodecSpec.hpp"
+#include "ProtoSchema.hpp"
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+class HybridProtobufCodec : public HybridProtobufCodecSpec {
+public:
+  HybridProtobufCodec() : HybridObject(TAG), _schema(std::make_shared<ProtoSchema>()) {}
+
+  void loadDescriptorSet(const std::shared_ptr<ArrayBuffer>& descriptorSet) override;
+  bool hasMessageType(const std::string& typeName) override;
+  std::shared_ptr<ArrayBuffer> encode(const std::string& typeName, const std::shared_ptr<AnyMap>& message) override;
+  std::shared_ptr<AnyMap>
+  decode(const std::string& typeName, const std::shared_ptr<ArrayBuffer>& data, double offset, double length) override;
+  std::shared_ptr<HybridLazyMessageSpec> decodeLazy(const std::string& typeName,
+                                                    const std::shared_ptr<ArrayBuffer>& data,
+                                                    double offset,
+                                                    double length) override;
+
+private:
+  /**
+   * @throws std::runtime_error if the type was not loaded
+   */
+  const MessagePlan& planFor(const std::string& typeName) const;
+
+  // Shared with lazy views, which may outlive the codec
+  std::shared_ptr<ProtoSchema> _schema;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,190 @@
+#include "MessageIndex.hpp"
+
+#include "ProtoCodec.hpp"
+#include "WireFormat.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+using WireFormat::Reader;
+
+namespace {
+
+struct Scanned {
+  uint32_t fieldIndex;
+  MessageIndex::Occurrence occurrence;
+};
+
+bool isPackedRun(const FieldPlan& field, uint32_t wireType) {
+  return field.repeated && !field.map && wireType == WireFormat::LEN && field.wireType != WireFormat::LEN;
+}
+
+Reader readerAt(const MessageIndex::Occurrence& occurrence, const uint8_t* data) {
+  return Reader(data + occurrence.offset, occurrence.size);
+}
+
+/**
+ * Skip one value of a packed run without decoding it.
+ */
+void skipElement(const FieldPlan& field, Reader& run) {
+  switch (field.wireType) {
+    case WireFormat::I32:
+      run.readFixed32();
+      return;
+    case WireFormat::I64:
+      run.readFixed64();
+      return;
+    default:
+      run.readVarint();
+      return;
+  }
+}
+
+} // namespace
+
+MessageIndex::MessageIndex(const MessagePlan& plan, const uint8_t* data, size_t size) : _plan(plan) {
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Message is too large to index");
+  }
+
+  std::vector<Scanned> scanned;
+  std::vector<uint32_t> perField(plan.fields.size() + 1, 0);
+  Reader reader(data, size);
+  while (!reader.atEnd()) {
+    const uint64_t tag = reader.readVarint();
+    const uint32_t number = static_cast<uint32_t>(tag >> 3);
+    const uint32_t wireType = static_cast<uint32_t>(tag & 7);
+    if (number == 0) {
+      WireFormat::malformed("field number 0");
+    }
+
+    const uint8_t* start = reader.position();
+    reader.skip(wireType, number);
+    const FieldPlan* field = plan.field(number);
+    if (field == nullptr || field->type == ProtoFieldType::GROUP) {
+      continue;
+    }
+    const auto fieldIndex = static_cast<uint32_t>(field - plan.fields.data());
+    const auto offset = static_cast<uint32_t>(start - data);
+    const auto length = static_cast<uint32_t>(reader.position() - start);
+    scanned.push_back({fieldIndex, {offset, length, wireType}});
+    perField[fieldIndex + 1]++;
+  }
+
+  // Counting sort by field, keeping wire order within each field
+  for (size_t i = 1; i < perField.size(); i++) {
+    perField[i] += perField[i - 1];
+  }
+  _firstOccurrence = perField;
+  _occurrences.resize(scanned.size());
+  for (const Scanned& entry : scanned) {
+    _occurrences[perField[entry.fieldIndex]++] = entry.occurrence;
+  }
+  _counts.assign(plan.fields.size(), -1);
+}
+
+size_t MessageIndex::elementsIn(const FieldPlan& field, const Occurrence& occurrence, const uint8_t* data) const {
+  if (!isPackedRun(field, occurrence.wireType)) {
+    return 1;
+  }
+  Reader outer = readerAt(occurrence, data);
+  Reader run = outer.readDelimited();
+  switch (field.wireType) {
+    case WireFormat::I32:
+      if (run.remaining() % 4 != 0) {
+        WireFormat::malformed("truncated fixed32");
+      }
+      return run.remaining() / 4;
+    case WireFormat::I64:
+      if (run.remaining() % 8 != 0) {
+        WireFormat::malformed("truncated fixed64");
+      }
+      return run.remaining() / 8;
+    default: {
+      // Every varint ends with exactly one byte below 0x80
+      size_t count = 0;
+      for (const uint8_t* byte = run.position(); byte < run.position() + run.remaining(); byte++) {
+        count += *byte < 0x80 ? 1 : 0;
+      }
+      return count;
+    }
+  }
+}
+
+size_t MessageIndex::count(const FieldPlan& field, const uint8_t* data) const {
+  int64_t& cached = _counts[indexOf(field)];
+  if (cached < 0) {
+    const auto found = occurrences(field);
+    if (!field.repeated) {
+      cached = found.empty() ? 0 : 1;
+    } else {
+      size_t total = 0;
+      for (const Occurrence& occurrence : found) {
+        total += elementsIn(field, occurrence, data);
+      }
+      cached = static_cast<int64_t>(total);
+    }
+  }
+  return static_cast<size_t>(cached);
+}
+
+void MessageIndex::decode(const FieldPlan& field, const uint8_t* data, AnyValue& slot) const {
+  for (const Occurrence& occurrence : occurrences(field)) {
+    Reader reader = readerAt(occurrence, data);
+    ProtoCodec::decodeField(field, occurrence.wireType, reader, slot);
+  }
+}
+
+void MessageIndex::decodeRange(const FieldPlan& field,
+                               const uint8_t* data,
+                               size_t start,
+                               size_t end,
+                               AnyArray& out) const {
+  if (!field.repeated || field.map) {
+    throw std::runtime_error("Field " + _plan.fullName + "." + field.name + " is not a repeated field");
+  }
+
+  size_t position = 0;
+  for (const Occurrence& occurrence : occurrences(field)) {
+    if (position >= end) {
+      break;
+    }
+    if (!isPackedRun(field, occurrence.wireType)) {
+      if (occurrence.wireType != field.wireType) {
+        WireFormat::malformed("wire type mismatch");
+      }
+      if (position >= start) {
+        Reader reader = readerAt(occurrence, data);
+        ProtoCodec::decodeElement(field, reader, out.emplace_back());
+      }
+      position++;
+      continue;
+    }
+
+    const size_t elements = elementsIn(field, occurrence, data);
+    if (position + elements <= start) {
+      position += elements;
+      continue;
+    }
+    const size_t runEnd = position + elements;
+    Reader outer = readerAt(occurrence, data);
+    Reader run = outer.readDelimited();
+    for (; position < start; position++) {
+      skipElement(field, run);
+    }
+    for (; position < end && position < runEnd; position++) {
+      ProtoCodec::decodeElement(field, run, out.emplace_back());
+    }
+    position = runEnd;
+  }
+}
+
+std::pair<const uint8_t*, size_t> MessageIndex::payload(const Occurrence& occurrence, const uint8_t* data) {
+  Reader outer = readerAt(occurrence, data);
+  Reader inner = outer.readDelimited();
+  return {inner.position(), inner.remaining()};
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ProtoSchema.hpp"
+
+#include <NitroModules/AnyMap.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Where each known field of a serialized message occurs.
+ *
+ * Built with a single scan that reads tags and skips values (varints and
+ * length prefixes only), so indexing costs a fraction of a full decode.
+ * Fields are then decoded individually on demand.
+ *
+ * The index stores offsets, not pointers: every accessor takes the message
+ * bytes again, so the owner can re-resolve its buffer between calls.
+ */
+class MessageIndex {
+public:
+  struct Occurrence {
+    uint32_t offset;   // Start of the value (at the length prefix for LEN values)
+    uint32_t size;     // Size of the value, including any length prefix
+    uint32_t wireType; // Wire type from the tag
+  };
+
+  /**
+   * @throws std::runtime_error if the bytes are not a valid message encoding
+   */
+  MessageIndex(const MessagePlan& plan, const uint8_t* data, size_t size);
+
+  const MessagePlan& plan() const {
+    return _plan;
+  }
+
+  /**
+   * Occurrences of `field` in wire order.
+   */
+  std::span<const Occurrence> occurrences(const FieldPlan& field) const {
+    const size_t index = indexOf(field);
+    return {_occurrences.data() + _firstOccurrence[index], _firstOccurrence[index + 1] - _firstOccurrence[index]};
+  }
+
+  bool has(const FieldPlan& field) const {
+    return !occurrences(field).empty();
+  }
+
+  /**
+   * Number of elements of a repeated field (values in packed runs counted
+   * individually), entries of a map field, or 0/1 for a singular field.
+   */
+  size_t count(const FieldPlan& field, const uint8_t* data) const;
+
+  /**
+   * Decode `field` into `slot` as a full decode would. Leaves `slot`
+   * untouched if the field is absent.
+   */
+  void decode(const FieldPlan& field, const uint8_t* data, AnyValue& slot) const;
+
+  /**
+   * Decode elements [start, end) of a repeated, non-map field into `out`,
+   * without decoding the elements before them.
+   */
+  void decodeRange(const FieldPlan& field, const uint8_t* data, size_t start, size_t end, AnyArray& out) const;
+
+  /**
+   * The payload of a length-delimited occurrence, without its length prefix.
+   */
+  static std::pair<const uint8_t*, size_t> payload(const Occurrence& occurrence, const uint8_t* data);
+
+private:
+  size_t indexOf(const FieldPlan& field) const {
+    return static_cast<size_t>(&field - _plan.fields.data());
+  }
+
+  size_t elementsIn(const FieldPlan& field, const Occurrence& occurrence, const uint8_t* data) const;
+
+  const MessagePlan& _plan;
+  std::vector<Occurrence> _occurrences;    // Grouped by field index, in wire order within a field
+  std::vector<uint32_t> _firstOccurrence; // Per field index, plus an end sentinel
+  mutable std::vector<int64_t> _counts;    // Cached count() results, -1 until computed
+};
+
+} // namespace margelo::nitro::grpc
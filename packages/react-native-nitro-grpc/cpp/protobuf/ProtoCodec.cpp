@@ -0,0 +1,600 @@
+#include "ProtoCodec.hpp"
+
+#include "../utils/base64/Base64Simd.hpp"
+#include "WireFormat.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::grpc {
+namespace ProtoCodec {
+
+using WireFormat::Reader;
+
+namespace {
+
+// Same limit as libprotobuf's default recursion limit
+constexpr int kMaxDepth = 100;
+
+// Messages with at most this many fields cache property slots on the stack
+constexpr size_t kMaxStackSlots = 32;
+
+// MARK: - Encoding
+
+[[noreturn]] void invalidValue(const MessagePlan& plan, const FieldPlan& field, const char* expected) {
+  throw std::runtime_error("Cannot encode " + plan.fullName + "." + field.name + ": expected " + expected);
+}
+
+double toDouble(const MessagePlan& plan, const FieldPlan& field, const AnyValue& value) {
+  if (const double* number = std::get_if<double>(&value)) {
+    return *number;
+  }
+  if (const int64_t* bigint = std::get_if<int64_t>(&value)) {
+    return static_cast<double>(*bigint);
+  }
+  if (const std::string* string = std::get_if<std::string>(&value)) {
+    if (*string == "NaN") {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (*string == "Infinity") {
+      return std::numeric_limits<double>::infinity();
+    }
+    if (*string == "-Infinity") {
+      return -std::numeric_limits<double>::infinity();
+    }
+    char* end = nullptr;
+    const double parsed = std::strtod(string->c_str(), &end);
+    if (!string->empty() && *end == '\0') {
+      return parsed;
+    }
+  }
+  invalidValue(plan, field, "a number");
+}
+
+int64_t toInt64(const MessagePlan& plan, const FieldPlan& field, const AnyValue& value, int64_t min, int64_t max) {
+  int64_t result = 0;
+  if (const double* number = std::get_if<double>(&value)) {
+    // 2^63 is exactly representable; anything at or beyond it is out of range
+    if (std::trunc(*number) != *number || *number < -9223372036854775808.0 || *number >= 9223372036854775808.0) {
+      invalidValue(plan, field, "an integer");
+    }
+    result = static_cast<int64_t>(*number);
+  } else if (const int64_t* bigint = std::get_if<int64_t>(&value)) {
+    result = *bigint;
+  } else if (const std::string* string = std::get_if<std::string>(&value)) {
+    char* end = nullptr;
+    errno = 0;
+    result = std::strtoll(string->c_str(), &end, 10);
+    if (string->empty() || *end != '\0' || errno == ERANGE) {
+      invalidValue(plan, field, "an integer");
+    }
+  } else {
+    invalidValue(plan, field, "an integer");
+  }
+  if (result < min || result > max) {
+    invalidValue(plan, field, "an integer in range");
+  }
+  return result;
+}
+
+uint64_t toUint64(const MessagePlan& plan, const FieldPlan& field, const AnyValue& value, uint64_t max) {
+  uint64_t result = 0;
+  if (const double* number = std::get_if<double>(&value)) {
+    if (std::trunc(*number) != *number || *number < 0 || *number >= 18446744073709551616.0) {
+      invalidValue(plan, field, "an unsigned integer");
+    }
+    result = static_cast<uint64_t>(*number);
+  } else if (const int64_t* bigint = std::get_if<int64_t>(&value)) {
+    if (*bigint < 0) {
+      invalidValue(plan, field, "an unsigned integer");
+    }
+    result = static_cast<uint64_t>(*bigint);
+  } else if (const std::string* string = std::get_if<std::string>(&value)) {
+    char* end = nullptr;
+    errno = 0;
+    result = std::strtoull(string->c_str(), &end, 10);
+    if (string->empty() || (*string)[0] == '-' || *end != '\0' || errno == ERANGE) {
+      invalidValue(plan, field, "an unsigned integer");
+    }
+  } else {
+    invalidValue(plan, field, "an unsigned integer");
+  }
+  if (result > max) {
+    invalidValue(plan, field, "an unsigned integer in range");
+  }
+  return result;
+}
+
+int32_t toEnum(const MessagePlan& plan, const FieldPlan& field, const AnyValue& value) {
+  if (const std::string* name = std::get_if<std::string>(&value)) {
+    auto it = field.enumType->values.find(*name);
+    if (it == field.enumType->values.end()) {
+      invalidValue(plan, field, ("a value of " + field.enumType->fullName).c_str());
+    }
+    return it->second;
+  }
+  return static_cast<int32_t>(toInt64(plan, field, value, INT32_MIN, INT32_MAX));
+}
+
+void writeBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+  WireFormat::writeVarint(out, size);
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  out.insert(out.end(), bytes, bytes + size);
+}
+
+void writeBase64(const MessagePlan& plan, const FieldPlan& field, const AnyValue& value, std::vector<uint8_t>& out) {
+  const std::string* base64 = std::get_if<std::string>(&value);
+  if (base64 == nullptr) {
+    invalidValue(plan, field, "a Base64 string");
+  }
+  const bool url = base64->find_first_of("-_") != std::string::npos;
+  size_t length = 0;
+  try {
+    length = Base64Simd::decodedLength(base64->data(), base64->size());
+  } catch (const std::exception&) {
+    invalidValue(plan, field, "a Base64 string");
+  }
+  WireFormat::writeVarint(out, length);
+  const size_t offset = out.size();
+  out.resize(offset + length);
+  try {
+    Base64Simd::decode(base64->data(), base64->size(), out.data() + offset, url);
+  } catch (const std::exception&) {
+    invalidValue(plan, field, "a Base64 string");
+  }
+}
+
+void encodeMessage(const MessagePlan& plan, const AnyObject& message, std::vector<uint8_t>& out, int depth);
+
+/**
+ * Write one value of `field` without its tag.
+ */
+void encodeValue(const MessagePlan& plan,
+                 const FieldPlan& field,
+                 const AnyValue& value,
+                 std::vector<uint8_t>& out,
+                 int depth) {
+  switch (field.type) {
+    case ProtoFieldType::DOUBLE: {
+      const double number = toDouble(plan, field, value);
+      uint64_t bits;
+      std::memcpy(&bits, &number, sizeof(bits));
+      WireFormat::writeFixed64(out, bits);
+      return;
+    }
+    case ProtoFieldType::FLOAT: {
+      const float number = static_cast<float>(toDouble(plan, field, value));
+      uint32_t bits;
+      std::memcpy(&bits, &number, sizeof(bits));
+      WireFormat::writeFixed32(out, bits);
+      return;
+    }
+    case ProtoFieldType::INT64:
+      WireFormat::writeVarint(out, static_cast<uint64_t>(toInt64(plan, field, value, INT64_MIN, INT64_MAX)));
+      return;
+    case ProtoFieldType::UINT64:
+      WireFormat::writeVarint(out, toUint64(plan, field, value, UINT64_MAX));
+      return;
+    case ProtoFieldType::INT32:
+      // Negative values are sign-extended to 10 bytes, as the spec requires
+      WireFormat::writeVarint(out, static_cast<uint64_t>(toInt64(plan, field, value, INT32_MIN, INT32_MAX)));
+      return;
+    case ProtoFieldType::UINT32:
+      WireFormat::writeVarint(out, toUint64(plan, field, value, UINT32_MAX));
+      return;
+    case ProtoFieldType::SINT32:
+      WireFormat::writeVarint(out, WireFormat::zigZagEncode(toInt64(plan, field, value, INT32_MIN, INT32_MAX)));
+      return;
+    case ProtoFieldType::SINT64:
+      WireFormat::writeVarint(out, WireFormat::zigZagEncode(toInt64(plan, field, value, INT64_MIN, INT64_MAX)));
+      return;
+    case ProtoFieldType::FIXED32:
+      WireFormat::writeFixed32(out, static_cast<uint32_t>(toUint64(plan, field, value, UINT32_MAX)));
+      return;
+    case ProtoFieldType::SFIXED32:
+      WireFormat::writeFixed32(out, static_cast<uint32_t>(toInt64(plan, field, value, INT32_MIN, INT32_MAX)));
+      return;
+    case ProtoFieldType::FIXED64:
+      WireFormat::writeFixed64(out, toUint64(plan, field, value, UINT64_MAX));
+      return;
+    case ProtoFieldType::SFIXED64:
+      WireFormat::writeFixed64(out, static_cast<uint64_t>(toInt64(plan, field, value, INT64_MIN, INT64_MAX)));
+      return;
+    case ProtoFieldType::BOOL: {
+      const bool* boolean = std::get_if<bool>(&value);
+      if (boolean == nullptr) {
+        invalidValue(plan, field, "a boolean");
+      }
+      out.push_back(*boolean ? 1 : 0);
+      return;
+    }
+    case ProtoFieldType::ENUM:
+      WireFormat::writeVarint(out, static_cast<uint64_t>(static_cast<int64_t>(toEnum(plan, field, value))));
+      return;
+    case ProtoFieldType::STRING: {
+      const std::string* string = std::get_if<std::string>(&value);
+      if (string == nullptr) {
+        invalidValue(plan, field, "a string");
+      }
+      writeBytes(out, string->data(), string->size());
+      return;
+    }
+    case ProtoFieldType::BYTES:
+      writeBase64(plan, field, value, out);
+      return;
+    case ProtoFieldType::MESSAGE: {
+      const AnyObject* object = std::get_if<AnyObject>(&value);
+      if (object == nullptr) {
+        invalidValue(plan, field, "an object");
+      }
+      const size_t start = WireFormat::beginDelimited(out);
+      encodeMessage(*field.message, *object, out, depth + 1);
+      WireFormat::endDelimited(out, start);
+      return;
+    }
+    case ProtoFieldType::GROUP:
+      throw std::runtime_error("Cannot encode " + plan.fullName + "." + field.name + ": groups are not supported");
+  }
+}
+
+void encodeTagged(const MessagePlan& plan,
+                  const FieldPlan& field,
+                  const AnyValue& value,
+                  std::vector<uint8_t>& out,
+                  int depth) {
+  WireFormat::writeVarint(out, (static_cast<uint64_t>(field.number) << 3) | field.wireType);
+  encodeValue(plan, field, value, out, depth);
+}
+
+void encodeMap(const MessagePlan& plan,
+               const FieldPlan& field,
+               const AnyValue& value,
+               std::vector<uint8_t>& out,
+               int depth) {
+  const AnyObject* object = std::get_if<AnyObject>(&value);
+  if (object == nullptr) {
+    invalidValue(plan, field, "an object");
+  }
+  const MessagePlan& entry = *field.message;
+  const FieldPlan* keyField = entry.field(1);
+  const FieldPlan* valueField = entry.field(2);
+  if (keyField == nullptr || valueField == nullptr) {
+    throw std::runtime_error("Invalid map entry type " + entry.fullName);
+  }
+
+  // Sorted keys keep the output deterministic
+  std::vector<const AnyObject::value_type*> entries;
+  entries.reserve(object->size());
+  for (const auto& item : *object) {
+    entries.push_back(&item);
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+  for (const auto* item : entries) {
+    WireFormat::writeVarint(out, (static_cast<uint64_t>(field.number) << 3) | WireFormat::LEN);
+    const size_t start = WireFormat::beginDelimited(out);
+    if (keyField->type == ProtoFieldType::BOOL) {
+      if (item->first != "true" && item->first != "false") {
+        invalidValue(entry, *keyField, "\"true\" or \"false\"");
+      }
+      encodeTagged(entry, *keyField, AnyValue(item->first == "true"), out, depth + 1);
+    } else {
+      encodeTagged(entry, *keyField, AnyValue(item->first), out, depth + 1);
+    }
+    if (!std::holds_alternative<NullType>(item->second)) {
+      encodeTagged(entry, *valueField, item->second, out, depth + 1);
+    }
+    WireFormat::endDelimited(out, start);
+  }
+}
+
+void encodeMessage(const MessagePlan& plan, const AnyObject& message, std::vector<uint8_t>& out, int depth) {
+  if (depth > kMaxDepth) {
+    throw std::runtime_error("Cannot encode " + plan.fullName + ": message nested too deeply");
+  }
+
+  for (const FieldPlan& field : plan.fields) {
+    auto it = message.find(field.name);
+    if (it == message.end() || std::holds_alternative<NullType>(it->second)) {
+      continue;
+    }
+    const AnyValue& value = it->second;
+
+    if (field.map) {
+      encodeMap(plan, field, value, out, depth);
+    } else if (field.repeated) {
+      const AnyArray* array = std::get_if<AnyArray>(&value);
+      if (array == nullptr) {
+        invalidValue(plan, field, "an array");
+      }
+      if (array->empty()) {
+        continue;
+      }
+      if (field.packed) {
+        WireFormat::writeVarint(out, (static_cast<uint64_t>(field.number) << 3) | WireFormat::LEN);
+        const size_t start = WireFormat::beginDelimited(out);
+        for (const AnyValue& item : *array) {
+          encodeValue(plan, field, item, out, depth);
+        }
+        WireFormat::endDelimited(out, start);
+      } else {
+        for (const AnyValue& item : *array) {
+          encodeTagged(plan, field, item, out, depth);
+        }
+      }
+    } else {
+      encodeTagged(plan, field, value, out, depth);
+    }
+  }
+}
+
+// MARK: - Decoding
+
+std::string toBase64(const Reader& bytes) {
+  std::string result(Base64Simd::encodedLength(bytes.remaining(), false), '\0');
+  Base64Simd::encode(bytes.position(), bytes.remaining(), result.data(), false);
+  return result;
+}
+
+/**
+ * Read one value of `field` (wire type already checked) into `slot`.
+ * Message values are merged into an existing object, as protobuf requires.
+ */
+void decodeValue(const FieldPlan& field, Reader& reader, AnyValue& slot, int depth);
+
+void decodeMessage(const MessagePlan& plan, Reader reader, AnyObject& out, int depth);
+
+void decodeValue(const FieldPlan& field, Reader& reader, AnyValue& slot, int depth) {
+  switch (field.type) {
+    case ProtoFieldType::DOUBLE: {
+      const uint64_t bits = reader.readFixed64();
+      double number;
+      std::memcpy(&number, &bits, sizeof(number));
+      slot = number;
+      return;
+    }
+    case ProtoFieldType::FLOAT: {
+      const uint32_t bits = reader.readFixed32();
+      float number;
+      std::memcpy(&number, &bits, sizeof(number));
+      slot = static_cast<double>(number);
+      return;
+    }
+    case ProtoFieldType::INT64:
+      slot = std::to_string(static_cast<int64_t>(reader.readVarint()));
+      return;
+    case ProtoFieldType::UINT64:
+      slot = std::to_string(reader.readVarint());
+      return;
+    case ProtoFieldType::INT32:
+      slot = static_cast<double>(static_cast<int32_t>(reader.readVarint()));
+      return;
+    case ProtoFieldType::UINT32:
+      slot = static_cast<double>(static_cast<uint32_t>(reader.readVarint()));
+      return;
+    case ProtoFieldType::SINT32:
+      slot = static_cast<double>(static_cast<int32_t>(WireFormat::zigZagDecode(reader.readVarint())));
+      return;
+    case ProtoFieldType::SINT64:
+      slot = std::to_string(WireFormat::zigZagDecode(reader.readVarint()));
+      return;
+    case ProtoFieldType::FIXED32:
+      slot = static_cast<double>(reader.readFixed32());
+      return;
+    case ProtoFieldType::SFIXED32:
+      slot = static_cast<double>(static_cast<int32_t>(reader.readFixed32()));
+      return;
+    case ProtoFieldType::FIXED64:
+      slot = std::to_string(reader.readFixed64());
+      return;
+    case ProtoFieldType::SFIXED64:
+      slot = std::to_string(static_cast<int64_t>(reader.readFixed64()));
+      return;
+    case ProtoFieldType::BOOL:
+      slot = reader.readVarint() != 0;
+      return;
+    case ProtoFieldType::ENUM: {
+      const auto number = static_cast<int32_t>(reader.readVarint());
+      auto it = field.enumType->names.find(number);
+      if (it != field.enumType->names.end()) {
+        slot = it->second;
+      } else {
+        slot = static_cast<double>(number);
+      }
+      return;
+    }
+    case ProtoFieldType::STRING: {
+      Reader bytes = reader.readDelimited();
+      slot = std::string(reinterpret_cast<const char*>(bytes.position()), bytes.remaining());
+      return;
+    }
+    case ProtoFieldType::BYTES:
+      slot = toBase64(reader.readDelimited());
+      return;
+    case ProtoFieldType::MESSAGE: {
+      if (!std::holds_alternative<AnyObject>(slot)) {
+        slot = AnyObject();
+      }
+      decodeMessage(*field.message, reader.readDelimited(), std::get<AnyObject>(slot), depth + 1);
+      return;
+    }
+    case ProtoFieldType::GROUP:
+      WireFormat::malformed("unexpected group");
+  }
+}
+
+AnyValue defaultValue(const FieldPlan& field) {
+  switch (field.type) {
+    case ProtoFieldType::INT64:
+    case ProtoFieldType::UINT64:
+    case ProtoFieldType::SINT64:
+    case ProtoFieldType::FIXED64:
+    case ProtoFieldType::SFIXED64:
+      return std::string("0");
+    case ProtoFieldType::BOOL:
+      return false;
+    case ProtoFieldType::STRING:
+    case ProtoFieldType::BYTES:
+      return std::string();
+    case ProtoFieldType::MESSAGE:
+      return AnyObject();
+    case ProtoFieldType::ENUM: {
+      auto it = field.enumType->names.find(0);
+      if (it != field.enumType->names.end()) {
+        return it->second;
+      }
+      return 0.0;
+    }
+    default:
+      return 0.0;
+  }
+}
+
+std::string mapKey(const AnyValue& key) {
+  if (const std::string* string = std::get_if<std::string>(&key)) {
+    return *string;
+  }
+  if (const bool* boolean = std::get_if<bool>(&key)) {
+    return *boolean ? "true" : "false";
+  }
+  // 32-bit integer keys decode to exact doubles
+  return std::to_string(static_cast<int64_t>(std::get<double>(key)));
+}
+
+void decodeMapEntry(const FieldPlan& field, Reader reader, AnyObject& out, int depth) {
+  const MessagePlan& entry = *field.message;
+  const FieldPlan* keyField = entry.field(1);
+  const FieldPlan* valueField = entry.field(2);
+  if (keyField == nullptr || valueField == nullptr) {
+    throw std::runtime_error("Invalid map entry type " + entry.fullName);
+  }
+
+  AnyValue key;
+  AnyValue value;
+  bool hasKey = false;
+  bool hasValue = false;
+  while (!reader.atEnd()) {
+    const uint64_t tag = reader.readVarint();
+    const uint32_t number = static_cast<uint32_t>(tag >> 3);
+    const uint32_t wireType = static_cast<uint32_t>(tag & 7);
+    if (number == 1 && wireType == keyField->wireType) {
+      decodeValue(*keyField, reader, key, depth + 1);
+      hasKey = true;
+    } else if (number == 2 && wireType == valueField->wireType) {
+      decodeValue(*valueField, reader, value, depth + 1);
+      hasValue = true;
+    } else {
+      reader.skip(wireType, number);
+    }
+  }
+
+  out[mapKey(hasKey ? key : defaultValue(*keyField))] = hasValue ? std::move(value) : defaultValue(*valueField);
+}
+
+/**
+ * Decode one occurrence of `field`, whose tag was just read, into its property slot.
+ * Repeated values are appended, map entries added and messages merged.
+ */
+void decodeOccurrence(const FieldPlan& field, uint32_t wireType, Reader& reader, AnyValue& slot, int depth) {
+  if (field.map) {
+    if (wireType != WireFormat::LEN) {
+      WireFormat::malformed("wire type mismatch");
+    }
+    if (!std::holds_alternative<AnyObject>(slot)) {
+      slot = AnyObject();
+    }
+    decodeMapEntry(field, reader.readDelimited(), std::get<AnyObject>(slot), depth);
+    return;
+  }
+
+  if (field.repeated) {
+    if (!std::holds_alternative<AnyArray>(slot)) {
+      slot = AnyArray();
+    }
+    AnyArray& array = std::get<AnyArray>(slot);
+    if (wireType == WireFormat::LEN && field.wireType != WireFormat::LEN) {
+      // Packed run; accepted whether or not the field is declared packed
+      Reader packed = reader.readDelimited();
+      while (!packed.atEnd()) {
+        decodeValue(field, packed, array.emplace_back(), depth);
+      }
+    } else if (wireType == field.wireType) {
+      decodeValue(field, reader, array.emplace_back(), depth);
+    } else {
+      WireFormat::malformed("wire type mismatch");
+    }
+    return;
+  }
+
+  if (wireType != field.wireType) {
+    WireFormat::malformed("wire type mismatch");
+  }
+  decodeValue(field, reader, slot, depth);
+}
+
+void decodeMessage(const MessagePlan& plan, Reader reader, AnyObject& out, int depth) {
+  if (depth > kMaxDepth) {
+    WireFormat::malformed("message nested too deeply");
+  }
+
+  // Property slots by field index; unordered_map references stay valid on insert
+  AnyValue* stackSlots[kMaxStackSlots] = {};
+  std::vector<AnyValue*> heapSlots;
+  AnyValue** slots = stackSlots;
+  if (plan.fields.size() > kMaxStackSlots) {
+    heapSlots.assign(plan.fields.size(), nullptr);
+    slots = heapSlots.data();
+  }
+  auto slotFor = [&](const FieldPlan& field) -> AnyValue& {
+    AnyValue*& slot = slots[&field - plan.fields.data()];
+    if (slot == nullptr) {
+      slot = &out[field.name];
+    }
+    return *slot;
+  };
+
+  while (!reader.atEnd()) {
+    const uint64_t tag = reader.readVarint();
+    const uint32_t number = static_cast<uint32_t>(tag >> 3);
+    const uint32_t wireType = static_cast<uint32_t>(tag & 7);
+    if (number == 0) {
+      WireFormat::malformed("field number 0");
+    }
+
+    const FieldPlan* field = plan.field(number);
+    if (field == nullptr || field->type == ProtoFieldType::GROUP) {
+      reader.skip(wireType, number);
+      continue;
+    }
+
+    decodeOccurrence(*field, wireType, reader, slotFor(*field), depth);
+  }
+}
+
+} // namespace
+
+void encode(const MessagePlan& plan, const AnyObject& message, std::vector<uint8_t>& out) {
+  encodeMessage(plan, message, out, 0);
+}
+
+void decode(const MessagePlan& plan, const uint8_t* data, size_t size, AnyObject& out) {
+  decodeMessage(plan, Reader(data, size), out, 0);
+}
+
+void decodeField(const FieldPlan& field, uint32_t wireType, Reader& reader, AnyValue& slot) {
+  decodeOccurrence(field, wireType, reader, slot, 0);
+}
+
+void decodeElement(const FieldPlan& field, Reader& reader, AnyValue& slot) {
+  decodeValue(field, reader, slot, 0);
+}
+
+} // namespace ProtoCodec
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ProtoSchema.hpp"
+#include "WireFormat.hpp"
+
+#include <NitroModules/AnyMap.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Converts between protobuf wire bytes and JS objects (Nitro AnyMap).
+ *
+ * Driven entirely by MessagePlans: decoding dispatches on the field number
+ * through the plan's dense table and on the field type with a switch;
+ * encoding walks the plan's fields in number order, so equal objects always
+ * produce identical bytes (request cache and coalescing keys rely on this).
+ *
+ * JS representation (the proto3 JSON mapping, minus well-known types):
+ * - Property names are the fields' json_name (lowerCamelCase).
+ * - 32-bit integers, float and double are numbers.
+ * - 64-bit integers decode to decimal strings; numbers, BigInts and
+ *   strings are accepted when encoding.
+ * - bytes are Base64 strings (either alphabet is accepted when encoding).
+ * - Enums decode to value names (numbers for unknown values); names and
+ *   numbers are accepted when encoding.
+ * - Maps are objects keyed by the string form of the key.
+ * - Only fields present on the wire are decoded; defaults are not filled in.
+ *   Unknown fields and groups are skipped.
+ */
+namespace ProtoCodec {
+
+/**
+ * Append the encoding of `message` to `out`.
+ *
+ * @throws std::runtime_error if a value does not match its field's type
+ */
+void encode(const MessagePlan& plan, const AnyObject& message, std::vector<uint8_t>& out);
+
+/**
+ * Decode `size` bytes into `out`, merging with existing properties.
+ *
+ * @throws std::runtime_error if the bytes are not a valid encoding of the message
+ */
+void decode(const MessagePlan& plan, const uint8_t* data, size_t size, AnyObject& out);
+
+/**
+ * Decode one occurrence of `field` whose tag (carrying `wireType`) was just
+ * read, into the property value `slot`. Repeated values are appended, map
+ * entries added and messages merged, exactly as decode() does.
+ *
+ * @throws std::runtime_error if the value is malformed
+ */
+void decodeField(const FieldPlan& field, uint32_t wireType, WireFormat::Reader& reader, AnyValue& slot);
+
+/**
+ * Decode a single value of `field` (one element of a packed run, or an
+ * unpacked occurrence) into `slot`.
+ *
+ * @throws std::runtime_error if the value is malformed
+ */
+void decodeElement(const FieldPlan& field, WireFormat::Reader& reader, AnyValue& slot);
+
+} // namespace ProtoCodec
+
+} // namespace margelo::nitro::grpc
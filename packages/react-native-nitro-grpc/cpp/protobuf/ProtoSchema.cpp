@@ -0,0 +1,405 @@
+#include "ProtoSchema.hpp"
+
+#include "WireFormat.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+using WireFormat::Reader;
+
+namespace {
+
+// Field numbers from google/protobuf/descriptor.proto
+constexpr uint32_t kFileSetFile = 1;
+
+constexpr uint32_t kFilePackage = 2;
+constexpr uint32_t kFileMessageType = 4;
+constexpr uint32_t kFileEnumType = 5;
+constexpr uint32_t kFileSyntax = 12;
+
+constexpr uint32_t kMessageName = 1;
+constexpr uint32_t kMessageField = 2;
+constexpr uint32_t kMessageNestedType = 3;
+constexpr uint32_t kMessageEnumType = 4;
+constexpr uint32_t kMessageOptions = 7;
+constexpr uint32_t kMessageOptionsMapEntry = 7;
+
+constexpr uint32_t kFieldName = 1;
+constexpr uint32_t kFieldNumber = 3;
+constexpr uint32_t kFieldLabel = 4;
+constexpr uint32_t kFieldType = 5;
+constexpr uint32_t kFieldTypeName = 6;
+constexpr uint32_t kFieldOptions = 8;
+constexpr uint32_t kFieldJsonName = 10;
+constexpr uint32_t kFieldOptionsPacked = 2;
+
+constexpr uint32_t kEnumName = 1;
+constexpr uint32_t kEnumValue = 2;
+constexpr uint32_t kEnumValueName = 1;
+constexpr uint32_t kEnumValueNumber = 2;
+
+constexpr uint32_t kLabelRepeated = 3;
+
+// Field numbers below this use the dense lookup table
+constexpr uint32_t kMaxDenseFieldNumber = 256;
+
+/**
+ * Iterate the fields of a serialized message, calling `onField(number, wireType, reader)`.
+ * The callback must consume the value; it returns `false` to have an unhandled field skipped.
+ */
+template <typename OnField> void forEachField(const uint8_t* data, size_t size, OnField&& onField) {
+  Reader reader(data, size);
+  while (!reader.atEnd()) {
+    const uint64_t tag = reader.readVarint();
+    const uint32_t wireType = static_cast<uint32_t>(tag & 7);
+    const uint32_t number = static_cast<uint32_t>(tag >> 3);
+    if (!onField(number, wireType, reader)) {
+      reader.skip(wireType, number);
+    }
+  }
+}
+
+std::string readString(Reader& reader) {
+  Reader value = reader.readDelimited();
+  return std::string(reinterpret_cast<const char*>(value.position()), value.remaining());
+}
+
+std::string qualify(const std::string& scope, const std::string& name) {
+  return scope.empty() ? name : scope + "." + name;
+}
+
+// protoc's ToJsonName(): drop underscores and upper-case the following letter
+std::string toJsonName(const std::string& name) {
+  std::string result;
+  result.reserve(name.size());
+  bool upperNext = false;
+  for (char c : name) {
+    if (c == '_') {
+      upperNext = true;
+    } else if (upperNext) {
+      result.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+      upperNext = false;
+    } else {
+      result.push_back(c);
+    }
+  }
+  return result;
+}
+
+uint32_t wireTypeFor(ProtoFieldType type) {
+  switch (type) {
+    case ProtoFieldType::DOUBLE:
+    case ProtoFieldType::FIXED64:
+    case ProtoFieldType::SFIXED64:
+      return WireFormat::I64;
+    case ProtoFieldType::FLOAT:
+    case ProtoFieldType::FIXED32:
+    case ProtoFieldType::SFIXED32:
+      return WireFormat::I32;
+    case ProtoFieldType::STRING:
+    case ProtoFieldType::BYTES:
+    case ProtoFieldType::MESSAGE:
+      return WireFormat::LEN;
+    case ProtoFieldType::GROUP:
+      return WireFormat::SGROUP;
+    default:
+      return WireFormat::VARINT;
+  }
+}
+
+bool isPackable(ProtoFieldType type) {
+  return type != ProtoFieldType::STRING && type != ProtoFieldType::BYTES && type != ProtoFieldType::MESSAGE &&
+         type != ProtoFieldType::GROUP;
+}
+
+} // namespace
+
+void ProtoSchema::load(const uint8_t* data, size_t size) {
+  forEachField(data, size, [&](uint32_t number, uint32_t wireType, Reader& reader) {
+    if (number != kFileSetFile || wireType != WireFormat::LEN) {
+      return false;
+    }
+    Reader file = reader.readDelimited();
+    parseFile(file.position(), file.remaining());
+    return true;
+  });
+
+  // Re-link everything: new files may complete types referenced by earlier ones
+  for (const auto& [name, raw] : _raw) {
+    auto& plan = _messages[name];
+    if (!plan) {
+      plan = std::make_unique<MessagePlan>();
+    }
+  }
+  for (const auto& [name, raw] : _raw) {
+    link(*_messages[name], raw);
+  }
+}
+
+const MessagePlan* ProtoSchema::find(const std::string& fullName) const {
+  auto it = _messages.find(fullName);
+  return it == _messages.end() ? nullptr : it->second.get();
+}
+
+void ProtoSchema::parseFile(const uint8_t* data, size_t size) {
+  // The package and syntax may follow the messages, so collect first
+  std::string package;
+  bool packedByDefault = false;
+  std::vector<std::pair<const uint8_t*, size_t>> messages;
+  std::vector<std::pair<const uint8_t*, size_t>> enums;
+
+  forEachField(data, size, [&](uint32_t number, uint32_t wireType, Reader& reader) {
+    if (wireType != WireFormat::LEN) {
+      return false;
+    }
+    switch (number) {
+      case kFilePackage:
+        package = readString(reader);
+        return true;
+      case kFileSyntax: {
+        const std::string syntax = readString(reader);
+        packedByDefault = syntax == "proto3" || syntax == "editions";
+        return true;
+      }
+      case kFileMessageType: {
+        Reader message = reader.readDelimited();
+        messages.emplace_back(message.position(), message.remaining());
+        return true;
+      }
+      case kFileEnumType: {
+        Reader enumType = reader.readDelimited();
+        enums.emplace_back(enumType.position(), enumType.remaining());
+        return true;
+      }
+      default:
+        return false;
+    }
+  });
+
+  for (const auto& [messageData, messageSize] : messages) {
+    parseMessage(messageData, messageSize, package, packedByDefault);
+  }
+  for (const auto& [enumData, enumSize] : enums) {
+    parseEnum(enumData, enumSize, package);
+  }
+}
+
+void ProtoSchema::parseMessage(const uint8_t* data, size_t size, const std::string& scope, bool packedByDefault) {
+  RawMessage message;
+  message.packedByDefault = packedByDefault;
+  std::string name;
+  std::vector<std::pair<const uint8_t*, size_t>> nestedMessages;
+  std::vector<std::pair<const uint8_t*, size_t>> nestedEnums;
+
+  forEachField(data, size, [&](uint32_t number, uint32_t wireType, Reader& reader) {
+    if (wireType != WireFormat::LEN) {
+      return false;
+    }
+    switch (number) {
+      case kMessageName:
+        name = readString(reader);
+        return true;
+      case kMessageField: {
+        RawField field;
+        Reader fieldReader = reader.readDelimited();
+        forEachField(fieldReader.position(), fieldReader.remaining(), [&](uint32_t n, uint32_t wt, Reader& r) {
+          if (wt == WireFormat::VARINT) {
+            switch (n) {
+              case kFieldNumber:
+                field.number = static_cast<uint32_t>(r.readVarint());
+                return true;
+              case kFieldLabel:
+                field.label = static_cast<uint32_t>(r.readVarint());
+                return true;
+              case kFieldType:
+                field.type = static_cast<uint32_t>(r.readVarint());
+                return true;
+              default:
+                return false;
+            }
+          }
+          if (wt != WireFormat::LEN) {
+            return false;
+          }
+          switch (n) {
+            case kFieldName:
+              field.name = readString(r);
+              return true;
+            case kFieldTypeName:
+              field.typeName = readString(r);
+              return true;
+            case kFieldJsonName:
+              field.jsonName = readString(r);
+              return true;
+            case kFieldOptions: {
+              Reader options = r.readDelimited();
+              forEachField(options.position(), options.remaining(), [&](uint32_t on, uint32_t owt, Reader& o) {
+                if (on != kFieldOptionsPacked || owt != WireFormat::VARINT) {
+                  return false;
+                }
+                field.hasPackedOption = true;
+                field.packedOption = o.readVarint() != 0;
+                return true;
+              });
+              return true;
+            }
+            default:
+              return false;
+          }
+        });
+        message.fields.push_back(std::move(field));
+        return true;
+      }
+      case kMessageNestedType: {
+        Reader nested = reader.readDelimited();
+        nestedMessages.emplace_back(nested.position(), nested.remaining());
+        return true;
+      }
+      case kMessageEnumType: {
+        Reader nested = reader.readDelimited();
+        nestedEnums.emplace_back(nested.position(), nested.remaining());
+        return true;
+      }
+      case kMessageOptions: {
+        Reader options = reader.readDelimited();
+        forEachField(options.position(), options.remaining(), [&](uint32_t n, uint32_t wt, Reader& o) {
+          if (n != kMessageOptionsMapEntry || wt != WireFormat::VARINT) {
+            return false;
+          }
+          message.mapEntry = o.readVarint() != 0;
+          return true;
+        });
+        return true;
+      }
+      default:
+        return false;
+    }
+  });
+
+  if (name.empty()) {
+    throw std::runtime_error("Invalid descriptor: message without a name in " + scope);
+  }
+  message.fullName = qualify(scope, name);
+  for (const auto& [nestedData, nestedSize] : nestedMessages) {
+    parseMessage(nestedData, nestedSize, message.fullName, packedByDefault);
+  }
+  for (const auto& [nestedData, nestedSize] : nestedEnums) {
+    parseEnum(nestedData, nestedSize, message.fullName);
+  }
+  std::string fullName = message.fullName;
+  _raw[fullName] = std::move(message);
+}
+
+void ProtoSchema::parseEnum(const uint8_t* data, size_t size, const std::string& scope) {
+  auto plan = std::make_unique<EnumPlan>();
+  std::string name;
+
+  forEachField(data, size, [&](uint32_t number, uint32_t wireType, Reader& reader) {
+    if (wireType != WireFormat::LEN) {
+      return false;
+    }
+    if (number == kEnumName) {
+      name = readString(reader);
+      return true;
+    }
+    if (number != kEnumValue) {
+      return false;
+    }
+    std::string valueName;
+    int32_t valueNumber = 0;
+    Reader value = reader.readDelimited();
+    forEachField(value.position(), value.remaining(), [&](uint32_t n, uint32_t wt, Reader& r) {
+      if (n == kEnumValueName && wt == WireFormat::LEN) {
+        valueName = readString(r);
+        return true;
+      }
+      if (n == kEnumValueNumber && wt == WireFormat::VARINT) {
+        valueNumber = static_cast<int32_t>(r.readVarint());
+        return true;
+      }
+      return false;
+    });
+    // With allow_alias the first name of a number is the canonical one
+    plan->names.emplace(valueNumber, valueName);
+    plan->values.emplace(std::move(valueName), valueNumber);
+    return true;
+  });
+
+  plan->fullName = qualify(scope, name);
+  std::string fullName = plan->fullName;
+  _enums[fullName] = std::move(plan);
+}
+
+void ProtoSchema::link(MessagePlan& plan, const RawMessage& raw) {
+  plan.fullName = raw.fullName;
+  plan.mapEntry = raw.mapEntry;
+  plan.fields.clear();
+  plan.fields.reserve(raw.fields.size());
+
+  for (const RawField& rawField : raw.fields) {
+    FieldPlan field;
+    field.name = rawField.jsonName.empty() ? toJsonName(rawField.name) : rawField.jsonName;
+    field.number = rawField.number;
+    if (rawField.type < static_cast<uint32_t>(ProtoFieldType::DOUBLE) ||
+        rawField.type > static_cast<uint32_t>(ProtoFieldType::SINT64)) {
+      throw std::runtime_error("Invalid descriptor: field " + raw.fullName + "." + rawField.name +
+                               " has unknown type " + std::to_string(rawField.type));
+    }
+    field.type = static_cast<ProtoFieldType>(rawField.type);
+    field.wireType = wireTypeFor(field.type);
+    field.repeated = rawField.label == kLabelRepeated;
+    field.packed = field.repeated && isPackable(field.type) &&
+                   (rawField.hasPackedOption ? rawField.packedOption : raw.packedByDefault);
+
+    if (field.type == ProtoFieldType::MESSAGE || field.type == ProtoFieldType::GROUP ||
+        field.type == ProtoFieldType::ENUM) {
+      // Type names are fully qualified with a leading dot
+      const std::string typeName =
+          !rawField.typeName.empty() && rawField.typeName[0] == '.' ? rawField.typeName.substr(1) : rawField.typeName;
+      if (field.type == ProtoFieldType::ENUM) {
+        auto it = _enums.find(typeName);
+        if (it == _enums.end()) {
+          throw std::runtime_error("Invalid descriptor: unknown enum " + typeName + " in " + raw.fullName);
+        }
+        field.enumType = it->second.get();
+      } else {
+        auto it = _messages.find(typeName);
+        if (it == _messages.end()) {
+          throw std::runtime_error("Invalid descriptor: unknown message " + typeName + " in " + raw.fullName);
+        }
+        field.message = it->second.get();
+        field.map = field.repeated && _raw.at(typeName).mapEntry;
+      }
+    }
+    plan.fields.push_back(std::move(field));
+  }
+
+  std::sort(plan.fields.begin(), plan.fields.end(), [](const FieldPlan& a, const FieldPlan& b) {
+    return a.number < b.number;
+  });
+
+  plan._byNumber.clear();
+  plan._sparseByNumber.clear();
+  plan._byName.clear();
+  uint32_t maxDense = 0;
+  for (const FieldPlan& field : plan.fields) {
+    if (field.number < kMaxDenseFieldNumber) {
+      maxDense = std::max(maxDense, field.number + 1);
+    }
+  }
+  plan._byNumber.assign(maxDense, -1);
+  for (size_t i = 0; i < plan.fields.size(); i++) {
+    const uint32_t number = plan.fields[i].number;
+    if (number < maxDense) {
+      plan._byNumber[number] = static_cast<int16_t>(i);
+    } else {
+      plan._sparseByNumber[number] = i;
+    }
+    plan._byName.emplace(plan.fields[i].name, i);
+  }
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * Field types, numbered as in google/protobuf/descriptor.proto.
+ */
+enum class ProtoFieldType : uint8_t {
+  DOUBLE = 1,
+  FLOAT = 2,
+  INT64 = 3,
+  UINT64 = 4,
+  INT32 = 5,
+  FIXED64 = 6,
+  FIXED32 = 7,
+  BOOL = 8,
+  STRING = 9,
+  GROUP = 10,
+  MESSAGE = 11,
+  BYTES = 12,
+  UINT32 = 13,
+  ENUM = 14,
+  SFIXED32 = 15,
+  SFIXED64 = 16,
+  SINT32 = 17,
+  SINT64 = 18,
+};
+
+struct EnumPlan {
+  std::string fullName;
+  std::unordered_map<int32_t, std::string> names;
+  std::unordered_map<std::string, int32_t> values;
+};
+
+struct MessagePlan;
+
+/**
+ * Everything the codec needs to encode or decode one field, resolved once.
+ */
+struct FieldPlan {
+  std::string name; // JS property name (json_name)
+  uint32_t number = 0;
+  ProtoFieldType type = ProtoFieldType::INT32;
+  uint32_t wireType = 0; // Wire type of a single (unpacked) value
+  bool repeated = false;
+  bool packed = false;   // Encode repeated scalars packed
+  bool map = false;      // `message` is a map entry; the JS value is an object
+  const MessagePlan* message = nullptr;
+  const EnumPlan* enumType = nullptr;
+};
+
+struct MessagePlan {
+  std::string fullName;
+  std::vector<FieldPlan> fields; // Sorted by field number
+  bool mapEntry = false;
+
+  /**
+   * Field by number, or nullptr for unknown fields.
+   */
+  const FieldPlan* field(uint32_t number) const {
+    if (number < _byNumber.size()) {
+      const int16_t index = _byNumber[number];
+      return index < 0 ? nullptr : &fields[index];
+    }
+    auto it = _sparseByNumber.find(number);
+    return it == _sparseByNumber.end() ? nullptr : &fields[it->second];
+  }
+
+  /**
+   * Field by JS property name, or nullptr if there is none.
+   */
+  const FieldPlan* fieldNamed(const std::string& name) const {
+    auto it = _byName.find(name);
+    return it == _byName.end() ? nullptr : &fields[it->second];
+  }
+
+private:
+  friend class ProtoSchema;
+
+  // Dense table for the usual small field numbers; the rest go to the map
+  std::vector<int16_t> _byNumber;
+  std::unordered_map<uint32_t, size_t> _sparseByNumber;
+  std::unordered_map<std::string, size_t> _byName;
+};
+
+/**
+ * @brief Message and enum types loaded from serialized FileDescriptorSets.
+ *
+ * Loading parses the descriptors with a minimal built-in reader (no
+ * libprotobuf dependency) and resolves every message into a MessagePlan:
+ * fields sorted by number, a dense number-to-field table, resolved nested
+ * message and enum types, and wire types. The codec only ever reads plans.
+ *
+ * Not thread-safe while loading; plans are immutable afterwards.
+ */
+class ProtoSchema {
+public:
+  /**
+   * Add the files of a serialized google.protobuf.FileDescriptorSet.
+   * Types from earlier loads stay available and may be referenced.
+   *
+   * @throws std::runtime_error if the set is malformed or references unknown types
+   */
+  void load(const uint8_t* data, size_t size);
+
+  /**
+   * @param fullName Fully qualified name, e.g. "helloworld.HelloRequest"
+   * @return The plan, or nullptr if the type is unknown
+   */
+  const MessagePlan* find(const std::string& fullName) const;
+
+  size_t messageCount() const {
+    return _messages.size();
+  }
+
+private:
+  struct RawField {
+    std::string name;
+    std::string jsonName;
+    std::string typeName;
+    uint32_t number = 0;
+    uint32_t label = 0;
+    uint32_t type = 0;
+    bool hasPackedOption = false;
+    bool packedOption = false;
+  };
+
+  struct RawMessage {
+    std::string fullName;
+    std::vector<RawField> fields;
+    bool mapEntry = false;
+    bool packedByDefault = false; // proto3 and editions
+  };
+
+  void parseFile(const uint8_t* data, size_t size);
+  void parseMessage(const uint8_t* data, size_t size, const std::string& scope, bool packedByDefault);
+  void parseEnum(const uint8_t* data, size_t size, const std::string& scope);
+  void link(MessagePlan& plan, const RawMessage& raw);
+
+  std::unordered_map<std::string, RawMessage> _raw;
+  std::unordered_map<std::string, std::unique_ptr<MessagePlan>> _messages;
+  std::unordered_map<std::string, std::unique_ptr<EnumPlan>> _enums;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Protobuf wire format primitives.
+ *
+ * Header-only so the codec's hot loops can inline them.
+ */
+namespace WireFormat {
+
+enum WireType : uint32_t {
+  VARINT = 0,
+  I64 = 1,
+  LEN = 2,
+  SGROUP = 3,
+  EGROUP = 4,
+  I32 = 5,
+};
+
+[[noreturn]] inline void malformed(const char* what) {
+  throw std::runtime_error(std::string("Malformed protobuf message: ") + what);
+}
+
+/**
+ * Bounds-checked cursor over serialized bytes.
+ */
+class Reader {
+public:
+  Reader(const uint8_t* data, size_t size) : _pos(data), _end(data + size) {}
+
+  bool atEnd() const {
+    return _pos >= _end;
+  }
+
+  size_t remaining() const {
+    return static_cast<size_t>(_end - _pos);
+  }
+
+  const uint8_t* position() const {
+    return _pos;
+  }
+
+  uint64_t readVarint() {
+    // One-byte fast path: tags and small values
+    if (_pos < _end && *_pos < 0x80) {
+      return *_pos++;
+    }
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (_pos >= _end) {
+        malformed("truncated varint");
+      }
+      const uint8_t byte = *_pos++;
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (byte < 0x80) {
+        return result;
+      }
+    }
+    malformed("varint longer than 10 bytes");
+  }
+
+  uint32_t readFixed32() {
+    if (remaining() < 4) {
+      malformed("truncated fixed32");
+    }
+    uint32_t value;
+    std::memcpy(&value, _pos, 4); // Wire format is little-endian, as are all supported targets
+    _pos += 4;
+    return value;
+  }
+
+  uint64_t readFixed64() {
+    if (remaining() < 8) {
+      malformed("truncated fixed64");
+    }
+    uint64_t value;
+    std::memcpy(&value, _pos, 8);
+    _pos += 8;
+    return value;
+  }
+
+  /**
+   * Read a length prefix and return the delimited bytes, advancing past them.
+   */
+  Reader readDelimited() {
+    const uint64_t length = readVarint();
+    if (length > remaining()) {
+      malformed("length exceeds message");
+    }
+    Reader inner(_pos, static_cast<size_t>(length));
+    _pos += length;
+    return inner;
+  }
+
+  /**
+   * Skip the value of a field whose tag was just read.
+   */
+  void skip(uint32_t wireType, uint32_t fieldNumber, int depth = 0) {
+    switch (wireType) {
+      case VARINT:
+        readVarint();
+        return;
+      case I64:
+        readFixed64();
+        return;
+      case LEN:
+        readDelimited();
+        return;
+      case I32:
+        readFixed32();
+        return;
+      case SGROUP:
+        if (depth > 64) {
+          malformed("groups nested too deeply");
+        }
+        while (true) {
+          if (atEnd()) {
+            malformed("unterminated group");
+          }
+          const uint64_t tag = readVarint();
+          const uint32_t type = static_cast<uint32_t>(tag & 7);
+          const uint32_t number = static_cast<uint32_t>(tag >> 3);
+          if (type == EGROUP) {
+            if (number != fieldNumber) {
+              malformed("mismatched end group");
+            }
+            return;
+          }
+          skip(type, number, depth + 1);
+        }
+      default:
+        malformed("invalid wire type");
+    }
+  }
+
+private:
+  const uint8_t* _pos;
+  const uint8_t* _end;
+};
+
+inline size_t varintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+inline void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+inline void writeFixed32(std::vector<uint8_t>& out, uint32_t value) {
+  const size_t offset = out.size();
+  out.resize(offset + 4);
+  std::memcpy(out.data() + offset, &value, 4);
+}
+
+inline void writeFixed64(std::vector<uint8_t>& out, uint64_t value) {
+  const size_t offset = out.size();
+  out.resize(offset + 8);
+  std::memcpy(out.data() + offset, &value, 8);
+}
+
+/**
+ * Start a length-delimited value. Reserves a one-byte length prefix, which
+ * fits every payload below 128 bytes; endDelimited() widens it if needed.
+ *
+ * @return Offset to pass to endDelimited()
+ */
+inline size_t beginDelimited(std::vector<uint8_t>& out) {
+  out.push_back(0);
+  return out.size();
+}
+
+inline void endDelimited(std::vector<uint8_t>& out, size_t start) {
+  const size_t length = out.size() - start;
+  const size_t prefixSize = varintSize(length);
+  if (prefixSize > 1) {
+    out.insert(out.begin() + static_cast<std::ptrdiff_t>(start), prefixSize - 1, 0);
+  }
+  uint8_t* prefix = out.data() + start - 1;
+  uint64_t value = length;
+  while (value >= 0x80) {
+    *prefix++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *prefix = static_cast<uint8_t>(value);
+}
+
+inline uint64_t zigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace WireFormat
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/base64/Base64.hpp"
+#include "utils/base64/Base64Simd.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+std::string encode(const std::vector<uint8_t>& data, bool url) {
+  std::string out(Base64Simd::encodedLength(data.size(), url), '\0');
+  out.resize(Base64Simd::encode(data.data(), data.size(), out.data(), url));
+  return out;
+}
+
+std::vector<uint8_t> decode(const std::string& text, bool url) {
+  std::vector<uint8_t> out(Base64Simd::decodedLength(text.data(), text.size()));
+  out.resize(Base64Simd::decode(text.data(), text.size(), out.data(), url));
+  return out;
+}
+
+std::vector<uint8_t> bytes(const std::string& text) {
+  return {text.begin(), text.end()};
+}
+
+// Distinct consecutive bytes, so the 6-bit groups spread over the whole alphabet
+std::vector<uint8_t> pattern(size_t length) {
+  std::vector<uint8_t> data(length);
+  for (size_t i = 0; i < length; i++) {
+    data[i] = static_cast<uint8_t>(i * 167 + 13);
+  }
+  return data;
+}
+
+// Covers the scalar tail alone and every block width the kernels use (12, 16, 24, 32 and 48 bytes)
+constexpr size_t kMaxLength = 200;
+
+} // namespace
+
+TEST(Base64SimdTest, Encode_Rfc4648Vectors_MatchExpected) {
+  const std::pair<const char*, const char*> vectors[] = {
+      {"", ""},
+      {"f", "Zg=="},
+      {"fo", "Zm8="},
+      {"foo", "Zm9v"},
+      {"foob", "Zm9vYg=="},
+      {"fooba", "Zm9vYmE="},
+      {"foobar", "Zm9vYmFy"},
+  };
+  for (const auto& [plain, encoded] : vectors) {
+    EXPECT_EQ(encode(bytes(plain), false), encoded) << "input: " << plain;
+    EXPECT_EQ(decode(encoded, false), bytes(plain)) << "input: " << encoded;
+  }
+}
+
+TEST(Base64SimdTest, Encode_AllLengths_MatchesScalarReference) {
+  for (bool url : {false, true}) {
+    for (size_t length = 0; length <= kMaxLength; length++) {
+      const auto data = pattern(length);
+      const auto expected = base64_encode(data.data(), data.size(), url);
+
+      EXPECT_EQ(encode(data, url), expected) << "length " << length << " url " << url << " ("
+                                             << Base64Simd::implementationName() << ")";
+    }
+  }
+}
+
+TEST(Base64SimdTest, Decode_AllLengths_RoundTrips) {
+  for (bool url : {false, true}) {
+    for (size_t length = 0; length <= kMaxLength; length++) {
+      const auto data = pattern(length);
+
+      EXPECT_EQ(decode(encode(data, url), url), data) << "length " << length << " url " << url << " ("
+                                                      << Base64Simd::implementationName() << ")";
+    }
+  }
+}
+
+TEST(Base64SimdTest, Decode_PaddingOptional_BothAlphabets) {
+  EXPECT_EQ(decode("Zm9vYg", false), bytes("foob"));
+  EXPECT_EQ(decode("Zm9vYg==", true), bytes("foob"));
+}
+
+TEST(Base64SimdTest, Encode_UrlAlphabet_UsesDashUnderscoreWithoutPadding) {
+  const std::vector<uint8_t> data = {0xfb, 0xff, 0xbf};
+
+  EXPECT_EQ(encode(data, false), "+/+/");
+  EXPECT_EQ(encode(data, true), "-_-_");
+  EXPECT_EQ(encode({0xfb, 0xff}, true), "-_8");
+}
+
+TEST(Base64SimdTest, Decode_OtherAlphabet_Throws) {
+  // Long enough to reach the vector kernels
+  const std::string standard = base64_encode(pattern(96).data(), 96, false);
+  const std::string url = base64_encode(pattern(96).data(), 96, true);
+  ASSERT_NE(standard, url);
+
+  EXPECT_THROW(decode(standard, true), std::runtime_error);
+  EXPECT_THROW(decode(url, false), std::runtime_error);
+}
+
+TEST(Base64SimdTest, Decode_InvalidCharacterAtEveryPosition_Throws) {
+  const std::string valid = encode(pattern(kMaxLength / 4 * 3), false);
+  for (char invalid : {'!', '\n', ' ', '\x80', '-'}) {
+    for (size_t position = 0; position < valid.size(); position++) {
+      std::string text = valid;
+      text[position] = invalid;
+
+      EXPECT_THROW(decode(text, false), std::runtime_error)
+          << "char " << static_cast<int>(invalid) << " at " << position << " (" << Base64Simd::implementationName()
+          << ")";
+    }
+  }
+}
+
+TEST(Base64SimdTest, DecodedLength_InvalidLengths_Throws) {
+  EXPECT_THROW(Base64Simd::decodedLength("Zm9vY", 5), std::runtime_error);
+  EXPECT_THROW(Base64Simd::decodedLength("Zm9vY=", 6), std::runtime_error);
+  EXPECT_EQ(Base64Simd::decodedLength("Zm9vYg==", 8), 4u);
+  EXPECT_EQ(Base64Simd::decodedLength("Zm9vYg", 6), 4u);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "utils/pool/BufferPool.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+class BufferPoolTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    BufferPool::Config config;
+    config.enabled = true;
+    BufferPool::shared().configure(config);
+    _before = BufferPool::shared().stats();
+  }
+
+  void TearDown() override {
+    // The pool is process-wide; leave it as the other tests expect it
+    BufferPool::shared().configure(BufferPool::Config{});
+  }
+
+  BufferPool::Stats _before;
+};
+
+TEST_F(BufferPoolTest, Allocate_AfterBufferDropped_ReusesBlock) {
+  const uint8_t* first = BufferPool::shared().allocate(1000)->data();
+  auto second = BufferPool::shared().allocate(900);
+
+  EXPECT_EQ(second->data(), first);
+  EXPECT_EQ(second->size(), 900u);
+  EXPECT_EQ(BufferPool::shared().stats().hits, _before.hits + 1);
+}
+
+TEST_F(BufferPoolTest, Release_LeasedBuffer_RecyclesOnce) {
+  auto buffer = BufferPool::shared().allocate(4096);
+
+  EXPECT_TRUE(BufferPool::shared().release(buffer));
+  EXPECT_FALSE(BufferPool::shared().release(buffer));
+  buffer.reset();
+
+  EXPECT_EQ(BufferPool::shared().stats().releases, _before.releases + 1);
+}
+
+TEST_F(BufferPoolTest, Allocate_AboveMaxBufferSize_IsNotPooled) {
+  BufferPool::Config config;
+  config.enabled = true;
+  config.maxBufferSize = 1024;
+  BufferPool::shared().configure(config);
+
+  auto buffer = BufferPool::shared().allocate(2048);
+
+  EXPECT_FALSE(BufferPool::shared().release(buffer));
+  EXPECT_EQ(BufferPool::shared().stats().misses, _before.misses);
+}
+
+TEST_F(BufferPoolTest, ParseConfig_NegativeSize_ThrowsError) {
+  EXPECT_THROW(BufferPool::parseConfig(R"({"maxRetainedBytes":-1})"), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "channel/ChannelOptions.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+using nlohmann::json;
+
+namespace {
+
+json effective(const std::string& options) {
+  return json::parse(ChannelOptions::parse(options).toJson());
+}
+
+} // namespace
+
+TEST(ChannelOptionsTest, Parse_Empty_HasNoArguments) {
+  EXPECT_TRUE(ChannelOptions::parse("").values().empty());
+  EXPECT_TRUE(ChannelOptions::parse("{}").values().empty());
+}
+
+TEST(ChannelOptionsTest, Parse_KnownArguments_ConvertsByDeclaredType) {
+  const auto options = effective(R"({
+    "grpc.keepalive_time_ms": 30000,
+    "grpc.keepalive_permit_without_calls": true,
+    "grpc.enable_retries": 0,
+    "grpc.primary_user_agent": "app/1.0"
+  })");
+
+  EXPECT_EQ(options, json::parse(R"({
+    "grpc.keepalive_time_ms": 30000,
+    "grpc.keepalive_permit_without_calls": 1,
+    "grpc.enable_retries": 0,
+    "grpc.primary_user_agent": "app/1.0"
+  })"));
+}
+
+TEST(ChannelOptionsTest, Parse_OutOfRangeOrWrongType_Throws) {
+  for (const char* options : {
+           R"({"grpc.keepalive_time_ms": 0})",
+           R"({"grpc.keepalive_time_ms": 1.5})",
+           R"({"grpc.keepalive_time_ms": "30000"})",
+           R"({"grpc.keepalive_time_ms": 3000000000})",
+           R"({"grpc.http2.max_frame_size": 1024})",
+           R"({"grpc.default_compression_algorithm": 3})",
+           R"({"grpc.enable_retries": 2})",
+           R"({"grpc.enable_retries": "yes"})",
+           R"({"grpc.primary_user_agent": 1})",
+           R"({"grpc.some_future_argument": 0.5})",
+       }) {
+    EXPECT_THROW(ChannelOptions::parse(options), std::runtime_error) << options;
+  }
+}
+
+TEST(ChannelOptionsTest, Parse_BoundaryValues_Accepted) {
+  EXPECT_EQ(effective(R"({"grpc.http2.max_frame_size": 16384})")["grpc.http2.max_frame_size"], 16384);
+  EXPECT_EQ(effective(R"({"grpc.http2.max_frame_size": 16777215})")["grpc.http2.max_frame_size"], 16777215);
+  EXPECT_EQ(effective(R"({"grpc.max_receive_message_length": -1})")["grpc.max_receive_message_length"], -1);
+}
+
+TEST(ChannelOptionsTest, Parse_UnknownCoreArgument_PassesThroughJsonType) {
+  const auto options = effective(R"({"grpc.future_int": -5, "grpc.future_bool": false, "grpc.future_string": "x"})");
+
+  EXPECT_EQ(options, json::parse(R"({"grpc.future_int": -5, "grpc.future_bool": 0, "grpc.future_string": "x"})"));
+}
+
+TEST(ChannelOptionsTest, Parse_GrpcJsOnlyAndNullOptions_Ignored) {
+  const auto options = ChannelOptions::parse(
+      R"({"grpc-node.max_session_memory": 10, "channelOverride": {}, "grpc.keepalive_time_ms": null})");
+
+  EXPECT_TRUE(options.values().empty());
+}
+
+TEST(ChannelOptionsTest, Parse_NonGrpcOption_Throws) {
+  EXPECT_THROW(ChannelOptions::parse(R"({"keepalive": 1})"), std::runtime_error);
+  EXPECT_THROW(ChannelOptions::parse("[]"), std::runtime_error);
+  EXPECT_THROW(ChannelOptions::parse("{"), std::runtime_error);
+}
+
+TEST(ChannelOptionsTest, Parse_ServiceConfig_SerializedAsString) {
+  const auto options = effective(R"({"serviceConfig": {"loadBalancingConfig": [{"round_robin": {}}]}})");
+
+  EXPECT_EQ(json::parse(options["grpc.service_config"].get<std::string>()),
+            json::parse(R"({"loadBalancingConfig": [{"round_robin": {}}]})"));
+  EXPECT_THROW(ChannelOptions::parse(R"({"serviceConfig": "{}"})"), std::runtime_error);
+}
+
+TEST(ChannelOptionsTest, Parse_Preset_ExplicitArgumentsOverride) {
+  const auto preset = json::parse(ChannelOptions::preset("low-latency-interactive").toJson());
+  const auto options =
+      effective(R"({"preset": "low-latency-interactive", "grpc.keepalive_time_ms": 45000, "grpc.future": 1})");
+
+  json expected = preset;
+  expected["grpc.keepalive_time_ms"] = 45000;
+  expected["grpc.future"] = 1;
+  EXPECT_EQ(options, expected);
+  EXPECT_NE(preset["grpc.keepalive_time_ms"], 45000);
+}
+
+TEST(ChannelOptionsTest, Preset_EveryPreset_PassesValidation) {
+  for (const char* name : {"low-latency-interactive", "bulk-transfer"}) {
+    const auto preset = ChannelOptions::preset(name);
+    ASSERT_FALSE(preset.values().empty()) << name;
+
+    // Every preset value must be one the user could also have passed explicitly
+    EXPECT_EQ(ChannelOptions::parse(preset.toJson()).values(), preset.values()) << name;
+    EXPECT_EQ(ChannelOptions::parse(json{{"preset", name}}.dump()).values(), preset.values()) << name;
+  }
+}
+
+TEST(ChannelOptionsTest, Preset_EveryPreset_KeepaliveWithinDefaultServerPingPolicy) {
+  // gRPC servers answer pings more often than every 5 minutes with GOAWAY too_many_pings by default
+  for (const char* name : {"low-latency-interactive", "bulk-transfer"}) {
+    const auto preset = json::parse(ChannelOptions::preset(name).toJson());
+
+    if (preset.contains("grpc.keepalive_time_ms")) {
+      EXPECT_GE(preset["grpc.keepalive_time_ms"].get<int>(), 300000) << name;
+    }
+  }
+}
+
+TEST(ChannelOptionsTest, Parse_UnknownOrInvalidPreset_Throws) {
+  EXPECT_THROW(ChannelOptions::preset("fast"), std::runtime_error);
+  EXPECT_THROW(ChannelOptions::parse(R"({"preset": "fast"})"), std::runtime_error);
+  EXPECT_THROW(ChannelOptions::parse(R"({"preset": 1})"), std::runtime_error);
+}
+
+TEST(ChannelOptionsTest, ToChannelArguments_EffectiveArguments_AllForwarded) {
+  const auto options = ChannelOptions::parse(
+      R"({"preset": "bulk-transfer", "grpc.keepalive_time_ms": 45000, "grpc.primary_user_agent": "app/1.0"})");
+  const auto args = options.toChannelArguments();
+  const grpc_channel_args channelArgs = args.c_channel_args();
+
+  json forwarded = json::object();
+  for (size_t i = 0; i < channelArgs.num_args; i++) {
+    const grpc_arg& arg = channelArgs.args[i];
+    if (arg.type == GRPC_ARG_INTEGER) {
+      forwarded[arg.key] = arg.value.integer;
+    } else if (arg.type == GRPC_ARG_STRING) {
+      forwarded[arg.key] = arg.value.string;
+    }
+  }
+  const auto expected = json::parse(options.toJson());
+  for (const auto& [key, value] : expected.items()) {
+    EXPECT_EQ(forwarded[key], value) << key;
+  }
+  EXPECT_EQ(forwarded["grpc.keepalive_time_ms"], 45000);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
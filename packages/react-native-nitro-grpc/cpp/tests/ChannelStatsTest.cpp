@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "ClientFixture.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+class ChannelStatsTest : public ClientFixture {
+protected:
+  // Settles the call; returns whether it succeeded
+  bool call(const std::string& request, const std::string& metadataJson = "{}") {
+    auto future = _client->unaryCall("/test.Echo/Unary", bytes(request), metadataJson, 0, "")->await();
+    if (future.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+      throw std::runtime_error("unary call did not complete");
+    }
+    try {
+      future.get();
+      return true;
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+
+  nlohmann::json stats(bool reset = false) {
+    return nlohmann::json::parse(_client->getStats(reset));
+  }
+};
+
+TEST_F(ChannelStatsTest, GetStats_UnaryCalls_CountsOutcomesAndBytes) {
+  EXPECT_TRUE(call("hello"));
+  EXPECT_TRUE(call("hello"));
+  EXPECT_FALSE(call("hello", R"({"x-status":["5"]})"));
+
+  const auto s = stats();
+  EXPECT_EQ(s["callsStarted"], 3);
+  EXPECT_EQ(s["callsSucceeded"], 2);
+  EXPECT_EQ(s["callsFailed"], 1);
+  EXPECT_EQ(s["failuresByCode"]["5"], 1);
+  EXPECT_EQ(s["activeCalls"], 0);
+  EXPECT_EQ(s["messagesSent"], 3);
+  EXPECT_EQ(s["bytesSent"], 15);
+  EXPECT_EQ(s["messagesReceived"], 2);
+  EXPECT_EQ(s["bytesReceived"], 10);
+
+  const auto& method = s["methods"]["/test.Echo/Unary"];
+  EXPECT_EQ(method["callsStarted"], 3);
+  EXPECT_EQ(method["failuresByCode"]["5"], 1);
+}
+
+TEST_F(ChannelStatsTest, GetStats_ServerStream_CountsMessages) {
+  auto stream = _client->createServerStreamSync("/test.Echo/Server", bytes("tick"), R"({"x-repeat":["3"]})", 0);
+  while (std::holds_alternative<std::shared_ptr<ArrayBuffer>>(stream->readSync())) {
+  }
+
+  const auto s = stats()["methods"]["/test.Echo/Server"];
+  EXPECT_EQ(s["callsSucceeded"], 1);
+  EXPECT_EQ(s["activeStreams"], 0);
+  EXPECT_EQ(s["messagesSent"], 1);
+  EXPECT_EQ(s["messagesReceived"], 3);
+  EXPECT_EQ(s["bytesReceived"], 12);
+}
+
+TEST_F(ChannelStatsTest, GetStats_Reset_RestartsCounters) {
+  EXPECT_TRUE(call("hello"));
+
+  EXPECT_EQ(stats(true)["callsStarted"], 1);
+  const auto s = stats();
+  EXPECT_EQ(s["callsStarted"], 0);
+  EXPECT_EQ(s["bytesSent"], 0);
+  EXPECT_EQ(s["methods"]["/test.Echo/Unary"]["callsSucceeded"], 0);
+}
+
+TEST_F(ChannelStatsTest, GetStats_ConnectionAfterIdle_CountsReconnect) {
+  // gRPC does not go idle sooner than after one second
+  _client->connect(_server.target(), R"({"type":"insecure"})", R"({"grpc.client_idle_timeout_ms":1000})");
+  EXPECT_TRUE(call("hello"));
+  EXPECT_EQ(stats()["reconnects"], 0);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+  EXPECT_TRUE(call("hello"));
+  // The watcher sees READY on the queue thread, possibly just after the call returns
+  for (int i = 0; i < 50 && stats()["reconnects"] == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(stats()["reconnects"], 1);
+}
+
+TEST_F(ChannelStatsTest, GetLatencyPercentiles_UnaryCalls_CoversEveryCall) {
+  EXPECT_TRUE(call("hello"));
+  EXPECT_TRUE(call("hello"));
+  EXPECT_FALSE(call("hello", R"({"x-status":["5"]})"));
+
+  const auto latency = nlohmann::json::parse(_client->getLatencyPercentiles("/test.Echo/Unary", {50, 100}));
+  EXPECT_EQ(latency["count"], 3);
+  EXPECT_GT(latency["max"].get<double>(), 0);
+  EXPECT_LE(latency["values"][0].get<double>(), latency["values"][1].get<double>());
+  EXPECT_EQ(latency["values"][1].get<double>(), latency["max"].get<double>());
+
+  const auto sizes = nlohmann::json::parse(_client->getMessageSizePercentiles("/test.Echo/Unary", {50}));
+  EXPECT_EQ(sizes["sent"]["count"], 3);
+  EXPECT_EQ(sizes["sent"]["values"][0], 5);
+  EXPECT_EQ(sizes["received"]["count"], 2);
+}
+
+TEST_F(ChannelStatsTest, GetLatencyPercentiles_UnknownMethod_ReturnsZeros) {
+  const auto latency = nlohmann::json::parse(_client->getLatencyPercentiles("/test.Echo/Missing", {50, 99}));
+  EXPECT_EQ(latency["count"], 0);
+  EXPECT_EQ(latency["values"], nlohmann::json::array({0, 0}));
+}
+
+TEST_F(ChannelStatsTest, ConfigureHistograms_InvalidWindow_Throws) {
+  EXPECT_THROW(_client->configureHistograms(R"({"windowMs":0})"), std::runtime_error);
+  EXPECT_THROW(_client->configureHistograms("not json"), std::runtime_error);
+  EXPECT_NO_THROW(_client->configureHistograms(R"({"windowMs":60000})"));
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
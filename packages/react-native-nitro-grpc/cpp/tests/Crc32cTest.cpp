@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/checksum/Crc32c.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+// Bit-at-a-time CRC32C: slow, but shares nothing with the table or hardware kernels
+uint32_t referenceCrc(uint32_t crc, const uint8_t* data, size_t length) {
+  crc = ~crc;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+std::vector<uint8_t> pattern(size_t length) {
+  std::vector<uint8_t> data(length);
+  for (size_t i = 0; i < length; i++) {
+    data[i] = static_cast<uint8_t>(i * 167 + 13);
+  }
+  return data;
+}
+
+// Three 4 KiB lanes are hashed in parallel once this much data is left
+constexpr size_t kLaneBlock = 3 * 4096;
+
+} // namespace
+
+TEST(Crc32cTest, Value_Rfc3720Vectors_MatchExpected) {
+  std::vector<uint8_t> ascending(32);
+  std::vector<uint8_t> descending(32);
+  for (uint8_t i = 0; i < 32; i++) {
+    ascending[i] = i;
+    descending[i] = 31 - i;
+  }
+  const std::string check = "123456789";
+
+  EXPECT_EQ(Crc32c::value(std::vector<uint8_t>(32, 0x00).data(), 32), 0x8A9136AAu);
+  EXPECT_EQ(Crc32c::value(std::vector<uint8_t>(32, 0xff).data(), 32), 0x62A8AB43u);
+  EXPECT_EQ(Crc32c::value(ascending.data(), 32), 0x46DD794Eu);
+  EXPECT_EQ(Crc32c::value(descending.data(), 32), 0x113FDB5Cu);
+  EXPECT_EQ(Crc32c::value(reinterpret_cast<const uint8_t*>(check.data()), check.size()), 0xE3069283u);
+  EXPECT_EQ(Crc32c::value(nullptr, 0), 0u);
+}
+
+TEST(Crc32cTest, Value_AllLengthsAndAlignments_MatchReference) {
+  const auto data = pattern(300 + 8);
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 0; length <= 300; length++) {
+      EXPECT_EQ(Crc32c::value(data.data() + offset, length), referenceCrc(0, data.data() + offset, length))
+          << "offset " << offset << " length " << length << " (" << Crc32c::implementationName() << ")";
+    }
+  }
+}
+
+TEST(Crc32cTest, Value_AroundLaneBlocks_MatchReference) {
+  const auto data = pattern(3 * kLaneBlock + 64);
+  for (size_t length : {kLaneBlock - 1, kLaneBlock, kLaneBlock + 1, kLaneBlock + 13, 2 * kLaneBlock + 7,
+                        3 * kLaneBlock + 63}) {
+    EXPECT_EQ(Crc32c::value(data.data() + 1, length), referenceCrc(0, data.data() + 1, length))
+        << "length " << length << " (" << Crc32c::implementationName() << ")";
+  }
+}
+
+TEST(Crc32cTest, Extend_SplitInput_MatchesWholeBuffer) {
+  const auto data = pattern(kLaneBlock + 100);
+  const uint32_t whole = Crc32c::value(data.data(), data.size());
+
+  for (size_t split : {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{100}, kLaneBlock, data.size()}) {
+    const uint32_t head = Crc32c::value(data.data(), split);
+    EXPECT_EQ(Crc32c::extend(head, data.data() + split, data.size() - split), whole) << "split at " << split;
+  }
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "HybridGrpcClient.hpp"
+#include "auth/CredentialsRegistry.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+// The registry is process-wide; a unique name keeps each test's entries apart.
+std::string sslCredentials(const std::string& name) {
+  return R"({"type":"ssl","rootCerts":"unused-)" + name + R"(","targetNameOverride":"example.test"})";
+}
+
+std::string bearer(const std::string& token) {
+  return R"({"type":"bearer","token":")" + token + R"("})";
+}
+
+// Enough registrations to push every unheld handle out of the handle cache
+void rotateTokens(const std::string& name) {
+  for (int i = 0; i < 64; i++) {
+    CredentialsRegistry::shared().registerCredentials(sslCredentials(name), bearer("token-" + std::to_string(i)));
+  }
+}
+
+} // namespace
+
+TEST(CredentialsRegistryTest, Register_SameConfiguration_ReturnsSameHandleAndCredentials) {
+  auto& registry = CredentialsRegistry::shared();
+  const auto handle = registry.registerCredentials(sslCredentials("same"), bearer("a")).handle;
+
+  EXPECT_EQ(registry.registerCredentials(sslCredentials("same"), bearer("a")).handle, handle);
+  const auto first = registry.lookup(handle);
+  const auto second = registry.lookup(handle);
+  ASSERT_NE(first.credentials, nullptr);
+  EXPECT_EQ(first.credentials, second.credentials);
+  EXPECT_EQ(first.targetNameOverride, "example.test");
+}
+
+TEST(CredentialsRegistryTest, Register_DifferentCallCredentials_DifferentHandles) {
+  auto& registry = CredentialsRegistry::shared();
+  const auto none = registry.registerCredentials(sslCredentials("call"), "").handle;
+  const auto a = registry.registerCredentials(sslCredentials("call"), bearer("a")).handle;
+  const auto b = registry.registerCredentials(sslCredentials("call"), bearer("b")).handle;
+
+  EXPECT_NE(none, a);
+  EXPECT_NE(a, b);
+  EXPECT_NE(registry.lookup(a).credentials, registry.lookup(b).credentials);
+}
+
+TEST(CredentialsRegistryTest, Register_ManyTokens_EvictsOldHandlesButReusesChannelCredentials) {
+  auto& registry = CredentialsRegistry::shared();
+  const auto plain = registry.registerCredentials(sslCredentials("rotate"), "").handle;
+  const auto channel = registry.lookup(plain).credentials;
+
+  // Rotating tokens pushes the token-less handle, which nothing holds, out of the handle cache...
+  rotateTokens("rotate");
+  EXPECT_THROW(registry.lookup(plain), std::runtime_error);
+
+  // ...but the TLS configuration it was built from is still cached and shared
+  EXPECT_EQ(registry.registerCredentials(sslCredentials("rotate"), "").handle, plain);
+  EXPECT_EQ(registry.lookup(plain).credentials, channel);
+}
+
+TEST(CredentialsRegistryTest, Lookup_EvictedButHeld_ReturnsSameCredentialsUntilReleased) {
+  auto& registry = CredentialsRegistry::shared();
+  auto registration = registry.registerCredentials(sslCredentials("held"), "");
+
+  rotateTokens("held");
+  EXPECT_EQ(registry.lookup(registration.handle).credentials, registration.entry->credentials);
+
+  const auto handle = registration.handle;
+  registration.entry.reset();
+  rotateTokens("held");
+  EXPECT_THROW(registry.lookup(handle), std::runtime_error);
+}
+
+TEST(CredentialsRegistryTest, ConnectWithCredentials_HandleEvictedAfterRegister_Connects) {
+  auto client = std::make_shared<HybridGrpcClient>();
+  const auto handle = client->registerCredentials(sslCredentials("client"), "");
+
+  // Other clients register enough configurations to evict the handle
+  rotateTokens("client");
+
+  EXPECT_NO_THROW(client->connectWithCredentials("localhost:1", handle, "{}"));
+  client->close();
+}
+
+TEST(CredentialsRegistryTest, Register_InvalidConfiguration_Throws) {
+  auto& registry = CredentialsRegistry::shared();
+
+  EXPECT_THROW(registry.registerCredentials("{", ""), std::runtime_error);
+  EXPECT_THROW(registry.registerCredentials(R"({"type":"tls"})", ""), std::runtime_error);
+  EXPECT_THROW(registry.registerCredentials(sslCredentials("invalid"), R"({"type":"bearer"})"), std::runtime_error);
+  // gRPC refuses to send call credentials over plaintext
+  EXPECT_THROW(registry.registerCredentials(R"({"type":"insecure"})", bearer("a")), std::runtime_error);
+}
+
+TEST(CredentialsRegistryTest, Lookup_UnknownHandle_Throws) {
+  EXPECT_THROW(CredentialsRegistry::shared().lookup("0123456789abcdef"), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ClientFixture.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+/**
+ * Registers all callbacks the way the JS wrappers do and records what arrives.
+ */
+class StreamRecorder {
+public:
+  explicit StreamRecorder(const std::shared_ptr<HybridGrpcStreamSpec>& stream) {
+    stream->onMetadata([this](const std::shared_ptr<HybridCallMetadataSpec>& metadata) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _events += "M";
+      _headers = metadata;
+    });
+    stream->onData([this](const std::shared_ptr<ArrayBuffer>& data) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _events += "D";
+      _messages.emplace_back(reinterpret_cast<const char*>(data->data()), data->size());
+    });
+    stream->onStatus(
+        [this](double code, const std::string& message, const std::shared_ptr<HybridCallMetadataSpec>& trailers) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _events += "S";
+          _code = static_cast<int>(code);
+          _message = message;
+          _trailers = trailers;
+          _cv.notify_all();
+        });
+    stream->onError([](const std::string&) {});
+  }
+
+  bool waitForStatus() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _cv.wait_for(lock, std::chrono::seconds(10), [this]() { return _trailers != nullptr; });
+  }
+
+  std::string _events;
+  std::vector<std::string> _messages;
+  int _code = -1;
+  std::string _message;
+  std::shared_ptr<HybridCallMetadataSpec> _headers;
+  std::shared_ptr<HybridCallMetadataSpec> _trailers;
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _cv;
+};
+
+class GrpcStreamTest : public ClientFixture {};
+
+TEST_F(GrpcStreamTest, ServerStream_Repeat_DeliversAllMessagesThenStatus) {
+  auto stream = _client->createServerStream("/test.Echo/Server", bytes("tick"), R"({"x-repeat":["5"]})", 0);
+  StreamRecorder recorder(stream);
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._code, 0);
+  EXPECT_EQ(recorder._messages, std::vector<std::string>(5, "tick"));
+  EXPECT_EQ(recorder._events.back(), 'S');
+}
+
+TEST_F(GrpcStreamTest, ServerStream_EchoMetadata_DeliversHeadersFirstAndTrailers) {
+  auto stream = _client->createServerStream(
+      "/test.Echo/Server", bytes("tick"), R"({"x-echo-metadata":["1"],"x-hdr":["h1","h2"]})", 0);
+  StreamRecorder recorder(stream);
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._events, "MDS");
+  ASSERT_NE(recorder._headers, nullptr);
+  EXPECT_EQ(recorder._headers->get("X-HDR"), (std::vector<std::string>{"h1", "h2"}));
+  EXPECT_EQ(recorder._trailers->get("x-trailer"), std::vector<std::string>{"done"});
+}
+
+TEST_F(GrpcStreamTest, ServerStream_ServerError_ReportsStatus) {
+  auto stream = _client->createServerStream(
+      "/test.Echo/Server", bytes("tick"), R"({"x-status":["7"],"x-status-message":["denied"]})", 0);
+  StreamRecorder recorder(stream);
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._code, 7);
+  EXPECT_EQ(recorder._message, "denied");
+}
+
+TEST_F(GrpcStreamTest, ServerStreamSync_Repeat_ReadsUntilEnd) {
+  auto stream = _client->createServerStreamSync("/test.Echo/Server", bytes("tick"), R"({"x-repeat":["3"]})", 0);
+
+  int count = 0;
+  while (std::holds_alternative<std::shared_ptr<ArrayBuffer>>(stream->readSync())) {
+    count++;
+  }
+  EXPECT_EQ(count, 3);
+}
+
+TEST_F(GrpcStreamTest, ClientStream_ReplyAtEnd_ReceivesLastMessage) {
+  auto stream = _client->createClientStream("/test.Echo/Client", R"({"x-reply-at-end":["1"]})", 0);
+  StreamRecorder recorder(stream);
+
+  for (const char* message : {"a", "b", "c"}) {
+    stream->write(bytes(message));
+  }
+  stream->writesDone();
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._code, 0);
+  EXPECT_EQ(recorder._messages, std::vector<std::string>{"c"});
+  EXPECT_EQ(_server.requestCount(), 3u);
+}
+
+TEST_F(GrpcStreamTest, BidiStream_Echo_ReturnsEachMessage) {
+  auto stream = _client->createBidiStream("/test.Echo/Bidi", "{}", 0);
+  StreamRecorder recorder(stream);
+
+  stream->write(bytes("ping"));
+  stream->write(bytes("pong"));
+  stream->writesDone();
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._messages, (std::vector<std::string>{"ping", "pong"}));
+  EXPECT_EQ(recorder._events, "MDDS");
+}
+
+TEST_F(GrpcStreamTest, BidiStream_WritesBeforeStartAndBackToBack_AllSentInOrder) {
+  auto stream = _client->createBidiStream("/test.Echo/Bidi", "{}", 0);
+  // Issued before StartCall completes and without waiting for each other
+  std::vector<std::string> sent;
+  for (int i = 0; i < 50; i++) {
+    sent.push_back("message-" + std::to_string(i));
+    stream->write(bytes(sent.back()));
+  }
+  stream->writesDone();
+  StreamRecorder recorder(stream);
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._code, 0);
+  EXPECT_EQ(recorder._messages, sent);
+  EXPECT_EQ(_server.requestCount(), sent.size());
+}
+
+TEST_F(GrpcStreamTest, ClientStream_WritesBeforeStart_AllCounted) {
+  auto stream = _client->createClientStream("/test.Echo/Client", R"({"x-reply-at-end":["1"]})", 0);
+  for (int i = 0; i < 20; i++) {
+    stream->write(bytes(std::to_string(i)));
+  }
+  stream->writesDone();
+  StreamRecorder recorder(stream);
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._code, 0);
+  EXPECT_EQ(recorder._messages, std::vector<std::string>{"19"});
+  EXPECT_EQ(_server.requestCount(), 20u);
+}
+
+TEST_F(GrpcStreamTest, BidiStream_WriteAfterFinish_Ignored) {
+  auto stream = _client->createBidiStream("/test.Echo/Bidi", "{}", 0);
+  StreamRecorder recorder(stream);
+  stream->writesDone();
+  ASSERT_TRUE(recorder.waitForStatus());
+
+  stream->write(bytes("late"));
+  stream->writesDone();
+
+  EXPECT_EQ(_server.requestCount(), 0u);
+}
+
+TEST_F(GrpcStreamTest, BidiStream_CancelInFlight_ReportsCancelled) {
+  auto stream = _client->createBidiStream("/test.Echo/Bidi", R"({"x-delay-ms":["300"]})", 0);
+  StreamRecorder recorder(stream);
+
+  stream->write(bytes("slow"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  stream->cancel();
+
+  ASSERT_TRUE(recorder.waitForStatus());
+  EXPECT_EQ(recorder._code, 1);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
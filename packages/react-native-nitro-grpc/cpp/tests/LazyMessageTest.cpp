@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "HybridLazyMessage.hpp"
+#include "MessageIndex.hpp"
+#include "fixtures/ProtoFixture.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+using nlohmann::json;
+
+namespace {
+
+// Outer, deliberately written the way real senders split things up:
+//   child { name: "a" ids: [1] }         first half of a split message
+//   repeated {
+//     packed_int32: [1, 150] packed_int32: 7 packed_int32: [-1, 2, 3]
+//     unpacked_int32: [5, 6] (as one packed run)
+//     packed_double: [0.5, 1.5, 2.5]
+//     packed_fixed32: [10, 11, 12]
+//     children { name: "x" } children { value: 2 }
+//   }
+//   tail: "end"
+//   child { value: 9 ids: [2, 3] }       second half; merges into the first
+//   maps { counts { key: "k" value: 4 } }
+const std::vector<uint8_t> kSplitOuter = [] {
+  const std::vector<uint8_t> repeated = {
+      0x0a, 0x03, 0x01, 0x96, 0x01,                                           // packed_int32 [1, 150]
+      0x08, 0x07,                                                             // packed_int32 7, unpacked
+      0x0a, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, // packed_int32 [-1,
+      0x02, 0x03,                                                             //   2, 3]
+      0x12, 0x02, 0x05, 0x06,                                                 // unpacked_int32 packed [5, 6]
+      0x1a, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x3f,             // packed_double [0.5,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f,                         //   1.5,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x40,                         //   2.5]
+      0x2a, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, // fixed32 [10, 11, 12]
+      0x3a, 0x03, 0x0a, 0x01, 0x78,                                           // children { name: "x" }
+      0x3a, 0x02, 0x10, 0x02,                                                 // children { value: 2 }
+  };
+  std::vector<uint8_t> bytes = {0x0a, 0x06, 0x0a, 0x01, 0x61, 0x1a, 0x01, 0x01}; // child, first half
+  bytes.push_back(0x12);
+  WireFormat::writeVarint(bytes, repeated.size());
+  bytes.insert(bytes.end(), repeated.begin(), repeated.end());
+  const std::vector<uint8_t> rest = {
+      0x1a, 0x03, 0x65, 0x6e, 0x64,                         // tail: "end"
+      0x0a, 0x06, 0x10, 0x09, 0x1a, 0x02, 0x02, 0x03,       // child, second half
+      0x22, 0x07, 0x0a, 0x05, 0x0a, 0x01, 0x6b, 0x10, 0x04, // maps
+  };
+  bytes.insert(bytes.end(), rest.begin(), rest.end());
+  return bytes;
+}();
+
+} // namespace
+
+class LazyMessageTest : public ProtoFixture {
+protected:
+  std::shared_ptr<HybridLazyMessage> lazy(const std::string& type, const std::vector<uint8_t>& bytes) {
+    // Offset into a larger buffer, as views of received messages are
+    std::vector<uint8_t> padded = {0xee, 0xee, 0xee};
+    padded.insert(padded.end(), bytes.begin(), bytes.end());
+    padded.push_back(0xee);
+    return std::make_shared<HybridLazyMessage>(_schema, plan(type), ArrayBuffer::copy(padded), 3, bytes.size());
+  }
+
+  static json toJson(const std::shared_ptr<AnyMap>& map) {
+    return ProtoFixture::toJson(map->getMap());
+  }
+
+  // What a full decode yields for `field` (null if absent)
+  json decodedField(const std::string& type, const std::vector<uint8_t>& bytes, const std::string& field) {
+    const json full = ProtoFixture::toJson(decode(type, bytes));
+    return full.contains(field) ? full[field] : json();
+  }
+};
+
+TEST_F(LazyMessageTest, Pick_EveryField_MatchesFullDecode) {
+  const json full = ProtoFixture::toJson(decode("Outer", kSplitOuter));
+  auto message = lazy("Outer", kSplitOuter);
+
+  EXPECT_EQ(toJson(message->pick({"child", "repeated", "tail", "maps"})), full);
+  for (const auto& [name, value] : full.items()) {
+    EXPECT_EQ(toJson(message->pick({name}))[name], value) << name;
+  }
+  EXPECT_EQ(toJson(message->decode()), full);
+}
+
+TEST_F(LazyMessageTest, Pick_NestedRepeated_MatchesFullDecode) {
+  const auto& repeatedField = *plan("Outer").fieldNamed("repeated");
+  MessageIndex outer(plan("Outer"), kSplitOuter.data(), kSplitOuter.size());
+  const auto [payload, size] = MessageIndex::payload(outer.occurrences(repeatedField)[0], kSplitOuter.data());
+  const std::vector<uint8_t> repeated(payload, payload + size);
+  const json full = ProtoFixture::toJson(decode("Repeated", repeated));
+  ASSERT_EQ(full["packedInt32"], json::parse("[1, 150, 7, -1, 2, 3]"));
+
+  auto message = lazy("Repeated", repeated);
+  for (const auto& [name, value] : full.items()) {
+    EXPECT_EQ(toJson(message->pick({name}))[name], value) << name;
+  }
+}
+
+TEST_F(LazyMessageTest, Slice_EveryRange_MatchesFullDecode) {
+  auto outer = lazy("Outer", kSplitOuter);
+  auto repeated = outer->getMessage("repeated", 0);
+  ASSERT_TRUE(repeated.has_value());
+  const json full = toJson((*repeated)->decode());
+
+  for (const std::string field : {"packedInt32", "unpackedInt32", "packedDouble", "packedFixed32", "children"}) {
+    const auto& values = full[field];
+    const auto total = static_cast<int>(values.size());
+    ASSERT_EQ((*repeated)->count(field), total) << field;
+    for (int start = 0; start <= total; start++) {
+      for (int end = start; end <= total + 1; end++) {
+        json expected = json::array();
+        for (int i = start; i < std::min(end, total); i++) {
+          expected.push_back(values[i]);
+        }
+
+        EXPECT_EQ(toJson((*repeated)->slice(field, start, end))[field], expected)
+            << field << "[" << start << ", " << end << ")";
+      }
+    }
+  }
+}
+
+TEST_F(LazyMessageTest, GetMessage_SplitSingularMessage_MatchesMergedDecode) {
+  auto message = lazy("Outer", kSplitOuter);
+  const json expected = decodedField("Outer", kSplitOuter, "child");
+  ASSERT_EQ(expected, json::parse(R"({"name":"a","value":9,"ids":[1,2,3]})"));
+
+  auto child = message->getMessage("child", 0);
+  ASSERT_TRUE(child.has_value());
+  EXPECT_EQ(toJson((*child)->decode()), expected);
+  EXPECT_EQ(toJson((*child)->pick({"ids"}))["ids"], expected["ids"]);
+  EXPECT_EQ((*child)->count("ids"), 3);
+  EXPECT_FALSE(message->getMessage("child", 1).has_value());
+}
+
+TEST_F(LazyMessageTest, GetMessage_RepeatedMessages_MatchFullDecode) {
+  auto outer = lazy("Outer", kSplitOuter);
+  auto repeated = *outer->getMessage("repeated", 0);
+  const json children = toJson(repeated->decode())["children"];
+
+  ASSERT_EQ(repeated->count("children"), children.size());
+  for (size_t i = 0; i < children.size(); i++) {
+    auto child = repeated->getMessage("children", static_cast<double>(i));
+    ASSERT_TRUE(child.has_value());
+    EXPECT_EQ(toJson((*child)->decode()), children[i]) << i;
+  }
+  EXPECT_FALSE(repeated->getMessage("children", static_cast<double>(children.size())).has_value());
+}
+
+TEST_F(LazyMessageTest, HasAndCount_MatchFullDecode) {
+  auto outer = lazy("Outer", kSplitOuter);
+  const json full = ProtoFixture::toJson(decode("Outer", kSplitOuter));
+
+  for (const auto& field : plan("Outer").fields) {
+    EXPECT_EQ(outer->has(field.name), full.contains(field.name)) << field.name;
+  }
+  EXPECT_EQ(outer->count("child"), 1);
+  EXPECT_EQ(outer->count("tail"), 1);
+
+  auto maps = *outer->getMessage("maps", 0);
+  EXPECT_EQ(maps->count("counts"), 1);
+  EXPECT_EQ(toJson(maps->pick({"counts"})), full["maps"]);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
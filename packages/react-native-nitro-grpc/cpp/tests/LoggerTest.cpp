@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../logging/Logger.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+class LoggerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Logger::shared().configure({LogLevel::INFO, false});
+    Logger::shared().setHandler([this](const Logger::Entry& entry) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _entries.push_back(std::string(Logger::levelName(entry.level)) + " " + entry.tag + " " + entry.message);
+    });
+  }
+
+  void TearDown() override {
+    Logger::shared().flush();
+    Logger::shared().setHandler(nullptr);
+    Logger::shared().configure({});
+  }
+
+  std::vector<std::string> entries() {
+    Logger::shared().flush();
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries;
+  }
+
+  std::mutex _mutex;
+  std::vector<std::string> _entries;
+};
+
+TEST_F(LoggerTest, Log_BelowLevel_Skipped) {
+  Logger::shared().configure({LogLevel::WARN, false});
+  RNGRPC_LOG_INFO("test", "hidden");
+  RNGRPC_LOG_WARN("test", "shown");
+  RNGRPC_LOG_ERROR("test", "also shown");
+
+  EXPECT_EQ(entries(), (std::vector<std::string>{"warn test shown", "error test also shown"}));
+}
+
+TEST_F(LoggerTest, Log_DisabledLevel_DoesNotBuildMessage) {
+  int built = 0;
+  auto message = [&built]() {
+    built++;
+    return std::string("expensive");
+  };
+  RNGRPC_LOG_VERBOSE("test", message());
+  RNGRPC_LOG_INFO("test", message());
+
+  EXPECT_EQ(built, 1);
+  EXPECT_EQ(entries(), (std::vector<std::string>{"info test expensive"}));
+}
+
+TEST_F(LoggerTest, Log_RingFull_DropsOldestAndReportsCount) {
+  // Hold the logger thread in the handler while the ring fills up
+  std::mutex gateMutex;
+  std::condition_variable gate;
+  bool blocked = false;
+  bool open = false;
+  Logger::shared().setHandler([&](const Logger::Entry& entry) {
+    std::unique_lock<std::mutex> lock(gateMutex);
+    blocked = true;
+    gate.notify_all();
+    gate.wait(lock, [&open]() { return open; });
+    std::lock_guard<std::mutex> entriesLock(_mutex);
+    _entries.push_back(entry.message);
+  });
+
+  RNGRPC_LOG_INFO("test", "first");
+  {
+    std::unique_lock<std::mutex> lock(gateMutex);
+    gate.wait(lock, [&blocked]() { return blocked; });
+  }
+  for (size_t i = 0; i < Logger::kCapacity + 3; i++) {
+    RNGRPC_LOG_INFO("test", std::to_string(i));
+  }
+  {
+    std::lock_guard<std::mutex> lock(gateMutex);
+    open = true;
+  }
+  gate.notify_all();
+
+  const auto logged = entries();
+  ASSERT_EQ(logged.size(), Logger::kCapacity + 2);
+  EXPECT_EQ(logged[0], "first");
+  EXPECT_EQ(logged[1], "Dropped 3 log messages");
+  EXPECT_EQ(logged[2], "3");
+  EXPECT_EQ(logged.back(), std::to_string(Logger::kCapacity + 2));
+}
+
+TEST_F(LoggerTest, ParseConfig_Levels_Parsed) {
+  EXPECT_EQ(Logger::parseConfig(R"({"level":"verbose"})").level, LogLevel::VERBOSE);
+  EXPECT_EQ(Logger::parseConfig(R"({"level":"off"})").level, LogLevel::OFF);
+  EXPECT_FALSE(Logger::parseConfig(R"({"platform":false})").platform);
+  EXPECT_EQ(Logger::parseConfig("{}").level, LogLevel::INFO);
+}
+
+TEST_F(LoggerTest, ParseConfig_Invalid_Throws) {
+  EXPECT_THROW(Logger::parseConfig(R"({"level":"loud"})"), std::runtime_error);
+  EXPECT_THROW(Logger::parseConfig(R"({"level":3})"), std::runtime_error);
+  EXPECT_THROW(Logger::parseConfig("not json"), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
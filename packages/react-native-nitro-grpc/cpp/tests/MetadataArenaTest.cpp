@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/client_unary_call.h>
+#include <grpcpp/impl/rpc_method.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "TestServer.hpp"
+#include "metadata/MetadataArena.hpp"
+#include "metadata/MetadataConverter.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+/**
+ * MetadataArena must add exactly what MetadataConverter::applyMetadata adds,
+ * so both are compared by the headers the server receives.
+ */
+class MetadataArenaTest : public ::testing::Test {
+protected:
+  using Headers = std::multimap<std::string, std::string>;
+
+  // The `x-` headers the server receives for a call whose context `apply` filled
+  Headers sent(const std::function<void(::grpc::ClientContext&)>& apply) {
+    ::grpc::ClientContext context;
+    apply(context);
+    ::grpc::Slice slice("x", 1);
+    ::grpc::ByteBuffer request(&slice, 1);
+    ::grpc::ByteBuffer response;
+    const ::grpc::internal::RpcMethod method("/test.Echo/Unary", ::grpc::internal::RpcMethod::NORMAL_RPC);
+    const auto status = ::grpc::internal::BlockingUnaryCall(_channel.get(), method, &context, request, &response);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+    return _server.lastClientMetadata();
+  }
+
+  Headers sentByArena(const std::string& json) {
+    return sent([&](::grpc::ClientContext& context) { _arena.apply(json, context); });
+  }
+
+  Headers sentByConverter(const std::string& json) {
+    return sent([&](::grpc::ClientContext& context) { MetadataConverter::applyMetadata(json, context); });
+  }
+
+  void expectSameAsConverter(const std::string& json) {
+    EXPECT_EQ(sentByArena(json), sentByConverter(json)) << json;
+  }
+
+  TestServer _server;
+  std::shared_ptr<::grpc::Channel> _channel =
+      ::grpc::CreateChannel(_server.target(), ::grpc::InsecureChannelCredentials());
+  // One arena for the whole test, as a pooled call record reuses it
+  MetadataArena _arena;
+};
+
+TEST_F(MetadataArenaTest, Apply_ArrayAndStringValues_MatchesConverter) {
+  for (const char* json : {
+           R"({"x-a":["1","2"],"x-b":["only"]})",
+           R"({"x-a":"single","x-b":[]})",
+           R"( { "x-a" : [ "1" , "2" ] ,
+               "x-b" : "3" } )",
+       }) {
+    expectSameAsConverter(json);
+  }
+  EXPECT_EQ(sentByArena(R"({"x-a":["1","2"],"x-b":"3"})"), (Headers{{"x-a", "1"}, {"x-a", "2"}, {"x-b", "3"}}));
+}
+
+TEST_F(MetadataArenaTest, Apply_Escapes_MatchesConverter) {
+  // Binary keys, so control characters and UTF-8 survive the transport unchanged
+  const std::string escapes = R"({"x-e-bin":["\"\\\/\b\f\n\r\t"]})";
+  const std::string unicode = R"({"x-u-bin":["caf\u00e9 \u20AC \ud83d\ude00 \u0041"]})";
+
+  expectSameAsConverter(escapes);
+  expectSameAsConverter(unicode);
+  EXPECT_EQ(sentByArena(escapes), (Headers{{"x-e-bin", "\"\\/\b\f\n\r\t"}}));
+  EXPECT_EQ(sentByArena(unicode), (Headers{{"x-u-bin", "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 A"}}));
+}
+
+TEST_F(MetadataArenaTest, Apply_NonStringValues_FallsBackToConverter) {
+  for (const char* json : {
+           R"({"x-n":[1,"a"],"x-s":"v"})",
+           R"({"x-n":true,"x-s":"v"})",
+           R"({"x-n":null})",
+           R"({"x-o":{"k":"v"}})",
+           "[]",
+       }) {
+    expectSameAsConverter(json);
+  }
+}
+
+TEST_F(MetadataArenaTest, Apply_MalformedJson_ThrowsLikeConverter) {
+  for (const char* json : {
+           "{",
+           R"({"x-a":["1"])",
+           R"({"x-a" "1"})",
+           R"({"x-a":["1",]})",
+           R"({"x-a":"\q"})",
+           R"({"x-a":"\u12"})",
+           R"({"x-a":"\ud83d"})",
+           R"({"x-a":"\ude00"})",
+           R"({"x-a":"1"} trailing)",
+       }) {
+    ::grpc::ClientContext arenaContext;
+    ::grpc::ClientContext converterContext;
+    EXPECT_THROW(_arena.apply(json, arenaContext), std::runtime_error) << json;
+    EXPECT_THROW(MetadataConverter::applyMetadata(json, converterContext), std::runtime_error) << json;
+  }
+
+  // Nothing parsed before the error leaks into the next call
+  EXPECT_EQ(sentByArena(R"({"x-b":"2"})"), (Headers{{"x-b", "2"}}));
+}
+
+TEST_F(MetadataArenaTest, Apply_Empty_AddsNothing) {
+  for (const char* json : {"", "{}", " { } "}) {
+    EXPECT_TRUE(sentByArena(json).empty()) << json;
+    expectSameAsConverter(json);
+  }
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include <nlohmann/json.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "metadata/MetadataConverter.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+using Multimap = std::multimap<::grpc::string_ref, ::grpc::string_ref>;
+
+TEST(MetadataConverterTest, ValueToString_TextKey_ReturnsValue) {
+  EXPECT_EQ(MetadataConverter::valueToString("x-trace", "abc"), "abc");
+}
+
+TEST(MetadataConverterTest, ValueToString_BinaryKey_ReturnsBase64) {
+  const std::string raw("\x01\xff\x00z", 4);
+  EXPECT_EQ(MetadataConverter::valueToString("x-raw-bin", raw), "Af8Aeg==");
+}
+
+TEST(MetadataConverterTest, SerializeInitialMetadata_RepeatedKey_GroupsValues) {
+  const std::string first = "h1";
+  const std::string second = "h2";
+  Multimap metadata{{"x-hdr", first}, {"x-hdr", second}, {"x-one", first}};
+
+  const auto json = nlohmann::json::parse(MetadataConverter::serializeInitialMetadata(metadata));
+
+  EXPECT_EQ(json["x-hdr"], nlohmann::json({"h1", "h2"}));
+  EXPECT_EQ(json["x-one"], nlohmann::json({"h1"}));
+}
+
+TEST(MetadataConverterTest, SerializeTrailingMetadata_Empty_ReturnsEmptyObject) {
+  EXPECT_EQ(MetadataConverter::serializeTrailingMetadata(Multimap{}), "{}");
+}
+
+TEST(MetadataConverterTest, ApplyMetadata_InvalidJson_ThrowsError) {
+  ::grpc::ClientContext context;
+  EXPECT_THROW(MetadataConverter::applyMetadata("{not json", context), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "utils/pool/ObjectPool.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+std::atomic<int> destroyed{0};
+
+struct Tracked {
+  ~Tracked() {
+    destroyed++;
+  }
+
+  void reset() {
+    resets++;
+    scratch.clear();
+    owner = nullptr;
+  }
+
+  int resets = 0;
+  std::vector<int> scratch;
+  std::atomic<const void*> owner{nullptr};
+};
+
+} // namespace
+
+TEST(ObjectPoolTest, Acquire_AfterRelease_ReusesResetObjectWithCapacity) {
+  ObjectPool<Tracked> pool(2);
+  Tracked* first = nullptr;
+  {
+    auto object = pool.acquire();
+    object->scratch.assign(100, 1);
+    first = object.get();
+  }
+
+  auto again = pool.acquire();
+  EXPECT_EQ(again.get(), first);
+  EXPECT_EQ(again->resets, 1);
+  EXPECT_TRUE(again->scratch.empty());
+  EXPECT_GE(again->scratch.capacity(), 100u);
+
+  const auto stats = pool.stats();
+  EXPECT_EQ(stats.created, 1u);
+  EXPECT_EQ(stats.reused, 1u);
+  EXPECT_EQ(stats.idle, 0u);
+}
+
+TEST(ObjectPoolTest, Release_BeyondRetention_FreesExtraObjects) {
+  ObjectPool<Tracked> pool(1);
+  const int before = destroyed.load();
+  {
+    auto a = pool.acquire();
+    auto b = pool.acquire();
+    auto c = pool.acquire();
+  }
+
+  EXPECT_EQ(destroyed.load() - before, 2);
+  EXPECT_EQ(pool.stats().idle, 1u);
+  EXPECT_EQ(pool.stats().created, 3u);
+}
+
+TEST(ObjectPoolTest, Acquire_Concurrent_NeverHandsOutAnObjectTwice) {
+  constexpr int kThreads = 4;
+  constexpr int kIterations = 2000;
+  ObjectPool<Tracked> pool(2);
+  std::atomic<int> shared{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kIterations; i++) {
+        auto object = pool.acquire();
+        const void* expected = nullptr;
+        if (!object->owner.compare_exchange_strong(expected, &object)) {
+          shared++;
+        }
+        std::this_thread::yield();
+        object->owner = nullptr;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(shared.load(), 0);
+  const auto stats = pool.stats();
+  EXPECT_EQ(stats.created + stats.reused, static_cast<uint64_t>(kThreads * kIterations));
+  EXPECT_LE(stats.idle, 2u);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fixtures/ProtoFixture.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+using nlohmann::json;
+
+namespace {
+
+// The messages below were encoded by `protoc --encode` from the text shown
+// above each; protoc writes fields in number order, as ProtoCodec does.
+
+// f_double: 1.5 f_float: -2.25 f_int64: -5000000000
+// f_uint64: 18446744073709551615 f_int32: -1 f_fixed64: 1234567890123
+// f_fixed32: 4000000000 f_bool: true f_string: "héllo" f_bytes: "\x00\xff"
+// f_uint32: 300 f_enum: GREEN f_sfixed32: -7 f_sfixed64: -9000000000
+// f_sint32: -64 f_sint64: -9223372036854775808
+const std::vector<uint8_t> kProtocScalars = {
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f, 0x15, 0x00, 0x00, 0x10, 0xc0, 0x18, 0x80, 0x9c, 0xe8,
+    0xaf, 0xed, 0xff, 0xff, 0xff, 0xff, 0x01, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+    0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x31, 0xcb, 0x04, 0xfb, 0x71, 0x1f, 0x01,
+    0x00, 0x00, 0x3d, 0x00, 0x28, 0x6b, 0xee, 0x40, 0x01, 0x4a, 0x06, 0x68, 0xc3, 0xa9, 0x6c, 0x6c, 0x6f, 0x62,
+    0x02, 0x00, 0xff, 0x68, 0xac, 0x02, 0x70, 0x02, 0x7d, 0xf9, 0xff, 0xff, 0xff, 0x81, 0x01, 0x00, 0xe6, 0x8e,
+    0xe7, 0xfd, 0xff, 0xff, 0xff, 0x88, 0x01, 0x7f, 0x90, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x01,
+};
+
+// packed_int32: [1, 150, -1] unpacked_int32: [3, 270] packed_double: [0.5]
+// packed_sint64: [-2, 2] packed_fixed32: [7, 8] strings: ["a", ""]
+// children { name: "x" } colors: [RED, GREEN]
+const std::vector<uint8_t> kProtocRepeated = {
+    0x0a, 0x0d, 0x01, 0x96, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x10, 0x03, 0x10,
+    0x8e, 0x02, 0x1a, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x3f, 0x22, 0x02, 0x03, 0x04, 0x2a, 0x08,
+    0x07, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x32, 0x01, 0x61, 0x32, 0x00, 0x3a, 0x03, 0x0a, 0x01, 0x78,
+    0x42, 0x02, 0x01, 0x02,
+};
+
+// counts { key: "a" value: 1 } counts { key: "b" value: 2 }
+// children { key: -3 value { name: "c" } } flags { key: true value: "yes" }
+// by_id { key: 9000000000 value: "big" }
+const std::vector<uint8_t> kProtocMaps = {
+    0x0a, 0x05, 0x0a, 0x01, 0x61, 0x10, 0x01, 0x0a, 0x05, 0x0a, 0x01, 0x62, 0x10, 0x02, 0x12, 0x10, 0x08, 0xfd,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x12, 0x03, 0x0a, 0x01, 0x63, 0x1a, 0x07, 0x08, 0x01,
+    0x12, 0x03, 0x79, 0x65, 0x73, 0x22, 0x0b, 0x08, 0x80, 0xb4, 0xc4, 0xc3, 0x21, 0x12, 0x03, 0x62, 0x69, 0x67,
+};
+
+// child { name: "kid" ids: 4 } after: 5
+const std::vector<uint8_t> kProtocChoice = {
+    0x1a, 0x08, 0x0a, 0x03, 0x6b, 0x69, 0x64, 0x1a, 0x01, 0x04, 0x20, 0x05,
+};
+
+// `depth` Node messages, each the `child` of the previous one
+std::vector<uint8_t> nestedNodes(int depth) {
+  std::vector<uint8_t> bytes;
+  for (int i = 0; i < depth; i++) {
+    std::vector<uint8_t> outer = {0x0a};
+    WireFormat::writeVarint(outer, bytes.size());
+    outer.insert(outer.end(), bytes.begin(), bytes.end());
+    bytes = std::move(outer);
+  }
+  return bytes;
+}
+
+} // namespace
+
+class ProtoCodecTest : public ProtoFixture {};
+
+TEST_F(ProtoCodecTest, Decode_ProtocScalars_MatchesProto3JsonMapping) {
+  const json expected = {
+      {"fDouble", 1.5},
+      {"fFloat", -2.25},
+      {"fInt64", "-5000000000"},
+      {"fUint64", "18446744073709551615"},
+      {"fInt32", -1.0},
+      {"fFixed64", "1234567890123"},
+      {"fFixed32", 4000000000.0},
+      {"fBool", true},
+      {"fString", "h\xc3\xa9llo"},
+      {"fBytes", "AP8="},
+      {"fUint32", 300.0},
+      {"fEnum", "GREEN"},
+      {"fSfixed32", -7.0},
+      {"fSfixed64", "-9000000000"},
+      {"fSint32", -64.0},
+      {"fSint64", "-9223372036854775808"},
+  };
+
+  EXPECT_EQ(toJson(decode("Scalars", kProtocScalars)), expected);
+}
+
+TEST_F(ProtoCodecTest, Encode_DecodedProtocMessages_ReproducesProtocBytes) {
+  for (const auto& [type, bytes] : {std::pair{"Scalars", kProtocScalars},
+                                    std::pair{"Repeated", kProtocRepeated},
+                                    std::pair{"Maps", kProtocMaps},
+                                    std::pair{"Choice", kProtocChoice}}) {
+    EXPECT_EQ(encode(type, decode(type, bytes)), bytes) << type;
+  }
+}
+
+TEST_F(ProtoCodecTest, RoundTrip_ScalarLimits_PreservesValues) {
+  const std::vector<std::pair<std::string, AnyValue>> values = {
+      {"fDouble", -std::numeric_limits<double>::max()},
+      {"fDouble", std::numeric_limits<double>::denorm_min()},
+      {"fFloat", 3.4028234663852886e38},
+      {"fInt64", std::string("-9223372036854775808")},
+      {"fInt64", std::string("9223372036854775807")},
+      {"fUint64", std::string("18446744073709551615")},
+      {"fInt32", -2147483648.0},
+      {"fInt32", 2147483647.0},
+      {"fFixed64", std::string("18446744073709551615")},
+      {"fFixed32", 4294967295.0},
+      {"fBool", false},
+      {"fString", std::string("")},
+      {"fString", std::string("\xf0\x9f\x98\x80 emoji")},
+      {"fBytes", std::string("AAECAwQFBgcICQ==")},
+      {"fUint32", 4294967295.0},
+      {"fEnum", std::string("RED")},
+      {"fEnum", 42.0}, // Unknown values decode as numbers
+      {"fSfixed32", -2147483648.0},
+      {"fSfixed64", std::string("-9223372036854775808")},
+      {"fSint32", -2147483648.0},
+      {"fSint32", 2147483647.0},
+      {"fSint64", std::string("9223372036854775807")},
+  };
+
+  for (const auto& [field, value] : values) {
+    const AnyObject message = {{field, value}};
+
+    EXPECT_EQ(toJson(decode("Scalars", encode("Scalars", message))), toJson(message))
+        << field << " = " << toJson(value);
+  }
+}
+
+TEST_F(ProtoCodecTest, Encode_NumericForms_EncodeTheSameInteger) {
+  const auto fromString = encode("Scalars", {{"fInt64", std::string("-42")}});
+
+  EXPECT_EQ(encode("Scalars", {{"fInt64", -42.0}}), fromString);
+  EXPECT_EQ(encode("Scalars", {{"fInt64", int64_t{-42}}}), fromString);
+}
+
+TEST_F(ProtoCodecTest, Encode_NegativeInt32_SignExtendsToTenBytes) {
+  const std::vector<uint8_t> expected = {0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+
+  EXPECT_EQ(encode("Scalars", {{"fInt32", -1.0}}), expected);
+}
+
+TEST_F(ProtoCodecTest, Encode_OutOfRangeValues_Throws) {
+  EXPECT_THROW(encode("Scalars", {{"fInt32", 2147483648.0}}), std::runtime_error);
+  EXPECT_THROW(encode("Scalars", {{"fUint32", -1.0}}), std::runtime_error);
+  EXPECT_THROW(encode("Scalars", {{"fInt64", 1.5}}), std::runtime_error);
+  EXPECT_THROW(encode("Scalars", {{"fUint64", std::string("18446744073709551616")}}), std::runtime_error);
+  EXPECT_THROW(encode("Scalars", {{"fEnum", std::string("BLUE")}}), std::runtime_error);
+  EXPECT_THROW(encode("Scalars", {{"fBool", 1.0}}), std::runtime_error);
+  EXPECT_THROW(encode("Scalars", {{"fBytes", std::string("not base64!")}}), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Decode_ProtocRepeated_PackedAndUnpackedFields) {
+  const json expected = {
+      {"packedInt32", {1.0, 150.0, -1.0}},
+      {"unpackedInt32", {3.0, 270.0}},
+      {"packedDouble", {0.5}},
+      {"packedSint64", {"-2", "2"}},
+      {"packedFixed32", {7.0, 8.0}},
+      {"strings", {"a", ""}},
+      {"children", {{{"name", "x"}}}},
+      {"colors", {"RED", "GREEN"}},
+  };
+
+  EXPECT_EQ(toJson(decode("Repeated", kProtocRepeated)), expected);
+}
+
+TEST_F(ProtoCodecTest, Decode_PackingOppositeToDeclaration_AcceptsBoth) {
+  // packed_int32 as separate tags, unpacked_int32 as one packed run
+  const std::vector<uint8_t> bytes = {0x08, 0x01, 0x08, 0x02, 0x12, 0x02, 0x03, 0x04};
+
+  const json expected = {{"packedInt32", {1.0, 2.0}}, {"unpackedInt32", {3.0, 4.0}}};
+  EXPECT_EQ(toJson(decode("Repeated", bytes)), expected);
+}
+
+TEST_F(ProtoCodecTest, Decode_SplitPackedRuns_Concatenates) {
+  const std::vector<uint8_t> bytes = {0x0a, 0x02, 0x01, 0x02, 0x08, 0x03, 0x0a, 0x01, 0x04};
+
+  EXPECT_EQ(toJson(decode("Repeated", bytes)), json::parse(R"({"packedInt32":[1,2,3,4]})"));
+}
+
+TEST_F(ProtoCodecTest, Decode_ProtocMaps_KeysAsStrings) {
+  const json expected = {
+      {"counts", {{"a", 1.0}, {"b", 2.0}}},
+      {"children", {{"-3", {{"name", "c"}}}}},
+      {"flags", {{"true", "yes"}}},
+      {"byId", {{"9000000000", "big"}}},
+  };
+
+  EXPECT_EQ(toJson(decode("Maps", kProtocMaps)), expected);
+}
+
+TEST_F(ProtoCodecTest, Decode_MapEntryWithoutValue_UsesDefault) {
+  // counts { key: "a" } with the value omitted, as proto3 writers may do
+  const std::vector<uint8_t> bytes = {0x0a, 0x03, 0x0a, 0x01, 0x61};
+
+  EXPECT_EQ(toJson(decode("Maps", bytes)), json::parse(R"({"counts":{"a":0}})"));
+}
+
+TEST_F(ProtoCodecTest, Encode_MapKeysInAnyOrder_SameBytes) {
+  AnyObject counts = {{"z", 1.0}, {"a", 2.0}, {"m", 3.0}};
+  const auto first = encode("Maps", {{"counts", counts}});
+
+  AnyObject reversed;
+  reversed.reserve(64); // A different bucket count iterates in a different order
+  reversed["m"] = 3.0;
+  reversed["a"] = 2.0;
+  reversed["z"] = 1.0;
+  EXPECT_EQ(encode("Maps", {{"counts", reversed}}), first);
+  EXPECT_EQ(toJson(decode("Maps", first)), json::parse(R"({"counts":{"a":2,"m":3,"z":1}})"));
+}
+
+TEST_F(ProtoCodecTest, Decode_ProtocOneof_DecodesSetMember) {
+  EXPECT_EQ(toJson(decode("Choice", kProtocChoice)), json::parse(R"({"child":{"name":"kid","ids":[4]},"after":5})"));
+}
+
+TEST_F(ProtoCodecTest, RoundTrip_EachOneofMember_PreservesValue) {
+  const std::vector<AnyObject> messages = {
+      {{"text", std::string("hi")}},
+      {{"number", std::string("-12345678901")}},
+      {{"child", AnyObject{{"value", 7.0}}}, {"after", 1.0}},
+  };
+
+  for (const auto& message : messages) {
+    EXPECT_EQ(toJson(decode("Choice", encode("Choice", message))), toJson(message));
+  }
+}
+
+TEST_F(ProtoCodecTest, Decode_SplitMessageField_MergesOccurrences) {
+  // child { name: "a" ids: 1 } child { value: 2 ids: 3 }
+  const std::vector<uint8_t> bytes = {0x0a, 0x06, 0x0a, 0x01, 0x61, 0x1a, 0x01, 0x01,
+                                      0x0a, 0x05, 0x10, 0x02, 0x1a, 0x01, 0x03};
+
+  EXPECT_EQ(toJson(decode("Outer", bytes)), json::parse(R"({"child":{"name":"a","value":2,"ids":[1,3]}})"));
+}
+
+TEST_F(ProtoCodecTest, Decode_UnknownFields_Skipped) {
+  // Unknown field 20 as varint, fixed64, length-delimited and fixed32, around `value`
+  const std::vector<uint8_t> bytes = {0xa0, 0x01, 0x05, 0xa1, 0x01, 1, 2, 3, 4, 5, 6, 7, 8, 0x10,
+                                      0x09, 0xa2, 0x01, 0x02, 0xaa, 0xbb, 0xa5, 0x01, 1, 2, 3, 4};
+
+  EXPECT_EQ(toJson(decode("Child", bytes)), json::parse(R"({"value":9})"));
+}
+
+TEST_F(ProtoCodecTest, Decode_TruncatedVarint_Throws) {
+  EXPECT_THROW(decode("Child", {0x10, 0x80}), std::runtime_error);
+  EXPECT_THROW(decode("Child", {0x10, 0xff, 0xff, 0xff}), std::runtime_error);
+  // Tag itself truncated
+  EXPECT_THROW(decode("Child", {0x80}), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Decode_VarintLongerThanTenBytes_Throws) {
+  std::vector<uint8_t> bytes = {0x10};
+  bytes.insert(bytes.end(), 10, 0xff);
+  bytes.push_back(0x01);
+
+  EXPECT_THROW(decode("Child", bytes), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Decode_LengthBeyondBuffer_Throws) {
+  EXPECT_THROW(decode("Child", {0x0a, 0x05, 0x61}), std::runtime_error);
+  // A length near 2^64 must not wrap around the bounds check
+  EXPECT_THROW(decode("Child", {0x0a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01}),
+               std::runtime_error);
+  EXPECT_THROW(decode("Repeated", {0x0a, 0x04, 0x01}), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Decode_TruncatedFixedValues_Throws) {
+  EXPECT_THROW(decode("Scalars", {0x09, 0x00, 0x00, 0x00}), std::runtime_error);
+  EXPECT_THROW(decode("Scalars", {0x15, 0x00}), std::runtime_error);
+  // A packed fixed32 run whose length is not a multiple of 4
+  EXPECT_THROW(decode("Repeated", {0x2a, 0x03, 0x07, 0x00, 0x00}), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Decode_WireTypeMismatchAndFieldZero_Throws) {
+  // `name` (a string) sent as a varint
+  EXPECT_THROW(decode("Child", {0x08, 0x01}), std::runtime_error);
+  EXPECT_THROW(decode("Child", {0x00, 0x01}), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Decode_NestingAtLimit_Decodes) {
+  EXPECT_NO_THROW(decode("Node", nestedNodes(100)));
+}
+
+TEST_F(ProtoCodecTest, Decode_NestingBeyondLimit_Throws) {
+  EXPECT_THROW(decode("Node", nestedNodes(101)), std::runtime_error);
+}
+
+TEST_F(ProtoCodecTest, Encode_NestingBeyondLimit_Throws) {
+  AnyObject node = {{"depth", 0.0}};
+  for (int i = 0; i < 101; i++) {
+    node = AnyObject{{"child", std::move(node)}};
+  }
+
+  EXPECT_THROW(encode("Node", node), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
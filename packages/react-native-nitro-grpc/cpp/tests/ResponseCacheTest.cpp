@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cache/ResponseCache.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+constexpr const char* kMethod = "/test.Echo/Unary";
+
+std::vector<uint8_t> response(size_t size, uint8_t fill = 0x2a) {
+  return std::vector<uint8_t>(size, fill);
+}
+
+} // namespace
+
+class ResponseCacheTest : public ::testing::Test {
+protected:
+  void configure(int64_t ttlMs, int64_t staleWhileRevalidateMs = 0, size_t maxBytes = 4096) {
+    ResponseCache::Config config;
+    config.maxBytes = maxBytes;
+    config.methods[kMethod] = {ttlMs, staleWhileRevalidateMs, {}};
+    _cache.configure(std::move(config));
+  }
+
+  static void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  }
+
+  ResponseCache _cache;
+};
+
+TEST_F(ResponseCacheTest, Lookup_WithinTtl_ReturnsFreshHit) {
+  configure(60'000);
+  _cache.store("k", kMethod, response(3));
+
+  const auto hit = _cache.lookup("k");
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(*hit->response, response(3));
+  EXPECT_FALSE(hit->stale);
+  EXPECT_FALSE(hit->shouldRevalidate);
+  EXPECT_EQ(_cache.stats().hits, 1u);
+}
+
+TEST_F(ResponseCacheTest, Lookup_AfterTtlWithoutSwr_MissesAndEvicts) {
+  configure(20);
+  _cache.store("k", kMethod, response(3));
+  sleepMs(40);
+
+  EXPECT_FALSE(_cache.lookup("k").has_value());
+  const auto stats = _cache.stats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.entries, 0u);
+  EXPECT_EQ(stats.bytes, 0u);
+}
+
+TEST_F(ResponseCacheTest, Lookup_InsideSwrWindow_OneCallerRevalidates) {
+  configure(20, 60'000);
+  _cache.store("k", kMethod, response(3));
+  sleepMs(40);
+
+  const auto first = _cache.lookup("k");
+  const auto second = _cache.lookup("k");
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_TRUE(first->stale);
+  EXPECT_TRUE(first->shouldRevalidate);
+  EXPECT_TRUE(second->stale);
+  EXPECT_FALSE(second->shouldRevalidate);
+  EXPECT_EQ(_cache.stats().staleHits, 2u);
+  EXPECT_EQ(_cache.stats().revalidations, 1u);
+}
+
+TEST_F(ResponseCacheTest, RevalidationFailed_StaleEntry_AllowsAnotherRevalidation) {
+  configure(20, 60'000);
+  _cache.store("k", kMethod, response(3));
+  sleepMs(40);
+  ASSERT_TRUE(_cache.lookup("k")->shouldRevalidate);
+
+  _cache.revalidationFailed("k");
+
+  EXPECT_TRUE(_cache.lookup("k")->shouldRevalidate);
+}
+
+TEST_F(ResponseCacheTest, Store_AfterRevalidation_ServesFreshResponse) {
+  configure(20, 60'000);
+  _cache.store("k", kMethod, response(3, 1));
+  sleepMs(40);
+  ASSERT_TRUE(_cache.lookup("k")->stale);
+
+  _cache.store("k", kMethod, response(3, 2));
+
+  const auto hit = _cache.lookup("k");
+  EXPECT_FALSE(hit->stale);
+  EXPECT_EQ(*hit->response, response(3, 2));
+  EXPECT_EQ(_cache.stats().entries, 1u);
+}
+
+TEST_F(ResponseCacheTest, Lookup_AfterSwrWindow_Misses) {
+  configure(10, 20);
+  _cache.store("k", kMethod, response(3));
+  sleepMs(50);
+
+  EXPECT_FALSE(_cache.lookup("k").has_value());
+}
+
+TEST_F(ResponseCacheTest, Store_OverMaxBytes_EvictsLeastRecentlyUsed) {
+  // Each entry costs 40 + 1 bytes (response plus key), so only two fit.
+  configure(60'000, 0, 100);
+  _cache.store("a", kMethod, response(40));
+  _cache.store("b", kMethod, response(40));
+  ASSERT_TRUE(_cache.lookup("a").has_value()); // "b" is now least recently used
+
+  _cache.store("c", kMethod, response(40));
+
+  EXPECT_TRUE(_cache.lookup("a").has_value());
+  EXPECT_FALSE(_cache.lookup("b").has_value());
+  EXPECT_TRUE(_cache.lookup("c").has_value());
+  const auto stats = _cache.stats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.bytes, 82u);
+  EXPECT_LE(stats.bytes, stats.maxBytes);
+}
+
+TEST_F(ResponseCacheTest, Store_LargerThanMaxBytes_KeepsExistingEntries) {
+  configure(60'000, 0, 100);
+  _cache.store("a", kMethod, response(40));
+
+  _cache.store("big", kMethod, response(100));
+
+  EXPECT_FALSE(_cache.lookup("big").has_value());
+  EXPECT_TRUE(_cache.lookup("a").has_value());
+  EXPECT_EQ(_cache.stats().evictions, 0u);
+}
+
+TEST_F(ResponseCacheTest, Store_SameKey_ReplacesWithoutDoubleCounting) {
+  configure(60'000);
+  _cache.store("k", kMethod, response(10));
+  _cache.store("k", kMethod, response(20));
+
+  const auto stats = _cache.stats();
+  EXPECT_EQ(stats.entries, 1u);
+  EXPECT_EQ(stats.bytes, 21u);
+}
+
+TEST_F(ResponseCacheTest, Store_UnconfiguredMethod_Ignored) {
+  configure(60'000);
+  _cache.store("k", "/test.Echo/Other", response(3));
+
+  EXPECT_FALSE(_cache.lookup("k").has_value());
+  EXPECT_FALSE(_cache.policyFor("/test.Echo/Other").has_value());
+  EXPECT_TRUE(_cache.policyFor(kMethod).has_value());
+}
+
+TEST_F(ResponseCacheTest, Invalidate_Method_DropsOnlyThatMethod) {
+  ResponseCache::Config config;
+  config.methods[kMethod] = {60'000, 0, {}};
+  config.methods["/test.Echo/Other"] = {60'000, 0, {}};
+  _cache.configure(std::move(config));
+  _cache.store("a", kMethod, response(3));
+  _cache.store("b", "/test.Echo/Other", response(3));
+
+  _cache.invalidate(kMethod);
+  EXPECT_FALSE(_cache.lookup("a").has_value());
+  EXPECT_TRUE(_cache.lookup("b").has_value());
+
+  _cache.invalidate("");
+  EXPECT_FALSE(_cache.lookup("b").has_value());
+  EXPECT_EQ(_cache.stats().bytes, 0u);
+}
+
+TEST_F(ResponseCacheTest, ParseConfig_Valid_ReadsPolicies) {
+  const auto config = ResponseCache::parseConfig(
+      R"({"maxBytes":1024,"methods":{"/a.B/C":{"ttlMs":500,"staleWhileRevalidateMs":100,"varyMetadata":["x-user"]}}})");
+
+  EXPECT_EQ(config.maxBytes, 1024u);
+  const auto& policy = config.methods.at("/a.B/C");
+  EXPECT_EQ(policy.ttlMs, 500);
+  EXPECT_EQ(policy.staleWhileRevalidateMs, 100);
+  EXPECT_EQ(policy.varyMetadata, (std::vector<std::string>{"x-user", "authorization"}));
+}
+
+TEST_F(ResponseCacheTest, ParseConfig_VaryAuthorization_OnlyOptOutDropsAuthorization) {
+  const auto config = ResponseCache::parseConfig(R"({"methods":{
+    "/a.B/Default":{"ttlMs":500},
+    "/a.B/Listed":{"ttlMs":500,"varyMetadata":["authorization","x-user"]},
+    "/a.B/Shared":{"ttlMs":500,"varyMetadata":["x-user"],"varyAuthorization":false}
+  }})");
+
+  EXPECT_EQ(config.methods.at("/a.B/Default").varyMetadata, std::vector<std::string>{"authorization"});
+  EXPECT_EQ(config.methods.at("/a.B/Listed").varyMetadata, (std::vector<std::string>{"authorization", "x-user"}));
+  EXPECT_EQ(config.methods.at("/a.B/Shared").varyMetadata, std::vector<std::string>{"x-user"});
+}
+
+TEST_F(ResponseCacheTest, ParseConfig_InvalidValues_Throws) {
+  EXPECT_THROW(ResponseCache::parseConfig(R"({"methods":{"/a.B/C":{"ttlMs":0}}})"), std::runtime_error);
+  EXPECT_THROW(ResponseCache::parseConfig(R"({"methods":{"/a.B/C":{"ttlMs":100,"staleWhileRevalidateMs":-1}}})"),
+               std::runtime_error);
+  EXPECT_THROW(ResponseCache::parseConfig(R"({"maxBytes":-1})"), std::runtime_error);
+  EXPECT_THROW(ResponseCache::parseConfig(R"({"methods":{"/a.B/C":{}}})"), std::runtime_error);
+  EXPECT_THROW(ResponseCache::parseConfig("{"), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
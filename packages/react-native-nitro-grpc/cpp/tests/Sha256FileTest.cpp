@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/sha256/Sha256File.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace fs = std::filesystem;
+
+class Sha256FileTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    _dir = fs::temp_directory_path() /
+           ("rngrpc-sha256-" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+    fs::create_directories(_dir);
+  }
+
+  void TearDown() override {
+    fs::remove_all(_dir);
+  }
+
+  std::string write(const std::string& name, const std::string& contents) {
+    const auto path = (_dir / name).string();
+    std::ofstream(path, std::ios::binary) << contents;
+    return path;
+  }
+
+  static std::string hex(const std::string& data) {
+    return Sha256::toHex(Sha256::hash(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+  }
+
+  fs::path _dir;
+};
+
+TEST_F(Sha256FileTest, Hash_KnownFile_MatchesExpectedDigest) {
+  const auto path = write("abc", "abc");
+
+  EXPECT_EQ(Sha256::toHex(Sha256File::hash(path)), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+TEST_F(Sha256FileTest, Hash_FileUri_StripsScheme) {
+  const auto path = write("hello", "hello");
+
+  EXPECT_EQ(Sha256File::hash("file://" + path), Sha256File::hash(path));
+  EXPECT_EQ(Sha256::toHex(Sha256File::hash("file://" + path)), hex("hello"));
+}
+
+TEST_F(Sha256FileTest, HashAll_ManyFiles_DigestsInInputOrder) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 64; i++) {
+    paths.push_back(write("file" + std::to_string(i), std::string(i * 1000, static_cast<char>('a' + i % 26))));
+  }
+
+  const auto digests = Sha256File::hashAll(paths);
+
+  ASSERT_EQ(digests.size(), paths.size());
+  for (int i = 0; i < 64; i++) {
+    EXPECT_EQ(Sha256::toHex(digests[i]), hex(std::string(i * 1000, static_cast<char>('a' + i % 26)))) << "file " << i;
+  }
+}
+
+TEST_F(Sha256FileTest, HashAll_MissingFiles_ThrowsFirstInInputOrder) {
+  const std::vector<std::string> paths = {
+      write("present", "x"),
+      (_dir / "missing-1").string(),
+      (_dir / "missing-2").string(),
+  };
+
+  try {
+    Sha256File::hashAll(paths);
+    FAIL() << "expected hashAll to throw";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("missing-1"), std::string::npos) << e.what();
+  }
+}
+
+TEST_F(Sha256FileTest, HashAll_EmptyInput_ReturnsEmpty) {
+  EXPECT_TRUE(Sha256File::hashAll({}).empty());
+}
+
+TEST_F(Sha256FileTest, HashAll_ConcurrentCallers_ShareThePool) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 16; i++) {
+    paths.push_back(write("file" + std::to_string(i), std::to_string(i)));
+  }
+
+  std::vector<std::thread> callers;
+  std::vector<char> correct(8, false); // Not vector<bool>: each caller writes its own element
+  for (size_t caller = 0; caller < correct.size(); caller++) {
+    callers.emplace_back([&, caller]() {
+      bool allMatch = true;
+      for (int round = 0; round < 20; round++) {
+        const auto digests = Sha256File::hashAll(paths, 4);
+        for (int i = 0; i < 16; i++) {
+          allMatch = allMatch && Sha256::toHex(digests[i]) == hex(std::to_string(i));
+        }
+      }
+      correct[caller] = allMatch;
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  for (size_t caller = 0; caller < correct.size(); caller++) {
+    EXPECT_TRUE(correct[caller]) << "caller " << caller;
+  }
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
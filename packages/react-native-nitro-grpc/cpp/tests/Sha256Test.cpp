@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/sha256/Sha256.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+std::string hex(const std::vector<uint8_t>& data) {
+  return Sha256::toHex(Sha256::hash(data.data(), data.size()));
+}
+
+std::vector<uint8_t> bytes(const std::string& text) {
+  return {text.begin(), text.end()};
+}
+
+// Same pattern as Base64SimdTest
+std::vector<uint8_t> pattern(size_t length) {
+  std::vector<uint8_t> data(length);
+  for (size_t i = 0; i < length; i++) {
+    data[i] = static_cast<uint8_t>(i * 167 + 13);
+  }
+  return data;
+}
+
+} // namespace
+
+TEST(Sha256Test, Hash_NistVectors_MatchExpected) {
+  EXPECT_EQ(hex(bytes("")), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(hex(bytes("abc")), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  EXPECT_EQ(hex(bytes("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  EXPECT_EQ(hex(bytes("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnop"
+                      "qrstnopqrstu")),
+            "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1");
+  EXPECT_EQ(hex(std::vector<uint8_t>(1'000'000, 'a')),
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+// Expected digests from Python's hashlib, independent of the kernel selected for this CPU
+TEST(Sha256Test, Hash_BlockBoundaries_MatchReference) {
+  const std::pair<size_t, const char*> vectors[] = {
+      {1, "9d1e0e2d9459d06523ad13e28a4093c2316baafe7aec5b25f30eba2e113599c4"},
+      {55, "b2ca0adc388a66d3a5a7f6541239331d5a867eede554e11262241271faaf36c5"},
+      {56, "3768eff44f1df02704a832cf708935fbed9bb74d0714fbe75454c266c4e12856"},
+      {63, "dc06ea9e456da9f9fc2276564018231c36196ff7745bf505fd7f503aec5c67fd"},
+      {64, "b68fe543b0b5a544e32eb08712e697bfcd3a3cb491563c3b1cba112d378f4bdb"},
+      {65, "587cdb9ad9be371721f2f84a84eb09f2b698ec19bbe2d7c222179996547a04a6"},
+      {119, "b27b61037be684924f5497ee79c784f09c971d8c8c3136f6270e0fd34775aa1b"},
+      {120, "00c666e960132985e9c99dc98bf25782df791138d0f1252b69781694ed97d693"},
+      {127, "805f2702e76ff5d578052c965ded05a689d9293fd86c5584b0db399d33e9745c"},
+      {128, "cd77acfc16d0964a4c3ef06f0678a5c88d2d610de00f7b997676fea5b4d2ae9e"},
+      {129, "2c0b373b4a62770395098399a7d08ca18fce440e3b6c35a22e5910eaf515b72c"},
+      {1000, "fa10d4e76ab24b0ff9d6c596a00df178cd2a80a15c70770dee68d374ccb39bc6"},
+  };
+  for (const auto& [length, expected] : vectors) {
+    EXPECT_EQ(hex(pattern(length)), expected) << "length " << length << " (" << Sha256::implementationName() << ")";
+  }
+}
+
+TEST(Sha256Test, Hash_AllLengths_MatchReferenceAggregate) {
+  // SHA-256 over the digests of pattern(0) ... pattern(300), also from hashlib
+  Sha256 aggregate;
+  for (size_t length = 0; length <= 300; length++) {
+    const auto data = pattern(length);
+    const auto digest = Sha256::hash(data.data(), data.size());
+    aggregate.update(digest.data(), digest.size());
+  }
+
+  EXPECT_EQ(Sha256::toHex(aggregate.finalize()), "27fec5f2f3539e1e99cce5b9021123c85bcdca277bdf34c13ec2f84920d17eff")
+      << Sha256::implementationName();
+}
+
+TEST(Sha256Test, Update_EverySplitPoint_MatchesOneShot) {
+  const auto data = pattern(200);
+  const auto expected = Sha256::hash(data.data(), data.size());
+
+  Sha256 hasher;
+  for (size_t split = 0; split <= data.size(); split++) {
+    hasher.update(data.data(), split);
+    hasher.update(data.data() + split, data.size() - split);
+    EXPECT_EQ(hasher.finalize(), expected) << "split at " << split;
+  }
+}
+
+TEST(Sha256Test, Reset_AfterUpdate_StartsNewMessage) {
+  Sha256 hasher;
+  hasher.update(reinterpret_cast<const uint8_t*>("junk"), 4);
+  hasher.reset();
+  hasher.update(reinterpret_cast<const uint8_t*>("abc"), 3);
+
+  EXPECT_EQ(Sha256::toHex(hasher.finalize()), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
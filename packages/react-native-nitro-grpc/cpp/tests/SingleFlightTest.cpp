@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cache/SingleFlight.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+using ResponsePromise = SingleFlight::ResponsePromise;
+
+class SingleFlightTest : public ::testing::Test {
+protected:
+  std::shared_ptr<ResponsePromise> lead(const std::string& key, const std::string& callId,
+                                        const std::shared_ptr<ResponsePromise>& promise) {
+    return _flights->lead(key, callId, promise, std::make_shared<::grpc::ClientContext>());
+  }
+
+  static std::shared_ptr<ArrayBuffer> buffer(const std::string& text) {
+    return ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+  }
+
+  static std::string text(const std::shared_ptr<ArrayBuffer>& buffer) {
+    return {reinterpret_cast<const char*>(buffer->data()), buffer->size()};
+  }
+
+  // The outcome of a settled promise; pending promises fail the test.
+  static std::shared_ptr<ArrayBuffer> result(const std::shared_ptr<ResponsePromise>& promise) {
+    auto future = promise->await();
+    if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      throw std::logic_error("promise is still pending");
+    }
+    return future.get();
+  }
+
+  std::shared_ptr<SingleFlight> _flights = std::make_shared<SingleFlight>();
+};
+
+TEST_F(SingleFlightTest, Join_NoFlight_ReturnsFalse) {
+  EXPECT_FALSE(_flights->join("k", "1", ResponsePromise::create()));
+  EXPECT_EQ(_flights->coalescedCount(), 0u);
+}
+
+TEST_F(SingleFlightTest, Resolve_LeaderAndWaiters_EachGetOwnBuffer) {
+  auto leader = ResponsePromise::create();
+  auto shared = lead("k", "1", leader);
+  std::vector<std::shared_ptr<ResponsePromise>> waiters;
+  for (int i = 2; i <= 4; i++) {
+    waiters.push_back(ResponsePromise::create());
+    ASSERT_TRUE(_flights->join("k", std::to_string(i), waiters.back()));
+  }
+  EXPECT_EQ(_flights->coalescedCount(), 3u);
+
+  auto response = buffer("payload");
+  shared->resolve(response);
+
+  EXPECT_EQ(result(leader), response);
+  for (const auto& waiter : waiters) {
+    const auto copy = result(waiter);
+    EXPECT_NE(copy, response);
+    EXPECT_EQ(text(copy), "payload");
+  }
+}
+
+TEST_F(SingleFlightTest, Reject_LeaderAndWaiters_AllRejectWithSameError) {
+  auto leader = ResponsePromise::create();
+  auto waiter = ResponsePromise::create();
+  auto shared = lead("k", "1", leader);
+  ASSERT_TRUE(_flights->join("k", "2", waiter));
+
+  shared->reject(std::make_exception_ptr(std::runtime_error("gRPC Error [14]: unavailable")));
+
+  for (const auto& promise : {leader, waiter}) {
+    try {
+      result(promise);
+      FAIL() << "expected rejection";
+    } catch (const std::runtime_error& e) {
+      EXPECT_STREQ(e.what(), "gRPC Error [14]: unavailable");
+    }
+  }
+}
+
+TEST_F(SingleFlightTest, Join_AfterCompletion_LeadsNewFlight) {
+  auto shared = lead("k", "1", ResponsePromise::create());
+  shared->resolve(buffer("first"));
+
+  EXPECT_FALSE(_flights->join("k", "2", ResponsePromise::create()));
+  EXPECT_FALSE(_flights->cancel("1"));
+}
+
+TEST_F(SingleFlightTest, Cancel_OneWaiter_OthersStillResolve) {
+  auto leader = ResponsePromise::create();
+  auto cancelled = ResponsePromise::create();
+  auto remaining = ResponsePromise::create();
+  auto shared = lead("k", "1", leader);
+  ASSERT_TRUE(_flights->join("k", "2", cancelled));
+  ASSERT_TRUE(_flights->join("k", "3", remaining));
+
+  EXPECT_TRUE(_flights->cancel("2"));
+  EXPECT_THROW(result(cancelled), std::runtime_error);
+  EXPECT_TRUE(leader->isPending());
+  EXPECT_TRUE(remaining->isPending());
+
+  shared->resolve(buffer("payload"));
+  EXPECT_EQ(text(result(leader)), "payload");
+  EXPECT_EQ(text(result(remaining)), "payload");
+}
+
+TEST_F(SingleFlightTest, Cancel_Leader_WaitersStillResolve) {
+  auto leader = ResponsePromise::create();
+  auto waiter = ResponsePromise::create();
+  auto shared = lead("k", "1", leader);
+  ASSERT_TRUE(_flights->join("k", "2", waiter));
+
+  EXPECT_TRUE(_flights->cancel("1"));
+  EXPECT_THROW(result(leader), std::runtime_error);
+
+  shared->resolve(buffer("payload"));
+  EXPECT_EQ(text(result(waiter)), "payload");
+}
+
+TEST_F(SingleFlightTest, Cancel_LastWaiter_AbandonsFlight) {
+  auto leader = ResponsePromise::create();
+  auto shared = lead("k", "1", leader);
+
+  EXPECT_TRUE(_flights->cancel("1"));
+  EXPECT_THROW(result(leader), std::runtime_error);
+
+  // The key is free again, and the abandoned RPC settling later reaches nobody
+  auto next = ResponsePromise::create();
+  EXPECT_FALSE(_flights->join("k", "2", next));
+  shared->resolve(buffer("late"));
+  EXPECT_TRUE(next->isPending());
+}
+
+TEST_F(SingleFlightTest, Cancel_UnknownCallId_ReturnsFalse) {
+  EXPECT_FALSE(_flights->cancel("missing"));
+}
+
+TEST_F(SingleFlightTest, Lead_EmptyOrDuplicateCallId_Throws) {
+  lead("k", "1", ResponsePromise::create());
+
+  EXPECT_THROW(lead("other", "", ResponsePromise::create()), std::runtime_error);
+  EXPECT_THROW(lead("other", "1", ResponsePromise::create()), std::runtime_error);
+  EXPECT_THROW(_flights->join("k", "", ResponsePromise::create()), std::runtime_error);
+  EXPECT_THROW(_flights->join("k", "1", ResponsePromise::create()), std::runtime_error);
+  EXPECT_EQ(_flights->coalescedCount(), 0u);
+}
+
+TEST_F(SingleFlightTest, ParseConfig_Methods_ReadsVaryMetadata) {
+  _flights->configure(SingleFlight::parseConfig(R"({"methods":{
+    "/a.B/C":{"varyMetadata":["x-user"]},
+    "/a.B/D":{},
+    "/a.B/S":{"varyMetadata":["x-user"],"varyAuthorization":false}
+  }})"));
+
+  EXPECT_EQ(_flights->varyMetadataFor("/a.B/C"), (std::vector<std::string>{"x-user", "authorization"}));
+  EXPECT_EQ(_flights->varyMetadataFor("/a.B/D"), std::vector<std::string>{"authorization"});
+  EXPECT_EQ(_flights->varyMetadataFor("/a.B/S"), std::vector<std::string>{"x-user"});
+  EXPECT_FALSE(_flights->varyMetadataFor("/a.B/E").has_value());
+  EXPECT_THROW(SingleFlight::parseConfig("{"), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/client_unary_call.h>
+#include <grpcpp/impl/rpc_method.h>
+
+#include <atomic>
+#include <memory>
+
+#include "TestServer.hpp"
+#include "channel/TlsSessionCache.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+class TlsSessionCacheTest : public ::testing::Test {
+protected:
+  void call(::grpc::ClientContext& context) {
+    ::grpc::Slice slice("x", 1);
+    ::grpc::ByteBuffer request(&slice, 1);
+    ::grpc::ByteBuffer response;
+    const ::grpc::internal::RpcMethod method("/test.Echo/Unary", ::grpc::internal::RpcMethod::NORMAL_RPC);
+    const auto status = ::grpc::internal::BlockingUnaryCall(_channel.get(), method, &context, request, &response);
+    ASSERT_TRUE(status.ok()) << status.error_message();
+  }
+
+  TestServer _server;
+  std::shared_ptr<::grpc::Channel> _channel =
+      ::grpc::CreateChannel(_server.target(), ::grpc::InsecureChannelCredentials());
+};
+
+TEST_F(TlsSessionCacheTest, RecordConnectionIfPending_CallNeverStarted_StaysPending) {
+  std::atomic<bool> pending(true);
+  ::grpc::ClientContext context;
+
+  TlsSessionCache::shared().recordConnectionIfPending(pending, context);
+
+  EXPECT_TRUE(pending.load());
+}
+
+TEST_F(TlsSessionCacheTest, RecordConnectionIfPending_FinishedCall_ClearsPendingWithoutCountingPlaintext) {
+  const auto before = TlsSessionCache::shared().stats();
+  std::atomic<bool> pending(true);
+  ::grpc::ClientContext first;
+  call(first);
+
+  TlsSessionCache::shared().recordConnectionIfPending(pending, first);
+  EXPECT_FALSE(pending.load());
+
+  // Later calls on the same connection skip the check until the next READY
+  ::grpc::ClientContext second;
+  call(second);
+  TlsSessionCache::shared().recordConnectionIfPending(pending, second);
+  EXPECT_FALSE(pending.load());
+
+  const auto after = TlsSessionCache::shared().stats();
+  EXPECT_EQ(after.fullHandshakes, before.fullHandshakes);
+  EXPECT_EQ(after.resumedHandshakes, before.resumedHandshakes);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
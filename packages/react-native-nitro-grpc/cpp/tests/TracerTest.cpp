@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../calls/MethodHandle.hpp"
+#include "../trace/Tracer.hpp"
+#include "ClientFixture.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+class TracerTest : public ClientFixture {
+protected:
+  void SetUp() override {
+    ClientFixture::SetUp();
+    _client->setTracingEnabled(true);
+  }
+
+  void TearDown() override {
+    _client->setTracingEnabled(false);
+    ClientFixture::TearDown();
+  }
+
+  // The dumped spans with the given name
+  static std::vector<nlohmann::json> spans(const std::string& name) {
+    const auto trace = nlohmann::json::parse(Tracer::shared().dumpJson());
+    std::vector<nlohmann::json> result;
+    for (const auto& event : trace["traceEvents"]) {
+      if (event["name"] == name) {
+        result.push_back(event);
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(TracerTest, Dump_SpansFromThreads_ChromeTraceEvents) {
+  std::thread([] { TraceSpan span("test", "worker", "bytes", 42); }).join();
+  { TraceSpan span("test", "main"); }
+
+  const auto worker = spans("worker");
+  ASSERT_EQ(worker.size(), 1u);
+  EXPECT_EQ(worker[0]["ph"], "X");
+  EXPECT_EQ(worker[0]["cat"], "test");
+  EXPECT_EQ(worker[0]["args"]["bytes"], 42);
+  EXPECT_GE(worker[0]["dur"].get<double>(), 0);
+
+  const auto main = spans("main");
+  ASSERT_EQ(main.size(), 1u);
+  EXPECT_NE(main[0]["tid"], worker[0]["tid"]);
+}
+
+TEST_F(TracerTest, Record_MoreThanBufferHolds_KeepsLatestSpans) {
+  std::thread([] {
+    for (size_t i = 0; i < Tracer::kEventsPerThread + 10; i++) {
+      TraceSpan span("test", "wrap", "i", static_cast<int64_t>(i));
+    }
+  }).join();
+
+  const auto wrapped = spans("wrap");
+  ASSERT_EQ(wrapped.size(), Tracer::kEventsPerThread);
+  EXPECT_EQ(wrapped.front()["args"]["i"], 10);
+}
+
+TEST_F(TracerTest, SetEnabled_Disabled_RecordsNothing) {
+  { TraceSpan span("test", "before"); }
+  _client->setTracingEnabled(false);
+  { TraceSpan span("test", "off"); }
+
+  EXPECT_EQ(spans("before").size(), 1u);
+  EXPECT_TRUE(spans("off").empty());
+
+  // Enabling again starts a new trace
+  _client->setTracingEnabled(true);
+  EXPECT_TRUE(spans("before").empty());
+}
+
+TEST_F(TracerTest, Calls_UnaryAndStream_RecordCallAndReadSpans) {
+  auto future = _client->unaryCall("/test.Echo/Unary", bytes("hello"), R"({"x-status":["5"]})", 0, "")->await();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_THROW(future.get(), std::exception);
+
+  auto stream = _client->createServerStreamSync("/test.Echo/Server", bytes("tick"), R"({"x-repeat":["3"]})", 0);
+  while (std::holds_alternative<std::shared_ptr<ArrayBuffer>>(stream->readSync())) {
+  }
+
+  const auto unary = spans("unary");
+  ASSERT_EQ(unary.size(), 1u);
+  EXPECT_EQ(unary[0]["args"]["method"], "/test.Echo/Unary");
+  EXPECT_EQ(unary[0]["args"]["status"], 5);
+
+  const auto streams = spans("stream");
+  ASSERT_EQ(streams.size(), 1u);
+  EXPECT_EQ(streams[0]["args"]["method"], "/test.Echo/Server");
+  EXPECT_EQ(streams[0]["args"]["status"], 0);
+
+  const auto reads = spans("read");
+  ASSERT_EQ(reads.size(), 3u);
+  EXPECT_EQ(reads[0]["args"]["bytes"], 4);
+}
+
+TEST_F(TracerTest, TraceName_RepeatedCalls_ReusesInternedPath) {
+  const MethodHandle method("/test.Echo/Interned", MethodHandle::Type::UNARY);
+
+  const char* name = method.traceName();
+  EXPECT_STREQ(name, "/test.Echo/Interned");
+  EXPECT_EQ(method.traceName(), name);
+  EXPECT_EQ(Tracer::shared().intern("/test.Echo/Interned"), name);
+}
+
+TEST_F(TracerTest, DumpTrace_UnwritablePath_Throws) {
+  EXPECT_THROW(_client->dumpTrace("/nonexistent-dir/trace.json"), std::runtime_error);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "calls/UnaryCallRecord.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+TEST(UnaryCallRecordTest, Reset_ReusedRecord_CarriesNoStaleState) {
+  ObjectPool<UnaryCallRecord> pool(1);
+  auto registry = std::make_shared<CallRegistry>();
+  const std::vector<uint8_t> request(64, 0x2a);
+  UnaryCallRecord* used = nullptr;
+  {
+    auto record = pool.acquire();
+    used = record.get();
+    record->channel = ::grpc::CreateChannel("localhost:1", ::grpc::InsecureChannelCredentials());
+    record->method = std::make_shared<const MethodHandle>("/test.Echo/Unary", MethodHandle::Type::UNARY);
+    record->setRequest(request.data(), request.size());
+    record->metadataJson = R"({"x-a":["1"]})";
+    record->deadlineMs = 1234;
+    record->context = std::make_shared<::grpc::ClientContext>();
+    record->promise = Promise<std::shared_ptr<ArrayBuffer>>::create();
+    record->metrics = std::make_shared<ChannelMetrics>()->forMethod("/test.Echo/Unary");
+    record->connectionPending = std::make_shared<std::atomic<bool>>(true);
+    record->registerCall(registry, "call-1");
+    record->timingStore = std::make_shared<CallTimingStore>();
+    record->timing.mark(CallTiming::DISPATCHED);
+    record->metadataStore = std::make_shared<CallMetadataStore>();
+    record->finished = true;
+    ::grpc::Slice response("response", 8);
+    record->response = ::grpc::ByteBuffer(&response, 1);
+    ASSERT_TRUE(record->response.Dump(&record->responseSlices).ok());
+  }
+
+  // Releasing the record unregistered its call
+  EXPECT_FALSE(registry->cancel("call-1"));
+
+  auto record = pool.acquire();
+  ASSERT_EQ(record.get(), used);
+  EXPECT_EQ(record->channel, nullptr);
+  EXPECT_EQ(record->method, nullptr);
+  EXPECT_EQ(record->request.size(), 0u);
+  EXPECT_TRUE(record->metadataJson.empty());
+  EXPECT_EQ(record->deadlineMs, 0);
+  EXPECT_EQ(record->context, nullptr);
+  EXPECT_EQ(record->promise, nullptr);
+  EXPECT_EQ(record->metrics, nullptr);
+  EXPECT_EQ(record->connectionPending, nullptr);
+  EXPECT_EQ(record->registry, nullptr);
+  EXPECT_TRUE(record->callId.empty());
+  EXPECT_EQ(record->timingStore, nullptr);
+  EXPECT_TRUE(std::all_of(record->timing.at.begin(), record->timing.at.end(), [](int64_t at) { return at == 0; }));
+  EXPECT_EQ(record->metadataStore, nullptr);
+  EXPECT_FALSE(record->finished);
+  EXPECT_EQ(record->response.Length(), 0u);
+  EXPECT_TRUE(record->responseSlices.empty());
+}
+
+TEST(UnaryCallRecordTest, StoreMetadata_ReusedWithoutCallId_StoresNothing) {
+  ObjectPool<UnaryCallRecord> pool(1);
+  auto store = std::make_shared<CallMetadataStore>();
+  {
+    auto record = pool.acquire();
+    record->context = std::make_shared<::grpc::ClientContext>();
+    record->callId = "call-1";
+    record->metadataStore = store;
+  }
+
+  // The next call through the same record was made without a call ID
+  auto record = pool.acquire();
+  record->context = std::make_shared<::grpc::ClientContext>();
+  record->finished = true;
+  record->storeMetadata();
+
+  EXPECT_EQ(store->take("call-1"), nullptr);
+  EXPECT_EQ(store->take(""), nullptr);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ClientFixture.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+class UnaryCallTest : public ClientFixture {
+protected:
+  std::shared_ptr<ArrayBuffer> call(const std::string& request, const std::string& metadataJson, double deadline = 0,
+                                    const std::string& callId = "") {
+    auto future = _client->unaryCall("/test.Echo/Unary", bytes(request), metadataJson, deadline, callId)->await();
+    if (future.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+      throw std::runtime_error("unary call did not complete");
+    }
+    return future.get();
+  }
+};
+
+TEST_F(UnaryCallTest, UnaryCall_Echo_ResolvesWithRequest) {
+  EXPECT_EQ(text(call("hello", "{}")), "hello");
+  EXPECT_EQ(_server.requestCount(), 1u);
+}
+
+TEST_F(UnaryCallTest, UnaryCall_EmptyRequest_ResolvesEmpty) {
+  EXPECT_EQ(call("", "{}")->size(), 0u);
+}
+
+TEST_F(UnaryCallTest, UnaryCall_WithMetadata_SendsHeaders) {
+  call("ping", R"({"x-user":["alice"],"x-tag":["a","b"]})");
+
+  const auto metadata = _server.lastClientMetadata();
+  EXPECT_EQ(metadata.count("x-user"), 1u);
+  EXPECT_EQ(metadata.find("x-user")->second, "alice");
+  EXPECT_EQ(metadata.count("x-tag"), 2u);
+}
+
+TEST_F(UnaryCallTest, UnaryCall_ServerError_RejectsWithStatus) {
+  try {
+    call("ping", R"({"x-status":["5"],"x-status-message":["missing"]})");
+    FAIL() << "expected rejection";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("[5]"), std::string::npos) << e.what();
+    EXPECT_NE(std::string(e.what()).find("missing"), std::string::npos) << e.what();
+  }
+}
+
+TEST_F(UnaryCallTest, UnaryCall_DeadlineExceeded_Rejects) {
+  EXPECT_THROW(call("slow", R"({"x-delay-ms":["500"]})", deadlineIn(50)), std::runtime_error);
+}
+
+TEST_F(UnaryCallTest, UnaryCall_CachedForOneAuthorization_NotServedToAnother) {
+  _client->configureResponseCache(R"({"methods":{"/test.Echo/Unary":{"ttlMs":60000}}})");
+
+  call("profile", R"({"authorization":["Bearer alice"]})");
+  call("profile", R"({"authorization":["Bearer alice"]})");
+  EXPECT_EQ(_server.callCount(), 1u);
+
+  call("profile", R"({"authorization":["Bearer bob"]})");
+  call("profile", "{}");
+  EXPECT_EQ(_server.callCount(), 3u);
+}
+
+TEST_F(UnaryCallTest, UnaryCallSync_Echo_ReturnsRequest) {
+  EXPECT_EQ(text(_client->unaryCallSync("/test.Echo/Unary", bytes("sync"), "{}", 0)), "sync");
+}
+
+TEST_F(UnaryCallTest, UnaryCall_TimingEnabled_RecordsEveryPhase) {
+  _client->setCallTimingEnabled(true);
+  EXPECT_EQ(text(call("timed", "{}", 0, "call-1")), "timed");
+
+  const auto timing = nlohmann::json::parse(_client->takeCallTiming("call-1"));
+  for (const char* phase : {"queuedMs", "metadataMs", "firstByteSentMs", "initialMetadataMs", "responseMs", "settleMs",
+                            "nativeTotalMs"}) {
+    ASSERT_TRUE(timing[phase].is_number()) << phase << " in " << timing.dump();
+    EXPECT_GE(timing[phase].get<double>(), 0) << phase;
+  }
+  EXPECT_EQ(_client->takeCallTiming("call-1"), "");
+}
+
+TEST_F(UnaryCallTest, UnaryCall_TimingEnabledServerError_KeepsStatus) {
+  _client->setCallTimingEnabled(true);
+  try {
+    call("ping", R"({"x-status":["5"],"x-status-message":["missing"]})", 0, "call-2");
+    FAIL() << "expected rejection";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("[5]"), std::string::npos) << e.what();
+  }
+
+  const auto timing = nlohmann::json::parse(_client->takeCallTiming("call-2"));
+  EXPECT_TRUE(timing["nativeTotalMs"].is_number()) << timing.dump();
+}
+
+TEST_F(UnaryCallTest, UnaryCall_TimingDisabled_RecordsNothing) {
+  call("untimed", "{}", 0, "call-3");
+  EXPECT_EQ(_client->takeCallTiming("call-3"), "");
+}
+
+TEST_F(UnaryCallTest, UnaryCall_TimingOnAndOff_SameStatusMetadataAndBytes) {
+  // Timing switches perform() to the step-by-step timedCall path; callers must not see a difference
+  struct Outcome {
+    std::string result; // Response bytes, or the rejection message
+    std::vector<std::string> metadata;
+  };
+  int calls = 0;
+  auto run = [&](bool timed, const std::string& request, const std::string& metadataJson) {
+    _client->setCallTimingEnabled(timed);
+    const std::string callId = "timing-" + std::to_string(calls++);
+    Outcome outcome;
+    try {
+      outcome.result = "ok:" + text(call(request, metadataJson, 0, callId));
+    } catch (const std::runtime_error& e) {
+      outcome.result = std::string("error:") + e.what();
+    }
+    for (const auto& metadata : _client->takeCallMetadata(callId)) {
+      outcome.metadata.push_back(metadata->toJson());
+    }
+    EXPECT_EQ(_client->takeCallTiming(callId).empty(), !timed) << callId;
+    return outcome;
+  };
+
+  for (const auto& [request, metadataJson] : std::vector<std::pair<std::string, std::string>>{
+           {"payload", R"({"x-echo-metadata":["1"],"x-hdr":["a","b"]})"},
+           {"", "{}"},
+           {std::string(64 * 1024, 'x'), R"({"x-echo-metadata":["1"]})"},
+           {"ping", R"({"x-echo-metadata":["1"],"x-hdr":["v"],"x-status":["5"],"x-status-message":["missing"]})"},
+           {"ping", R"({"x-status":["14"]})"},
+       }) {
+    const auto untimed = run(false, request, metadataJson);
+    const auto timed = run(true, request, metadataJson);
+
+    EXPECT_EQ(timed.result, untimed.result) << metadataJson;
+    EXPECT_EQ(timed.metadata, untimed.metadata) << metadataJson;
+    EXPECT_EQ(untimed.metadata.size(), 2u) << metadataJson;
+  }
+}
+
+TEST_F(UnaryCallTest, UnaryCall_CoalescedWithoutOrWithDuplicateCallId_RejectsInsteadOfThrowing) {
+  _client->configureCoalescing(R"({"methods":{"/test.Echo/Unary":{}}})");
+
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> promise;
+  ASSERT_NO_THROW(promise = _client->unaryCall("/test.Echo/Unary", bytes("ping"), "{}", 0, ""));
+  EXPECT_THROW(promise->await().get(), std::runtime_error);
+
+  auto first = _client->unaryCall("/test.Echo/Unary", bytes("slow"), R"({"x-delay-ms":["200"]})", 0, "dup");
+  ASSERT_NO_THROW(promise = _client->unaryCall("/test.Echo/Unary", bytes("other"), "{}", 0, "dup"));
+  EXPECT_THROW(promise->await().get(), std::runtime_error);
+  EXPECT_EQ(text(first->await().get()), "slow");
+}
+
+TEST_F(UnaryCallTest, TakeCallMetadata_Success_HasServerHeadersAndTrailers) {
+  call("ping", R"({"x-echo-metadata":["1"],"x-hdr":["v"]})", 0, "call-4");
+
+  const auto metadata = _client->takeCallMetadata("call-4");
+  ASSERT_EQ(metadata.size(), 2u);
+  EXPECT_EQ(metadata[0]->get("x-hdr"), std::vector<std::string>{"v"});
+  EXPECT_EQ(metadata[1]->get("x-trailer"), std::vector<std::string>{"done"});
+  EXPECT_TRUE(_client->takeCallMetadata("call-4").empty());
+}
+
+TEST_F(UnaryCallTest, TakeCallMetadata_ServerError_HasServerHeadersAndTrailers) {
+  EXPECT_THROW(call("ping", R"({"x-echo-metadata":["1"],"x-hdr":["v"],"x-status":["5"]})", 0, "call-5"),
+               std::runtime_error);
+
+  const auto metadata = _client->takeCallMetadata("call-5");
+  ASSERT_EQ(metadata.size(), 2u);
+  EXPECT_EQ(metadata[0]->get("x-hdr"), std::vector<std::string>{"v"});
+  EXPECT_EQ(metadata[1]->get("x-trailer"), std::vector<std::string>{"done"});
+}
+
+TEST_F(UnaryCallTest, TakeCallMetadata_NoCallIdOrFailedBeforeSending_ReturnsEmpty) {
+  call("ping", "{}");
+  EXPECT_TRUE(_client->takeCallMetadata("").empty());
+
+  // Invalid metadata fails the call before it reaches the server
+  EXPECT_THROW(call("ping", "{", 0, "call-6"), std::runtime_error);
+  EXPECT_TRUE(_client->takeCallMetadata("call-6").empty());
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
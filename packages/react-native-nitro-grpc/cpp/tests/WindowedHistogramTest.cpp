@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../metrics/WindowedHistogram.hpp"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+TEST(WindowedHistogramTest, Summarize_UniformValues_PercentilesWithinPrecision) {
+  WindowedHistogram histogram(60'000);
+  for (int64_t value = 1; value <= 100'000; value++) {
+    histogram.record(value, 0);
+  }
+
+  const auto summary = histogram.summarize({50, 90, 99, 100}, 0);
+  EXPECT_EQ(summary.count, 100'000u);
+  EXPECT_EQ(summary.max, 100'000);
+  const std::vector<int64_t> expected = {50'000, 90'000, 99'000, 100'000};
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(summary.percentiles[i], expected[i], expected[i] * 0.035) << "percentile #" << i;
+  }
+}
+
+TEST(WindowedHistogramTest, Summarize_SmallValues_Exact) {
+  WindowedHistogram histogram(60'000);
+  for (int64_t value : {0, 1, 2, 3, 63}) {
+    histogram.record(value, 0);
+  }
+
+  const auto summary = histogram.summarize({0, 40, 60, 100}, 0);
+  EXPECT_EQ(summary.percentiles, (std::vector<int64_t>{0, 1, 2, 63}));
+}
+
+TEST(WindowedHistogramTest, Summarize_AfterWindow_DropsOldValues) {
+  WindowedHistogram histogram(4'000); // 1 s slots
+  histogram.record(1'000, 0);
+  histogram.record(2'000, 2'500);
+
+  EXPECT_EQ(histogram.summarize({50}, 3'999).count, 2u);
+
+  // The first slot leaves the window; recording into it again clears it
+  const auto later = histogram.summarize({50}, 4'000);
+  EXPECT_EQ(later.count, 1u);
+  EXPECT_EQ(later.max, 2'000);
+
+  histogram.record(3'000, 4'100);
+  const auto rotated = histogram.summarize({100}, 4'100);
+  EXPECT_EQ(rotated.count, 2u);
+  EXPECT_EQ(rotated.max, 3'000);
+
+  EXPECT_EQ(histogram.summarize({50}, 60'000).count, 0u);
+}
+
+TEST(WindowedHistogramTest, SetWindow_DropsValues) {
+  WindowedHistogram histogram(60'000);
+  histogram.record(10, 0);
+
+  histogram.setWindow(1'000);
+  EXPECT_EQ(histogram.summarize({50}, 0).count, 0u);
+}
+
+TEST(WindowedHistogramTest, Record_ConcurrentThreads_CountsEveryValue) {
+  WindowedHistogram histogram(60'000);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&histogram] {
+      for (int i = 0; i < 10'000; i++) {
+        histogram.record(i, 0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(histogram.summarize({50}, 0).count, 40'000u);
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
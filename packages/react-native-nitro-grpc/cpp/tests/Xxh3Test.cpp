@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "utils/checksum/Xxh3.hpp"
+
+// A second, private copy of xxHash pinned to its portable scalar kernel, as the
+// reference for whichever vector kernel Xxh3.cpp was compiled with.
+#define XXH_INLINE_ALL
+#define XXH_VECTOR 0 // XXH_SCALAR
+#include "utils/checksum/xxhash.h"
+
+namespace margelo::nitro::grpc {
+namespace test {
+
+namespace {
+
+std::string hex64(uint64_t value) {
+  char out[17];
+  std::snprintf(out, sizeof(out), "%016" PRIx64, value);
+  return out;
+}
+
+// Canonical (big-endian) hex, as Xxh3::toHex produces
+std::string scalar64(const std::vector<uint8_t>& data) {
+  return hex64(XXH3_64bits(data.data(), data.size()));
+}
+
+std::string scalar128(const std::vector<uint8_t>& data) {
+  const XXH128_hash_t hash = XXH3_128bits(data.data(), data.size());
+  return hex64(hash.high64) + hex64(hash.low64);
+}
+
+std::vector<uint8_t> pattern(size_t length) {
+  std::vector<uint8_t> data(length);
+  for (size_t i = 0; i < length; i++) {
+    data[i] = static_cast<uint8_t>(i * 167 + 13);
+  }
+  return data;
+}
+
+// Past the 240-byte short-input paths and across several 1 KiB stripe blocks
+constexpr size_t kMaxLength = 2300;
+
+} // namespace
+
+TEST(Xxh3Test, Hash_EmptyInput_MatchesXxhsum) {
+  EXPECT_EQ(Xxh3::toHex(Xxh3::hash64(nullptr, 0)), "2d06800538d394c2");
+  EXPECT_EQ(Xxh3::toHex(Xxh3::hash128(nullptr, 0)), "99aa06d3014798d86001c324468d497f");
+}
+
+TEST(Xxh3Test, Hash_AllLengths_MatchesScalarReference) {
+  const auto data = pattern(kMaxLength);
+  for (size_t length = 0; length <= kMaxLength; length++) {
+    const std::vector<uint8_t> input(data.begin(), data.begin() + length);
+
+    ASSERT_EQ(Xxh3::toHex(Xxh3::hash64(input.data(), input.size())), scalar64(input)) << "length " << length;
+    ASSERT_EQ(Xxh3::toHex(Xxh3::hash128(input.data(), input.size())), scalar128(input)) << "length " << length;
+  }
+}
+
+TEST(Xxh3Test, Update_Chunked_MatchesScalarReference) {
+  const auto data = pattern(kMaxLength);
+  for (size_t chunk : {1, 7, 64, 239, 256, 1000}) {
+    Xxh3 hasher;
+    for (size_t offset = 0; offset < data.size(); offset += chunk) {
+      hasher.update(data.data() + offset, std::min(chunk, data.size() - offset));
+    }
+
+    EXPECT_EQ(Xxh3::toHex(hasher.digest64()), scalar64(data)) << "chunk " << chunk;
+    EXPECT_EQ(Xxh3::toHex(hasher.digest128()), scalar128(data)) << "chunk " << chunk;
+  }
+}
+
+TEST(Xxh3Test, Digest_ThenMoreData_ContinuesStream) {
+  const auto data = pattern(500);
+  Xxh3 hasher;
+  hasher.update(data.data(), 200);
+  EXPECT_EQ(Xxh3::toHex(hasher.digest64()), scalar64({data.begin(), data.begin() + 200}));
+
+  hasher.update(data.data() + 200, 300);
+  EXPECT_EQ(Xxh3::toHex(hasher.digest64()), scalar64(data));
+
+  hasher.reset();
+  EXPECT_EQ(Xxh3::toHex(hasher.digest64()), "2d06800538d394c2");
+}
+
+} // namespace test
+} // namespace margelo::nitro::grpc
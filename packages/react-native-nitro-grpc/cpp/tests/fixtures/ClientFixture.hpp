@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "HybridGrpcClient.hpp"
+#include "TestServer.hpp"
+
+namespace margelo::nitro::grpc::test {
+
+/**
+ * @brief Test fixture with a TestServer and a client connected to it.
+ */
+class ClientFixture : public ::testing::Test {
+protected:
+  void SetUp() override {
+    _client = std::make_shared<HybridGrpcClient>();
+    _client->connect(_server.target(), R"({"type":"insecure"})", "{}");
+  }
+
+  static std::shared_ptr<ArrayBuffer> bytes(const std::string& text) {
+    return ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+  }
+
+  static std::string text(const std::shared_ptr<ArrayBuffer>& buffer) {
+    return std::string(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+  }
+
+  /**
+   * Absolute deadline `ms` from now, in the epoch milliseconds the client expects.
+   */
+  static double deadlineIn(int64_t ms) {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count() + ms);
+  }
+
+  TestServer _server;
+  std::shared_ptr<HybridGrpcClient> _client;
+};
+
+} // namespace margelo::nitro::grpc::test
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <NitroModules/AnyMap.hpp>
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CodecTestDescriptor.hpp"
+#include "ProtoCodec.hpp"
+#include "ProtoSchema.hpp"
+
+namespace margelo::nitro::grpc::test {
+
+/**
+ * @brief Test fixture with the types of codec_test.proto loaded.
+ */
+class ProtoFixture : public ::testing::Test {
+protected:
+  void SetUp() override {
+    _schema = std::make_shared<ProtoSchema>();
+    _schema->load(kCodecTestDescriptorSet, sizeof(kCodecTestDescriptorSet));
+  }
+
+  const MessagePlan& plan(const std::string& name) const {
+    const MessagePlan* found = _schema->find("codectest." + name);
+    if (found == nullptr) {
+      throw std::runtime_error("Unknown test type " + name);
+    }
+    return *found;
+  }
+
+  AnyObject decode(const std::string& type, const std::vector<uint8_t>& bytes) const {
+    AnyObject out;
+    ProtoCodec::decode(plan(type), bytes.data(), bytes.size(), out);
+    return out;
+  }
+
+  std::vector<uint8_t> encode(const std::string& type, const AnyObject& message) const {
+    std::vector<uint8_t> out;
+    ProtoCodec::encode(plan(type), message, out);
+    return out;
+  }
+
+  /**
+   * The value as JSON, so comparisons ignore property order and failures print readably.
+   */
+  static nlohmann::json toJson(const AnyValue& value) {
+    if (const bool* boolean = std::get_if<bool>(&value)) {
+      return *boolean;
+    }
+    if (const double* number = std::get_if<double>(&value)) {
+      return *number;
+    }
+    if (const int64_t* bigint = std::get_if<int64_t>(&value)) {
+      return *bigint;
+    }
+    if (const std::string* string = std::get_if<std::string>(&value)) {
+      return *string;
+    }
+    if (const AnyArray* array = std::get_if<AnyArray>(&value)) {
+      auto result = nlohmann::json::array();
+      for (const AnyValue& item : *array) {
+        result.push_back(toJson(item));
+      }
+      return result;
+    }
+    if (const AnyObject* object = std::get_if<AnyObject>(&value)) {
+      return toJson(*object);
+    }
+    return nullptr;
+  }
+
+  static nlohmann::json toJson(const AnyObject& object) {
+    auto result = nlohmann::json::object();
+    for (const auto& [key, item] : object) {
+      result[key] = toJson(item);
+    }
+    return result;
+  }
+
+  std::shared_ptr<ProtoSchema> _schema;
+};
+
+} // namespace margelo::nitro::grpc::test
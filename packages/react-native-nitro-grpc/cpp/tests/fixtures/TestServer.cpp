@@ -0,0 +1,162 @@
+#include "TestServer.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace margelo::nitro::grpc::test {
+
+namespace {
+
+std::string header(const ::grpc::GenericCallbackServerContext& context, const std::string& key) {
+  auto it = context.client_metadata().find(key);
+  if (it == context.client_metadata().end()) {
+    return "";
+  }
+  return std::string(it->second.data(), it->second.size());
+}
+
+int headerInt(const ::grpc::GenericCallbackServerContext& context, const std::string& key, int fallback) {
+  const std::string value = header(context, key);
+  return value.empty() ? fallback : std::stoi(value);
+}
+
+} // namespace
+
+/**
+ * One call. Reads requests one at a time and answers each with `_repeat`
+ * writes, so at most one read or write is in flight.
+ */
+class TestServer::Reactor : public ::grpc::ServerGenericBidiReactor {
+public:
+  Reactor(TestServer& owner, ::grpc::GenericCallbackServerContext* context) : _owner(owner) {
+    _repeat = headerInt(*context, "x-repeat", 1);
+    _delayMs = headerInt(*context, "x-delay-ms", 0);
+    _replyAtEnd = header(*context, "x-reply-at-end") == "1";
+    const int code = headerInt(*context, "x-status", 0);
+    _finalStatus = ::grpc::Status(static_cast<::grpc::StatusCode>(code), header(*context, "x-status-message"));
+
+    if (header(*context, "x-echo-metadata") == "1") {
+      for (const auto& [key, value] : context->client_metadata()) {
+        std::string keyStr(key.data(), key.size());
+        if (keyStr.rfind("x-", 0) == 0) {
+          context->AddInitialMetadata(keyStr, std::string(value.data(), value.size()));
+        }
+      }
+      context->AddTrailingMetadata("x-trailer", "done");
+      StartSendInitialMetadata();
+    }
+    StartRead(&_request);
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      // Client half-closed (or the call died)
+      if (_replyAtEnd && _hasRequest && _finalStatus.ok()) {
+        _remaining = 0;
+        _finishAfterWrite = true;
+        StartWrite(&_request);
+      } else {
+        Finish(_finalStatus);
+      }
+      return;
+    }
+    _owner._requestCount++;
+    _hasRequest = true;
+    if (_replyAtEnd || _repeat <= 0) {
+      StartRead(&_request);
+      return;
+    }
+    _remaining = _repeat;
+    writeNext();
+  }
+
+  void OnWriteDone(bool ok) override {
+    if (!ok || _finishAfterWrite) {
+      Finish(ok ? _finalStatus : ::grpc::Status::CANCELLED);
+      return;
+    }
+    if (_remaining > 0) {
+      writeNext();
+    } else {
+      StartRead(&_request);
+    }
+  }
+
+  void OnSendInitialMetadataDone(bool /* ok */) override {}
+
+  void OnDone() override {
+    delete this;
+  }
+
+private:
+  void writeNext() {
+    if (_delayMs > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(_delayMs));
+    }
+    _remaining--;
+    StartWrite(&_request);
+  }
+
+  TestServer& _owner;
+  ::grpc::ByteBuffer _request;
+  ::grpc::Status _finalStatus;
+  int _repeat = 1;
+  int _delayMs = 0;
+  int _remaining = 0;
+  bool _replyAtEnd = false;
+  bool _hasRequest = false;
+  bool _finishAfterWrite = false;
+};
+
+class TestServer::Service : public ::grpc::CallbackGenericService {
+public:
+  explicit Service(TestServer& owner) : _owner(owner) {}
+
+  ::grpc::ServerGenericBidiReactor* CreateReactor(::grpc::GenericCallbackServerContext* context) override {
+    _owner.recordCall(*context);
+    return new Reactor(_owner, context);
+  }
+
+private:
+  TestServer& _owner;
+};
+
+TestServer::TestServer() : _service(std::make_unique<Service>(*this)) {
+  ::grpc::ServerBuilder builder;
+  builder.AddListeningPort("127.0.0.1:0", ::grpc::InsecureServerCredentials(), &_port);
+  builder.RegisterCallbackGenericService(_service.get());
+  _server = builder.BuildAndStart();
+  if (!_server || _port == 0) {
+    throw std::runtime_error("TestServer: failed to start");
+  }
+}
+
+TestServer::~TestServer() {
+  _server->Shutdown();
+  _server->Wait();
+}
+
+std::string TestServer::target() const {
+  return "127.0.0.1:" + std::to_string(_port);
+}
+
+std::multimap<std::string, std::string> TestServer::lastClientMetadata() const {
+  std::lock_guard<std::mutex> lock(_metadataMutex);
+  return _lastClientMetadata;
+}
+
+void TestServer::recordCall(const ::grpc::GenericCallbackServerContext& context) {
+  _callCount++;
+  std::multimap<std::string, std::string> metadata;
+  for (const auto& [key, value] : context.client_metadata()) {
+    std::string keyStr(key.data(), key.size());
+    if (keyStr.rfind("x-", 0) == 0) {
+      metadata.emplace(std::move(keyStr), std::string(value.data(), value.size()));
+    }
+  }
+  std::lock_guard<std::mutex> lock(_metadataMutex);
+  _lastClientMetadata = std::move(metadata);
+}
+
+} // namespace margelo::nitro::grpc::test
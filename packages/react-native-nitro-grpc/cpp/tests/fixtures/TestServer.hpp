@@ -0,0 +1,81 @@
+#pragma once
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/grpcpp.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::grpc::test {
+
+/**
+ * @brief In-process gRPC server that answers every method, for host tests
+ * and benchmarks.
+ *
+ * Methods are not registered: any path is accepted and handled as a
+ * bidirectional stream, which covers unary, server, client and bidi calls on
+ * the client side. By default each request is echoed back once. Clients can
+ * change that per call through request metadata:
+ *
+ * - `x-repeat: N` answers each request N times (server-streaming load)
+ * - `x-reply-at-end: 1` stays silent until the client half-closes, then
+ *   answers once with the last request (client streaming)
+ * - `x-delay-ms: N` waits N ms before each answer
+ * - `x-status: N` / `x-status-message: text` finishes with that status
+ *   instead of OK
+ * - `x-echo-metadata: 1` returns every `x-` header as initial metadata and
+ *   adds a `x-trailer: done` trailer
+ *
+ * Listens on an ephemeral loopback port; shuts down on destruction.
+ */
+class TestServer {
+public:
+  TestServer();
+  ~TestServer();
+
+  TestServer(const TestServer&) = delete;
+  TestServer& operator=(const TestServer&) = delete;
+
+  /**
+   * Address to pass to ChannelManager / HybridGrpcClient::connect.
+   */
+  std::string target() const;
+
+  /**
+   * Number of request messages received since construction.
+   */
+  size_t requestCount() const {
+    return _requestCount.load();
+  }
+
+  /**
+   * Number of calls started since construction.
+   */
+  size_t callCount() const {
+    return _callCount.load();
+  }
+
+  /**
+   * The `x-` prefixed headers of the most recent call.
+   */
+  std::multimap<std::string, std::string> lastClientMetadata() const;
+
+private:
+  class Service;
+  class Reactor;
+
+  void recordCall(const ::grpc::GenericCallbackServerContext& context);
+
+  std::unique_ptr<Service> _service;
+  std::unique_ptr<::grpc::Server> _server;
+  int _port = 0;
+  std::atomic<size_t> _requestCount{0};
+  std::atomic<size_t> _callCount{0};
+  mutable std::mutex _metadataMutex;
+  std::multimap<std::string, std::string> _lastClientMetadata;
+};
+
+} // namespace margelo::nitro::grpc::test
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Null.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro {
+
+struct AnyValue;
+using AnyArray = std::vector<AnyValue>;
+using AnyObject = std::unordered_map<std::string, AnyValue>;
+using VariantType = std::variant<NullType, bool, double, int64_t, std::string, AnyArray, AnyObject>;
+
+/**
+ * @brief Host stand-in for Nitro's AnyValue (a JS value of unknown shape).
+ */
+struct AnyValue : VariantType {
+  using VariantType::variant;
+  AnyValue(const VariantType& variant) : VariantType(variant) {}
+  AnyValue(VariantType&& variant) : VariantType(std::move(variant)) {}
+};
+
+/**
+ * @brief Host stand-in for Nitro's AnyMap (a JS object of unknown shape).
+ */
+class AnyMap final {
+public:
+  AnyMap() = default;
+  explicit AnyMap(size_t size) {
+    _map.reserve(size);
+  }
+
+  static std::shared_ptr<AnyMap> make() {
+    return std::make_shared<AnyMap>();
+  }
+  static std::shared_ptr<AnyMap> make(size_t size) {
+    return std::make_shared<AnyMap>(size);
+  }
+
+  bool contains(const std::string& key) const {
+    return _map.find(key) != _map.end();
+  }
+
+  std::unordered_map<std::string, AnyValue>& getMap() {
+    return _map;
+  }
+
+private:
+  std::unordered_map<std::string, AnyValue> _map;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace margelo::nitro {
+
+/**
+ * @brief Host stand-in for Nitro's ArrayBuffer.
+ *
+ * Mirrors the subset of the NitroModules API used by cpp/ so the core can be
+ * built and tested without a JS runtime. Buffers are always native-owned.
+ */
+class ArrayBuffer {
+public:
+  using DeleteFn = std::function<void()>;
+
+  ArrayBuffer(uint8_t* data, size_t size, DeleteFn&& deleteFunc)
+      : _data(data), _size(size), _deleteFunc(std::move(deleteFunc)) {}
+  ArrayBuffer(const ArrayBuffer&) = delete;
+  ArrayBuffer& operator=(const ArrayBuffer&) = delete;
+
+  ~ArrayBuffer() {
+    if (_deleteFunc) {
+      _deleteFunc();
+    }
+  }
+
+  uint8_t* data() {
+    return _data;
+  }
+  size_t size() const {
+    return _size;
+  }
+  bool isOwner() const noexcept {
+    return true;
+  }
+
+  static std::shared_ptr<ArrayBuffer> wrap(uint8_t* data, size_t size, DeleteFn&& deleteFunc) {
+    return std::make_shared<ArrayBuffer>(data, size, std::move(deleteFunc));
+  }
+
+  static std::shared_ptr<ArrayBuffer> allocate(size_t size) {
+    auto* data = new uint8_t[size > 0 ? size : 1];
+    return wrap(data, size, [data]() { delete[] data; });
+  }
+
+  static std::shared_ptr<ArrayBuffer> copy(const uint8_t* data, size_t size) {
+    auto buffer = allocate(size);
+    if (size > 0) {
+      std::memcpy(buffer->data(), data, size);
+    }
+    return buffer;
+  }
+
+  static std::shared_ptr<ArrayBuffer> copy(const std::vector<uint8_t>& data) {
+    return copy(data.data(), data.size());
+  }
+
+private:
+  uint8_t* _data;
+  size_t _size;
+  DeleteFn _deleteFunc;
+};
+
+} // namespace margelo::nitro
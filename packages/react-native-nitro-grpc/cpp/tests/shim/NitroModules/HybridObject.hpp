@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro {
+
+/**
+ * @brief Host stand-in for Nitro's method prototype registry.
+ *
+ * Registration is a no-op on the host; methods are invoked directly from C++.
+ */
+class Prototype {
+public:
+  template <typename Derived, typename ReturnType, typename... Args>
+  void registerHybridMethod(const std::string&, ReturnType (Derived::*)(Args...)) {}
+  template <typename Derived, typename ReturnType>
+  void registerHybridGetter(const std::string&, ReturnType (Derived::*)()) {}
+};
+
+/**
+ * @brief Host stand-in for Nitro's HybridObject base.
+ */
+class HybridObject : public virtual std::enable_shared_from_this<HybridObject> {
+public:
+  explicit HybridObject(const char* name) : _name(name) {}
+  virtual ~HybridObject() = default;
+
+  const char* getName() const {
+    return _name;
+  }
+
+protected:
+  virtual void loadHybridMethods() {}
+
+  template <typename Derived, typename Fn> void registerHybrids(Derived*, Fn&& fn) {
+    Prototype prototype;
+    fn(prototype);
+  }
+
+private:
+  const char* _name;
+};
+
+} // namespace margelo::nitro
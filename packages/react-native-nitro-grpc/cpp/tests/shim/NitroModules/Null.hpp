@@ -0,0 +1,13 @@
+#pragma once
+
+namespace margelo::nitro {
+
+struct NullType {
+  bool operator==(const NullType&) const {
+    return true;
+  }
+};
+
+inline constexpr NullType null{};
+
+} // namespace margelo::nitro
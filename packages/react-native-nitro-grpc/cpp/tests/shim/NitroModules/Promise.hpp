@@ -0,0 +1,215 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro {
+
+/**
+ * @brief Host stand-in for Nitro's Promise.
+ *
+ * Resolution happens inline on the resolving thread; listeners and `await()`
+ * let host tests observe the outcome.
+ */
+template <typename TResult> class Promise {
+public:
+  using OnResolvedFunc = std::function<void(const TResult&)>;
+  using OnRejectedFunc = std::function<void(const std::exception_ptr&)>;
+
+  static std::shared_ptr<Promise> create() {
+    return std::shared_ptr<Promise>(new Promise());
+  }
+
+  static std::shared_ptr<Promise> async(std::function<TResult()>&& run) {
+    auto promise = create();
+    ThreadPool::shared().run([run = std::move(run), promise]() {
+      try {
+        promise->resolve(run());
+      } catch (...) {
+        promise->reject(std::current_exception());
+      }
+    });
+    return promise;
+  }
+
+  void resolve(const TResult& result) {
+    std::vector<OnResolvedFunc> listeners;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_result.has_value() || _error) {
+        return;
+      }
+      _result = result;
+      listeners.swap(_onResolved);
+      _onRejected.clear();
+    }
+    for (auto& listener : listeners) {
+      listener(result);
+    }
+  }
+
+  void reject(const std::exception_ptr& error) {
+    std::vector<OnRejectedFunc> listeners;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_result.has_value() || _error) {
+        return;
+      }
+      _error = error;
+      listeners.swap(_onRejected);
+      _onResolved.clear();
+    }
+    for (auto& listener : listeners) {
+      listener(error);
+    }
+  }
+
+  void addOnResolvedListener(OnResolvedFunc&& onResolved) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_result.has_value()) {
+      auto result = *_result;
+      lock.unlock();
+      onResolved(result);
+    } else if (!_error) {
+      _onResolved.push_back(std::move(onResolved));
+    }
+  }
+
+  void addOnRejectedListener(OnRejectedFunc&& onRejected) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_error) {
+      auto error = _error;
+      lock.unlock();
+      onRejected(error);
+    } else if (!_result.has_value()) {
+      _onRejected.push_back(std::move(onRejected));
+    }
+  }
+
+  std::future<TResult> await() {
+    auto promise = std::make_shared<std::promise<TResult>>();
+    addOnResolvedListener([promise](const TResult& result) { promise->set_value(result); });
+    addOnRejectedListener([promise](const std::exception_ptr& error) { promise->set_exception(error); });
+    return promise->get_future();
+  }
+
+  bool isPending() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return !_result.has_value() && !_error;
+  }
+
+private:
+  Promise() = default;
+
+  std::mutex _mutex;
+  std::optional<TResult> _result;
+  std::exception_ptr _error;
+  std::vector<OnResolvedFunc> _onResolved;
+  std::vector<OnRejectedFunc> _onRejected;
+};
+
+template <> class Promise<void> {
+public:
+  using OnResolvedFunc = std::function<void()>;
+  using OnRejectedFunc = std::function<void(const std::exception_ptr&)>;
+
+  static std::shared_ptr<Promise> create() {
+    return std::shared_ptr<Promise>(new Promise());
+  }
+
+  static std::shared_ptr<Promise> async(std::function<void()>&& run) {
+    auto promise = create();
+    ThreadPool::shared().run([run = std::move(run), promise]() {
+      try {
+        run();
+        promise->resolve();
+      } catch (...) {
+        promise->reject(std::current_exception());
+      }
+    });
+    return promise;
+  }
+
+  void resolve() {
+    std::vector<OnResolvedFunc> listeners;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_resolved || _error) {
+        return;
+      }
+      _resolved = true;
+      listeners.swap(_onResolved);
+      _onRejected.clear();
+    }
+    for (auto& listener : listeners) {
+      listener();
+    }
+  }
+
+  void reject(const std::exception_ptr& error) {
+    std::vector<OnRejectedFunc> listeners;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_resolved || _error) {
+        return;
+      }
+      _error = error;
+      listeners.swap(_onRejected);
+      _onResolved.clear();
+    }
+    for (auto& listener : listeners) {
+      listener(error);
+    }
+  }
+
+  void addOnResolvedListener(OnResolvedFunc&& onResolved) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_resolved) {
+      lock.unlock();
+      onResolved();
+    } else if (!_error) {
+      _onResolved.push_back(std::move(onResolved));
+    }
+  }
+
+  void addOnRejectedListener(OnRejectedFunc&& onRejected) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_error) {
+      auto error = _error;
+      lock.unlock();
+      onRejected(error);
+    } else if (!_resolved) {
+      _onRejected.push_back(std::move(onRejected));
+    }
+  }
+
+  std::future<void> await() {
+    auto promise = std::make_shared<std::promise<void>>();
+    addOnResolvedListener([promise]() { promise->set_value(); });
+    addOnRejectedListener([promise](const std::exception_ptr& error) { promise->set_exception(error); });
+    return promise->get_future();
+  }
+
+  bool isPending() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return !_resolved && !_error;
+  }
+
+private:
+  Promise() = default;
+
+  std::mutex _mutex;
+  bool _resolved = false;
+  std::exception_ptr _error;
+  std::vector<OnResolvedFunc> _onResolved;
+  std::vector<OnRejectedFunc> _onRejected;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro {
+
+/**
+ * @brief Host stand-in for Nitro's shared worker pool backing Promise::async.
+ */
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t threadCount) {
+    for (size_t i = 0; i < threadCount; i++) {
+      _workers.emplace_back([this]() { workerLoop(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopped = true;
+    }
+    _cv.notify_all();
+    for (auto& worker : _workers) {
+      worker.join();
+    }
+  }
+
+  void run(std::function<void()>&& task) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _tasks.push_back(std::move(task));
+    }
+    _cv.notify_one();
+  }
+
+  static ThreadPool& shared() {
+    static ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()));
+    return pool;
+  }
+
+private:
+  void workerLoop() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]() { return _stopped || !_tasks.empty(); });
+        if (_stopped && _tasks.empty()) {
+          return;
+        }
+        task = std::move(_tasks.front());
+        _tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> _workers;
+  std::deque<std::function<void()>> _tasks;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  bool _stopped = false;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/Base64.nitro.ts`.
+ */
+class HybridBase64Spec : public virtual HybridObject {
+public:
+  HybridBase64Spec() : HybridObject(TAG) {}
+  ~HybridBase64Spec() override = default;
+
+public:
+  virtual std::string encode(const std::shared_ptr<ArrayBuffer>& data, bool urlSafe) = 0;
+  virtual std::shared_ptr<ArrayBuffer> decode(const std::string& base64, bool urlSafe) = 0;
+  virtual double decodeInto(const std::string& base64,
+                            const std::shared_ptr<ArrayBuffer>& target,
+                            double offset,
+                            double length,
+                            bool urlSafe) = 0;
+  virtual double decodedLength(const std::string& base64) = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "Base64";
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <NitroModules/HybridObject.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/CallMetadata.nitro.ts`.
+ */
+class HybridCallMetadataSpec : public virtual HybridObject {
+public:
+  HybridCallMetadataSpec() : HybridObject(TAG) {}
+  ~HybridCallMetadataSpec() override = default;
+
+public:
+  virtual double getSize() = 0;
+  virtual std::vector<std::string> get(const std::string& key) = 0;
+  virtual std::string toJson() = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "CallMetadata";
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/ChecksumHasher.nitro.ts`.
+ */
+class HybridChecksumHasherSpec : public virtual HybridObject {
+public:
+  HybridChecksumHasherSpec() : HybridObject(TAG) {}
+  ~HybridChecksumHasherSpec() override = default;
+
+public:
+  virtual std::string getAlgorithm() = 0;
+  virtual void update(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) = 0;
+  virtual void updateString(const std::string& data) = 0;
+  virtual std::string digest() = 0;
+  virtual std::shared_ptr<ArrayBuffer> digestBytes() = 0;
+  virtual void reset() = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "ChecksumHasher";
+};
+
+} // namespace margelo::nitro::grpc
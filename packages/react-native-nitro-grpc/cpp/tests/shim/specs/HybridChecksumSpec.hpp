@@ -0,0 +1,41 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include "HybridChecksumHasherSpec.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/Checksum.nitro.ts`.
+ */
+class HybridChecksumSpec : public virtual HybridObject {
+public:
+  HybridChecksumSpec() : HybridObject(TAG) {}
+  ~HybridChecksumSpec() override = default;
+
+public:
+  virtual double crc32c(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) = 0;
+  virtual double crc32cString(const std::string& data) = 0;
+  virtual std::string xxh3(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) = 0;
+  virtual std::string xxh3String(const std::string& data) = 0;
+  virtual std::string xxh128(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) = 0;
+  virtual std::string xxh128String(const std::string& data) = 0;
+  virtual std::shared_ptr<HybridChecksumHasherSpec> createHasher(const std::string& algorithm) = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "Checksum";
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "HybridCallMetadataSpec.hpp"
+#include "HybridGrpcStreamSpec.hpp"
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/GrpcClient.nitro.ts`.
+ */
+class HybridGrpcClientSpec : public virtual HybridObject {
+public:
+  HybridGrpcClientSpec() : HybridObject(TAG) {}
+  ~HybridGrpcClientSpec() override = default;
+
+public:
+  virtual void connect(const std::string& target, const std::string& credentialsJson, const std::string& optionsJson) = 0;
+  virtual void connectWithCallCredentials(const std::string& target,
+                                          const std::string& credentialsJson,
+                                          const std::string& optionsJson,
+                                          const std::string& callCredentialsJson) = 0;
+  virtual void close() = 0;
+  virtual double getConnectivityState(bool tryToConnect) = 0;
+  virtual std::shared_ptr<Promise<void>> watchConnectivityState(double lastState, double deadlineMs) = 0;
+  virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> unaryCall(const std::string& method,
+                                                                           const std::shared_ptr<ArrayBuffer>& request,
+                                                                           const std::string& metadataJson,
+                                                                           double deadlineMs,
+                                                                           const std::string& callId) = 0;
+  virtual void cancelCall(const std::string& callId) = 0;
+  virtual void setCallTimingEnabled(bool enabled) = 0;
+  virtual std::string takeCallTiming(const std::string& callId) = 0;
+  virtual std::vector<std::shared_ptr<HybridCallMetadataSpec>> takeCallMetadata(const std::string& callId) = 0;
+  virtual std::string getStats(bool reset) = 0;
+  virtual void configureHistograms(const std::string& configJson) = 0;
+  virtual std::string getLatencyPercentiles(const std::string& method, const std::vector<double>& percentiles) = 0;
+  virtual std::string getMessageSizePercentiles(const std::string& method, const std::vector<double>& percentiles) = 0;
+  virtual void configureResponseCache(const std::string& configJson) = 0;
+  virtual std::string getResponseCacheStats() = 0;
+  virtual void invalidateResponseCache(const std::string& method) = 0;
+  virtual void configureCoalescing(const std::string& configJson) = 0;
+  virtual std::string getTlsSessionStats() = 0;
+  virtual void configureBufferPool(const std::string& configJson) = 0;
+  virtual std::string getBufferPoolStats() = 0;
+  virtual bool releaseBuffer(const std::shared_ptr<ArrayBuffer>& buffer) = 0;
+  virtual void setTracingEnabled(bool enabled) = 0;
+  virtual double dumpTrace(const std::string& path) = 0;
+  virtual void configureLogging(const std::string& configJson) = 0;
+  virtual void setLogHandler(const std::function<void(const std::string&, const std::string&, const std::string&, double)>& handler) = 0;
+  virtual void clearLogHandler() = 0;
+  virtual std::string registerCredentials(const std::string& credentialsJson, const std::string& callCredentialsJson) = 0;
+  virtual void connectWithCredentials(const std::string& target, const std::string& credentialsHandle, const std::string& optionsJson) = 0;
+  virtual std::string getEffectiveChannelOptions() = 0;
+  virtual double registerMethod(const std::string& path, const std::string& type, const std::string& defaultsJson) = 0;
+  virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> unaryCallWithHandle(double handle, const std::shared_ptr<ArrayBuffer>& request, const std::string& metadataJson, double deadlineMs, const std::string& callId) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec> createServerStreamWithHandle(double handle, const std::shared_ptr<ArrayBuffer>& request, const std::string& metadataJson, double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec> createClientStreamWithHandle(double handle, const std::string& metadataJson, double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec> createBidiStreamWithHandle(double handle, const std::string& metadataJson, double deadlineMs) = 0;
+  virtual std::shared_ptr<ArrayBuffer> unaryCallSync(const std::string& method,
+                                                     const std::shared_ptr<ArrayBuffer>& request,
+                                                     const std::string& metadata,
+                                                     double deadline) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec> createServerStream(const std::string& method,
+                                                                   const std::shared_ptr<ArrayBuffer>& request,
+                                                                   const std::string& metadataJson,
+                                                                   double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec>
+  createClientStream(const std::string& method, const std::string& metadataJson, double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec>
+  createBidiStream(const std::string& method, const std::string& metadataJson, double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec> createServerStreamSync(const std::string& method,
+                                                                       const std::shared_ptr<ArrayBuffer>& request,
+                                                                       const std::string& metadataJson,
+                                                                       double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec>
+  createClientStreamSync(const std::string& method, const std::string& metadataJson, double deadlineMs) = 0;
+  virtual std::shared_ptr<HybridGrpcStreamSpec>
+  createBidiStreamSync(const std::string& method, const std::string& metadataJson, double deadlineMs) = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "GrpcClient";
+};
+
+} // namespace margelo::nitro::grpc
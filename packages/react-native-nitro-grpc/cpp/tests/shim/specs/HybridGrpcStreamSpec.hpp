@@ -0,0 +1,44 @@
+#pragma once
+
+#include "HybridCallMetadataSpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/GrpcStream.nitro.ts`.
+ */
+class HybridGrpcStreamSpec : public virtual HybridObject {
+public:
+  HybridGrpcStreamSpec() : HybridObject(TAG) {}
+  ~HybridGrpcStreamSpec() override = default;
+
+public:
+  virtual void write(const std::shared_ptr<ArrayBuffer>& data) = 0;
+  virtual void writesDone() = 0;
+  virtual void onData(const std::function<void(const std::shared_ptr<ArrayBuffer>&)>& callback) = 0;
+  virtual void onMetadata(const std::function<void(const std::shared_ptr<HybridCallMetadataSpec>&)>& callback) = 0;
+  virtual void onStatus(const std::function<void(double, const std::string&, const std::shared_ptr<HybridCallMetadataSpec>&)>& callback) = 0;
+  virtual void onError(const std::function<void(const std::string&)>& callback) = 0;
+  virtual void cancel() = 0;
+  virtual std::variant<nitro::NullType, std::shared_ptr<ArrayBuffer>> readSync() = 0;
+  virtual void writeSync(const std::shared_ptr<ArrayBuffer>& data) = 0;
+  virtual std::variant<nitro::NullType, std::shared_ptr<ArrayBuffer>> finishSync() = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "GrpcStream";
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/Gzip.nitro.ts`.
+ */
+class HybridGzipSpec : public virtual HybridObject {
+public:
+  HybridGzipSpec() : HybridObject(TAG) {}
+  ~HybridGzipSpec() override = default;
+
+public:
+  virtual std::shared_ptr<ArrayBuffer> gzip(const std::shared_ptr<ArrayBuffer>& data) = 0;
+  virtual std::shared_ptr<ArrayBuffer> ungzip(const std::shared_ptr<ArrayBuffer>& data) = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "Gzip";
+};
+
+} // namespace margelo::nitro::grpc
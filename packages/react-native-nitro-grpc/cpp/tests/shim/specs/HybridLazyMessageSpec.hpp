@@ -0,0 +1,39 @@
+#pragma once
+
+#include <NitroModules/AnyMap.hpp>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/LazyMessage.nitro.ts`.
+ */
+class HybridLazyMessageSpec : public virtual HybridObject {
+public:
+  HybridLazyMessageSpec() : HybridObject(TAG) {}
+  ~HybridLazyMessageSpec() override = default;
+
+public:
+  virtual std::string getTypeName() = 0;
+  virtual double getByteLength() = 0;
+  virtual bool has(const std::string& field) = 0;
+  virtual double count(const std::string& field) = 0;
+  virtual std::shared_ptr<AnyMap> pick(const std::vector<std::string>& fields) = 0;
+  virtual std::shared_ptr<AnyMap> slice(const std::string& field, double start, double end) = 0;
+  virtual std::optional<std::shared_ptr<HybridLazyMessageSpec>> getMessage(const std::string& field, double index) = 0;
+  virtual std::shared_ptr<AnyMap> decode() = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "LazyMessage";
+};
+
+} // namespace margelo::nitro::grpc
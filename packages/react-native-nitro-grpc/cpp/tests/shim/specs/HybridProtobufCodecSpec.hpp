@@ -0,0 +1,35 @@
+#pragma once
+
+#include <NitroModules/AnyMap.hpp>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include "HybridLazyMessageSpec.hpp"
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/ProtobufCodec.nitro.ts`.
+ */
+class HybridProtobufCodecSpec : public virtual HybridObject {
+public:
+  HybridProtobufCodecSpec() : HybridObject(TAG) {}
+  ~HybridProtobufCodecSpec() override = default;
+
+public:
+  virtual void loadDescriptorSet(const std::shared_ptr<ArrayBuffer>& descriptorSet) = 0;
+  virtual bool hasMessageType(const std::string& typeName) = 0;
+  virtual std::shared_ptr<ArrayBuffer> encode(const std::string& typeName, const std::shared_ptr<AnyMap>& message) = 0;
+  virtual std::shared_ptr<AnyMap> decode(const std::string& typeName, const std::shared_ptr<ArrayBuffer>& data, double offset, double length) = 0;
+  virtual std::shared_ptr<HybridLazyMessageSpec> decodeLazy(const std::string& typeName, const std::shared_ptr<ArrayBuffer>& data, double offset, double length) = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "ProtobufCodec";
+};
+
+} // namespace margelo::nitro::grpc
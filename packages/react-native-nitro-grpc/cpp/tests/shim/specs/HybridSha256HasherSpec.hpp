@@ -0,0 +1,38 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/Sha256Hasher.nitro.ts`.
+ */
+class HybridSha256HasherSpec : public virtual HybridObject {
+public:
+  HybridSha256HasherSpec() : HybridObject(TAG) {}
+  ~HybridSha256HasherSpec() override = default;
+
+public:
+  virtual void update(const std::shared_ptr<ArrayBuffer>& data) = 0;
+  virtual void updateString(const std::string& data) = 0;
+  virtual std::string digest() = 0;
+  virtual std::shared_ptr<ArrayBuffer> digestBytes() = 0;
+  virtual void reset() = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "Sha256Hasher";
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/Sha256.nitro.ts`.
+ */
+class HybridSha256Spec : public virtual HybridObject {
+public:
+  HybridSha256Spec() : HybridObject(TAG) {}
+  ~HybridSha256Spec() override = default;
+
+public:
+  virtual std::string hash(const std::string& data) = 0;
+  virtual std::string hashBytes(const std::shared_ptr<ArrayBuffer>& data) = 0;
+  virtual std::shared_ptr<Promise<std::string>> hashFile(const std::string& path) = 0;
+  virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> hashFileBytes(const std::string& path) = 0;
+  virtual std::shared_ptr<Promise<std::vector<std::string>>> hashFiles(const std::vector<std::string>& paths) = 0;
+  virtual std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  hashFilesBytes(const std::vector<std::string>& paths) = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "Sha256";
+};
+
+} // namespace margelo::nitro::grpc
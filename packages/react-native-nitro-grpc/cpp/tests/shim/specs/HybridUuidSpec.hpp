@@ -0,0 +1,34 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/Null.hpp>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Host mirror of the nitrogen-generated spec for `src/specs/Uuid.nitro.ts`.
+ */
+class HybridUuidSpec : public virtual HybridObject {
+public:
+  HybridUuidSpec() : HybridObject(TAG) {}
+  ~HybridUuidSpec() override = default;
+
+public:
+  virtual std::string generate() = 0;
+protected:
+  void loadHybridMethods() override {}
+
+protected:
+  static constexpr auto TAG = "Uuid";
+};
+
+} // namespace margelo::nitro::grpc
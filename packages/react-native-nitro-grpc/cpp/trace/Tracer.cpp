@@ -0,0 +1,197 @@
+#include "Tracer.hpp"
+
+#include <fstream>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint64_t kIndexMask = Tracer::kEventsPerThread - 1;
+static_assert((Tracer::kEventsPerThread & kIndexMask) == 0, "kEventsPerThread must be a power of two");
+
+// The OS thread ID, as system traces show it
+uint32_t currentThreadId() {
+  thread_local const uint32_t id = [] {
+#if defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return static_cast<uint32_t>(tid);
+#elif defined(__linux__)
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+  }();
+  return id;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::_enabled{false};
+
+Tracer& Tracer::shared() {
+  // Never destroyed: exiting threads hand their buffers back during process exit
+  static auto* instance = new Tracer();
+  return *instance;
+}
+
+Tracer::Lease::~Lease() {
+  if (buffer != nullptr) {
+    Tracer::shared().release(buffer);
+  }
+}
+
+void Tracer::setEnabled(bool enabled) {
+  if (enabled) {
+    _sinceNs.store(nowNs(), std::memory_order_relaxed);
+  }
+  _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer& Tracer::bufferForThisThread() {
+  thread_local Lease lease;
+  if (lease.buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_freeBuffers.empty()) {
+      lease.buffer = _freeBuffers.back();
+      _freeBuffers.pop_back();
+    } else {
+      _buffers.push_back(std::make_unique<ThreadBuffer>());
+      lease.buffer = _buffers.back().get();
+    }
+  }
+  return *lease.buffer;
+}
+
+void Tracer::release(ThreadBuffer* buffer) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _freeBuffers.push_back(buffer);
+}
+
+void Tracer::record(const char* category,
+                    const char* name,
+                    int64_t startNs,
+                    int64_t endNs,
+                    const char* detail,
+                    const char* valueName,
+                    int64_t value) {
+  ThreadBuffer& buffer = bufferForThisThread();
+  const uint64_t index = buffer.next.load(std::memory_order_relaxed);
+  Event& event = buffer.events[index & kIndexMask];
+
+  // Seqlock write: readers discard the slot while the sequence is odd or changed
+  event.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.category.store(category, std::memory_order_relaxed);
+  event.name.store(name, std::memory_order_relaxed);
+  event.detail.store(detail, std::memory_order_relaxed);
+  event.valueName.store(valueName, std::memory_order_relaxed);
+  event.value.store(value, std::memory_order_relaxed);
+  event.startNs.store(startNs, std::memory_order_relaxed);
+  event.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+  event.threadId.store(currentThreadId(), std::memory_order_relaxed);
+  event.sequence.store(2 * (index + 1), std::memory_order_release);
+  buffer.next.store(index + 1, std::memory_order_release);
+}
+
+const char* Tracer::intern(const std::string& text) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _strings.insert(text).first->c_str();
+}
+
+std::string Tracer::dumpJson() {
+  size_t count = 0;
+  return dumpJson(count);
+}
+
+std::string Tracer::dumpJson(size_t& count) {
+  std::vector<ThreadBuffer*> buffers;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& buffer : _buffers) {
+      buffers.push_back(buffer.get());
+    }
+  }
+
+  const int64_t sinceNs = _sinceNs.load(std::memory_order_relaxed);
+  const auto pid = static_cast<int64_t>(getpid());
+  json events = json::array();
+  for (ThreadBuffer* buffer : buffers) {
+    const uint64_t next = buffer->next.load(std::memory_order_acquire);
+    const uint64_t first = next > kEventsPerThread ? next - kEventsPerThread : 0;
+    for (uint64_t index = first; index < next; index++) {
+      const Event& event = buffer->events[index & kIndexMask];
+      const uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+      if (sequence != 2 * (index + 1)) {
+        continue; // Being overwritten
+      }
+      const char* category = event.category.load(std::memory_order_relaxed);
+      const char* name = event.name.load(std::memory_order_relaxed);
+      const char* detail = event.detail.load(std::memory_order_relaxed);
+      const char* valueName = event.valueName.load(std::memory_order_relaxed);
+      const int64_t value = event.value.load(std::memory_order_relaxed);
+      const int64_t startNs = event.startNs.load(std::memory_order_relaxed);
+      const int64_t durationNs = event.durationNs.load(std::memory_order_relaxed);
+      const uint32_t threadId = event.threadId.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (event.sequence.load(std::memory_order_relaxed) != sequence || startNs < sinceNs) {
+        continue;
+      }
+
+      json args = json::object();
+      if (detail != nullptr) {
+        args["method"] = detail;
+      }
+      if (valueName != nullptr) {
+        args[valueName] = value;
+      }
+      events.push_back({
+          {"ph", "X"},
+          {"cat", category},
+          {"name", name},
+          {"ts", static_cast<double>(startNs) / 1000.0},
+          {"dur", static_cast<double>(durationNs) / 1000.0},
+          {"pid", pid},
+          {"tid", threadId},
+          {"args", std::move(args)},
+      });
+    }
+  }
+
+  count = events.size();
+  json j = {
+      {"traceEvents", std::move(events)},
+      {"displayTimeUnit", "ms"},
+  };
+  return j.dump();
+}
+
+size_t Tracer::dumpToFile(const std::string& path) {
+  size_t count = 0;
+  const std::string trace = dumpJson(count);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("Failed to open trace file: " + path);
+  }
+  file.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+  if (!file) {
+    throw std::runtime_error("Failed to write trace file: " + path);
+  }
+  return count;
+}
+
+} // namespace margelo::nitro::grpc
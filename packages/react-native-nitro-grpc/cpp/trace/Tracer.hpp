@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Process-wide recorder of native RPC activity, off by default.
+ *
+ * Spans go into a ring buffer owned by the recording thread: recording is a
+ * handful of relaxed stores, with no locks and no allocation after a
+ * thread's first span. Each buffer keeps the last kEventsPerThread spans.
+ * Buffers of exited threads are handed to new threads, so short-lived call
+ * workers do not grow memory; their spans stay until overwritten.
+ *
+ * dumpJson() writes the spans in the Chrome trace-event format, which
+ * chrome://tracing and ui.perfetto.dev open directly. Timestamps come from
+ * the monotonic clock and thread IDs are the OS IDs, so spans line up with
+ * a system trace of the same process.
+ *
+ * While disabled, a span costs one relaxed load. Thread-safe.
+ */
+class Tracer {
+public:
+  static constexpr size_t kEventsPerThread = 2048; // A power of two; about 150 KB per thread
+
+  static Tracer& shared();
+
+  static bool enabled() {
+    return _enabled.load(std::memory_order_relaxed);
+  }
+
+  static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /**
+   * Start or stop recording. Starting drops the spans recorded before.
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * Record a finished span on the calling thread.
+   *
+   * @param category, name String literals (or intern()ed strings)
+   * @param detail Shown as the "method" argument; intern()ed or null
+   * @param valueName Name of the `value` argument (a literal), or null for none
+   */
+  void record(const char* category,
+              const char* name,
+              int64_t startNs,
+              int64_t endNs,
+              const char* detail = nullptr,
+              const char* valueName = nullptr,
+              int64_t value = 0);
+
+  /**
+   * A copy of `text` that lives as long as the process, for span details.
+   * Repeated calls with the same text return the same pointer.
+   */
+  const char* intern(const std::string& text);
+
+  /**
+   * All spans recorded since tracing was last enabled, as a Chrome
+   * trace-event JSON object.
+   */
+  std::string dumpJson();
+
+  /**
+   * Write dumpJson() to `path`.
+   *
+   * @returns The number of spans written
+   * @throws std::runtime_error if the file cannot be written
+   */
+  size_t dumpToFile(const std::string& path);
+
+private:
+  struct Event {
+    // Odd while the writer fills the slot; 2 * (index + 1) once it holds span `index`
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> detail{nullptr};
+    std::atomic<const char*> valueName{nullptr};
+    std::atomic<int64_t> value{0};
+    std::atomic<int64_t> startNs{0};
+    std::atomic<int64_t> durationNs{0};
+    std::atomic<uint32_t> threadId{0};
+  };
+
+  struct ThreadBuffer {
+    std::atomic<uint64_t> next{0}; // Index of the next span; only the owning thread writes
+    Event events[kEventsPerThread];
+  };
+
+  // Hands a buffer of an exited thread back to the tracer
+  struct Lease {
+    ThreadBuffer* buffer = nullptr;
+    ~Lease();
+  };
+
+  Tracer() = default;
+
+  ThreadBuffer& bufferForThisThread();
+  void release(ThreadBuffer* buffer);
+  std::string dumpJson(size_t& count);
+
+  static std::atomic<bool> _enabled;
+
+  std::atomic<int64_t> _sinceNs{0};
+
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> _buffers; // Guarded by _mutex; never shrinks
+  std::vector<ThreadBuffer*> _freeBuffers;             // Guarded by _mutex
+  std::unordered_set<std::string> _strings;            // Guarded by _mutex
+};
+
+/**
+ * @brief Records the lifetime of a scope as a span, if tracing is enabled
+ * when the scope starts.
+ */
+class TraceSpan {
+public:
+  TraceSpan(const char* category, const char* name, const char* valueName = nullptr, int64_t value = 0)
+      : _category(category), _name(name), _valueName(valueName), _value(value),
+        _startNs(Tracer::enabled() ? Tracer::nowNs() : 0) {}
+
+  ~TraceSpan() {
+    if (_startNs != 0) {
+      Tracer::shared().record(_category, _name, _startNs, Tracer::nowNs(), nullptr, _valueName, _value);
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  // Set the value once it is known, e.g. the output size
+  void setValue(int64_t value) {
+    _value = value;
+  }
+
+private:
+  const char* _category;
+  const char* _name;
+  const char* _valueName;
+  int64_t _value;
+  int64_t _startNs;
+};
+
+} // namespace margelo::nitro::grpc
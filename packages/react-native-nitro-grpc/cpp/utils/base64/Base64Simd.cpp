@@ -0,0 +1,451 @@
+#include "Base64Simd.hpp"
+
+#include <array>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RNGRPC_BASE64_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define RNGRPC_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace margelo::nitro::grpc {
+namespace Base64Simd {
+
+namespace {
+
+constexpr char kStdAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kUrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr uint8_t kInvalid = 0xFF;
+
+constexpr std::array<uint8_t, 256> makeDecodeTable(const char* alphabet) {
+  std::array<uint8_t, 256> table{};
+  for (auto& entry : table) {
+    entry = kInvalid;
+  }
+  for (uint8_t i = 0; i < 64; i++) {
+    table[static_cast<uint8_t>(alphabet[i])] = i;
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, 256> kStdDecodeTable = makeDecodeTable(kStdAlphabet);
+constexpr std::array<uint8_t, 256> kUrlDecodeTable = makeDecodeTable(kUrlAlphabet);
+
+[[noreturn]] void throwInvalid() {
+  throw std::runtime_error("Input is not valid base64-encoded data.");
+}
+
+// Bulk kernels consume whole blocks only and return how much input they used
+// (a multiple of 3 bytes for encode, 4 chars for decode). Decoders stop early
+// on the first invalid block and leave error reporting to the scalar tail.
+using EncodeKernel = size_t (*)(const uint8_t* src, size_t length, char* dst, bool url);
+using DecodeKernel = size_t (*)(const char* src, size_t length, uint8_t* dst, bool url);
+
+struct Kernels {
+  EncodeKernel encode;
+  DecodeKernel decode;
+  const char* name;
+};
+
+size_t encodeBlocksScalar(const uint8_t*, size_t, char*, bool) {
+  return 0;
+}
+
+size_t decodeBlocksScalar(const char*, size_t, uint8_t*, bool) {
+  return 0;
+}
+
+size_t encodeTail(const uint8_t* src, size_t length, char* dst, bool url) {
+  const char* alphabet = url ? kUrlAlphabet : kStdAlphabet;
+  char* out = dst;
+  size_t i = 0;
+
+  for (; i + 3 <= length; i += 3) {
+    const uint32_t v = (uint32_t(src[i]) << 16) | (uint32_t(src[i + 1]) << 8) | src[i + 2];
+    *out++ = alphabet[(v >> 18) & 0x3F];
+    *out++ = alphabet[(v >> 12) & 0x3F];
+    *out++ = alphabet[(v >> 6) & 0x3F];
+    *out++ = alphabet[v & 0x3F];
+  }
+
+  const size_t remaining = length - i;
+  if (remaining == 1) {
+    const uint32_t v = uint32_t(src[i]) << 16;
+    *out++ = alphabet[(v >> 18) & 0x3F];
+    *out++ = alphabet[(v >> 12) & 0x3F];
+    if (!url) {
+      *out++ = '=';
+      *out++ = '=';
+    }
+  } else if (remaining == 2) {
+    const uint32_t v = (uint32_t(src[i]) << 16) | (uint32_t(src[i + 1]) << 8);
+    *out++ = alphabet[(v >> 18) & 0x3F];
+    *out++ = alphabet[(v >> 12) & 0x3F];
+    *out++ = alphabet[(v >> 6) & 0x3F];
+    if (!url) {
+      *out++ = '=';
+    }
+  }
+
+  return static_cast<size_t>(out - dst);
+}
+
+// `length` excludes padding and has already been validated (length % 4 != 1).
+size_t decodeTail(const char* src, size_t length, uint8_t* dst, bool url) {
+  const auto& table = url ? kUrlDecodeTable : kStdDecodeTable;
+  const auto* in = reinterpret_cast<const uint8_t*>(src);
+  uint8_t* out = dst;
+  size_t i = 0;
+
+  for (; i + 4 <= length; i += 4) {
+    const uint8_t a = table[in[i]];
+    const uint8_t b = table[in[i + 1]];
+    const uint8_t c = table[in[i + 2]];
+    const uint8_t d = table[in[i + 3]];
+    if ((a | b | c | d) & 0x80) {
+      throwInvalid();
+    }
+    const uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+    *out++ = static_cast<uint8_t>(v >> 16);
+    *out++ = static_cast<uint8_t>(v >> 8);
+    *out++ = static_cast<uint8_t>(v);
+  }
+
+  const size_t remaining = length - i;
+  if (remaining >= 2) {
+    const uint8_t a = table[in[i]];
+    const uint8_t b = table[in[i + 1]];
+    const uint8_t c = remaining == 3 ? table[in[i + 2]] : 0;
+    if ((a | b | c) & 0x80) {
+      throwInvalid();
+    }
+    *out++ = static_cast<uint8_t>((a << 2) | (b >> 4));
+    if (remaining == 3) {
+      *out++ = static_cast<uint8_t>((b << 4) | (c >> 2));
+    }
+  }
+
+  return static_cast<size_t>(out - dst);
+}
+
+#if defined(RNGRPC_BASE64_X86)
+
+// Muła/Lemire Base64 kernels. Encode splits 12 bytes into 16 six-bit indices
+// with two multiplies, then maps indices to ASCII through a 16-entry offset
+// table. Decode validates via nibble lookup tables and repacks with madd.
+
+__attribute__((target("ssse3"))) inline __m128i encodeShiftLut128(bool url) {
+  return url ? _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                             '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0)
+             : _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                             '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+}
+
+// Maps the URL-safe alphabet onto the standard one and poisons '+' and '/'
+// (setting the high bit) so the standard validation rejects them.
+__attribute__((target("ssse3"))) inline __m128i translateUrl128(__m128i in) {
+  const __m128i isMinus = _mm_cmpeq_epi8(in, _mm_set1_epi8('-'));
+  const __m128i isUnderscore = _mm_cmpeq_epi8(in, _mm_set1_epi8('_'));
+  const __m128i isStdOnly =
+      _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('+')), _mm_cmpeq_epi8(in, _mm_set1_epi8('/')));
+  __m128i out = _mm_andnot_si128(_mm_or_si128(isMinus, isUnderscore), in);
+  out = _mm_or_si128(out, _mm_and_si128(isMinus, _mm_set1_epi8('+')));
+  out = _mm_or_si128(out, _mm_and_si128(isUnderscore, _mm_set1_epi8('/')));
+  return _mm_or_si128(out, _mm_and_si128(isStdOnly, _mm_set1_epi8(static_cast<char>(0x80))));
+}
+
+__attribute__((target("ssse3"))) size_t encodeBlocksSsse3(const uint8_t* src, size_t length, char* dst, bool url) {
+  const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m128i shiftLut = encodeShiftLut128(url);
+  size_t i = 0;
+  char* out = dst;
+
+  // Each iteration loads 16 bytes but only consumes 12.
+  for (; length - i >= 16; i += 12, out += 16) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    in = _mm_shuffle_epi8(in, shuffle);
+
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(shiftLut, reduced), indices);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+  }
+
+  return i;
+}
+
+__attribute__((target("ssse3"))) size_t decodeBlocksSsse3(const char* src, size_t length, uint8_t* dst, bool url) {
+  const __m128i lutLo = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lutHi = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask2F = _mm_set1_epi8(0x2F);
+  const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  size_t i = 0;
+  uint8_t* out = dst;
+
+  // Each iteration stores 16 bytes but only produces 12; keep enough input
+  // in reserve that the overhang stays inside the destination.
+  for (; length - i >= 24; i += 16, out += 12) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (url) {
+      in = translateUrl128(in);
+    }
+
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+    const __m128i loNibbles = _mm_and_si128(in, mask2F);
+    const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+      break;
+    }
+
+    const __m128i eq2F = _mm_cmpeq_epi8(in, mask2F);
+    const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+    const __m128i values = _mm_add_epi8(in, roll);
+
+    const __m128i mergedPairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i merged = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(merged, pack));
+  }
+
+  return i;
+}
+
+__attribute__((target("avx2"))) inline __m256i translateUrl256(__m256i in) {
+  const __m256i isMinus = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('-'));
+  const __m256i isUnderscore = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('_'));
+  const __m256i isStdOnly =
+      _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')));
+  __m256i out = _mm256_andnot_si256(_mm256_or_si256(isMinus, isUnderscore), in);
+  out = _mm256_or_si256(out, _mm256_and_si256(isMinus, _mm256_set1_epi8('+')));
+  out = _mm256_or_si256(out, _mm256_and_si256(isUnderscore, _mm256_set1_epi8('/')));
+  return _mm256_or_si256(out, _mm256_and_si256(isStdOnly, _mm256_set1_epi8(static_cast<char>(0x80))));
+}
+
+__attribute__((target("avx2"))) size_t encodeBlocksAvx2(const uint8_t* src, size_t length, char* dst, bool url) {
+  const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4,
+                                           7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i shiftLut = _mm256_broadcastsi128_si256(encodeShiftLut128(url));
+  size_t i = 0;
+  char* out = dst;
+
+  // Two 16-byte loads at +0 and +12 feed one 24-byte block per iteration.
+  for (; length - i >= 28; i += 24, out += 32) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    in = _mm256_shuffle_epi8(in, shuffle);
+
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLut, reduced), indices);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+  }
+
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t decodeBlocksAvx2(const char* src, size_t length, uint8_t* dst, bool url) {
+  const __m256i lutLo = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+  const __m256i lutHi = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+  const __m256i lutRoll =
+      _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i mask2F = _mm256_set1_epi8(0x2F);
+  const __m256i pack = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+  size_t i = 0;
+  uint8_t* out = dst;
+
+  // Each iteration stores 32 bytes but only produces 24.
+  for (; length - i >= 45; i += 32, out += 24) {
+    __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    if (url) {
+      in = translateUrl256(in);
+    }
+
+    const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask2F);
+    const __m256i loNibbles = _mm256_and_si256(in, mask2F);
+    const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+    const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != 0) {
+      break;
+    }
+
+    const __m256i eq2F = _mm256_cmpeq_epi8(in, mask2F);
+    const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+    const __m256i values = _mm256_add_epi8(in, roll);
+
+    const __m256i mergedPairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i merged = _mm256_madd_epi16(mergedPairs, _mm256_set1_epi32(0x00011000));
+    merged = _mm256_shuffle_epi8(merged, pack);
+    merged = _mm256_permutevar8x32_epi32(merged, compact);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), merged);
+  }
+
+  return i;
+}
+
+Kernels selectKernels() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {encodeBlocksAvx2, decodeBlocksAvx2, "avx2"};
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return {encodeBlocksSsse3, decodeBlocksSsse3, "ssse3"};
+  }
+  return {encodeBlocksScalar, decodeBlocksScalar, "scalar"};
+}
+
+#elif defined(RNGRPC_BASE64_NEON)
+
+inline uint8x16x4_t loadTable64(const uint8_t* table) {
+  return {{vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48)}};
+}
+
+size_t encodeBlocksNeon(const uint8_t* src, size_t length, char* dst, bool url) {
+  const uint8x16x4_t lut = loadTable64(reinterpret_cast<const uint8_t*>(url ? kUrlAlphabet : kStdAlphabet));
+  const uint8x16_t mask3F = vdupq_n_u8(0x3F);
+  size_t i = 0;
+  char* out = dst;
+
+  // vld3/vst4 de-interleave 48 bytes into byte lanes and re-interleave the
+  // 64 resulting characters, so no shuffles are needed.
+  for (; length - i >= 48; i += 48, out += 64) {
+    const uint8x16x3_t in = vld3q_u8(src + i);
+    uint8x16x4_t chars;
+    chars.val[0] = vqtbl4q_u8(lut, vshrq_n_u8(in.val[0], 2));
+    chars.val[1] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask3F));
+    chars.val[2] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask3F));
+    chars.val[3] = vqtbl4q_u8(lut, vandq_u8(in.val[2], mask3F));
+    vst4q_u8(reinterpret_cast<uint8_t*>(out), chars);
+  }
+
+  return i;
+}
+
+size_t decodeBlocksNeon(const char* src, size_t length, uint8_t* dst, bool url) {
+  const auto& table = url ? kUrlDecodeTable : kStdDecodeTable;
+  const uint8x16x4_t lutLo = loadTable64(table.data());
+  const uint8x16x4_t lutHi = loadTable64(table.data() + 64);
+  const uint8x16_t offset = vdupq_n_u8(64);
+  size_t i = 0;
+  uint8_t* out = dst;
+
+  for (; length - i >= 64; i += 64, out += 48) {
+    const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16_t values[4];
+    uint8x16_t error = vdupq_n_u8(0);
+    for (int lane = 0; lane < 4; lane++) {
+      // Two 64-entry lookups cover ASCII; out-of-range indices yield 0, so
+      // non-ASCII input is caught by OR-ing in the raw character.
+      const uint8x16_t c = in.val[lane];
+      values[lane] = vorrq_u8(vqtbl4q_u8(lutLo, c), vqtbl4q_u8(lutHi, vsubq_u8(c, offset)));
+      error = vorrq_u8(error, vorrq_u8(values[lane], c));
+    }
+    if (vmaxvq_u8(error) & 0x80) {
+      break;
+    }
+
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+    vst3q_u8(out, bytes);
+  }
+
+  return i;
+}
+
+Kernels selectKernels() {
+  return {encodeBlocksNeon, decodeBlocksNeon, "neon"};
+}
+
+#else
+
+Kernels selectKernels() {
+  return {encodeBlocksScalar, decodeBlocksScalar, "scalar"};
+}
+
+#endif
+
+const Kernels& kernels() {
+  static const Kernels selected = selectKernels();
+  return selected;
+}
+
+size_t paddingLength(const char* src, size_t length) {
+  size_t padding = 0;
+  while (padding < 2 && padding < length && src[length - 1 - padding] == '=') {
+    padding++;
+  }
+  return padding;
+}
+
+} // namespace
+
+size_t encodedLength(size_t length, bool url) {
+  if (url) {
+    return length / 3 * 4 + (length % 3 == 0 ? 0 : length % 3 + 1);
+  }
+  return (length + 2) / 3 * 4;
+}
+
+size_t decodedLength(const char* src, size_t length) {
+  const size_t padding = paddingLength(src, length);
+  if (padding > 0 && length % 4 != 0) {
+    throwInvalid();
+  }
+
+  const size_t chars = length - padding;
+  if (chars % 4 == 1) {
+    throwInvalid();
+  }
+  return chars / 4 * 3 + (chars % 4 == 0 ? 0 : chars % 4 - 1);
+}
+
+size_t encode(const uint8_t* src, size_t length, char* dst, bool url) {
+  const size_t consumed = kernels().encode(src, length, dst, url);
+  const size_t written = consumed / 3 * 4;
+  return written + encodeTail(src + consumed, length - consumed, dst + written, url);
+}
+
+size_t decode(const char* src, size_t length, uint8_t* dst, bool url) {
+  // Validates padding and the residual length before any kernel runs.
+  decodedLength(src, length);
+  const size_t chars = length - paddingLength(src, length);
+
+  const size_t consumed = kernels().decode(src, chars, dst, url);
+  const size_t written = consumed / 4 * 3;
+  return written + decodeTail(src + consumed, chars - consumed, dst + written, url);
+}
+
+const char* implementationName() {
+  return kernels().name;
+}
+
+} // namespace Base64Simd
+} // namespace margelo::nitro::grpc
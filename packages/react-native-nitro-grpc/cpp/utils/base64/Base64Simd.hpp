@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Vectorized Base64 codec working on caller-provided buffers.
+ *
+ * Picks the widest implementation available at runtime:
+ * - x86/x86_64: AVX2, then SSSE3 (checked via CPUID on first use)
+ * - AArch64: NEON (always available)
+ * - Everything else: table-driven scalar code
+ *
+ * All paths produce byte-identical output. Encoding never allocates; the
+ * caller sizes the destination with encodedLength()/decodedLength().
+ */
+namespace Base64Simd {
+
+/**
+ * Number of characters produced by encode().
+ *
+ * @param length Number of input bytes
+ * @param url Whether the URL-safe alphabet (unpadded) is used
+ */
+size_t encodedLength(size_t length, bool url);
+
+/**
+ * Exact number of bytes produced by decode(), accounting for padding.
+ *
+ * @param src Base64 characters
+ * @param length Number of characters
+ * @throws std::runtime_error if the length cannot be valid Base64
+ */
+size_t decodedLength(const char* src, size_t length);
+
+/**
+ * Encode `length` bytes from `src` into `dst`.
+ *
+ * @param dst Destination with room for encodedLength(length, url) chars
+ * @param url Use the URL-safe alphabet ("-_") and omit padding
+ * @return Number of characters written
+ */
+size_t encode(const uint8_t* src, size_t length, char* dst, bool url);
+
+/**
+ * Decode `length` Base64 characters from `src` into `dst`.
+ *
+ * Padding is optional for both alphabets. Line breaks and characters outside
+ * the selected alphabet are rejected.
+ *
+ * @param dst Destination with room for decodedLength(src, length) bytes
+ * @param url Decode the URL-safe alphabet ("-_") instead of "+/"
+ * @return Number of bytes written
+ * @throws std::runtime_error if the input is not valid Base64
+ */
+size_t decode(const char* src, size_t length, uint8_t* dst, bool url);
+
+/**
+ * Name of the implementation selected for this CPU ("avx2", "ssse3", "neon"
+ * or "scalar"). Useful for benchmarks and diagnostics.
+ */
+const char* implementationName();
+
+} // namespace Base64Simd
+
+} // namespace margelo::nitro::grpc
@@ -1,20 +1,57 @@
 #include "HybridBase64.hpp"
 
-#include "../../utils/base64/Base64.hpp"
+#include "../../trace/Tracer.hpp"
+#include "Base64Simd.hpp"
 
-#include <vector>
+#include <stdexcept>
 
 namespace margelo::nitro::grpc {
 
 std::string HybridBase64::encode(const std::shared_ptr<ArrayBuffer>& data, bool urlSafe) {
-  if (!data)
+  if (!data || data->size() == 0)
     return "";
-  return base64_encode<std::string>(data->data(), data->size(), urlSafe);
+
+  TraceSpan span("base64", "encode", "bytes", static_cast<int64_t>(data->size()));
+  std::string encoded(Base64Simd::encodedLength(data->size(), urlSafe), '\0');
+  Base64Simd::encode(data->data(), data->size(), encoded.data(), urlSafe);
+  return encoded;
+}
+
+std::shared_ptr<ArrayBuffer> HybridBase64::decode(const std::string& base64, bool urlSafe) {
+  TraceSpan span("base64", "decode", "chars", static_cast<int64_t>(base64.size()));
+  // Decode straight into the JS-visible buffer; no intermediate vector.
+  auto buffer = ArrayBuffer::allocate(Base64Simd::decodedLength(base64.data(), base64.size()));
+  Base64Simd::decode(base64.data(), base64.size(), buffer->data(), urlSafe);
+  return buffer;
+}
+
+double HybridBase64::decodeInto(const std::string& base64,
+                                const std::shared_ptr<ArrayBuffer>& target,
+                                double offset,
+                                double length,
+                                bool urlSafe) {
+  if (!target) {
+    throw std::runtime_error("decodeInto: target buffer is null");
+  }
+
+  const size_t start = static_cast<size_t>(offset);
+  const size_t capacity = static_cast<size_t>(length);
+  if (offset < 0 || length < 0 || start > target->size() || capacity > target->size() - start) {
+    throw std::runtime_error("decodeInto: range is outside of the target buffer");
+  }
+
+  const size_t required = Base64Simd::decodedLength(base64.data(), base64.size());
+  if (required > capacity) {
+    throw std::runtime_error("decodeInto: target too small (need " + std::to_string(required) + " bytes, have " +
+                             std::to_string(capacity) + ")");
+  }
+
+  TraceSpan span("base64", "decodeInto", "chars", static_cast<int64_t>(base64.size()));
+  return static_cast<double>(Base64Simd::decode(base64.data(), base64.size(), target->data() + start, urlSafe));
 }
 
-std::shared_ptr<ArrayBuffer> HybridBase64::decode(const std::string& base64) {
-  std::vector<char> decoded = base64_decode<std::vector<char>>(base64, false);
-  return ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(decoded.data()), decoded.size());
+double HybridBase64::decodedLength(const std::string& base64) {
+  return static_cast<double>(Base64Simd::decodedLength(base64.data(), base64.size()));
 }
 
 } // namespace margelo::nitro::grpc
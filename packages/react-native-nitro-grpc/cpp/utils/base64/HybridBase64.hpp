@@ -4,7 +4,6 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
 namespace margelo::nitro::grpc {
 
@@ -13,7 +12,13 @@ public:
   HybridBase64() : HybridObject(TAG) {}
 
   std::string encode(const std::shared_ptr<ArrayBuffer>& data, bool urlSafe) override;
-  std::shared_ptr<ArrayBuffer> decode(const std::string& base64) override;
+  std::shared_ptr<ArrayBuffer> decode(const std::string& base64, bool urlSafe) override;
+  double decodeInto(const std::string& base64,
+                    const std::shared_ptr<ArrayBuffer>& target,
+                    double offset,
+                    double length,
+                    bool urlSafe) override;
+  double decodedLength(const std::string& base64) override;
 };
 
 } // namespace margelo::nitro::grpc
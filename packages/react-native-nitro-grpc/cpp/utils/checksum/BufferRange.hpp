@@ -0,0 +1,44 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Validated window into a JS ArrayBuffer.
+ *
+ * Lets typed-array views (`byteOffset`/`byteLength`) be processed in place
+ * without slicing them into a fresh buffer on the JS side.
+ */
+struct BufferRange {
+  const uint8_t* data;
+  size_t size;
+
+  /**
+   * @throws std::runtime_error if the range does not fit inside `buffer`
+   */
+  static BufferRange of(const std::shared_ptr<ArrayBuffer>& buffer, double offset, double length,
+                        const char* method) {
+    if (!buffer) {
+      if (offset == 0 && length == 0) {
+        return {nullptr, 0};
+      }
+      throw std::runtime_error(std::string(method) + ": buffer is null");
+    }
+
+    const size_t start = static_cast<size_t>(offset);
+    const size_t size = static_cast<size_t>(length);
+    if (offset < 0 || length < 0 || start > buffer->size() || size > buffer->size() - start) {
+      throw std::runtime_error(std::string(method) + ": range is outside of the buffer");
+    }
+    return {buffer->data() + start, size};
+  }
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,257 @@
+#include "Crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#define RNGRPC_CRC32C_X86 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+// Android builds this file with -march=armv8-a+crc; the kernel is only
+// entered after the HWCAP check below.
+#define RNGRPC_CRC32C_ARM 1
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+// Reflected Castagnoli polynomial.
+constexpr uint32_t kPolynomial = 0x82f63b78;
+
+// Operates on the raw CRC register (no pre/post inversion).
+using ExtendFn = uint32_t (*)(uint32_t crc, const uint8_t* data, size_t length);
+
+constexpr std::array<std::array<uint32_t, 256>, 8> makeTables() {
+  std::array<std::array<uint32_t, 256>, 8> tables{};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? (crc >> 1) ^ kPolynomial : crc >> 1;
+    }
+    tables[0][i] = crc;
+  }
+  for (uint32_t i = 0; i < 256; i++) {
+    for (size_t t = 1; t < 8; t++) {
+      tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xff];
+    }
+  }
+  return tables;
+}
+
+constexpr auto kTables = makeTables();
+
+inline uint32_t loadLittleEndian32(const uint8_t* p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+uint32_t extendScalar(uint32_t crc, const uint8_t* data, size_t length) {
+  // Slicing-by-8: eight table lookups per 8 input bytes.
+  while (length >= 8) {
+    const uint32_t lo = loadLittleEndian32(data) ^ crc;
+    const uint32_t hi = loadLittleEndian32(data + 4);
+    crc = kTables[7][lo & 0xff] ^ kTables[6][(lo >> 8) & 0xff] ^ kTables[5][(lo >> 16) & 0xff] ^
+          kTables[4][lo >> 24] ^ kTables[3][hi & 0xff] ^ kTables[2][(hi >> 8) & 0xff] ^
+          kTables[1][(hi >> 16) & 0xff] ^ kTables[0][hi >> 24];
+    data += 8;
+    length -= 8;
+  }
+  for (; length > 0; length--, data++) {
+    crc = kTables[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(RNGRPC_CRC32C_X86) || defined(RNGRPC_CRC32C_ARM)
+
+// The crc32 instructions have a latency of ~3 cycles but a throughput of one
+// per cycle, so large inputs are split into three lanes that are processed
+// side by side and merged afterwards.
+constexpr size_t kLaneSize = 4096;
+
+/**
+ * Product of two polynomials modulo the CRC polynomial (bit-reflected).
+ */
+uint32_t multiplyModP(uint32_t a, uint32_t b) {
+  uint32_t product = 0;
+  for (uint32_t mask = 1u << 31; mask != 0; mask >>= 1) {
+    if (a & mask) {
+      product ^= b;
+    }
+    b = (b & 1) ? (b >> 1) ^ kPolynomial : b >> 1;
+  }
+  return product;
+}
+
+/**
+ * x^(8 * bytes) modulo the CRC polynomial. Multiplying a raw CRC register by
+ * this value is equivalent to feeding it `bytes` zero bytes.
+ */
+uint32_t zeroBytesOperator(size_t bytes) {
+  uint32_t result = 1u << 31; // x^0
+  uint32_t square = 1u << 30; // x^1
+  for (size_t bits = bytes * 8; bits != 0; bits >>= 1) {
+    if (bits & 1) {
+      result = multiplyModP(result, square);
+    }
+    square = multiplyModP(square, square);
+  }
+  return result;
+}
+
+struct LaneShifts {
+  uint32_t oneLane = zeroBytesOperator(kLaneSize);
+  uint32_t twoLanes = zeroBytesOperator(2 * kLaneSize);
+};
+
+const LaneShifts& laneShifts() {
+  static const LaneShifts shifts;
+  return shifts;
+}
+
+#endif
+
+#if defined(RNGRPC_CRC32C_X86)
+
+__attribute__((target("sse4.2"))) uint32_t extendSse42(uint32_t crc, const uint8_t* data, size_t length) {
+  uint64_t crc0 = crc;
+
+  if (length >= 3 * kLaneSize) {
+    const LaneShifts& shifts = laneShifts();
+    do {
+      uint64_t crc1 = 0;
+      uint64_t crc2 = 0;
+      for (size_t i = 0; i < kLaneSize; i += 8) {
+        uint64_t v0, v1, v2;
+        std::memcpy(&v0, data + i, 8);
+        std::memcpy(&v1, data + kLaneSize + i, 8);
+        std::memcpy(&v2, data + 2 * kLaneSize + i, 8);
+        crc0 = _mm_crc32_u64(crc0, v0);
+        crc1 = _mm_crc32_u64(crc1, v1);
+        crc2 = _mm_crc32_u64(crc2, v2);
+      }
+      crc0 = multiplyModP(static_cast<uint32_t>(crc0), shifts.twoLanes) ^
+             multiplyModP(static_cast<uint32_t>(crc1), shifts.oneLane) ^ static_cast<uint32_t>(crc2);
+      data += 3 * kLaneSize;
+      length -= 3 * kLaneSize;
+    } while (length >= 3 * kLaneSize);
+  }
+
+  for (; length >= 8; data += 8, length -= 8) {
+    uint64_t v;
+    std::memcpy(&v, data, 8);
+    crc0 = _mm_crc32_u64(crc0, v);
+  }
+  uint32_t crc32 = static_cast<uint32_t>(crc0);
+  for (; length > 0; length--, data++) {
+    crc32 = _mm_crc32_u8(crc32, *data);
+  }
+  return crc32;
+}
+
+ExtendFn selectExtend(const char** name) {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")) {
+    *name = "sse4.2";
+    return extendSse42;
+  }
+  *name = "scalar";
+  return extendScalar;
+}
+
+#elif defined(RNGRPC_CRC32C_ARM)
+
+uint32_t extendArmv8(uint32_t crc, const uint8_t* data, size_t length) {
+  if (length >= 3 * kLaneSize) {
+    const LaneShifts& shifts = laneShifts();
+    do {
+      uint32_t crc1 = 0;
+      uint32_t crc2 = 0;
+      for (size_t i = 0; i < kLaneSize; i += 8) {
+        uint64_t v0, v1, v2;
+        std::memcpy(&v0, data + i, 8);
+        std::memcpy(&v1, data + kLaneSize + i, 8);
+        std::memcpy(&v2, data + 2 * kLaneSize + i, 8);
+        crc = __crc32cd(crc, v0);
+        crc1 = __crc32cd(crc1, v1);
+        crc2 = __crc32cd(crc2, v2);
+      }
+      crc = multiplyModP(crc, shifts.twoLanes) ^ multiplyModP(crc1, shifts.oneLane) ^ crc2;
+      data += 3 * kLaneSize;
+      length -= 3 * kLaneSize;
+    } while (length >= 3 * kLaneSize);
+  }
+
+  for (; length >= 8; data += 8, length -= 8) {
+    uint64_t v;
+    std::memcpy(&v, data, 8);
+    crc = __crc32cd(crc, v);
+  }
+  for (; length > 0; length--, data++) {
+    crc = __crc32cb(crc, *data);
+  }
+  return crc;
+}
+
+bool cpuHasArmv8Crc() {
+#if defined(__APPLE__)
+  return true;
+#elif defined(__linux__) && defined(HWCAP_CRC32)
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+  return false;
+#endif
+}
+
+ExtendFn selectExtend(const char** name) {
+  if (cpuHasArmv8Crc()) {
+    *name = "armv8-crc";
+    return extendArmv8;
+  }
+  *name = "scalar";
+  return extendScalar;
+}
+
+#else
+
+ExtendFn selectExtend(const char** name) {
+  *name = "scalar";
+  return extendScalar;
+}
+
+#endif
+
+struct Implementation {
+  ExtendFn extend;
+  const char* name;
+};
+
+const Implementation& implementation() {
+  static const Implementation selected = []() {
+    Implementation impl{};
+    impl.extend = selectExtend(&impl.name);
+    return impl;
+  }();
+  return selected;
+}
+
+} // namespace
+
+namespace Crc32c {
+
+uint32_t extend(uint32_t crc, const uint8_t* data, size_t length) {
+  return ~implementation().extend(~crc, data, length);
+}
+
+const char* implementationName() {
+  return implementation().name;
+}
+
+} // namespace Crc32c
+
+} // namespace margelo::nitro::grpc
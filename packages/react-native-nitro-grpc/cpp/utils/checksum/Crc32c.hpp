@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief CRC32C (Castagnoli) with hardware acceleration.
+ *
+ * Picks the fastest implementation available at runtime:
+ * - x86/x86_64: SSE4.2 `crc32` instruction (checked via CPUID on first use)
+ * - AArch64: ARMv8 CRC32 extension when HWCAP reports it (always on Apple)
+ * - Everything else: slicing-by-8 tables
+ *
+ * Values are the standard finalized CRC (as used by iSCSI, ext4, gRPC's
+ * xDS and Google Cloud Storage), so results can be compared directly with
+ * other implementations.
+ */
+namespace Crc32c {
+
+/**
+ * Continue a CRC over more data.
+ *
+ * @param crc CRC of the preceding data (0 for the start of a message)
+ * @return CRC of the preceding data followed by `data`
+ */
+uint32_t extend(uint32_t crc, const uint8_t* data, size_t length);
+
+/**
+ * CRC of a single contiguous buffer.
+ */
+inline uint32_t value(const uint8_t* data, size_t length) {
+  return extend(0, data, length);
+}
+
+/**
+ * Name of the implementation selected for this CPU ("sse4.2", "armv8-crc"
+ * or "scalar").
+ */
+const char* implementationName();
+
+} // namespace Crc32c
+
+} // namespace margelo::nitro::grpc
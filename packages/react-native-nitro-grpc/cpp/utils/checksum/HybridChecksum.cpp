@@ -0,0 +1,49 @@
+#include "HybridChecksum.hpp"
+
+#include "BufferRange.hpp"
+#include "Crc32c.hpp"
+#include "HybridChecksumHasher.hpp"
+#include "Xxh3.hpp"
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+const uint8_t* bytes(const std::string& data) {
+  return reinterpret_cast<const uint8_t*>(data.data());
+}
+
+} // namespace
+
+double HybridChecksum::crc32c(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) {
+  const auto range = BufferRange::of(data, offset, length, "crc32c");
+  return static_cast<double>(Crc32c::value(range.data, range.size));
+}
+
+double HybridChecksum::crc32cString(const std::string& data) {
+  return static_cast<double>(Crc32c::value(bytes(data), data.size()));
+}
+
+std::string HybridChecksum::xxh3(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) {
+  const auto range = BufferRange::of(data, offset, length, "xxh3");
+  return Xxh3::toHex(Xxh3::hash64(range.data, range.size));
+}
+
+std::string HybridChecksum::xxh3String(const std::string& data) {
+  return Xxh3::toHex(Xxh3::hash64(bytes(data), data.size()));
+}
+
+std::string HybridChecksum::xxh128(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) {
+  const auto range = BufferRange::of(data, offset, length, "xxh128");
+  return Xxh3::toHex(Xxh3::hash128(range.data, range.size));
+}
+
+std::string HybridChecksum::xxh128String(const std::string& data) {
+  return Xxh3::toHex(Xxh3::hash128(bytes(data), data.size()));
+}
+
+std::shared_ptr<HybridChecksumHasherSpec> HybridChecksum::createHasher(const std::string& algorithm) {
+  return std::make_shared<HybridChecksumHasher>(HybridChecksumHasher::parseAlgorithm(algorithm));
+}
+
+} // namespace margelo::nitro::grpc
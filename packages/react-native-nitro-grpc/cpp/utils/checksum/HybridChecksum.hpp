@@ -0,0 +1,28 @@
+#pragma once
+
+#include "HybridChecksumSpec.hpp"
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief One-shot CRC32C / XXH3 checksums and a factory for streaming hashers.
+ *
+ * ArrayBuffer inputs are hashed in place over the requested range.
+ */
+class HybridChecksum : public HybridChecksumSpec {
+public:
+  HybridChecksum() : HybridObject(TAG) {}
+
+  double crc32c(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) override;
+  double crc32cString(const std::string& data) override;
+  std::string xxh3(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) override;
+  std::string xxh3String(const std::string& data) override;
+  std::string xxh128(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) override;
+  std::string xxh128String(const std::string& data) override;
+  std::shared_ptr<HybridChecksumHasherSpec> createHasher(const std::string& algorithm) override;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,84 @@
+#include "HybridChecksumHasher.hpp"
+
+#include "BufferRange.hpp"
+
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+HybridChecksumHasher::Algorithm HybridChecksumHasher::parseAlgorithm(const std::string& name) {
+  if (name == "crc32c")
+    return Algorithm::Crc32c;
+  if (name == "xxh3")
+    return Algorithm::Xxh3;
+  if (name == "xxh128")
+    return Algorithm::Xxh128;
+  throw std::runtime_error("Unknown checksum algorithm: " + name);
+}
+
+std::string HybridChecksumHasher::getAlgorithm() {
+  switch (_algorithm) {
+    case Algorithm::Crc32c:
+      return "crc32c";
+    case Algorithm::Xxh3:
+      return "xxh3";
+    case Algorithm::Xxh128:
+      return "xxh128";
+  }
+  return "";
+}
+
+void HybridChecksumHasher::absorb(const uint8_t* data, size_t length) {
+  if (_algorithm == Algorithm::Crc32c) {
+    _crc = Crc32c::extend(_crc, data, length);
+  } else {
+    _xxh3.update(data, length);
+  }
+}
+
+void HybridChecksumHasher::update(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) {
+  const auto range = BufferRange::of(data, offset, length, "update");
+  absorb(range.data, range.size);
+}
+
+void HybridChecksumHasher::updateString(const std::string& data) {
+  absorb(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+std::vector<uint8_t> HybridChecksumHasher::finish() {
+  std::vector<uint8_t> digest;
+  switch (_algorithm) {
+    case Algorithm::Crc32c:
+      digest = {static_cast<uint8_t>(_crc >> 24), static_cast<uint8_t>(_crc >> 16), static_cast<uint8_t>(_crc >> 8),
+                static_cast<uint8_t>(_crc)};
+      break;
+    case Algorithm::Xxh3: {
+      const auto value = _xxh3.digest64();
+      digest.assign(value.begin(), value.end());
+      break;
+    }
+    case Algorithm::Xxh128: {
+      const auto value = _xxh3.digest128();
+      digest.assign(value.begin(), value.end());
+      break;
+    }
+  }
+  reset();
+  return digest;
+}
+
+std::string HybridChecksumHasher::digest() {
+  const auto digest = finish();
+  return Xxh3::toHex(digest.data(), digest.size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridChecksumHasher::digestBytes() {
+  return ArrayBuffer::copy(finish());
+}
+
+void HybridChecksumHasher::reset() {
+  _crc = 0;
+  _xxh3.reset();
+}
+
+} // namespace margelo::nitro::grpc
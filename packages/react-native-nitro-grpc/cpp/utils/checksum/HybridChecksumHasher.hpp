@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Crc32c.hpp"
+#include "HybridChecksumHasherSpec.hpp"
+#include "Xxh3.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Streaming CRC32C / XXH3 hasher created by HybridChecksum::createHasher.
+ *
+ * digest() finalizes and resets the hasher, matching Sha256Hasher.
+ */
+class HybridChecksumHasher : public HybridChecksumHasherSpec {
+public:
+  enum class Algorithm { Crc32c, Xxh3, Xxh128 };
+
+  explicit HybridChecksumHasher(Algorithm algorithm) : HybridObject(TAG), _algorithm(algorithm) {}
+
+  /**
+   * @throws std::runtime_error for unknown algorithm names
+   */
+  static Algorithm parseAlgorithm(const std::string& name);
+
+  std::string getAlgorithm() override;
+  void update(const std::shared_ptr<ArrayBuffer>& data, double offset, double length) override;
+  void updateString(const std::string& data) override;
+  std::string digest() override;
+  std::shared_ptr<ArrayBuffer> digestBytes() override;
+  void reset() override;
+
+private:
+  void absorb(const uint8_t* data, size_t length);
+  std::vector<uint8_t> finish();
+
+  Algorithm _algorithm;
+  uint32_t _crc = 0;
+  Xxh3 _xxh3;
+};
+
+} // namespace margelo::nitro::grpc
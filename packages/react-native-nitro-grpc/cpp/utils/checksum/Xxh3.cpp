@@ -0,0 +1,80 @@
+#include "Xxh3.hpp"
+
+#include <cstring>
+
+// Compile xxHash into this translation unit only, with prefixed symbols so it
+// cannot clash with another copy linked into the app (zstd, RocksDB, ...).
+#define XXH_NAMESPACE rngrpc_
+#define XXH_STATIC_LINKING_ONLY
+#define XXH_IMPLEMENTATION
+#include "xxhash.h"
+
+namespace margelo::nitro::grpc {
+
+struct Xxh3::State {
+  XXH3_state_t xxh;
+};
+
+namespace {
+
+Xxh3::Digest64 toDigest(XXH64_hash_t hash) {
+  XXH64_canonical_t canonical;
+  XXH64_canonicalFromHash(&canonical, hash);
+  Xxh3::Digest64 digest;
+  std::memcpy(digest.data(), canonical.digest, digest.size());
+  return digest;
+}
+
+Xxh3::Digest128 toDigest(XXH128_hash_t hash) {
+  XXH128_canonical_t canonical;
+  XXH128_canonicalFromHash(&canonical, hash);
+  Xxh3::Digest128 digest;
+  std::memcpy(digest.data(), canonical.digest, digest.size());
+  return digest;
+}
+
+} // namespace
+
+Xxh3::Xxh3() : _state(std::make_unique<State>()) {
+  reset();
+}
+
+Xxh3::~Xxh3() = default;
+
+void Xxh3::update(const uint8_t* data, size_t length) {
+  XXH3_128bits_update(&_state->xxh, data, length);
+}
+
+Xxh3::Digest64 Xxh3::digest64() const {
+  return toDigest(XXH3_64bits_digest(&_state->xxh));
+}
+
+Xxh3::Digest128 Xxh3::digest128() const {
+  return toDigest(XXH3_128bits_digest(&_state->xxh));
+}
+
+void Xxh3::reset() {
+  // The 64- and 128-bit variants share their state layout and update
+  // function; only the final mixing differs.
+  XXH3_128bits_reset(&_state->xxh);
+}
+
+Xxh3::Digest64 Xxh3::hash64(const uint8_t* data, size_t length) {
+  return toDigest(XXH3_64bits(data, length));
+}
+
+Xxh3::Digest128 Xxh3::hash128(const uint8_t* data, size_t length) {
+  return toDigest(XXH3_128bits(data, length));
+}
+
+std::string Xxh3::toHex(const uint8_t* data, size_t length) {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string hex(length * 2, '\0');
+  for (size_t i = 0; i < length; i++) {
+    hex[i * 2] = kHexDigits[data[i] >> 4];
+    hex[i * 2 + 1] = kHexDigits[data[i] & 0x0f];
+  }
+  return hex;
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief XXH3 64/128-bit hashes backed by the vendored xxHash.
+ *
+ * xxHash selects SSE2/AVX2 (x86) or NEON (AArch64) at compile time. Digests
+ * use xxHash's canonical big-endian byte order so hex output matches the
+ * `xxhsum` command line tool.
+ */
+class Xxh3 {
+public:
+  static constexpr size_t kDigestSize64 = 8;
+  static constexpr size_t kDigestSize128 = 16;
+
+  using Digest64 = std::array<uint8_t, kDigestSize64>;
+  using Digest128 = std::array<uint8_t, kDigestSize128>;
+
+  Xxh3();
+  ~Xxh3();
+
+  Xxh3(const Xxh3&) = delete;
+  Xxh3& operator=(const Xxh3&) = delete;
+
+  /**
+   * Absorb `length` bytes. Both the 64- and 128-bit digests can be read
+   * from the same stream.
+   */
+  void update(const uint8_t* data, size_t length);
+
+  /**
+   * Digests of everything absorbed since the last reset(). Does not modify
+   * the state, so more data may be added afterwards.
+   */
+  Digest64 digest64() const;
+  Digest128 digest128() const;
+
+  void reset();
+
+  static Digest64 hash64(const uint8_t* data, size_t length);
+  static Digest128 hash128(const uint8_t* data, size_t length);
+
+  /**
+   * Lower-case hex encoding of a digest (or any other byte string).
+   */
+  static std::string toHex(const uint8_t* data, size_t length);
+
+  template <size_t N> static std::string toHex(const std::array<uint8_t, N>& digest) {
+    return toHex(digest.data(), digest.size());
+  }
+
+private:
+  struct State;
+  std::unique_ptr<State> _state;
+};
+
+} // namespace margelo::nitro::grpc
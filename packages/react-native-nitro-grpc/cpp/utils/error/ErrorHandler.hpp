@@ -18,24 +18,17 @@ namespace ErrorHandler {
 struct GrpcError {
   int code;
   std::string message;
-  std::string metadataJson; // Trailing metadata as JSON
 };
 
 /**
  * Convert grpc::Status to GrpcError.
  *
- * @param status gRPC status from call
- * @param context Client context (for trailing metadata)
- * @return GrpcError structure
- */
-GrpcError fromStatus(const ::grpc::Status& status, ::grpc::ClientContext& context);
-
-/**
- * Convert grpc::Status to GrpcError (without context).
- * Use when context is not available.
+ * Trailing metadata is not part of the error. Streams deliver it with the
+ * status as a CallMetadata view; for unary calls JS takes it afterwards
+ * with takeCallMetadata.
  *
  * @param status gRPC status from call
- * @return GrpcError structure (no metadata)
+ * @return GrpcError structure
  */
 GrpcError fromStatus(const ::grpc::Status& status);
 
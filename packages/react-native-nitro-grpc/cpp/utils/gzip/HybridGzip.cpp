@@ -1,6 +1,7 @@
 #include "HybridGzip.hpp"
 
-#include <iostream>
+#include "../../trace/Tracer.hpp"
+
 #include <stdexcept>
 #include <vector>
 #include <zlib.h>
@@ -15,6 +16,7 @@ std::shared_ptr<ArrayBuffer> HybridGzip::gzip(const std::shared_ptr<ArrayBuffer>
   if (!data || data->size() == 0) {
     return ArrayBuffer::allocate(0);
   }
+  TraceSpan span("gzip", "gzip", "bytes", static_cast<int64_t>(data->size()));
 
   z_stream strm;
   strm.zalloc = Z_NULL;
@@ -67,6 +69,7 @@ std::shared_ptr<ArrayBuffer> HybridGzip::ungzip(const std::shared_ptr<ArrayBuffe
   if (!data || data->size() == 0) {
     return ArrayBuffer::allocate(0);
   }
+  TraceSpan span("gzip", "ungzip", "bytes", static_cast<int64_t>(data->size()));
 
   z_stream strm;
   strm.zalloc = Z_NULL;
@@ -88,37 +88,6 @@ CallCredentials parseCallCredentials(const std::string& jsonStr) {
   }
 }
 
-std::map<std::string, std::string> parseChannelOptions(const std::string& jsonStr) {
-  try {
-    // Handle empty string
-    if (jsonStr.empty() || jsonStr == "{}") {
-      return {};
-    }
-
-    auto j = json::parse(jsonStr);
-    std::map<std::string, std::string> options;
-
-    // Convert all values to strings
-    for (auto& [key, value] : j.items()) {
-      if (value.is_string()) {
-        options[key] = value.get<std::string>();
-      } else if (value.is_number_integer()) {
-        options[key] = std::to_string(value.get<int64_t>());
-      } else if (value.is_number_float()) {
-        options[key] = std::to_string(value.get<double>());
-      } else if (value.is_boolean()) {
-        options[key] = value.get<bool>() ? "1" : "0";
-      }
-      // Skip null and complex types
-    }
-
-    return options;
-
-  } catch (const json::exception& e) {
-    throw std::runtime_error("Failed to parse channel options JSON: " + std::string(e.what()));
-  }
-}
-
 std::map<std::string, std::vector<std::string>> parseMetadata(const std::string& jsonStr) {
   try {
     // Handle empty string
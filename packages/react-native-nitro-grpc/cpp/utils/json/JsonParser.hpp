@@ -73,22 +73,6 @@ struct CallCredentials {
  */
 CallCredentials parseCallCredentials(const std::string& json);
 
-/**
- * Parse channel options JSON from TypeScript.
- *
- * Expected format:
- * {
- *   "grpc.keepalive_time_ms": 7200000,
- *   "grpc.max_receive_message_length": 4194304,
- *   ...
- * }
- *
- * @param json JSON string from TypeScript
- * @return Map of option key → value (as strings)
- * @throws std::runtime_error if JSON is malformed
- */
-std::map<std::string, std::string> parseChannelOptions(const std::string& json);
-
 /**
  * Parse metadata JSON from TypeScript.
  *
@@ -0,0 +1,198 @@
+#include "BufferPool.hpp"
+
+#include <bit>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace margelo::nitro::grpc {
+
+using json = nlohmann::json;
+
+BufferPool& BufferPool::shared() {
+  // Never destroyed: ArrayBuffers released by JS during exit still call back into the pool
+  static auto* instance = new BufferPool();
+  return *instance;
+}
+
+BufferPool::Config BufferPool::parseConfig(const std::string& jsonStr) {
+  Config config;
+  if (jsonStr.empty() || jsonStr == "{}") {
+    return config;
+  }
+
+  try {
+    auto j = json::parse(jsonStr);
+
+    if (j.contains("enabled")) {
+      config.enabled = j["enabled"].get<bool>();
+    }
+    if (j.contains("maxRetainedBytes")) {
+      const double maxRetainedBytes = j["maxRetainedBytes"].get<double>();
+      if (maxRetainedBytes < 0) {
+        throw std::runtime_error("maxRetainedBytes must not be negative");
+      }
+      config.maxRetainedBytes = static_cast<size_t>(maxRetainedBytes);
+    }
+    if (j.contains("maxBufferSize")) {
+      const double maxBufferSize = j["maxBufferSize"].get<double>();
+      if (maxBufferSize < 0 || maxBufferSize > static_cast<double>(classBytes(kClassCount - 1))) {
+        throw std::runtime_error("maxBufferSize must be between 0 and " +
+                                 std::to_string(classBytes(kClassCount - 1)));
+      }
+      config.maxBufferSize = static_cast<size_t>(maxBufferSize);
+    }
+  } catch (const json::exception& e) {
+    throw std::runtime_error("Failed to parse buffer pool config: " + std::string(e.what()));
+  }
+
+  return config;
+}
+
+void BufferPool::configure(const Config& config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _config = config;
+  _stats.maxRetainedBytes = config.enabled ? config.maxRetainedBytes : 0;
+  trimLocked();
+}
+
+std::shared_ptr<ArrayBuffer> BufferPool::allocate(size_t size) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (!_config.enabled || size == 0 || size > _config.maxBufferSize) {
+    lock.unlock();
+    return ArrayBuffer::allocate(size);
+  }
+
+  const size_t sizeClass = classFor(size);
+  auto& idle = _idle[sizeClass];
+  Block* block;
+  if (!idle.empty()) {
+    block = idle.back();
+    idle.pop_back();
+    _stats.retainedBytes -= classBytes(sizeClass);
+    _stats.hits++;
+  } else {
+    uint8_t* data = new uint8_t[classBytes(sizeClass)];
+    if (!_spareHeaders.empty()) {
+      block = _spareHeaders.back();
+      _spareHeaders.pop_back();
+    } else {
+      block = &_blocks.emplace_back();
+    }
+    block->data = data;
+    block->sizeClass = sizeClass;
+    _byData[data] = block;
+    _stats.misses++;
+  }
+
+  block->leased = true;
+  block->size = size;
+  _stats.leasedBuffers++;
+  uint8_t* data = block->data;
+  const uint64_t generation = block->generation;
+  lock.unlock();
+
+  // Two words of capture: fits std::function's inline storage, so no allocation per message
+  return ArrayBuffer::wrap(data, size, [block, generation]() { shared().giveBack(block, generation); });
+}
+
+bool BufferPool::release(const std::shared_ptr<ArrayBuffer>& buffer) {
+  if (!buffer) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _byData.find(buffer->data());
+  if (it == _byData.end()) {
+    return false;
+  }
+  Block* block = it->second;
+  if (!block->leased || block->size != buffer->size()) {
+    return false;
+  }
+  return recycleLocked(block, true);
+}
+
+void BufferPool::giveBack(Block* block, uint64_t generation) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // A different generation means the block was released explicitly and maybe leased again
+  if (block->leased && block->generation == generation) {
+    recycleLocked(block, false);
+  }
+}
+
+bool BufferPool::recycleLocked(Block* block, bool explicitRelease) {
+  const size_t bytes = classBytes(block->sizeClass);
+  const bool fits = _config.enabled && bytes <= classBytes(classFor(_config.maxBufferSize)) &&
+                    _stats.retainedBytes + bytes <= _config.maxRetainedBytes;
+  if (!fits && explicitRelease) {
+    // JS still holds the buffer, so the memory must stay valid until it is collected
+    return false;
+  }
+
+  block->leased = false;
+  block->generation++;
+  _stats.leasedBuffers--;
+  if (!fits) {
+    _stats.discards++;
+    freeLocked(block);
+    return false;
+  }
+
+  _idle[block->sizeClass].push_back(block);
+  _stats.retainedBytes += bytes;
+  if (explicitRelease) {
+    _stats.releases++;
+  }
+  return true;
+}
+
+void BufferPool::freeLocked(Block* block) {
+  _byData.erase(block->data);
+  delete[] block->data;
+  block->data = nullptr;
+  _spareHeaders.push_back(block);
+}
+
+void BufferPool::trimLocked() {
+  // Drop idle blocks from the largest class down until the rest fits
+  for (size_t sizeClass = kClassCount; sizeClass-- > 0;) {
+    auto& idle = _idle[sizeClass];
+    const size_t bytes = classBytes(sizeClass);
+    const bool poolable = _config.enabled && bytes <= classBytes(classFor(_config.maxBufferSize));
+    while (!idle.empty() && (!poolable || _stats.retainedBytes > _config.maxRetainedBytes)) {
+      freeLocked(idle.back());
+      idle.pop_back();
+      _stats.retainedBytes -= bytes;
+      _stats.discards++;
+    }
+  }
+}
+
+size_t BufferPool::classFor(size_t size) {
+  if (size <= classBytes(0)) {
+    return 0;
+  }
+  return static_cast<size_t>(std::bit_width(size - 1)) - kMinClassShift;
+}
+
+BufferPool::Stats BufferPool::stats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
+
+std::string BufferPool::statsJson() const {
+  const Stats s = stats();
+  const uint64_t lookups = s.hits + s.misses;
+  json j = {
+      {"hits", s.hits},
+      {"misses", s.misses},
+      {"hitRate", lookups == 0 ? 0.0 : static_cast<double>(s.hits) / static_cast<double>(lookups)},
+      {"releases", s.releases},
+      {"discards", s.discards},
+      {"leasedBuffers", s.leasedBuffers},
+      {"retainedBytes", s.retainedBytes},
+      {"maxRetainedBytes", s.maxRetainedBytes},
+  };
+  return j.dump();
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+using namespace margelo::nitro;
+
+/**
+ * @brief Process-wide pool of backing stores for inbound messages.
+ *
+ * Disabled by default. When enabled, allocate() rounds the size up to a
+ * power-of-two class and hands out an idle block of that class if there is
+ * one. The block comes back when JS garbage-collects the ArrayBuffer, or
+ * earlier through release() if the caller promises not to touch the buffer
+ * again.
+ *
+ * Idle blocks are kept while their total size stays under `maxRetainedBytes`;
+ * anything beyond that is freed. Sizes above `maxBufferSize` are allocated
+ * normally and never pooled.
+ *
+ * Every handed-out ArrayBuffer is tagged with the block's generation, which
+ * changes whenever the block returns to the pool. A stale deleter or a second
+ * release() of the same buffer therefore has no effect.
+ *
+ * Thread-safe.
+ */
+class BufferPool {
+public:
+  struct Config {
+    bool enabled = false;
+    size_t maxRetainedBytes = 4 * 1024 * 1024;
+    size_t maxBufferSize = 1024 * 1024;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t releases = 0;
+    uint64_t discards = 0;
+    size_t leasedBuffers = 0;
+    size_t retainedBytes = 0;
+    size_t maxRetainedBytes = 0;
+  };
+
+  static BufferPool& shared();
+
+  /**
+   * Parse the configuration JSON from TypeScript.
+   *
+   * Expected format:
+   * {
+   *   "enabled"?: boolean,
+   *   "maxRetainedBytes"?: number,
+   *   "maxBufferSize"?: number
+   * }
+   *
+   * @throws std::runtime_error if the JSON is malformed or a size is out of range
+   */
+  static Config parseConfig(const std::string& json);
+
+  /**
+   * Replace the configuration. Idle blocks that no longer fit are freed;
+   * buffers currently held by JS are unaffected.
+   */
+  void configure(const Config& config);
+
+  /**
+   * An ArrayBuffer of exactly `size` bytes, backed by a pooled block when the
+   * pool is enabled and the size is poolable. Contents are uninitialized.
+   */
+  std::shared_ptr<ArrayBuffer> allocate(size_t size);
+
+  /**
+   * Return the block behind `buffer` to the pool before JS drops it.
+   *
+   * The caller must not read or write `buffer` afterwards: the block may be
+   * handed out for the next message right away. If the pool has no room the
+   * block stays with the buffer and is reclaimed on garbage collection.
+   *
+   * @return true if the block was recycled
+   */
+  bool release(const std::shared_ptr<ArrayBuffer>& buffer);
+
+  Stats stats() const;
+
+  /**
+   * Stats serialized as a JSON object for the JS bridge.
+   */
+  std::string statsJson() const;
+
+private:
+  // Smallest class is 256 bytes; below that pooling saves nothing
+  static constexpr size_t kMinClassShift = 8;
+  // Largest class is 1 GiB; the configured maxBufferSize caps it further
+  static constexpr size_t kClassCount = 23;
+
+  struct Block {
+    uint8_t* data = nullptr;
+    size_t sizeClass = 0;
+    size_t size = 0; // Size of the current lease
+    uint64_t generation = 0;
+    bool leased = false;
+  };
+
+  BufferPool() = default;
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  static size_t classFor(size_t size);
+  static size_t classBytes(size_t sizeClass) {
+    return size_t{1} << (sizeClass + kMinClassShift);
+  }
+
+  void giveBack(Block* block, uint64_t generation);
+  bool recycleLocked(Block* block, bool explicitRelease);
+  void freeLocked(Block* block);
+  void trimLocked();
+
+  mutable std::mutex _mutex;
+  Config _config;
+  // Headers are never destroyed, so deleters of old buffers can always check the generation
+  std::deque<Block> _blocks;
+  std::vector<Block*> _spareHeaders;
+  std::array<std::vector<Block*>, kClassCount> _idle;
+  std::unordered_map<const uint8_t*, Block*> _byData;
+  Stats _stats;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Thread-safe free list of reusable objects.
+ *
+ * acquire() hands out a pooled object (or a new one when the pool is empty)
+ * as a unique_ptr whose deleter calls `T::reset()` and returns the object to
+ * the pool instead of freeing it. Objects keep whatever capacity they grew,
+ * so steady-state reuse does not allocate.
+ *
+ * At most `maxRetained` idle objects are kept; extra releases free the
+ * object. The pool must outlive every object it hands out, which is why
+ * pools are process-wide singletons that are never destroyed.
+ */
+template <typename T> class ObjectPool {
+public:
+  struct Releaser {
+    ObjectPool* pool;
+
+    void operator()(T* object) const {
+      pool->release(object);
+    }
+  };
+
+  using Pooled = std::unique_ptr<T, Releaser>;
+
+  struct Stats {
+    uint64_t created;
+    uint64_t reused;
+    size_t idle;
+  };
+
+  explicit ObjectPool(size_t maxRetained) : _maxRetained(maxRetained) {
+    _idle.reserve(maxRetained);
+  }
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  ~ObjectPool() {
+    for (T* object : _idle) {
+      delete object;
+    }
+  }
+
+  Pooled acquire() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_idle.empty()) {
+        T* object = _idle.back();
+        _idle.pop_back();
+        _reused.fetch_add(1, std::memory_order_relaxed);
+        return Pooled(object, Releaser{this});
+      }
+    }
+    _created.fetch_add(1, std::memory_order_relaxed);
+    return Pooled(new T(), Releaser{this});
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return {_created.load(std::memory_order_relaxed), _reused.load(std::memory_order_relaxed), _idle.size()};
+  }
+
+private:
+  void release(T* object) {
+    // Reset outside the lock: it may release buffers, contexts and promises
+    object->reset();
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_idle.size() < _maxRetained) {
+        _idle.push_back(object);
+        return;
+      }
+    }
+    delete object;
+  }
+
+  const size_t _maxRetained;
+  mutable std::mutex _mutex;
+  std::vector<T*> _idle;
+  std::atomic<uint64_t> _created{0};
+  std::atomic<uint64_t> _reused{0};
+};
+
+} // namespace margelo::nitro::grpc
@@ -1,16 +1,58 @@
 #include "HybridSha256.hpp"
 
-#include "picosha2.h"
+#include "Sha256.hpp"
+#include "Sha256File.hpp"
 
 namespace margelo::nitro::grpc {
 
 std::string HybridSha256::hash(const std::string& data) {
-  return picosha2::hash256_hex_string(data);
+  return Sha256::toHex(Sha256::hash(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
 }
 
 std::string HybridSha256::hashBytes(const std::shared_ptr<ArrayBuffer>& data) {
-  std::vector<unsigned char> vec(data->data(), data->data() + data->size());
-  return picosha2::hash256_hex_string(vec);
+  // Hash the JS buffer in place; no intermediate copy.
+  return Sha256::toHex(Sha256::hash(data->data(), data->size()));
+}
+
+namespace {
+
+std::shared_ptr<ArrayBuffer> toArrayBuffer(const Sha256::Digest& digest) {
+  return ArrayBuffer::copy(digest.data(), digest.size());
+}
+
+} // namespace
+
+// File hashing runs on Nitro's shared pool so the JS thread never blocks on disk I/O.
+
+std::shared_ptr<Promise<std::string>> HybridSha256::hashFile(const std::string& path) {
+  return Promise<std::string>::async([path]() { return Sha256::toHex(Sha256File::hash(path)); });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridSha256::hashFileBytes(const std::string& path) {
+  return Promise<std::shared_ptr<ArrayBuffer>>::async([path]() { return toArrayBuffer(Sha256File::hash(path)); });
+}
+
+std::shared_ptr<Promise<std::vector<std::string>>> HybridSha256::hashFiles(const std::vector<std::string>& paths) {
+  return Promise<std::vector<std::string>>::async([paths]() {
+    std::vector<std::string> result;
+    result.reserve(paths.size());
+    for (const auto& digest : Sha256File::hashAll(paths)) {
+      result.push_back(Sha256::toHex(digest));
+    }
+    return result;
+  });
+}
+
+std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+HybridSha256::hashFilesBytes(const std::vector<std::string>& paths) {
+  return Promise<std::vector<std::shared_ptr<ArrayBuffer>>>::async([paths]() {
+    std::vector<std::shared_ptr<ArrayBuffer>> result;
+    result.reserve(paths.size());
+    for (const auto& digest : Sha256File::hashAll(paths)) {
+      result.push_back(toArrayBuffer(digest));
+    }
+    return result;
+  });
 }
 
 } // namespace margelo::nitro::grpc
@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace margelo::nitro::grpc {
 
@@ -13,11 +14,20 @@ public:
 
   std::string hash(const std::string& data) override;
   std::string hashBytes(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<Promise<std::string>> hashFile(const std::string& path) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> hashFileBytes(const std::string& path) override;
+  std::shared_ptr<Promise<std::vector<std::string>>> hashFiles(const std::vector<std::string>& paths) override;
+  std::shared_ptr<Promise<std::vector<std::shared_ptr<ArrayBuffer>>>>
+  hashFilesBytes(const std::vector<std::string>& paths) override;
 
   void loadHybridMethods() override {
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("hash", &HybridSha256::hash);
       prototype.registerHybridMethod("hashBytes", &HybridSha256::hashBytes);
+      prototype.registerHybridMethod("hashFile", &HybridSha256::hashFile);
+      prototype.registerHybridMethod("hashFileBytes", &HybridSha256::hashFileBytes);
+      prototype.registerHybridMethod("hashFiles", &HybridSha256::hashFiles);
+      prototype.registerHybridMethod("hashFilesBytes", &HybridSha256::hashFilesBytes);
     });
   }
 };
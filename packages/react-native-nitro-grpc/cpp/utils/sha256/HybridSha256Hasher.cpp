@@ -0,0 +1,28 @@
+#include "HybridSha256Hasher.hpp"
+
+namespace margelo::nitro::grpc {
+
+void HybridSha256Hasher::update(const std::shared_ptr<ArrayBuffer>& data) {
+  if (!data)
+    return;
+  _hasher.update(data->data(), data->size());
+}
+
+void HybridSha256Hasher::updateString(const std::string& data) {
+  _hasher.update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+std::string HybridSha256Hasher::digest() {
+  return Sha256::toHex(_hasher.finalize());
+}
+
+std::shared_ptr<ArrayBuffer> HybridSha256Hasher::digestBytes() {
+  auto digest = _hasher.finalize();
+  return ArrayBuffer::copy(digest.data(), digest.size());
+}
+
+void HybridSha256Hasher::reset() {
+  _hasher.reset();
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "HybridSha256HasherSpec.hpp"
+#include "Sha256.hpp"
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Streaming SHA-256 exposed to JS.
+ *
+ * Chunks are absorbed directly from the incoming ArrayBuffer, so multi-GB
+ * downloads can be hashed without buffering. digest() finalizes and resets
+ * the hasher for reuse.
+ */
+class HybridSha256Hasher : public HybridSha256HasherSpec {
+public:
+  HybridSha256Hasher() : HybridObject(TAG) {}
+
+  void update(const std::shared_ptr<ArrayBuffer>& data) override;
+  void updateString(const std::string& data) override;
+  std::string digest() override;
+  std::shared_ptr<ArrayBuffer> digestBytes() override;
+  void reset() override;
+
+private:
+  Sha256 _hasher;
+};
+
+} // namespace margelo::nitro::grpc
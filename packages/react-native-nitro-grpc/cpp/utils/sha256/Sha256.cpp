@@ -0,0 +1,327 @@
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RNGRPC_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+// Android builds this file with -march=armv8-a+crypto; the kernel is only
+// entered after the HWCAP check below.
+#define RNGRPC_SHA256_ARM 1
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+constexpr std::array<uint32_t, 8> kInitialState = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+alignas(16) constexpr uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+// Compresses `blocks` consecutive 64-byte blocks into `state`.
+using CompressFn = void (*)(uint32_t* state, const uint8_t* data, size_t blocks);
+
+inline uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t loadBigEndian32(const uint8_t* p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+void compressScalar(uint32_t* state, const uint8_t* data, size_t blocks) {
+  uint32_t w[64];
+
+  for (; blocks > 0; blocks--, data += Sha256::kBlockSize) {
+    for (int i = 0; i < 16; i++) {
+      w[i] = loadBigEndian32(data + i * 4);
+    }
+    for (int i = 16; i < 64; i++) {
+      const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; i++) {
+      const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+      const uint32_t ch = (e & f) ^ (~e & g);
+      const uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+      const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+      const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      const uint32_t t2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+#if defined(RNGRPC_SHA256_X86)
+
+// SHA-NI keeps the state as ABEF/CDGH lane pairs. Each 4-round group feeds
+// two sha256rnds2 calls, while msg1/msg2 extend the schedule four words
+// ahead of use.
+__attribute__((target("sha,sse4.1"))) void compressShaNi(uint32_t* state, const uint8_t* data, size_t blocks) {
+  const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+  __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);               // CDAB
+  state1 = _mm_shuffle_epi32(state1, 0x1B);         // EFGH
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);      // CDGH
+
+  for (; blocks > 0; blocks--, data += Sha256::kBlockSize) {
+    const __m128i abefSave = state0;
+    const __m128i cdghSave = state1;
+    __m128i w[4];
+
+    for (int group = 0; group < 16; group++) {
+      if (group < 4) {
+        w[group] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + group * 16)), byteSwap);
+      }
+
+      __m128i msg = _mm_add_epi32(w[group & 3],
+                                  _mm_load_si128(reinterpret_cast<const __m128i*>(&kRoundConstants[group * 4])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+      if (group >= 3 && group <= 14) {
+        // Extend the schedule: W[group + 1] from W[group - 3 .. group]
+        const __m128i next = _mm_add_epi32(w[(group + 1) & 3], _mm_alignr_epi8(w[group & 3], w[(group - 1) & 3], 4));
+        w[(group + 1) & 3] = _mm_sha256msg2_epu32(next, w[group & 3]);
+      }
+
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+      if (group >= 1 && group <= 12) {
+        w[(group - 1) & 3] = _mm_sha256msg1_epu32(w[(group - 1) & 3], w[group & 3]);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abefSave);
+    state1 = _mm_add_epi32(state1, cdghSave);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+  state1 = _mm_shuffle_epi32(state1, 0xB1);    // DCHG
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+  state1 = _mm_alignr_epi8(state1, tmp, 8);    // ABEF
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+bool cpuHasShaNi() {
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  const bool hasSse41 = (ecx & (1u << 19)) != 0;
+  const bool hasSsse3 = (ecx & (1u << 9)) != 0;
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  const bool hasSha = (ebx & (1u << 29)) != 0;
+  return hasSha && hasSse41 && hasSsse3;
+}
+
+#elif defined(RNGRPC_SHA256_ARM)
+
+void compressArmv8(uint32_t* state, const uint8_t* data, size_t blocks) {
+  uint32x4_t abcd = vld1q_u32(state);
+  uint32x4_t efgh = vld1q_u32(state + 4);
+
+  for (; blocks > 0; blocks--, data += Sha256::kBlockSize) {
+    const uint32x4_t abcdSave = abcd;
+    const uint32x4_t efghSave = efgh;
+    uint32x4_t w[4];
+
+    for (int i = 0; i < 4; i++) {
+      w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+    }
+
+    for (int group = 0; group < 16; group++) {
+      const uint32x4_t wk = vaddq_u32(w[group & 3], vld1q_u32(&kRoundConstants[group * 4]));
+      if (group < 12) {
+        // W[group + 4] from W[group .. group + 3]
+        w[group & 3] = vsha256su1q_u32(
+            vsha256su0q_u32(w[group & 3], w[(group + 1) & 3]), w[(group + 2) & 3], w[(group + 3) & 3]);
+      }
+      const uint32x4_t abcdPrev = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, wk);
+      efgh = vsha256h2q_u32(efgh, abcdPrev, wk);
+    }
+
+    abcd = vaddq_u32(abcd, abcdSave);
+    efgh = vaddq_u32(efgh, efghSave);
+  }
+
+  vst1q_u32(state, abcd);
+  vst1q_u32(state + 4, efgh);
+}
+
+bool cpuHasArmv8Sha2() {
+#if defined(__APPLE__)
+  return true;
+#elif defined(__linux__) && defined(HWCAP_SHA2)
+  return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif
+
+struct Implementation {
+  CompressFn compress;
+  const char* name;
+};
+
+Implementation selectImplementation() {
+#if defined(RNGRPC_SHA256_X86)
+  if (cpuHasShaNi()) {
+    return {compressShaNi, "sha-ni"};
+  }
+#elif defined(RNGRPC_SHA256_ARM)
+  if (cpuHasArmv8Sha2()) {
+    return {compressArmv8, "armv8-sha2"};
+  }
+#endif
+  return {compressScalar, "scalar"};
+}
+
+const Implementation& implementation() {
+  static const Implementation selected = selectImplementation();
+  return selected;
+}
+
+} // namespace
+
+Sha256::Sha256() {
+  reset();
+}
+
+void Sha256::reset() {
+  _state = kInitialState;
+  _bufferLength = 0;
+  _totalLength = 0;
+}
+
+void Sha256::update(const uint8_t* data, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  const CompressFn compress = implementation().compress;
+  _totalLength += length;
+
+  // Top up a partially filled block first.
+  if (_bufferLength > 0) {
+    const size_t take = std::min(length, kBlockSize - _bufferLength);
+    std::memcpy(_buffer.data() + _bufferLength, data, take);
+    _bufferLength += take;
+    data += take;
+    length -= take;
+    if (_bufferLength < kBlockSize) {
+      return;
+    }
+    compress(_state.data(), _buffer.data(), 1);
+    _bufferLength = 0;
+  }
+
+  // Whole blocks are compressed straight from the caller's memory.
+  const size_t blocks = length / kBlockSize;
+  if (blocks > 0) {
+    compress(_state.data(), data, blocks);
+    data += blocks * kBlockSize;
+    length -= blocks * kBlockSize;
+  }
+
+  if (length > 0) {
+    std::memcpy(_buffer.data(), data, length);
+    _bufferLength = length;
+  }
+}
+
+Sha256::Digest Sha256::finalize() {
+  const CompressFn compress = implementation().compress;
+  const uint64_t bitLength = _totalLength * 8;
+
+  _buffer[_bufferLength++] = 0x80;
+  if (_bufferLength > kBlockSize - 8) {
+    std::memset(_buffer.data() + _bufferLength, 0, kBlockSize - _bufferLength);
+    compress(_state.data(), _buffer.data(), 1);
+    _bufferLength = 0;
+  }
+  std::memset(_buffer.data() + _bufferLength, 0, kBlockSize - 8 - _bufferLength);
+  for (int i = 0; i < 8; i++) {
+    _buffer[kBlockSize - 1 - i] = static_cast<uint8_t>(bitLength >> (i * 8));
+  }
+  compress(_state.data(), _buffer.data(), 1);
+
+  Digest digest;
+  for (size_t i = 0; i < 8; i++) {
+    digest[i * 4] = static_cast<uint8_t>(_state[i] >> 24);
+    digest[i * 4 + 1] = static_cast<uint8_t>(_state[i] >> 16);
+    digest[i * 4 + 2] = static_cast<uint8_t>(_state[i] >> 8);
+    digest[i * 4 + 3] = static_cast<uint8_t>(_state[i]);
+  }
+
+  reset();
+  return digest;
+}
+
+Sha256::Digest Sha256::hash(const uint8_t* data, size_t length) {
+  Sha256 hasher;
+  hasher.update(data, length);
+  return hasher.finalize();
+}
+
+std::string Sha256::toHex(const Digest& digest) {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string hex(kDigestSize * 2, '\0');
+  for (size_t i = 0; i < kDigestSize; i++) {
+    hex[i * 2] = kHexDigits[digest[i] >> 4];
+    hex[i * 2 + 1] = kHexDigits[digest[i] & 0x0F];
+  }
+  return hex;
+}
+
+const char* Sha256::implementationName() {
+  return implementation().name;
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief Incremental SHA-256 with hardware acceleration.
+ *
+ * The block compression function is selected once at runtime:
+ * - x86/x86_64: SHA-NI when CPUID reports SHA + SSE4.1
+ * - AArch64: ARMv8 SHA2 crypto extensions when HWCAP reports them
+ *   (always on Apple silicon)
+ * - Everything else: portable scalar rounds
+ *
+ * Instances are not thread-safe; use one per stream.
+ */
+class Sha256 {
+public:
+  static constexpr size_t kDigestSize = 32;
+  static constexpr size_t kBlockSize = 64;
+
+  using Digest = std::array<uint8_t, kDigestSize>;
+
+  Sha256();
+
+  /**
+   * Absorb `length` bytes. May be called any number of times.
+   */
+  void update(const uint8_t* data, size_t length);
+
+  /**
+   * Finish the hash and return the digest. The instance is reset afterwards
+   * and can be reused for a new message.
+   */
+  Digest finalize();
+
+  /**
+   * Discard any absorbed data and start a new message.
+   */
+  void reset();
+
+  /**
+   * One-shot helper for contiguous input.
+   */
+  static Digest hash(const uint8_t* data, size_t length);
+
+  /**
+   * Lower-case hex encoding of a digest.
+   */
+  static std::string toHex(const Digest& digest);
+
+  /**
+   * Name of the compression function in use ("sha-ni", "armv8-sha2" or
+   * "scalar").
+   */
+  static const char* implementationName();
+
+private:
+  std::array<uint32_t, 8> _state;
+  std::array<uint8_t, kBlockSize> _buffer;
+  size_t _bufferLength = 0;
+  uint64_t _totalLength = 0;
+};
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,212 @@
+#include "Sha256File.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace margelo::nitro::grpc {
+
+namespace {
+
+// Multiple of every page size we run on (4K/16K/64K).
+constexpr size_t kMapWindow = 64 * 1024 * 1024;
+
+constexpr const char* kFileScheme = "file://";
+
+std::string stripScheme(const std::string& path) {
+  if (path.rfind(kFileScheme, 0) == 0) {
+    return path.substr(std::strlen(kFileScheme));
+  }
+  return path;
+}
+
+[[noreturn]] void throwErrno(const char* what, const std::string& path) {
+  throw std::runtime_error(std::string(what) + " '" + path + "': " + std::strerror(errno));
+}
+
+/**
+ * Closes the descriptor on every exit path.
+ */
+class FileDescriptor {
+public:
+  explicit FileDescriptor(int fd) : _fd(fd) {}
+  ~FileDescriptor() {
+    if (_fd >= 0) {
+      ::close(_fd);
+    }
+  }
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+  int get() const {
+    return _fd;
+  }
+
+private:
+  int _fd;
+};
+
+/**
+ * Fixed set of threads shared by every hashAll() call, so hashing many
+ * batches neither spawns threads per call nor oversubscribes the CPU when
+ * batches overlap.
+ */
+class WorkerPool {
+public:
+  static WorkerPool& shared() {
+    // Never destroyed: detached workers may still be waiting at exit
+    static auto* instance = new WorkerPool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return *instance;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  void submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _tasks.push_back(std::move(task));
+    }
+    _wake.notify_one();
+  }
+
+private:
+  explicit WorkerPool(size_t size) : _size(size) {
+    for (size_t i = 0; i < size; i++) {
+      std::thread([this]() { run(); }).detach();
+    }
+  }
+
+  void run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wake.wait(lock, [this]() { return !_tasks.empty(); });
+        task = std::move(_tasks.front());
+        _tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  const size_t _size;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::deque<std::function<void()>> _tasks; // Guarded by _mutex
+};
+
+/**
+ * One hashAll() call. Pool workers hold it by shared_ptr: a helper that
+ * only starts after the caller returned finds no files left and exits.
+ */
+struct HashJob {
+  explicit HashJob(const std::vector<std::string>& paths)
+      : paths(paths), count(paths.size()), digests(count), errors(count) {}
+
+  // Hash files until none are left; `paths` is only read while files remain
+  void work() {
+    for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      try {
+        digests[i] = Sha256File::hash(paths[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++finished == count) {
+        done.notify_all();
+      }
+    }
+  }
+
+  const std::vector<std::string>& paths; // Owned by the hashAll() caller
+  const size_t count;
+  std::vector<Sha256::Digest> digests;
+  std::vector<std::exception_ptr> errors;
+  std::atomic<size_t> next{0};
+
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t finished = 0; // Guarded by mutex
+};
+
+} // namespace
+
+Sha256::Digest Sha256File::hash(const std::string& uri) {
+  const std::string path = stripScheme(uri);
+
+  FileDescriptor fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (fd.get() < 0) {
+    throwErrno("Failed to open", path);
+  }
+
+  struct stat info {};
+  if (::fstat(fd.get(), &info) != 0) {
+    throwErrno("Failed to stat", path);
+  }
+  if (!S_ISREG(info.st_mode)) {
+    throw std::runtime_error("Not a regular file: '" + path + "'");
+  }
+
+  Sha256 hasher;
+  const auto size = static_cast<uint64_t>(info.st_size);
+  uint64_t offset = 0;
+  while (offset < size) {
+    const size_t length = static_cast<size_t>(std::min<uint64_t>(kMapWindow, size - offset));
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd.get(), static_cast<off_t>(offset));
+    if (mapped == MAP_FAILED) {
+      throwErrno("Failed to map", path);
+    }
+    ::madvise(mapped, length, MADV_SEQUENTIAL);
+    hasher.update(static_cast<const uint8_t*>(mapped), length);
+    ::munmap(mapped, length);
+    offset += length;
+  }
+  return hasher.finalize();
+}
+
+std::vector<Sha256::Digest> Sha256File::hashAll(const std::vector<std::string>& paths, size_t maxWorkers) {
+  if (paths.empty()) {
+    return {};
+  }
+
+  auto& pool = WorkerPool::shared();
+  if (maxWorkers == 0) {
+    maxWorkers = pool.size() + 1;
+  }
+  const size_t helpers = std::min({maxWorkers, paths.size(), pool.size() + 1}) - 1;
+
+  auto job = std::make_shared<HashJob>(paths);
+  for (size_t i = 0; i < helpers; i++) {
+    pool.submit([job]() { job->work(); });
+  }
+  // Helpers queued behind other batches may never get a file; the caller alone finishes the job then
+  job->work();
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->done.wait(lock, [&]() { return job->finished == job->count; });
+  }
+
+  for (const auto& error : job->errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return std::move(job->digests);
+}
+
+} // namespace margelo::nitro::grpc
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Sha256.hpp"
+
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::grpc {
+
+/**
+ * @brief SHA-256 of files on disk without copying them into memory.
+ *
+ * Files are memory-mapped in fixed-size windows with MADV_SEQUENTIAL so the
+ * kernel reads ahead and drops pages behind us; peak address space usage is
+ * bounded by the window size regardless of file size.
+ */
+namespace Sha256File {
+
+/**
+ * Hash a single file. A leading "file://" scheme is stripped so URIs from
+ * React Native file APIs can be passed directly.
+ *
+ * @throws std::runtime_error if the file cannot be opened or mapped
+ */
+Sha256::Digest hash(const std::string& path);
+
+/**
+ * Hash several files in parallel. Files are handed out to up to
+ * `maxWorkers` threads (0 = hardware concurrency); the calling thread is
+ * one of them, the others come from a worker pool shared by all calls and
+ * sized to the hardware concurrency.
+ *
+ * @return Digests in the same order as `paths`
+ * @throws std::runtime_error for the first path (in input order) that failed
+ */
+std::vector<Sha256::Digest> hashAll(const std::vector<std::string>& paths, size_t maxWorkers = 0);
+
+} // namespace Sha256File
+
+} // namespace margelo::nitro::grpc
@@ -5,13 +5,15 @@ import { serializeMessage } from '../utils/serialization';
 import { toAbsoluteDeadline } from '../utils/deadline';
 import { ServerStreamImpl, ClientStreamImpl, BidiStreamImpl } from '../streams';
 import { ServerStream, ClientStream, BidiStream } from '../types/stream';
+import { isMethodHandle } from '../types/method';
+import type { MethodHandle } from '../types/method';
 
 /**
  * Creates a server streaming call (single request, multiple responses).
  */
 export function serverStream<Req, Res>(
   hybrid: HybridGrpcClient,
-  method: string,
+  method: string | MethodHandle,
   request: Req,
   options?: GrpcCallOptions
 ): ServerStream<Res> {
@@ -20,12 +22,19 @@ export function serverStream<Req, Res>(
   const metadataJson = JSON.stringify(metadata.toJSON());
   const deadlineMs = toAbsoluteDeadline(options?.deadline);
 
-  const hybridStream = hybrid.createServerStream(
-    method,
-    requestBuffer,
-    metadataJson,
-    deadlineMs
-  );
+  const hybridStream = isMethodHandle(method)
+    ? hybrid.createServerStreamWithHandle(
+        method.id,
+        requestBuffer,
+        metadataJson,
+        deadlineMs
+      )
+    : hybrid.createServerStream(
+        method,
+        requestBuffer,
+        metadataJson,
+        deadlineMs
+      );
 
   return new ServerStreamImpl<Res>(hybridStream);
 }
@@ -35,18 +44,16 @@ export function serverStream<Req, Res>(
  */
 export function clientStream<Req, Res>(
   hybrid: HybridGrpcClient,
-  method: string,
+  method: string | MethodHandle,
   options?: GrpcCallOptions
 ): ClientStream<Req, Res> {
   const metadata = options?.metadata || new GrpcMetadata();
   const metadataJson = JSON.stringify(metadata.toJSON());
   const deadlineMs = toAbsoluteDeadline(options?.deadline);
 
-  const hybridStream = hybrid.createClientStream(
-    method,
-    metadataJson,
-    deadlineMs
-  );
+  const hybridStream = isMethodHandle(method)
+    ? hybrid.createClientStreamWithHandle(method.id, metadataJson, deadlineMs)
+    : hybrid.createClientStream(method, metadataJson, deadlineMs);
 
   return new ClientStreamImpl<Req, Res>(hybridStream);
 }
@@ -56,18 +63,16 @@ export function clientStream<Req, Res>(
  */
 export function bidiStream<Req, Res>(
   hybrid: HybridGrpcClient,
-  method: string,
+  method: string | MethodHandle,
   options?: GrpcCallOptions
 ): BidiStream<Req, Res> {
   const metadata = options?.metadata || new GrpcMetadata();
   const metadataJson = JSON.stringify(metadata.toJSON());
   const deadlineMs = toAbsoluteDeadline(options?.deadline);
 
-  const hybridStream = hybrid.createBidiStream(
-    method,
-    metadataJson,
-    deadlineMs
-  );
+  const hybridStream = isMethodHandle(method)
+    ? hybrid.createBidiStreamWithHandle(method.id, metadataJson, deadlineMs)
+    : hybrid.createBidiStream(method, metadataJson, deadlineMs);
 
   return new BidiStreamImpl<Req, Res>(hybridStream);
 }
@@ -4,30 +4,45 @@ import { GrpcMetadata } from '../types/metadata';
 import { serializeMessage, deserializeMessage } from '../utils/serialization';
 import { toAbsoluteDeadline } from '../utils/deadline';
 import { checkAborted } from '../utils/cancellation';
+import { recordRetry } from '../utils/channel-stats';
+import {
+  createUnaryError,
+  reportUnaryMetadata,
+} from '../streams/call-metadata';
+import {
+  hasCallTimingListener,
+  reportCallTiming,
+  timingNow,
+} from '../utils/call-timing';
 import type {
   GrpcInterceptor,
   UnaryInterceptor,
   NextUnaryFn,
 } from '../interceptor';
-import type { MethodDefinition } from '../types/method';
+import { isMethodHandle } from '../types/method';
+import type { MethodDefinition, MethodHandle } from '../types/method';
+
+let lastCallId = 0;
 
 /**
  * Makes an asynchronous unary call with interceptors.
  */
 export async function unaryCall<Req, Res>(
   hybrid: HybridGrpcClient,
-  method: string | MethodDefinition<Req, Res>,
+  method: string | MethodDefinition<Req, Res> | MethodHandle,
   request: Req,
   options: GrpcCallOptions | undefined,
   interceptors: GrpcInterceptor[]
 ): Promise<Res> {
   const methodName = typeof method === 'string' ? method : method.path;
-  const serializer =
-    typeof method === 'object' ? method.requestSerialize : serializeMessage;
-  const deserializer =
-    typeof method === 'object'
-      ? method.responseDeserialize
-      : deserializeMessage;
+  const handle = isMethodHandle(method) ? method : undefined;
+  const definition =
+    typeof method === 'object' && !handle
+      ? (method as MethodDefinition<Req, Res>)
+      : undefined;
+  const serializer = definition?.requestSerialize ?? serializeMessage;
+  const deserializer = definition?.responseDeserialize ?? deserializeMessage;
+  let attempts = 0;
 
   return applyUnaryInterceptors(
     interceptors,
@@ -35,13 +50,18 @@ export async function unaryCall<Req, Res>(
     request,
     options,
     async (m, r, o) => {
+      // An interceptor calling next() again is retrying the call
+      if (attempts++ > 0) {
+        recordRetry(hybrid, m);
+      }
+
       // Serialize request to ArrayBuffer
       const buffer = serializer(r as Req);
       const requestBuffer =
         buffer instanceof Uint8Array ? buffer.buffer : buffer;
 
-      // Generate a unique call ID
-      const callId = Math.random().toString(36).substring(7);
+      // Unique for the lifetime of the JS runtime; native code cancels by it
+      const callId = String(++lastCallId);
 
       // Prepare metadata and deadline
       const metadata = o?.metadata || new GrpcMetadata();
@@ -62,15 +82,46 @@ export async function unaryCall<Req, Res>(
         // Ideally we wrap the native call in a try/finally to remove listener.
       }
 
-      // Make the call
+      // Only measured while a channel listener wants call timings
+      const startedAt = hasCallTimingListener(hybrid) ? timingNow() : undefined;
+      let settledAt: number | undefined;
+
+      // Make the call. The handle is only used while interceptors kept the
+      // method it was registered for.
       try {
-        const responseBuffer = await hybrid.unaryCall(
-          m,
-          requestBuffer as ArrayBuffer,
-          metadataJson,
-          deadlineMs,
-          callId
-        );
+        let responseBuffer: ArrayBuffer;
+        try {
+          responseBuffer =
+            handle && m === handle.path
+              ? await hybrid.unaryCallWithHandle(
+                  handle.id,
+                  requestBuffer as ArrayBuffer,
+                  metadataJson,
+                  deadlineMs,
+                  callId
+                )
+              : await hybrid.unaryCall(
+                  m,
+                  requestBuffer as ArrayBuffer,
+                  metadataJson,
+                  deadlineMs,
+                  callId
+                );
+        } catch (error) {
+          throw createUnaryError(
+            error,
+            () => hybrid.takeCallMetadata(callId),
+            o
+          );
+        }
+
+        if (startedAt !== undefined) {
+          settledAt = timingNow();
+        }
+        // Headers and trailers are only taken from native when asked for
+        if (o?.onMetadata || o?.onStatus) {
+          reportUnaryMetadata(hybrid.takeCallMetadata(callId), o);
+        }
 
         const resultBuffer = responseBuffer;
         // Cast to unknown first to safely cast to expected return type
@@ -79,6 +130,11 @@ export async function unaryCall<Req, Res>(
         if (o?.signal && onAbort) {
           o.signal.removeEventListener('abort', onAbort);
         }
+        if (startedAt !== undefined) {
+          const ok = settledAt !== undefined;
+          const totalMs = (settledAt ?? timingNow()) - startedAt;
+          reportCallTiming(hybrid, callId, m, ok, totalMs);
+        }
       }
     }
   );
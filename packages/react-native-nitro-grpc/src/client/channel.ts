@@ -1,11 +1,42 @@
 import { NitroModules } from 'react-native-nitro-modules';
 import type { GrpcClient as HybridGrpcClient } from '../specs/GrpcClient.nitro';
-import type { ChannelOptions, ChannelState } from '../types/channel-types';
+import type { BufferPoolConfig, BufferPoolStats } from '../types/buffer-pool';
+import type { CallTiming } from '../types/call-timing';
+import type {
+  ChannelStats,
+  HistogramConfig,
+  MessageSizePercentiles,
+  PercentileSummary,
+} from '../types/channel-stats';
+import type {
+  ChannelOptions,
+  ChannelState,
+  TlsSessionStats,
+} from '../types/channel-types';
 import type {
   GrpcChannelCredentials,
   TypedCallCredentials,
 } from '../types/credentials';
 import { ChannelCredentials, CallCredentials } from '../types/credentials';
+import type { LogEntry, LogLevel, LoggingConfig } from '../types/logging';
+import type {
+  MethodDefaults,
+  MethodHandle,
+  MethodType,
+} from '../types/method';
+import type {
+  CoalescingConfig,
+  ResponseCacheConfig,
+  ResponseCacheStats,
+} from '../types/response-cache';
+import { setCallTimingListener } from '../utils/call-timing';
+import {
+  getChannelStats,
+  getLatencyPercentiles,
+  getMessageSizePercentiles,
+} from '../utils/channel-stats';
+
+const DEFAULT_PERCENTILES = [50, 90, 99, 99.9];
 
 /**
  * Represents a gRPC channel - a connection to a specific server endpoint.
@@ -63,20 +94,20 @@ export class GrpcChannel {
       ? JSON.stringify(processedOptions)
       : '{}';
 
-    // Connect with call credentials if provided (for composite auth)
-    if (callCredentials) {
-      const callCredsJson = CallCredentials.toJSON(callCredentials);
-      // Call overloaded C++ method with call credentials
-      this._hybrid.connectWithCallCredentials(
-        target,
-        credentialsJson,
-        optionsJson,
-        callCredsJson
-      );
-    } else {
-      // Standard connect without call credentials
-      this._hybrid.connect(target, credentialsJson, optionsJson);
-    }
+    // Credentials are built natively once per configuration; channels with
+    // the same credentials (e.g. reconnects) reuse them via the handle.
+    const callCredsJson = callCredentials
+      ? CallCredentials.toJSON(callCredentials)
+      : '';
+    const credentialsHandle = this._hybrid.registerCredentials(
+      credentialsJson,
+      callCredsJson
+    );
+    this._hybrid.connectWithCredentials(
+      target,
+      credentialsHandle,
+      optionsJson
+    );
   }
 
   /**
@@ -118,6 +149,307 @@ export class GrpcChannel {
       );
   }
 
+  /**
+   * Enables the native response cache for idempotent unary methods.
+   * Cache hits resolve without a network call. Calling this again replaces
+   * the configuration and drops all cached responses.
+   *
+   * @param config - Cached methods and size limit; `{ methods: {} }` disables caching
+   */
+  configureResponseCache(config: ResponseCacheConfig): void {
+    this._hybrid.configureResponseCache(JSON.stringify(config));
+  }
+
+  /**
+   * Gets hit/miss counters of the response cache.
+   *
+   * @returns Current cache statistics
+   */
+  getResponseCacheStats(): ResponseCacheStats {
+    return JSON.parse(this._hybrid.getResponseCacheStats());
+  }
+
+  /**
+   * Drops cached responses, e.g. after a mutation made them outdated.
+   *
+   * @param method - Full method path to invalidate; omit to clear everything
+   */
+  invalidateResponseCache(method?: string): void {
+    this._hybrid.invalidateResponseCache(method ?? '');
+  }
+
+  /**
+   * Enables single-flight coalescing: identical unary calls issued while
+   * one is already in flight share its response instead of issuing new RPCs.
+   *
+   * @param config - Coalesced methods; `{ methods: {} }` disables coalescing
+   */
+  configureCoalescing(config: CoalescingConfig): void {
+    this._hybrid.configureCoalescing(JSON.stringify(config));
+  }
+
+  /**
+   * Gets call counters and gauges of this channel: calls started, succeeded
+   * and failed by status code, active calls and streams, messages and bytes
+   * in each direction, retries and reconnects, in total and per method.
+   * Counting is always on and costs a few atomic increments per call.
+   *
+   * @example
+   * ```typescript
+   * // Report once a minute, counting from the previous report
+   * setInterval(() => report(channel.getStats(true)), 60_000);
+   * ```
+   *
+   * @param reset - Restart the counters from 0 after reading them; the
+   *   active call and stream gauges are kept
+   * @returns A snapshot of the stats
+   */
+  getStats(reset: boolean = false): ChannelStats {
+    return getChannelStats(this._hybrid, reset);
+  }
+
+  /**
+   * Sets the time span the latency and message size histograms cover.
+   * Drops the values recorded so far.
+   *
+   * @param config - Histogram settings; `{}` restores the 5 minute default
+   */
+  configureHistograms(config: HistogramConfig): void {
+    this._hybrid.configureHistograms(JSON.stringify(config));
+  }
+
+  /**
+   * Gets call duration percentiles of a method over the histogram window,
+   * from call start to final status. Failed calls are included.
+   *
+   * @example
+   * ```typescript
+   * const { percentiles } = channel.getLatencyPercentiles(
+   *   '/helloworld.Greeter/SayHello'
+   * );
+   * console.log(`p99: ${percentiles[99]} ms`);
+   * ```
+   *
+   * @param method - The full method path (e.g. '/package.Service/Method')
+   * @param percentiles - Percentiles between 0 and 100
+   * @returns Durations in milliseconds; all zero if the method made no calls
+   */
+  getLatencyPercentiles(
+    method: string,
+    percentiles: number[] = DEFAULT_PERCENTILES
+  ): PercentileSummary {
+    return getLatencyPercentiles(this._hybrid, method, percentiles);
+  }
+
+  /**
+   * Gets sent and received message size percentiles of a method over the
+   * histogram window.
+   *
+   * @param method - The full method path (e.g. '/package.Service/Method')
+   * @param percentiles - Percentiles between 0 and 100
+   * @returns Sizes in bytes, per direction
+   */
+  getMessageSizePercentiles(
+    method: string,
+    percentiles: number[] = DEFAULT_PERCENTILES
+  ): MessageSizePercentiles {
+    return getMessageSizePercentiles(this._hybrid, method, percentiles);
+  }
+
+  /**
+   * Reports a phase breakdown of every unary call made on this channel once
+   * it settles: queueing, metadata, send, server response, native settle and
+   * JS resolution. While a listener is set, unary calls take a separate
+   * native path (`timedCall`) that drives the RPC through the completion
+   * queue one step at a time so each phase can be timed, instead of the
+   * single batch used otherwise. Status, metadata and response bytes are the
+   * same on both paths, but the extra round trips cost a little latency, so
+   * the numbers describe the timed path rather than the untimed one. Leave
+   * the listener unset in production builds unless you are investigating.
+   *
+   * @example
+   * ```typescript
+   * channel.onCallCompleted((t) => {
+   *   if (t.totalMs > 200) console.warn('slow call', t);
+   * });
+   * ```
+   *
+   * @param listener - Called after each unary call; `undefined` stops reporting
+   */
+  onCallCompleted(listener?: (timing: CallTiming) => void): void {
+    setCallTimingListener(this._hybrid, listener);
+  }
+
+  /**
+   * Gets TLS handshake counters. All channels share one TLS session cache,
+   * so reconnects and new channels to a known server resume the earlier
+   * session instead of doing a full handshake. The counters are process-wide.
+   *
+   * @returns Full versus resumed handshake counts
+   */
+  getTlsSessionStats(): TlsSessionStats {
+    return JSON.parse(this._hybrid.getTlsSessionStats());
+  }
+
+  /**
+   * Configures recycling of inbound message buffers. The pool is shared by
+   * all channels; buffers return to it when they are garbage-collected or
+   * passed to `releaseBuffer()`.
+   *
+   * @param config - Pool settings; `{}` disables pooling
+   */
+  configureBufferPool(config: BufferPoolConfig): void {
+    this._hybrid.configureBufferPool(JSON.stringify(config));
+  }
+
+  /**
+   * Gets hit/miss counters of the buffer pool. The counters are process-wide.
+   *
+   * @returns Current pool statistics
+   */
+  getBufferPoolStats(): BufferPoolStats {
+    return JSON.parse(this._hybrid.getBufferPoolStats());
+  }
+
+  /**
+   * Hands a received message buffer back to the pool without waiting for
+   * garbage collection, e.g. at the end of a custom deserializer that copied
+   * everything it needs. The buffer must not be used afterwards: its memory
+   * may hold the next message. Buffers not allocated by the pool are ignored.
+   *
+   * @example
+   * ```typescript
+   * const deserialize = (buffer: ArrayBuffer) => {
+   *   const message = codec.decode<Quote>('market.Quote', buffer);
+   *   channel.releaseBuffer(buffer);
+   *   return message;
+   * };
+   * ```
+   *
+   * @param buffer - A response or stream message buffer
+   * @returns Whether the memory was recycled
+   */
+  releaseBuffer(buffer: ArrayBuffer): boolean {
+    return this._hybrid.releaseBuffer(buffer);
+  }
+
+  /**
+   * Starts or stops recording native spans: unary calls and streams from
+   * start to status, each stream read and write, completion queue event
+   * dispatch, and gzip and Base64 work. The tracer is process-wide and
+   * keeps the last few thousand spans per native thread; recording costs
+   * well under a microsecond per span.
+   *
+   * @param enabled - Whether to record; enabling drops earlier spans
+   */
+  setTracingEnabled(enabled: boolean): void {
+    this._hybrid.setTracingEnabled(enabled);
+  }
+
+  /**
+   * Writes the recorded spans to a Chrome trace-event JSON file, which
+   * ui.perfetto.dev and chrome://tracing open directly. Timestamps use the
+   * monotonic clock and OS thread IDs, so the spans line up with a system
+   * trace of the app.
+   *
+   * @example
+   * ```typescript
+   * channel.setTracingEnabled(true);
+   * await runScenario();
+   * channel.dumpTrace(`${DocumentDirectoryPath}/grpc-trace.json`);
+   * ```
+   *
+   * @param path - Absolute path of the file to create or overwrite
+   * @returns The number of spans written
+   */
+  dumpTrace(path: string): number {
+    return this._hybrid.dumpTrace(path);
+  }
+
+  /**
+   * Configures the native logger. Logging is process-wide: the settings
+   * apply to all channels. Logging a line only queues it; a native
+   * background thread writes it out, so logging never blocks calls.
+   *
+   * @param config - Logger settings; `{}` restores the defaults
+   */
+  configureLogging(config: LoggingConfig): void {
+    this._hybrid.configureLogging(JSON.stringify(config));
+  }
+
+  /**
+   * Forwards native log entries at or above the configured level to JS,
+   * e.g. to ship them with the app's own logs. Entries arrive
+   * asynchronously and in order. There is one handler per process; setting
+   * a new one replaces the previous one.
+   *
+   * @example
+   * ```typescript
+   * channel.onNativeLog((entry) => {
+   *   if (entry.level === 'error') crashReporter.log(entry.message);
+   * });
+   * ```
+   *
+   * @param handler - Called for each entry; `undefined` stops forwarding
+   */
+  onNativeLog(handler?: (entry: LogEntry) => void): void {
+    if (!handler) {
+      this._hybrid.clearLogHandler();
+      return;
+    }
+    this._hybrid.setLogHandler((level, tag, message, timestampMs) =>
+      handler({
+        level: level as LogLevel,
+        tag,
+        message,
+        timestamp: timestampMs,
+      })
+    );
+  }
+
+  /**
+   * Gets the channel arguments in effect: the preset's values merged with
+   * the explicitly given options. Boolean arguments are reported as 0/1.
+   *
+   * @returns Argument name to value
+   */
+  getEffectiveOptions(): Record<string, number | string> {
+    return JSON.parse(this._hybrid.getEffectiveChannelOptions());
+  }
+
+  /**
+   * Registers a method with the channel. Calls made with the returned handle
+   * skip per-call method setup in gRPC core and apply `defaults` natively.
+   * Registering the same path again updates its defaults and returns the
+   * same handle. Handles survive reconnects but are only valid for clients
+   * of this channel.
+   *
+   * @param path - Full method path (e.g., "/package.Service/Method")
+   * @param type - Call type the handle will be used for
+   * @param defaults - Defaults applied to every call through the handle
+   * @returns Handle to pass to GrpcClient calls instead of the path
+   *
+   * @example
+   * ```typescript
+   * const getUser = channel.registerMethod('/users.Users/Get', 'unary', {
+   *   timeoutMs: 2000,
+   * });
+   * const user = await client.unaryCall(getUser, request);
+   * ```
+   */
+  registerMethod(
+    path: string,
+    type: MethodType,
+    defaults: MethodDefaults = {}
+  ): MethodHandle {
+    const id = this._hybrid.registerMethod(
+      path,
+      type,
+      JSON.stringify(defaults)
+    );
+    return { id, path, type };
+  }
+
   /**
    * Closes the channel and releases all resources.
    * After calling close(), the channel cannot be reused.
@@ -12,7 +12,8 @@ import {
   clientStreamSync,
   bidiStreamSync,
 } from '../calls/streaming';
-import type { MethodDefinition } from '../types/method';
+import type { MethodDefinition, MethodHandle } from '../types/method';
+import { ChannelCredentials } from '../types/credentials';
 import type {
   SyncServerStreamImpl,
   SyncClientStreamImpl,
@@ -88,13 +89,17 @@ export class GrpcClient {
         'Cannot call connect() on a client created from a channel. Channel is already connected.'
       );
     }
-    this._hybrid.connect(host, isInsecure ? 'insecure' : 'ssl', '{}');
+    const credentials = isInsecure
+      ? ChannelCredentials.createInsecure()
+      : ChannelCredentials.createSsl();
+    this._hybrid.connect(host, ChannelCredentials.toJSON(credentials), '{}');
   }
 
   /**
    * Makes a unary call (single request, single response).
    *
-   * @param method - Full method name (e.g., "/package.Service/Method")
+   * @param method - Full method name (e.g., "/package.Service/Method"),
+   *   method definition, or handle from `GrpcChannel.registerMethod()`
    * @param request - Request message (Uint8Array or serializable object)
    * @param options - Optional call configuration
    * @returns Promise resolving to the response message
@@ -109,7 +114,7 @@ export class GrpcClient {
    * ```
    */
   public async unaryCall<Req, Res>(
-    method: string | MethodDefinition<Req, Res>,
+    method: string | MethodDefinition<Req, Res> | MethodHandle,
     request: Req,
     options?: GrpcCallOptions
   ): Promise<Res> {
@@ -159,7 +164,7 @@ export class GrpcClient {
    * ```
    */
   public serverStream<Req, Res>(
-    method: string,
+    method: string | MethodHandle,
     request: Req,
     options?: GrpcCallOptions
   ): ServerStream<Res> {
@@ -188,7 +193,7 @@ export class GrpcClient {
    * ```
    */
   public clientStream<Req, Res>(
-    method: string,
+    method: string | MethodHandle,
     options?: GrpcCallOptions
   ): ClientStream<Req, Res> {
     return clientStream(this._hybrid, method, options);
@@ -216,7 +221,7 @@ export class GrpcClient {
    * ```
    */
   public bidiStream<Req, Res>(
-    method: string,
+    method: string | MethodHandle,
     options?: GrpcCallOptions
   ): BidiStream<Req, Res> {
     return bidiStream(this._hybrid, method, options);
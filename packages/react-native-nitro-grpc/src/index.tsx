@@ -5,7 +5,9 @@ export type { GrpcCallOptions } from './types/call-options';
 export {
   ChannelState,
   type ChannelOptions,
+  type ChannelOptionsPreset,
   type StatusObject,
+  type TlsSessionStats,
 } from './types/channel-types';
 export {
   CallCredentials,
@@ -15,9 +17,31 @@ export {
   type InsecureCredentials,
   type SslCredentials,
 } from './types/credentials';
+export type { BufferPoolConfig, BufferPoolStats } from './types/buffer-pool';
+export type { CallTiming } from './types/call-timing';
+export type {
+  ChannelStats,
+  HistogramConfig,
+  MessageSizePercentiles,
+  MethodStats,
+  PercentileSummary,
+} from './types/channel-stats';
 export { GrpcError } from './types/grpc-error';
+export type { LogEntry, LogLevel, LoggingConfig } from './types/logging';
+export type {
+  CoalescingConfig,
+  ResponseCacheConfig,
+  ResponseCachePolicy,
+  ResponseCacheStats,
+} from './types/response-cache';
 export { GrpcStatus } from './types/grpc-status';
 export { GrpcMetadata } from './types/metadata';
+export type {
+  MethodDefaults,
+  MethodDefinition,
+  MethodHandle,
+  MethodType,
+} from './types/method';
 
 // Stream type exports
 export type { BidiStream, ClientStream, ServerStream } from './types/stream';
@@ -28,7 +52,9 @@ export type { Metadata, MetadataValue } from './types/metadata';
 // Utility functions
 export * from './streams';
 export * from './utils/base64';
+export * from './utils/checksum';
 export * from './utils/gzip';
+export * from './utils/protobuf';
 export * from './utils/sha256';
 export * from './utils/uuid';
 
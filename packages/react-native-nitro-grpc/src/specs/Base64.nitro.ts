@@ -2,5 +2,27 @@ import type { HybridObject } from 'react-native-nitro-modules';
 
 export interface Base64 extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   encode(data: ArrayBuffer, urlSafe: boolean): string;
-  decode(base64: string): ArrayBuffer;
+  decode(base64: string, urlSafe: boolean): ArrayBuffer;
+
+  /**
+   * Decodes directly into a caller-owned buffer without allocating.
+   * @param base64 The Base64 string to decode.
+   * @param target The destination buffer.
+   * @param offset Byte offset into `target` where decoding starts.
+   * @param length Number of bytes available in `target` from `offset`.
+   * @param urlSafe Whether `base64` uses the URL-safe alphabet.
+   * @returns The number of bytes written.
+   */
+  decodeInto(
+    base64: string,
+    target: ArrayBuffer,
+    offset: number,
+    length: number,
+    urlSafe: boolean
+  ): number;
+
+  /**
+   * Returns the exact number of bytes `base64` decodes to.
+   */
+  decodedLength(base64: string): number;
 }
@@ -0,0 +1,27 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Read-only view of the initial or trailing metadata of a call. The headers
+ * stay in native memory; nothing is copied to JS until it is read.
+ *
+ * Values of `-bin` keys are returned base64-encoded.
+ */
+export interface CallMetadata
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * Number of key-value pairs.
+   */
+  readonly size: number;
+
+  /**
+   * All values for a key, in the order they were received.
+   * @param key Metadata key (case-insensitive)
+   */
+  get(key: string): string[];
+
+  /**
+   * All metadata as a JSON object mapping each key to its values, the format
+   * `GrpcMetadata.fromJSON` accepts.
+   */
+  toJson(): string;
+}
@@ -0,0 +1,47 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+import type { ChecksumHasher } from './ChecksumHasher.nitro';
+
+/**
+ * Fast non-cryptographic checksums for cache keys, chunk integrity checks
+ * and deduplication. Use Sha256 when collision resistance matters.
+ */
+export interface Checksum extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * CRC32C (Castagnoli) of `length` bytes of `data` starting at `offset`.
+   * @returns The CRC as an unsigned 32-bit integer.
+   */
+  crc32c(data: ArrayBuffer, offset: number, length: number): number;
+
+  /**
+   * CRC32C of the UTF-8 bytes of a string.
+   */
+  crc32cString(data: string): number;
+
+  /**
+   * XXH3 64-bit hash of `length` bytes of `data` starting at `offset`.
+   * @returns The hash as a 16-character hex string.
+   */
+  xxh3(data: ArrayBuffer, offset: number, length: number): string;
+
+  /**
+   * XXH3 64-bit hash of the UTF-8 bytes of a string.
+   */
+  xxh3String(data: string): string;
+
+  /**
+   * XXH3 128-bit hash of `length` bytes of `data` starting at `offset`.
+   * @returns The hash as a 32-character hex string.
+   */
+  xxh128(data: ArrayBuffer, offset: number, length: number): string;
+
+  /**
+   * XXH3 128-bit hash of the UTF-8 bytes of a string.
+   */
+  xxh128String(data: string): string;
+
+  /**
+   * Creates a streaming hasher.
+   * @param algorithm One of `crc32c`, `xxh3` or `xxh128`.
+   */
+  createHasher(algorithm: string): ChecksumHasher;
+}
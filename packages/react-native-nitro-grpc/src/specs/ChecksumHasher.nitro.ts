@@ -0,0 +1,37 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+export interface ChecksumHasher
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * Name of the algorithm this hasher was created for.
+   */
+  readonly algorithm: string;
+
+  /**
+   * Absorbs `length` bytes of `data` starting at `offset`.
+   * The buffer is read in place; nothing is copied.
+   */
+  update(data: ArrayBuffer, offset: number, length: number): void;
+
+  /**
+   * Absorbs the UTF-8 bytes of a string.
+   */
+  updateString(data: string): void;
+
+  /**
+   * Finishes the checksum and resets the hasher for reuse.
+   * @returns The checksum as a big-endian hex string.
+   */
+  digest(): string;
+
+  /**
+   * Finishes the checksum and resets the hasher for reuse.
+   * @returns The checksum as big-endian bytes (4, 8 or 16 bytes).
+   */
+  digestBytes(): ArrayBuffer;
+
+  /**
+   * Discards all absorbed input.
+   */
+  reset(): void;
+}
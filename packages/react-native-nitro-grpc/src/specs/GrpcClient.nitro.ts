@@ -1,4 +1,5 @@
 import { type HybridObject } from 'react-native-nitro-modules';
+import type { CallMetadata } from './CallMetadata.nitro';
 import type { GrpcStream } from './GrpcStream.nitro';
 
 export interface GrpcClient
@@ -21,6 +22,39 @@ export interface GrpcClient
     callCredentialsJson: string
   ): void;
 
+  /**
+   * Builds channel (and optional call) credentials once per configuration.
+   * Registering an identical configuration again returns the same handle
+   * without re-parsing it. The handle returned last stays valid for
+   * connectWithCredentials on this client for as long as the client lives.
+   * @param credentialsJson JSON-serialized channel credentials
+   * @param callCredentialsJson JSON-serialized call credentials, or "" for none
+   * @returns Handle for connectWithCredentials
+   */
+  registerCredentials(
+    credentialsJson: string,
+    callCredentialsJson: string
+  ): string;
+
+  /**
+   * Connects using credentials from registerCredentials.
+   * @param target The server host URL (e.g. "localhost:50051")
+   * @param credentialsHandle Handle returned by registerCredentials
+   * @param optionsJson JSON-serialized channel options
+   */
+  connectWithCredentials(
+    target: string,
+    credentialsHandle: string,
+    optionsJson: string
+  ): void;
+
+  /**
+   * Gets the channel arguments in effect, after applying the preset and
+   * explicit options of the last connect.
+   * @returns JSON object of argument name to value
+   */
+  getEffectiveChannelOptions(): string;
+
   /**
    * Closes the channel and releases resources.
    */
@@ -41,6 +75,18 @@ export interface GrpcClient
    */
   watchConnectivityState(lastState: number, deadlineMs: number): Promise<void>;
 
+  /**
+   * Registers a method with the channel so calls can refer to it by handle.
+   * The path is interned by gRPC core once instead of on every call.
+   * Registering a path again updates its defaults and returns the same handle.
+   * Handles stay valid across reconnects.
+   * @param path The method name (e.g. "/MyService/MyMethod")
+   * @param type "unary" | "server_streaming" | "client_streaming" | "bidi_streaming"
+   * @param defaultsJson JSON-serialized MethodDefaults ("{}" for none)
+   * @returns The method handle
+   */
+  registerMethod(path: string, type: string, defaultsJson: string): number;
+
   /**
    * Makes a unary call.
    * @param method The method name (e.g. "/MyService/MyMethod")
@@ -57,11 +103,176 @@ export interface GrpcClient
     callId: string
   ): Promise<ArrayBuffer>;
 
+  /**
+   * Makes a unary call to a method from registerMethod.
+   * @param handle The method handle
+   * @param request The serialized request message
+   * @param metadataJson JSON-serialized metadata
+   * @param deadlineMs Absolute deadline in epoch ms (0 = method's default timeout)
+   * @returns A promise that resolves to the serialized response message
+   */
+  unaryCallWithHandle(
+    handle: number,
+    request: ArrayBuffer,
+    metadataJson: string,
+    deadlineMs: number,
+    callId: string
+  ): Promise<ArrayBuffer>;
+
   /**
    * Cancels a specific call.
    * @param callId The unique ID of the call to cancel
    */
   cancelCall(callId: string): void;
+
+  /**
+   * Turns per-call phase timing of unary calls on or off. While off, calls
+   * record nothing. Turning it off drops timings that were not taken.
+   * @param enabled Whether to record timings
+   */
+  setCallTimingEnabled(enabled: boolean): void;
+
+  /**
+   * Takes the native phase timing of a completed unary call.
+   * Timings are kept for the most recent calls only, so take it right after
+   * the call settles.
+   * @param callId The ID the call was made with
+   * @returns JSON-serialized native phase durations, or "" if none were recorded
+   */
+  takeCallTiming(callId: string): string;
+
+  /**
+   * Takes the server's headers and trailers of a finished unary call, on
+   * success or error. Only the most recent calls are kept, so take them right
+   * after the call settles. Nothing is serialized until the views are read.
+   * Calls served from the response cache or coalesced into another call have
+   * none.
+   * @param callId The ID the call was made with
+   * @returns [initial metadata, trailing metadata], or [] if none were kept
+   */
+  takeCallMetadata(callId: string): CallMetadata[];
+
+  /**
+   * Gets call counters and gauges of this channel, in total and per method.
+   * @param reset Whether to restart the counters from 0 after reading them
+   * @returns JSON-serialized stats
+   */
+  getStats(reset: boolean): string;
+
+  /**
+   * Sets the time span the latency and message size histograms cover.
+   * Drops the values recorded so far.
+   * @param configJson JSON-serialized HistogramConfig
+   */
+  configureHistograms(configJson: string): void;
+
+  /**
+   * Gets call duration percentiles of a method within the histogram window.
+   * @param method The full method path (e.g. "/package.Service/Method")
+   * @param percentiles The percentiles to compute, between 0 and 100
+   * @returns JSON-serialized count, max and values in milliseconds
+   */
+  getLatencyPercentiles(method: string, percentiles: number[]): string;
+
+  /**
+   * Gets sent and received message size percentiles of a method within the
+   * histogram window.
+   * @param method The full method path (e.g. "/package.Service/Method")
+   * @param percentiles The percentiles to compute, between 0 and 100
+   * @returns JSON-serialized count, max and values in bytes, per direction
+   */
+  getMessageSizePercentiles(method: string, percentiles: number[]): string;
+
+  /**
+   * Configures the native response cache for idempotent unary methods.
+   * Replaces any previous configuration and drops cached responses.
+   * @param configJson JSON-serialized ResponseCacheConfig ("{}" disables caching)
+   */
+  configureResponseCache(configJson: string): void;
+
+  /**
+   * Gets response cache counters.
+   * @returns JSON-serialized ResponseCacheStats
+   */
+  getResponseCacheStats(): string;
+
+  /**
+   * Drops cached responses.
+   * @param method The method to invalidate, or "" for all methods
+   */
+  invalidateResponseCache(method: string): void;
+
+  /**
+   * Configures single-flight coalescing of identical in-flight unary calls.
+   * @param configJson JSON-serialized CoalescingConfig ("{}" disables coalescing)
+   */
+  configureCoalescing(configJson: string): void;
+
+  /**
+   * Gets TLS handshake counters of the process-wide session cache.
+   * @returns JSON-serialized TlsSessionStats
+   */
+  getTlsSessionStats(): string;
+
+  /**
+   * Configures the process-wide pool of inbound message buffers.
+   * @param configJson JSON-serialized BufferPoolConfig ("{}" disables pooling)
+   */
+  configureBufferPool(configJson: string): void;
+
+  /**
+   * Gets buffer pool counters.
+   * @returns JSON-serialized BufferPoolStats
+   */
+  getBufferPoolStats(): string;
+
+  /**
+   * Returns a received message buffer to the pool ahead of garbage collection.
+   * @param buffer A response or stream message buffer that is no longer used
+   * @returns Whether the buffer's memory was recycled
+   */
+  releaseBuffer(buffer: ArrayBuffer): boolean;
+
+  /**
+   * Starts or stops the process-wide native tracer. Starting drops the spans
+   * recorded before.
+   * @param enabled Whether to record spans
+   */
+  setTracingEnabled(enabled: boolean): void;
+
+  /**
+   * Writes the recorded spans to a file in the Chrome trace-event format.
+   * @param path Absolute path of the file to create or overwrite
+   * @returns The number of spans written
+   */
+  dumpTrace(path: string): number;
+
+  /**
+   * Configures the process-wide native logger.
+   * @param configJson JSON-serialized LoggingConfig
+   */
+  configureLogging(configJson: string): void;
+
+  /**
+   * Receives every native log entry at or above the configured level.
+   * Called asynchronously, in the order the entries were logged.
+   * @param handler Called with the level name, tag, message and time (Unix
+   *   epoch milliseconds) of each entry
+   */
+  setLogHandler(
+    handler: (
+      level: string,
+      tag: string,
+      message: string,
+      timestampMs: number
+    ) => void
+  ): void;
+
+  /**
+   * Stops sending native log entries to the handler.
+   */
+  clearLogHandler(): void;
+
   unaryCallSync(
     method: string,
     request: ArrayBuffer,
@@ -110,6 +321,47 @@ export interface GrpcClient
     deadlineMs: number
   ): GrpcStream;
 
+  /**
+   * Creates a server streaming call to a method from registerMethod.
+   * @param handle The method handle
+   * @param request The serialized request message
+   * @param metadataJson JSON-serialized metadata
+   * @param deadlineMs Absolute deadline in epoch ms (0 = method's default timeout)
+   * @returns A stream for receiving responses
+   */
+  createServerStreamWithHandle(
+    handle: number,
+    request: ArrayBuffer,
+    metadataJson: string,
+    deadlineMs: number
+  ): GrpcStream;
+
+  /**
+   * Creates a client streaming call to a method from registerMethod.
+   * @param handle The method handle
+   * @param metadataJson JSON-serialized metadata
+   * @param deadlineMs Absolute deadline in epoch ms (0 = method's default timeout)
+   * @returns A stream for sending requests
+   */
+  createClientStreamWithHandle(
+    handle: number,
+    metadataJson: string,
+    deadlineMs: number
+  ): GrpcStream;
+
+  /**
+   * Creates a bidirectional streaming call to a method from registerMethod.
+   * @param handle The method handle
+   * @param metadataJson JSON-serialized metadata
+   * @param deadlineMs Absolute deadline in epoch ms (0 = method's default timeout)
+   * @returns A stream for sending and receiving messages
+   */
+  createBidiStreamWithHandle(
+    handle: number,
+    metadataJson: string,
+    deadlineMs: number
+  ): GrpcStream;
+
   // Synchronous (blocking) stream creation methods
 
   /**
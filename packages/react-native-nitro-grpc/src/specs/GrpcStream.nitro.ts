@@ -1,4 +1,5 @@
 import { type HybridObject } from 'react-native-nitro-modules';
+import type { CallMetadata } from './CallMetadata.nitro';
 
 export interface GrpcStream
   extends HybridObject<{
@@ -23,17 +24,19 @@ export interface GrpcStream
   onData(callback: (data: ArrayBuffer) => void): void;
 
   /**
-   * Sets a callback to be called when metadata is received.
-   * @param callback The callback function receiving JSON-serialized metadata
+   * Sets a callback to be called when the server's initial metadata is
+   * received, before the first message. Must be registered before `onData`
+   * and `onStatus`, otherwise the headers are skipped.
+   * @param callback The callback function receiving the headers
    */
-  onMetadata(callback: (metadataJson: string) => void): void;
+  onMetadata(callback: (metadata: CallMetadata) => void): void;
 
   /**
    * Sets a callback to be called when the stream completes with a status.
-   * @param callback The callback function
+   * @param callback The callback function receiving the status and trailers
    */
   onStatus(
-    callback: (code: number, message: string, metadataJson: string) => void
+    callback: (code: number, message: string, trailers: CallMetadata) => void
   ): void;
 
   /**
@@ -0,0 +1,52 @@
+import type { AnyMap, HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Read-only view of a serialized protobuf message. Field offsets are indexed
+ * on first access and only the fields that are read get decoded.
+ */
+export interface LazyMessage
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * Fully qualified message type name.
+   */
+  readonly typeName: string;
+
+  /**
+   * Size of the serialized message in bytes.
+   */
+  readonly byteLength: number;
+
+  /**
+   * Whether the field is present on the wire.
+   */
+  has(field: string): boolean;
+
+  /**
+   * Number of elements of a repeated field, entries of a map field, or
+   * 0/1 for a singular field.
+   */
+  count(field: string): number;
+
+  /**
+   * Decodes only the given fields. Absent fields are left out.
+   */
+  pick(fields: string[]): AnyMap;
+
+  /**
+   * Decodes elements `[start, end)` of a repeated field, returned under the
+   * field's name. Indices are clamped to the field's element count.
+   */
+  slice(field: string, start: number, end: number): AnyMap;
+
+  /**
+   * A view of a message field, or of element `index` of a repeated message
+   * field, over the same buffer.
+   * @returns `undefined` if the field or element is absent.
+   */
+  getMessage(field: string, index: number): LazyMessage | undefined;
+
+  /**
+   * Decodes the whole message.
+   */
+  decode(): AnyMap;
+}
@@ -0,0 +1,48 @@
+import type { AnyMap, HybridObject } from 'react-native-nitro-modules';
+import type { LazyMessage } from './LazyMessage.nitro';
+
+/**
+ * Schema-driven protobuf encoder/decoder. Messages are converted natively
+ * between wire bytes and plain JS objects using the proto3 JSON mapping.
+ */
+export interface ProtobufCodec
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * Loads the message types of a serialized `google.protobuf.FileDescriptorSet`
+   * (e.g. from `protoc --include_imports --descriptor_set_out`).
+   * Types from earlier loads stay available.
+   */
+  loadDescriptorSet(descriptorSet: ArrayBuffer): void;
+
+  /**
+   * Whether a message type has been loaded.
+   * @param typeName Fully qualified name, e.g. `helloworld.HelloRequest`.
+   */
+  hasMessageType(typeName: string): boolean;
+
+  /**
+   * Encodes a message to wire bytes.
+   */
+  encode(typeName: string, message: AnyMap): ArrayBuffer;
+
+  /**
+   * Decodes `length` bytes of `data` starting at `offset`.
+   */
+  decode(
+    typeName: string,
+    data: ArrayBuffer,
+    offset: number,
+    length: number
+  ): AnyMap;
+
+  /**
+   * Creates a lazy view of `length` bytes of `data` starting at `offset`.
+   * The buffer is referenced, not copied.
+   */
+  decodeLazy(
+    typeName: string,
+    data: ArrayBuffer,
+    offset: number,
+    length: number
+  ): LazyMessage;
+}
@@ -14,4 +14,32 @@ export interface Sha256 extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
    * @returns The SHA256 hash as a hex string.
    */
   hashBytes(data: ArrayBuffer): string;
+
+  /**
+   * Computes the SHA256 hash of a file without loading it into JS.
+   * The file is memory-mapped and hashed on a background thread.
+   * @param path Absolute file path or `file://` URI.
+   * @returns The SHA256 hash as a hex string.
+   */
+  hashFile(path: string): Promise<string>;
+
+  /**
+   * Same as `hashFile`, but resolves with the raw 32-byte digest.
+   * @param path Absolute file path or `file://` URI.
+   */
+  hashFileBytes(path: string): Promise<ArrayBuffer>;
+
+  /**
+   * Hashes several files in parallel on a native worker pool.
+   * Rejects if any file cannot be read.
+   * @param paths Absolute file paths or `file://` URIs.
+   * @returns Hex digests in the same order as `paths`.
+   */
+  hashFiles(paths: string[]): Promise<string[]>;
+
+  /**
+   * Same as `hashFiles`, but resolves with raw 32-byte digests.
+   * @param paths Absolute file paths or `file://` URIs.
+   */
+  hashFilesBytes(paths: string[]): Promise<ArrayBuffer[]>;
 }
@@ -0,0 +1,33 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+export interface Sha256Hasher
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * Absorbs a chunk of bytes.
+   * @param data The next chunk of input.
+   */
+  update(data: ArrayBuffer): void;
+
+  /**
+   * Absorbs the UTF-8 bytes of a string.
+   * @param data The next chunk of input.
+   */
+  updateString(data: string): void;
+
+  /**
+   * Finishes the hash and resets the hasher for reuse.
+   * @returns The SHA256 hash as a hex string.
+   */
+  digest(): string;
+
+  /**
+   * Finishes the hash and resets the hasher for reuse.
+   * @returns The raw 32-byte SHA256 digest.
+   */
+  digestBytes(): ArrayBuffer;
+
+  /**
+   * Discards all absorbed input.
+   */
+  reset(): void;
+}
@@ -1,17 +1,28 @@
 import { BidiStreamImpl, ClientStreamImpl, ServerStreamImpl } from '..';
+import type { CallMetadata } from '../../specs/CallMetadata.nitro';
 import type { GrpcStream } from '../../specs/GrpcStream.nitro';
 import { GrpcStatus } from '../../types/grpc-status';
 import { GrpcMetadata } from '../../types/metadata';
 
+// Stand-in for the native metadata view; toJson is spied on to check laziness
+function mockCallMetadata(metadata?: GrpcMetadata) {
+  const json = metadata ? metadata.toJSON() : {};
+  return {
+    size: Object.values(json).reduce((n, values) => n + values.length, 0),
+    get: jest.fn((key: string) => json[key.toLowerCase()] ?? []),
+    toJson: jest.fn(() => JSON.stringify(json)),
+  } as unknown as CallMetadata & { toJson: jest.Mock };
+}
+
 // Mock implementation of HybridGrpcStream
 class MockHybridStream implements GrpcStream {
   // Callbacks
   private _onData?: (data: ArrayBuffer) => void;
-  private _onMetadata?: (metadataJson: string) => void;
+  private _onMetadata?: (metadata: CallMetadata) => void;
   private _onStatus?: (
     code: number,
     message: string,
-    metadataJson: string
+    trailers: CallMetadata
   ) => void;
   private _onError?: (error: string) => void;
 
@@ -37,12 +48,15 @@ class MockHybridStream implements GrpcStream {
   }
 
   simulateMetadata(metadata: GrpcMetadata) {
-    this._onMetadata?.(JSON.stringify(metadata.toJSON()));
+    const native = mockCallMetadata(metadata);
+    this._onMetadata?.(native);
+    return native;
   }
 
   simulateStatus(code: number, message: string, metadata?: GrpcMetadata) {
-    const mdJson = metadata ? JSON.stringify(metadata.toJSON()) : '{}';
-    this._onStatus?.(code, message, mdJson);
+    const native = mockCallMetadata(metadata);
+    this._onStatus?.(code, message, native);
+    return native;
   }
 
   simulateError(error: string) {
@@ -62,12 +76,12 @@ class MockHybridStream implements GrpcStream {
     this._onData = callback;
   }
 
-  onMetadata(callback: (metadataJson: string) => void): void {
+  onMetadata(callback: (metadata: CallMetadata) => void): void {
     this._onMetadata = callback;
   }
 
   onStatus(
-    callback: (code: number, message: string, metadataJson: string) => void
+    callback: (code: number, message: string, trailers: CallMetadata) => void
   ): void {
     this._onStatus = callback;
   }
@@ -149,6 +163,30 @@ describe('StreamImplementations', () => {
       expect(receivedMd.get('key')).toBe('value');
     });
 
+    it('does not read metadata without listeners', () => {
+      const native = mockHybrid.simulateMetadata(
+        new GrpcMetadata({ key: 'value' })
+      );
+      expect(native.toJson).not.toHaveBeenCalled();
+    });
+
+    it('reads trailers only when accessed', () => {
+      const statusSpy = jest.fn();
+      stream.on('status', statusSpy);
+
+      const native = mockHybrid.simulateStatus(
+        GrpcStatus.OK,
+        'OK',
+        new GrpcMetadata({ 'x-trailer': 'done' })
+      );
+
+      expect(native.toJson).not.toHaveBeenCalled();
+      const status = statusSpy.mock.calls[0][0];
+      expect(status.metadata.get('x-trailer')).toBe('done');
+      expect(status.metadata).toBe(status.metadata);
+      expect(native.toJson).toHaveBeenCalledTimes(1);
+    });
+
     it('emits status and end on OK', () => {
       const statusSpy = jest.fn();
       const endSpy = jest.fn();
@@ -177,6 +215,22 @@ describe('StreamImplementations', () => {
       expect(error.message).toContain('Internal Error');
     });
 
+    it('exposes trailers on the error', () => {
+      const errorSpy = jest.fn();
+      stream.on('error', errorSpy);
+
+      mockHybrid.simulateStatus(
+        GrpcStatus.PERMISSION_DENIED,
+        'Denied',
+        new GrpcMetadata({ 'x-reason': 'quota' })
+      );
+
+      const error = errorSpy.mock.calls[0][0];
+      expect(error.cause).toBeUndefined();
+      expect(error.details).toBe('Denied');
+      expect(error.metadata.get('x-reason')).toBe('quota');
+    });
+
     it('propagates cancellation', () => {
       stream.cancel();
       expect(mockHybrid.isCancelled).toBe(true);
@@ -0,0 +1,114 @@
+import type { CallMetadata } from '../specs/CallMetadata.nitro';
+import type { GrpcCallOptions } from '../types/call-options';
+import type { StatusObject } from '../types/channel-types';
+import { GrpcError } from '../types/grpc-error';
+import { GrpcStatus } from '../types/grpc-status';
+import { GrpcMetadata } from '../types/metadata';
+
+/**
+ * Returns a getter that converts the native trailers on first use and then
+ * returns the same instance.
+ */
+function lazyMetadata(native: CallMetadata): () => GrpcMetadata {
+  let metadata: GrpcMetadata | undefined;
+  return () => {
+    if (metadata === undefined) {
+      metadata = GrpcMetadata.fromCallMetadata(native);
+    }
+    return metadata;
+  };
+}
+
+function defineMetadata<T extends object>(
+  target: T,
+  getMetadata: () => GrpcMetadata
+): T {
+  return Object.defineProperty(target, 'metadata', {
+    get: getMetadata,
+    configurable: true,
+    enumerable: true,
+  });
+}
+
+/**
+ * Builds the status and, for non-OK codes, the matching error of a finished
+ * stream. Both expose the trailers as `metadata`, which is only copied out of
+ * native memory when first read.
+ * @internal
+ */
+export function createStreamStatus(
+  code: number,
+  details: string,
+  trailers: CallMetadata
+): { status: StatusObject; error?: GrpcError } {
+  const getMetadata = lazyMetadata(trailers);
+  const status = defineMetadata({ code, details } as StatusObject, getMetadata);
+  if (code === GrpcStatus.OK) {
+    return { status };
+  }
+  const error = defineMetadata(
+    new GrpcError(code as GrpcStatus, details, undefined, details),
+    getMetadata
+  );
+  return { status, error };
+}
+
+// How the native client formats the status of a failed unary call
+const NATIVE_CALL_ERROR = /^gRPC Error \[(\d+)\]: ([\s\S]*)$/;
+
+/**
+ * Hands the headers and status of a successful unary call to the callbacks
+ * in `options`. `metadata` is what takeCallMetadata returned.
+ * @internal
+ */
+export function reportUnaryMetadata(
+  metadata: CallMetadata[],
+  options: GrpcCallOptions | undefined
+): void {
+  const [headers, trailers] = metadata;
+  if (headers === undefined || trailers === undefined) return;
+  if (options?.onMetadata) {
+    options.onMetadata(GrpcMetadata.fromCallMetadata(headers));
+  }
+  if (options?.onStatus) {
+    options.onStatus(createStreamStatus(GrpcStatus.OK, '', trailers).status);
+  }
+}
+
+/**
+ * Converts the rejection of a native unary call into a GrpcError that
+ * exposes the call's trailers as `metadata`, read on first access, and hands
+ * the headers and status to the callbacks in `options`. Errors that did not
+ * come from a finished call (a closed channel, an unknown handle) are
+ * returned unchanged.
+ * @internal
+ * @param takeMetadata Takes the call's [headers, trailers] from native
+ */
+export function createUnaryError(
+  error: unknown,
+  takeMetadata: () => CallMetadata[],
+  options: GrpcCallOptions | undefined
+): unknown {
+  const match =
+    error instanceof Error ? NATIVE_CALL_ERROR.exec(error.message) : null;
+  if (match === null) return error;
+  const code = Number(match[1]);
+  const details = match[2] ?? '';
+
+  const [headers, trailers] = takeMetadata();
+  if (trailers === undefined) {
+    return new GrpcError(code as GrpcStatus, details, undefined, details);
+  }
+  if (headers !== undefined && options?.onMetadata) {
+    options.onMetadata(GrpcMetadata.fromCallMetadata(headers));
+  }
+  const { status, error: grpcError } = createStreamStatus(
+    code,
+    details,
+    trailers
+  );
+  if (options?.onStatus) {
+    options.onStatus(status);
+  }
+  return grpcError;
+}
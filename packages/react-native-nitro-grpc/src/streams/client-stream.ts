@@ -1,10 +1,11 @@
+import type { CallMetadata } from '../specs/CallMetadata.nitro';
 import type { GrpcStream as HybridGrpcStream } from '../specs/GrpcStream.nitro';
-import type { StatusObject } from '../types/channel-types';
 import { GrpcError } from '../types/grpc-error';
 import { GrpcStatus } from '../types/grpc-status';
 import { GrpcMetadata } from '../types/metadata';
 import { ClientStream } from '../types/stream';
 import { serializeMessage, deserializeMessage } from '../utils/serialization';
+import { createStreamStatus } from './call-metadata';
 
 /**
  * Async client streaming implementation (EventEmitter-based).
@@ -26,35 +27,33 @@ export class ClientStreamImpl<Req, Res> extends ClientStream<Req, Res> {
       this._rejectResponse = reject;
     });
 
-    // Wire up callbacks
-    this._hybrid.onData((data: ArrayBuffer) => {
+    // Must be registered before onData/onStatus, or native skips the headers
+    this._hybrid.onMetadata((native: CallMetadata) => {
+      // Only copy the headers out of native memory if someone is listening
+      if (this.listenerCount('metadata') === 0) return;
       try {
-        const message = deserializeMessage<Res>(data);
-        this._resolveResponse(message);
+        this.emit('metadata', GrpcMetadata.fromCallMetadata(native));
       } catch (error) {
-        this._rejectResponse(this._wrapError(error));
+        console.warn('[ClientStream] Failed to read metadata:', error);
       }
     });
 
-    this._hybrid.onMetadata((metadataJson: string) => {
+    // Wire up callbacks
+    this._hybrid.onData((data: ArrayBuffer) => {
       try {
-        const metadata = GrpcMetadata.fromJSON(JSON.parse(metadataJson));
-        this.emit('metadata', metadata);
+        const message = deserializeMessage<Res>(data);
+        this._resolveResponse(message);
       } catch (error) {
-        console.warn('[ClientStream] Failed to parse metadata:', error);
+        this._rejectResponse(this._wrapError(error));
       }
     });
 
     this._hybrid.onStatus(
-      (code: number, message: string, metadataJson: string) => {
-        const metadata = GrpcMetadata.fromJSON(
-          JSON.parse(metadataJson || '{}')
-        );
-        const status: StatusObject = { code, details: message, metadata };
+      (code: number, message: string, trailers: CallMetadata) => {
+        const { status, error } = createStreamStatus(code, message, trailers);
         this.emit('status', status);
 
-        if (code !== GrpcStatus.OK) {
-          const error = new GrpcError(code as GrpcStatus, message, metadata);
+        if (error) {
           this.emit('error', error);
           this._rejectResponse(error);
         }
@@ -0,0 +1,55 @@
+/**
+ * Configuration of the process-wide pool of inbound message buffers.
+ *
+ * When enabled, response and stream message buffers are carved from
+ * power-of-two size classes and recycled once JS drops them, instead of
+ * allocating fresh memory for every message. Useful for high-rate streams.
+ *
+ * @example
+ * ```typescript
+ * channel.configureBufferPool({
+ *   enabled: true,
+ *   maxRetainedBytes: 8 * 1024 * 1024,
+ * });
+ * ```
+ */
+export interface BufferPoolConfig {
+  /**
+   * Whether inbound buffers are pooled. Defaults to false.
+   */
+  enabled?: boolean;
+
+  /**
+   * Upper bound for the total size of idle buffers kept for reuse, in bytes.
+   * Defaults to 4 MiB.
+   */
+  maxRetainedBytes?: number;
+
+  /**
+   * Messages larger than this are allocated normally and never pooled, in
+   * bytes. Defaults to 1 MiB.
+   */
+  maxBufferSize?: number;
+}
+
+/**
+ * Counters reported by the buffer pool. They are process-wide.
+ */
+export interface BufferPoolStats {
+  /** Messages that reused an idle buffer. */
+  hits: number;
+  /** Messages that needed a new buffer. */
+  misses: number;
+  /** `hits / (hits + misses)`, or 0 before the first pooled message. */
+  hitRate: number;
+  /** Buffers recycled through `releaseBuffer()`. */
+  releases: number;
+  /** Buffers freed because the pool was full or disabled. */
+  discards: number;
+  /** Pooled buffers currently held by JS. */
+  leasedBuffers: number;
+  /** Bytes of idle buffers kept for reuse. */
+  retainedBytes: number;
+  /** Configured retention limit (0 while disabled). */
+  maxRetainedBytes: number;
+}
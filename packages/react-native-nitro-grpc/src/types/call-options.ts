@@ -1,3 +1,4 @@
+import type { StatusObject } from './channel-types';
 import type { GrpcCallCredentials } from './credentials';
 import type { GrpcMetadata } from './metadata';
 
@@ -50,4 +51,20 @@ export interface GrpcCallOptions {
    * Advanced: Typically not needed in most applications.
    */
   propagateFlags?: number;
+
+  /**
+   * Unary calls only: called with the server's initial metadata (response
+   * headers) once the call has finished, before its promise settles.
+   * Not called for responses served from the response cache or shared with
+   * a coalesced call.
+   */
+  onMetadata?: (metadata: GrpcMetadata) => void;
+
+  /**
+   * Unary calls only: called with the final status and trailing metadata
+   * once the call has finished, before its promise settles. Same exceptions
+   * as `onMetadata`. On errors the trailers are also available as
+   * `GrpcError.metadata`.
+   */
+  onStatus?: (status: StatusObject) => void;
 }
@@ -0,0 +1,50 @@
+/**
+ * Where the time of one unary call went, reported to the listener set with
+ * `GrpcChannel.onCallCompleted()`. All durations are in milliseconds.
+ *
+ * The native phases are `null` when the call never reached them (e.g. it
+ * failed before the server answered) or did not make an RPC at all (served
+ * from the response cache or joined a coalesced call).
+ */
+export interface CallTiming {
+  /** Full method path, e.g. `/myservice.MyService/GetUser`. */
+  method: string;
+
+  /** Whether the call resolved. */
+  ok: boolean;
+
+  /** From entering the native call to the promise settling in JS. */
+  totalMs: number;
+
+  /** From entering the native call to a worker thread starting it. */
+  queuedMs: number | null;
+
+  /** Applying metadata, deadline and method defaults. */
+  metadataMs: number | null;
+
+  /** Until the request headers were written to the transport. */
+  firstByteSentMs: number | null;
+
+  /** Until the server's initial metadata arrived. */
+  initialMetadataMs: number | null;
+
+  /** Until the response message and status arrived. */
+  responseMs: number | null;
+
+  /**
+   * Until the native side was about to settle the promise. The last native
+   * timestamp is taken just before resolving or rejecting, so the hand-off
+   * to JS is not part of any native phase.
+   */
+  settleMs: number | null;
+
+  /**
+   * Estimate of the time after the native side settled until the awaiting
+   * JS code resumed: `totalMs` minus the native total, floored at 0.
+   * `totalMs` comes from the JS clock and the native total from the native
+   * monotonic clock, and the two start a few microseconds apart, so small
+   * values are noise. Use it to spot a busy JS thread, not as an exact
+   * measurement.
+   */
+  jsResolutionMs: number | null;
+}
@@ -0,0 +1,79 @@
+import type { GrpcStatus } from './grpc-status';
+
+/**
+ * Call counters and gauges of one method, or of a whole channel.
+ *
+ * Streams count as calls. Calls served from the response cache or joined
+ * to an identical in-flight call make no RPC and are not counted.
+ */
+export interface MethodStats {
+  /** Unary calls and streams started. */
+  callsStarted: number;
+  /** Calls that finished with OK. */
+  callsSucceeded: number;
+  /** Calls that finished with any other status. */
+  callsFailed: number;
+  /** `callsFailed` split by status code; codes that never occurred are absent. */
+  failuresByCode: Partial<Record<GrpcStatus, number>>;
+  /** Unary calls in flight (a gauge, not reset). */
+  activeCalls: number;
+  /** Streams in flight (a gauge, not reset). */
+  activeStreams: number;
+  /** Request messages sent. */
+  messagesSent: number;
+  /** Response messages received. */
+  messagesReceived: number;
+  /** Serialized bytes of the messages sent, before compression. */
+  bytesSent: number;
+  /** Serialized bytes of the messages received, after decompression. */
+  bytesReceived: number;
+  /** Unary calls an interceptor issued again, e.g. `RetryInterceptor`. */
+  retries: number;
+}
+
+/**
+ * Stats of a channel, returned by `GrpcChannel.getStats()`.
+ */
+export interface ChannelStats extends MethodStats {
+  /**
+   * Times the channel connected again after having been connected, e.g.
+   * after a network change or an idle timeout.
+   */
+  reconnects: number;
+  /** The same counters per method path. */
+  methods: Record<string, MethodStats>;
+}
+
+/**
+ * Histogram settings, passed to `GrpcChannel.configureHistograms()`.
+ */
+export interface HistogramConfig {
+  /**
+   * The time span the histograms cover, in milliseconds. Older values age
+   * out in quarters of the window. Defaults to 5 minutes.
+   */
+  windowMs?: number;
+}
+
+/**
+ * Percentiles of the values recorded within the histogram window. Values
+ * are kept to within about 3%.
+ */
+export interface PercentileSummary {
+  /** Values recorded within the window. */
+  count: number;
+  /** The largest value within the window. */
+  max: number;
+  /** The value at each requested percentile, keyed by the percentile. */
+  percentiles: Record<number, number>;
+}
+
+/**
+ * Message size percentiles of one method, in serialized bytes.
+ */
+export interface MessageSizePercentiles {
+  /** Request messages, before compression. */
+  sent: PercentileSummary;
+  /** Response messages, after decompression. */
+  received: PercentileSummary;
+}
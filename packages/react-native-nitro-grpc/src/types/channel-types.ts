@@ -51,13 +51,45 @@ export interface StatusObject {
   metadata: GrpcMetadata;
 }
 
+/**
+ * Named sets of channel arguments tuned for a traffic pattern.
+ *
+ * - `low-latency-interactive`: small request/response traffic on mobile
+ *   networks. Keepalive every 5 min, reconnect backoff 250 ms to 5 s, DNS
+ *   re-resolution after 5 s.
+ * - `bulk-transfer`: large messages and long streams. 4 MiB initial stream
+ *   window with BDP probing, 1 MiB write buffer and frames, 64 MiB maximum
+ *   received message, keepalive every 5 min.
+ *
+ * Keepalive stays at 5 minutes because gRPC servers by default answer more
+ * frequent pings with GOAWAY `too_many_pings`. To detect dead connections
+ * sooner, lower `grpc.keepalive_time_ms` only if your server's
+ * `grpc.http2.min_recv_ping_interval_without_data_ms` (or equivalent)
+ * permits it.
+ *
+ * The presets are starting points derived from gRPC's tuning guidance; they
+ * have not been benchmarked. Measure them against your own server and
+ * network, e.g. with `rngrpc_loadgen --preset <name>` (cpp/loadgen), before
+ * relying on them.
+ */
+export type ChannelOptionsPreset = 'low-latency-interactive' | 'bulk-transfer';
+
 /**
  * Channel options for configuring the underlying gRPC channel.
  * These options match the arguments supported by @grpc/grpc-js.
  *
+ * Options are validated natively when the channel is created: a value of the
+ * wrong type or out of range throws instead of being ignored.
+ *
  * @see https://grpc.github.io/grpc/node/grpc.html#~ChannelOptions
  */
 export interface ChannelOptions {
+  /**
+   * Start from a tuned preset. Options given explicitly override the
+   * preset's values.
+   */
+  'preset'?: ChannelOptionsPreset;
+
   /**
    * Override the target name used for SSL host name checking.
    */
@@ -201,6 +233,38 @@ export interface ChannelOptions {
    */
   'grpc.client_idle_timeout_ms'?: number;
 
+  /**
+   * Minimum reconnection backoff in milliseconds.
+   */
+  'grpc.min_reconnect_backoff_ms'?: number;
+
+  /**
+   * Adjust HTTP/2 flow-control windows to the measured bandwidth-delay product.
+   * 0 = false, 1 = true (default)
+   */
+  'grpc.http2.bdp_probe'?: 0 | 1;
+
+  /**
+   * Initial HTTP/2 stream flow-control window in bytes.
+   */
+  'grpc.http2.lookahead_bytes'?: number;
+
+  /**
+   * Bytes the transport may buffer per write.
+   */
+  'grpc.http2.write_buffer_size'?: number;
+
+  /**
+   * Largest HTTP/2 frame accepted, in bytes (16384 to 16777215).
+   */
+  'grpc.http2.max_frame_size'?: number;
+
+  /**
+   * Maximum keepalive pings sent without data frames in between.
+   * 0 = unlimited
+   */
+  'grpc.http2.max_pings_without_data'?: number;
+
   /**
    * Maximum session memory for HTTP/2 in bytes.
    * Node.js specific option.
@@ -243,3 +307,24 @@ export interface ChannelOptions {
    */
   'serviceConfig'?: Record<string, unknown>;
 }
+
+/**
+ * TLS handshake counters of the session cache shared by all channels.
+ * Each connection is counted once.
+ */
+export interface TlsSessionStats {
+  /**
+   * Connections that performed a full TLS handshake.
+   */
+  fullHandshakes: number;
+
+  /**
+   * Connections that resumed a cached TLS session.
+   */
+  resumedHandshakes: number;
+
+  /**
+   * Maximum number of servers with a cached session.
+   */
+  capacity: number;
+}
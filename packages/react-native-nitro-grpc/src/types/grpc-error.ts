@@ -91,7 +91,7 @@ export class GrpcError extends Error {
       }
     }
 
-    return new GrpcError(grpcCode, message, metadata);
+    return new GrpcError(grpcCode, message, undefined, undefined, metadata);
   }
 
   /**
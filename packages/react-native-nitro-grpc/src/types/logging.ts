@@ -0,0 +1,38 @@
+/**
+ * Severity of a native log entry. Verbose entries are only compiled into
+ * debug builds of the native library.
+ */
+export type LogLevel = 'verbose' | 'info' | 'warn' | 'error';
+
+/**
+ * Configuration of the process-wide native logger.
+ *
+ * @example
+ * ```typescript
+ * channel.configureLogging({ level: __DEV__ ? 'verbose' : 'warn' });
+ * ```
+ */
+export interface LoggingConfig {
+  /**
+   * Lowest level that is logged; 'off' disables logging. Defaults to 'info'.
+   */
+  level?: LogLevel | 'off';
+
+  /**
+   * Whether entries also go to the platform log: logcat on Android, the
+   * unified log (os_log) on iOS. Defaults to true.
+   */
+  platform?: boolean;
+}
+
+/**
+ * A native log entry, passed to `GrpcChannel.onNativeLog()` handlers.
+ */
+export interface LogEntry {
+  level: LogLevel;
+  /** The native component that logged, e.g. 'channel' or 'stream'. */
+  tag: string;
+  message: string;
+  /** When the entry was logged, in Unix epoch milliseconds. */
+  timestamp: number;
+}
@@ -1,3 +1,4 @@
+import type { CallMetadata } from '../specs/CallMetadata.nitro';
 import { decodeBase64, encodeBase64, isUint8Array } from '../utils/base64';
 
 /**
@@ -143,6 +144,20 @@ export class GrpcMetadata {
     return metadata;
   }
 
+  /**
+   * Copies headers or trailers received by a native call.
+   *
+   * @internal
+   * @param native - Metadata view returned by the native stream
+   * @returns New GrpcMetadata instance
+   */
+  static fromCallMetadata(native: CallMetadata): GrpcMetadata {
+    if (native.size === 0) {
+      return new GrpcMetadata();
+    }
+    return GrpcMetadata.fromJSON(JSON.parse(native.toJson()));
+  }
+
   /**
    * Gets all keys in the metadata.
    *
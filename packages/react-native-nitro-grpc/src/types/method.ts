@@ -29,3 +29,65 @@ export interface MethodDefinition<Req, Res> {
    */
   responseDeserialize: (bytes: Uint8Array | ArrayBuffer) => Res;
 }
+
+/**
+ * Call type of a registered method.
+ */
+export type MethodType =
+  | 'unary'
+  | 'server_streaming'
+  | 'client_streaming'
+  | 'bidi_streaming';
+
+/**
+ * Per-method call defaults, applied natively to every call made through a
+ * {@link MethodHandle}.
+ */
+export interface MethodDefaults {
+  /**
+   * Timeout in milliseconds used when a call sets no deadline.
+   */
+  timeoutMs?: number;
+
+  /**
+   * Compression algorithm for request messages.
+   */
+  compression?: 'identity' | 'deflate' | 'gzip';
+
+  /**
+   * Wait for the channel to become ready instead of failing fast.
+   */
+  waitForReady?: boolean;
+}
+
+/**
+ * A method registered with a channel via `GrpcChannel.registerMethod()`.
+ * Only valid for clients of the channel that registered it.
+ */
+export interface MethodHandle {
+  /**
+   * Native handle.
+   */
+  readonly id: number;
+
+  /**
+   * The method path (e.g. "/package.Service/Method")
+   */
+  readonly path: string;
+
+  /**
+   * Call type the method was registered for.
+   */
+  readonly type: MethodType;
+}
+
+/**
+ * Checks whether a method argument is a {@link MethodHandle}.
+ */
+export function isMethodHandle(method: unknown): method is MethodHandle {
+  return (
+    typeof method === 'object' &&
+    method !== null &&
+    typeof (method as MethodHandle).id === 'number'
+  );
+}
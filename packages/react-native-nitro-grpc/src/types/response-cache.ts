@@ -0,0 +1,123 @@
+/**
+ * Caching policy for a single unary method.
+ */
+export interface ResponseCachePolicy {
+  /**
+   * How long a response is served from the cache without contacting the
+   * server, in milliseconds.
+   */
+  ttlMs: number;
+
+  /**
+   * Extra time after `ttlMs` during which the cached response is still
+   * returned immediately while one background call refreshes it.
+   * Defaults to 0 (no stale responses).
+   */
+  staleWhileRevalidateMs?: number;
+
+  /**
+   * Metadata keys whose values are part of the cache key, e.g. `['x-locale']`.
+   * Other metadata is ignored when matching requests. `authorization` is
+   * always included unless `varyAuthorization` is false.
+   */
+  varyMetadata?: string[];
+
+  /**
+   * Whether the `authorization` header is part of the cache key, so a
+   * response cached for one user is never returned to another. Defaults to
+   * true. Set it to false only for responses that are identical for every
+   * user.
+   *
+   * Call credentials passed to the channel are not metadata and are not part
+   * of the key. The cache belongs to one channel, so this only matters if that
+   * channel's call credentials change between users.
+   */
+  varyAuthorization?: boolean;
+}
+
+/**
+ * Configuration of the native unary response cache.
+ * Only idempotent methods should be listed; everything else bypasses the cache.
+ *
+ * @example
+ * ```typescript
+ * channel.configureResponseCache({
+ *   maxBytes: 2 * 1024 * 1024,
+ *   methods: {
+ *     '/catalog.Catalog/ListProducts': {
+ *       ttlMs: 30_000,
+ *       staleWhileRevalidateMs: 300_000,
+ *       varyAuthorization: false,
+ *     },
+ *     '/user.Users/GetProfile': { ttlMs: 5_000 },
+ *   },
+ * });
+ * ```
+ */
+export interface ResponseCacheConfig {
+  /**
+   * Upper bound for the total size of cached responses, in bytes.
+   * Least recently used entries are evicted first. Defaults to 4 MiB.
+   */
+  maxBytes?: number;
+
+  /**
+   * Cached methods keyed by full method path ("/package.Service/Method").
+   */
+  methods: Record<string, ResponseCachePolicy>;
+}
+
+/**
+ * Counters reported by the native response cache.
+ */
+export interface ResponseCacheStats {
+  /** Calls answered with a fresh cached response. */
+  hits: number;
+  /** Calls answered with a stale response while it was being refreshed. */
+  staleHits: number;
+  /** Calls to cached methods that had to go to the server. */
+  misses: number;
+  /** Responses written to the cache. */
+  stores: number;
+  /** Entries dropped to stay under `maxBytes`. */
+  evictions: number;
+  /** Background refreshes started for stale entries. */
+  revalidations: number;
+  /** Entries currently cached. */
+  entries: number;
+  /** Bytes currently cached. */
+  bytes: number;
+  /** Configured size limit. */
+  maxBytes: number;
+}
+
+/**
+ * Single-flight coalescing of identical unary calls.
+ *
+ * While a call is in flight, further calls with the same method, the same
+ * request bytes and matching `varyMetadata` attach to it instead of issuing
+ * their own RPC; every caller receives its own copy of the one response.
+ * As with the response cache, `authorization` is always matched unless
+ * `varyAuthorization` is false.
+ * Joined callers share the first caller's deadline. Aborting one caller only
+ * rejects that caller; the RPC is cancelled once no callers remain.
+ *
+ * @example
+ * ```typescript
+ * channel.configureCoalescing({
+ *   methods: {
+ *     '/catalog.Catalog/GetProduct': { varyAuthorization: false },
+ *     '/user.Users/GetProfile': {},
+ *   },
+ * });
+ * ```
+ */
+export interface CoalescingConfig {
+  /**
+   * Coalesced methods keyed by full method path ("/package.Service/Method").
+   */
+  methods: Record<
+    string,
+    Pick<ResponseCachePolicy, 'varyMetadata' | 'varyAuthorization'>
+  >;
+}
@@ -1,11 +1,65 @@
 import {
+  base64DecodedLength,
   decodeBase64,
+  decodeBase64Into,
   encodeBase64,
   isUint8Array,
   stringToUint8Array,
   uint8ArrayToString,
 } from '../base64';
 
+// Mirrors the native length rules: padding is optional, but a padded string
+// must be a whole number of quads and a lone trailing character is invalid.
+const mockDecodedLength = (base64: string) => {
+  const padding = base64.endsWith('==') ? 2 : base64.endsWith('=') ? 1 : 0;
+  const chars = base64.length - padding;
+  if ((padding > 0 && base64.length % 4 !== 0) || chars % 4 === 1) {
+    throw new Error('Invalid base64 length');
+  }
+  return Math.floor(chars / 4) * 3 + (chars % 4 === 0 ? 0 : (chars % 4) - 1);
+};
+
+// Node's decoder accepts both alphabets; the native one accepts only the
+// selected alphabet.
+const mockDecode = (base64: string, urlSafe: boolean) => {
+  const alphabet = urlSafe
+    ? /^[A-Za-z0-9_-]*={0,2}$/
+    : /^[A-Za-z0-9+/]*={0,2}$/;
+  const length = mockDecodedLength(base64);
+  if (!alphabet.test(base64)) {
+    throw new Error('Invalid base64 character');
+  }
+  return Uint8Array.from(
+    Buffer.from(base64, urlSafe ? 'base64url' : 'base64').subarray(0, length)
+  );
+};
+
+jest.mock('react-native-nitro-modules', () => ({
+  NitroModules: {
+    createHybridObject: () => ({
+      encode: (data: ArrayBuffer, urlSafe: boolean) =>
+        Buffer.from(data).toString(urlSafe ? 'base64url' : 'base64'),
+      decode: (base64: string, urlSafe: boolean) =>
+        mockDecode(base64, urlSafe).buffer,
+      decodeInto: (
+        base64: string,
+        target: ArrayBuffer,
+        offset: number,
+        length: number,
+        urlSafe: boolean
+      ) => {
+        const bytes = mockDecode(base64, urlSafe);
+        if (bytes.length > length) {
+          throw new Error('Target buffer is too small');
+        }
+        new Uint8Array(target, offset, length).set(bytes);
+        return bytes.length;
+      },
+      decodedLength: mockDecodedLength,
+    }),
+  },
+}));
+
 describe('base64Utils', () => {
   describe('encodeBase64', () => {
     it('encodes standard strings correctly', () => {
@@ -38,6 +92,34 @@ describe('base64Utils', () => {
     it('handles empty strings', () => {
       expect(decodeBase64('')).toEqual(new Uint8Array(0));
     });
+
+    it('decodes URL-safe strings without padding', () => {
+      const decoded = decodeBase64('-_8', true);
+      expect(decoded).toEqual(new Uint8Array([251, 255]));
+    });
+
+    it('rejects characters from the other alphabet', () => {
+      expect(() => decodeBase64('-_8=')).toThrow();
+      expect(() => decodeBase64('+/8=', true)).toThrow();
+    });
+  });
+
+  describe('decodeBase64Into', () => {
+    it('writes into the target view and returns the byte count', () => {
+      const backing = new Uint8Array(8);
+      const target = backing.subarray(2);
+      expect(decodeBase64Into('AAECA/8=', target)).toBe(5);
+      expect(backing).toEqual(new Uint8Array([0, 0, 0, 1, 2, 3, 255, 0]));
+    });
+
+    it('throws when the target is too small', () => {
+      expect(() => decodeBase64Into('AAECA/8=', new Uint8Array(4))).toThrow();
+    });
+
+    it('reports the exact decoded length', () => {
+      expect(base64DecodedLength('AAECA/8=')).toBe(5);
+      expect(base64DecodedLength('AAECA_8')).toBe(5);
+    });
   });
 
   describe('string conversions', () => {
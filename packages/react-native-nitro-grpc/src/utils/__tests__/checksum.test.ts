@@ -0,0 +1,119 @@
+import { ChecksumHasher, crc32c, xxh128, xxh3 } from '../checksum';
+
+// Bitwise CRC32C reference; the native module uses hardware instructions.
+const mockCrc32c = (bytes: Uint8Array, crc = 0) => {
+  crc = ~crc >>> 0;
+  for (const byte of bytes) {
+    crc ^= byte;
+    for (let bit = 0; bit < 8; bit++) {
+      crc = crc & 1 ? (crc >>> 1) ^ 0x82f63b78 : crc >>> 1;
+    }
+  }
+  return ~crc >>> 0;
+};
+
+const mockView = (buffer: ArrayBuffer, offset: number, length: number) =>
+  new Uint8Array(buffer, offset, length);
+
+// xxh3 is not available in Node; the mock reports the bytes it was given so
+// the tests can check which range the wrapper forwarded.
+const mockXxh = (bytes: Uint8Array) => Array.from(bytes).join(',');
+
+jest.mock('react-native-nitro-modules', () => ({
+  NitroModules: {
+    createHybridObject: () => ({
+      crc32c: (data: ArrayBuffer, offset: number, length: number) =>
+        mockCrc32c(mockView(data, offset, length)),
+      crc32cString: (data: string) =>
+        mockCrc32c(new TextEncoder().encode(data)),
+      xxh3: (data: ArrayBuffer, offset: number, length: number) =>
+        `xxh3:${mockXxh(mockView(data, offset, length))}`,
+      xxh3String: (data: string) =>
+        `xxh3:${mockXxh(new TextEncoder().encode(data))}`,
+      xxh128: (data: ArrayBuffer, offset: number, length: number) =>
+        `xxh128:${mockXxh(mockView(data, offset, length))}`,
+      xxh128String: (data: string) =>
+        `xxh128:${mockXxh(new TextEncoder().encode(data))}`,
+      createHasher: (algorithm: string) => {
+        let crc = 0;
+        return {
+          algorithm,
+          update: (data: ArrayBuffer, offset: number, length: number) => {
+            crc = mockCrc32c(mockView(data, offset, length), crc);
+          },
+          updateString: (data: string) => {
+            crc = mockCrc32c(new TextEncoder().encode(data), crc);
+          },
+          digest: () => {
+            const hex = crc.toString(16).padStart(8, '0');
+            crc = 0;
+            return hex;
+          },
+          digestBytes: () => {
+            const bytes = new Uint8Array(4);
+            new DataView(bytes.buffer).setUint32(0, crc);
+            crc = 0;
+            return bytes.buffer;
+          },
+          reset: () => {
+            crc = 0;
+          },
+        };
+      },
+    }),
+  },
+}));
+
+describe('checksum', () => {
+  describe('crc32c', () => {
+    it('matches the standard check value', () => {
+      expect(crc32c('123456789')).toBe(0xe3069283);
+    });
+
+    it('hashes byte arrays', () => {
+      expect(crc32c(new TextEncoder().encode('123456789'))).toBe(0xe3069283);
+    });
+
+    it('only hashes the bytes covered by a subarray view', () => {
+      const backing = new TextEncoder().encode('xx123456789xx');
+      expect(crc32c(backing.subarray(2, 11))).toBe(0xe3069283);
+    });
+
+    it('returns 0 for empty input', () => {
+      expect(crc32c(new Uint8Array(0))).toBe(0);
+    });
+  });
+
+  describe('xxh3 / xxh128', () => {
+    it('forwards the view range without copying', () => {
+      const backing = new Uint8Array([9, 1, 2, 3, 9]);
+      expect(xxh3(backing.subarray(1, 4))).toBe('xxh3:1,2,3');
+      expect(xxh128(backing.subarray(1, 4))).toBe('xxh128:1,2,3');
+    });
+
+    it('hashes strings as UTF-8', () => {
+      expect(xxh3('é')).toBe('xxh3:195,169');
+      expect(xxh128('é')).toBe('xxh128:195,169');
+    });
+  });
+
+  describe('ChecksumHasher', () => {
+    it('reports its algorithm', () => {
+      expect(new ChecksumHasher('xxh128').algorithm).toBe('xxh128');
+    });
+
+    it('matches the one-shot checksum across chunks', () => {
+      const hasher = new ChecksumHasher('crc32c');
+      hasher.update('1234').update(new TextEncoder().encode('56789'));
+      expect(hasher.digest()).toBe('e3069283');
+    });
+
+    it('returns big-endian digest bytes and resets', () => {
+      const hasher = new ChecksumHasher('crc32c');
+      expect(hasher.update('123456789').digestBytes()).toEqual(
+        new Uint8Array([0xe3, 0x06, 0x92, 0x83])
+      );
+      expect(hasher.digest()).toBe('00000000');
+    });
+  });
+});
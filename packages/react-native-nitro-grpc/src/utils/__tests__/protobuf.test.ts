@@ -0,0 +1,220 @@
+import { ProtobufCodec } from '../protobuf';
+
+// The mock records what the wrapper forwarded; the wire format itself is
+// covered natively by cpp/tests/ProtoCodecTest.cpp.
+const mockCalls: { method: string; args: unknown[] }[] = [];
+const mockTypes = new Set(['test.Request', 'test.Reply']);
+
+// Stands in for a native LazyMessage over an already-decoded object, and
+// counts how many elements slice() decoded.
+const mockSliced: number[] = [];
+const mockLazy = (typeName: string, fields: Record<string, any>): any => ({
+  typeName,
+  byteLength: 0,
+  has: (field: string) => field in fields,
+  count: (field: string) => {
+    const value = fields[field];
+    if (Array.isArray(value)) return value.length;
+    return value === undefined ? 0 : 1;
+  },
+  pick: (names: string[]) =>
+    Object.fromEntries(
+      names.filter((name) => name in fields).map((name) => [name, fields[name]])
+    ),
+  slice: (field: string, start: number, end: number) => {
+    const values = (fields[field] ?? []).slice(start, end);
+    mockSliced.push(values.length);
+    return { [field]: values };
+  },
+  getMessage: (field: string, index: number) => {
+    const value = fields[field];
+    const element = Array.isArray(value) ? value[index] : value;
+    return element === undefined || (!Array.isArray(value) && index > 0)
+      ? undefined
+      : mockLazy(`${typeName}.${field}`, element);
+  },
+  decode: () => fields,
+});
+
+jest.mock('react-native-nitro-modules', () => ({
+  NitroModules: {
+    createHybridObject: () => ({
+      loadDescriptorSet: (descriptorSet: ArrayBuffer) => {
+        mockCalls.push({ method: 'load', args: [descriptorSet] });
+      },
+      hasMessageType: (typeName: string) => mockTypes.has(typeName),
+      encode: (typeName: string, message: object) => {
+        const text = `${typeName}:${JSON.stringify(message)}`;
+        return new TextEncoder().encode(text).buffer;
+      },
+      decode: (
+        typeName: string,
+        data: ArrayBuffer,
+        offset: number,
+        length: number
+      ) => ({
+        typeName,
+        text: new TextDecoder().decode(new Uint8Array(data, offset, length)),
+      }),
+      decodeLazy: (
+        typeName: string,
+        data: ArrayBuffer,
+        offset: number,
+        length: number
+      ) =>
+        mockLazy(typeName, {
+          text: new TextDecoder().decode(new Uint8Array(data, offset, length)),
+          ids: Array.from({ length: 150 }, (_, i) => String(i)),
+          items: [{ id: 'a' }, { id: 'b' }],
+          header: { id: 'h' },
+        }),
+    }),
+  },
+}));
+
+describe('ProtobufCodec', () => {
+  beforeEach(() => {
+    mockCalls.length = 0;
+    mockSliced.length = 0;
+  });
+
+  it('loads the descriptor set passed to the constructor', () => {
+    const descriptorSet = new Uint8Array([10, 2, 8, 1]);
+    new ProtobufCodec(descriptorSet);
+
+    expect(mockCalls).toHaveLength(1);
+    expect(new Uint8Array(mockCalls[0]!.args[0] as ArrayBuffer)).toEqual(
+      descriptorSet
+    );
+  });
+
+  it('copies descriptor set views to their own buffer', () => {
+    const backing = new Uint8Array([0, 0, 10, 2, 8, 1, 0]);
+    new ProtobufCodec(backing.subarray(2, 6));
+
+    const loaded = mockCalls[0]!.args[0] as ArrayBuffer;
+    expect(loaded.byteLength).toBe(4);
+    expect(new Uint8Array(loaded)).toEqual(new Uint8Array([10, 2, 8, 1]));
+  });
+
+  it('forwards encode to the native codec', () => {
+    const codec = new ProtobufCodec();
+    const bytes = codec.encode('test.Request', { name: 'nitro' });
+
+    expect(new TextDecoder().decode(bytes)).toBe(
+      'test.Request:{"name":"nitro"}'
+    );
+  });
+
+  it('decodes views in place', () => {
+    const codec = new ProtobufCodec();
+    const backing = new TextEncoder().encode('xxpayloadxx');
+
+    expect(codec.decode('test.Reply', backing.subarray(2, 9))).toEqual({
+      typeName: 'test.Reply',
+      text: 'payload',
+    });
+  });
+
+  it('reports loaded types', () => {
+    const codec = new ProtobufCodec();
+
+    expect(codec.hasType('test.Request')).toBe(true);
+    expect(codec.hasType('test.Missing')).toBe(false);
+  });
+
+  it('creates method definitions bound to the message types', () => {
+    const codec = new ProtobufCodec();
+    const method = codec.method<{ name: string }, { text: string }>(
+      '/test.Service/Call',
+      'test.Request',
+      'test.Reply',
+      { responseStream: true }
+    );
+
+    expect(method.path).toBe('/test.Service/Call');
+    expect(method.requestStream).toBe(false);
+    expect(method.responseStream).toBe(true);
+
+    const request = method.requestSerialize({ name: 'a' });
+    expect(new TextDecoder().decode(request)).toBe('test.Request:{"name":"a"}');
+    expect(method.responseDeserialize(new TextEncoder().encode('ok'))).toEqual({
+      typeName: 'test.Reply',
+      text: 'ok',
+    });
+  });
+
+  it('rejects method definitions for unknown types', () => {
+    const codec = new ProtobufCodec();
+
+    expect(() =>
+      codec.method('/test.Service/Call', 'test.Request', 'test.Missing')
+    ).toThrow('Unknown message type: test.Missing');
+  });
+
+  describe('LazyMessage', () => {
+    const view = () =>
+      new ProtobufCodec().decodeLazy<{
+        text: string;
+        ids: string[];
+        items: { id: string }[];
+        header: { id: string };
+        missing?: string;
+      }>('test.Reply', new TextEncoder().encode('xxbodyxx').subarray(2, 6));
+
+    it('reads single fields from the requested range', () => {
+      const message = view();
+
+      expect(message.typeName).toBe('test.Reply');
+      expect(message.get('text')).toBe('body');
+      expect(message.get('missing')).toBeUndefined();
+      expect(message.has('missing')).toBe(false);
+      expect(message.pick('text', 'missing')).toEqual({ text: 'body' });
+    });
+
+    it('iterates repeated fields in chunks', () => {
+      const message = view();
+
+      expect(message.count('ids')).toBe(150);
+      expect(message.slice('ids', 148)).toEqual(['148', '149']);
+      mockSliced.length = 0;
+
+      const ids = Array.from(message.values('ids'));
+      expect(ids).toHaveLength(150);
+      expect(ids[149]).toBe('149');
+      expect(mockSliced).toEqual([64, 64, 22]);
+    });
+
+    it('stops decoding when iteration stops early', () => {
+      for (const id of view().values('ids')) {
+        if (id === '3') break;
+      }
+
+      expect(mockSliced).toEqual([64]);
+    });
+
+    it('returns nested messages as lazy views', () => {
+      const message = view();
+
+      expect(message.message('header')?.get('id')).toBe('h');
+      expect(message.message('header', 1)).toBeUndefined();
+      expect(
+        Array.from(message.messages<{ id: string }>('items'), (item) =>
+          item.get('id')
+        )
+      ).toEqual(['a', 'b']);
+    });
+  });
+
+  it('creates lazy method definitions', () => {
+    const method = new ProtobufCodec().lazyMethod<object, { text: string }>(
+      '/test.Service/List',
+      'test.Request',
+      'test.Reply'
+    );
+    const reply = method.responseDeserialize(new TextEncoder().encode('ok'));
+
+    expect(reply.get('text')).toBe('ok');
+    expect(method.responseStream).toBe(false);
+  });
+});
@@ -1,4 +1,12 @@
-import { sha256, sha256Bytes } from '../sha256';
+import {
+  Sha256Hasher,
+  sha256,
+  sha256Bytes,
+  sha256File,
+  sha256FileBytes,
+  sha256Files,
+  sha256FilesBytes,
+} from '../sha256';
 
 // Mock NitroModules before importing the util
 const mockHash = (data: string | ArrayBuffer) => {
@@ -16,12 +24,57 @@ const mockHash = (data: string | ArrayBuffer) => {
   return crypto.createHash('sha256').update(d).digest('hex');
 };
 
+const mockHashFile = (path: string) => {
+  // eslint-disable-next-line @typescript-eslint/no-var-requires
+  const fs = require('fs');
+  const bytes = fs.readFileSync(path);
+  return mockHash(new Uint8Array(bytes).buffer);
+};
+
+const mockHexToBuffer = (hex: string) =>
+  new Uint8Array(hex.match(/../g)!.map((h: string) => parseInt(h, 16)))
+    .buffer;
+
+const mockHasher = () => {
+  let chunks: Uint8Array[] = [];
+  const digestHex = () => {
+    const total = chunks.reduce((n, c) => n + c.length, 0);
+    const joined = new Uint8Array(total);
+    let offset = 0;
+    for (const c of chunks) {
+      joined.set(c, offset);
+      offset += c.length;
+    }
+    chunks = [];
+    return mockHash(joined.buffer);
+  };
+  return {
+    update: (data: ArrayBuffer) => chunks.push(new Uint8Array(data.slice(0))),
+    updateString: (data: string) =>
+      chunks.push(new TextEncoder().encode(data)),
+    digest: digestHex,
+    digestBytes: () => mockHexToBuffer(digestHex()),
+    reset: () => {
+      chunks = [];
+    },
+  };
+};
+
 jest.mock('react-native-nitro-modules', () => ({
   NitroModules: {
-    createHybridObject: () => ({
-      hash: (data: string) => mockHash(data),
-      hashBytes: (data: ArrayBuffer) => mockHash(data),
-    }),
+    createHybridObject: (name: string) =>
+      name === 'Sha256Hasher'
+        ? mockHasher()
+        : {
+            hash: (data: string) => mockHash(data),
+            hashBytes: (data: ArrayBuffer) => mockHash(data),
+            hashFile: async (path: string) => mockHashFile(path),
+            hashFileBytes: async (path: string) =>
+              mockHexToBuffer(mockHashFile(path)),
+            hashFiles: async (paths: string[]) => paths.map(mockHashFile),
+            hashFilesBytes: async (paths: string[]) =>
+              paths.map((p) => mockHexToBuffer(mockHashFile(p))),
+          },
   },
 }));
 
@@ -57,4 +110,76 @@ describe('Local SHA256', () => {
     expect(sha256('')).toBe(expected);
     expect(sha256Bytes(new Uint8Array(0))).toBe(expected);
   });
+
+  describe('Sha256Hasher', () => {
+    it('matches the one-shot hash across chunks', () => {
+      const hasher = new Sha256Hasher();
+      hasher.update('hel').update(new TextEncoder().encode('lo'));
+      expect(hasher.digest()).toBe(sha256('hello'));
+    });
+
+    it('only hashes the bytes covered by a subarray view', () => {
+      const backing = new TextEncoder().encode('xxhelloxx');
+      const hasher = new Sha256Hasher();
+      hasher.update(backing.subarray(2, 7));
+      expect(hasher.digest()).toBe(sha256('hello'));
+    });
+
+    it('resets after digest', () => {
+      const hasher = new Sha256Hasher();
+      hasher.update('discarded');
+      hasher.digest();
+      expect(hasher.digest()).toBe(sha256(''));
+    });
+
+    it('returns the raw digest bytes', () => {
+      const bytes = new Sha256Hasher().update('hello').digestBytes();
+      expect(bytes.length).toBe(32);
+      expect(bytes[0]).toBe(0x2c);
+    });
+  });
+
+  describe('file hashing', () => {
+    // eslint-disable-next-line @typescript-eslint/no-var-requires
+    const fs = require('fs');
+    // eslint-disable-next-line @typescript-eslint/no-var-requires
+    const os = require('os');
+    // eslint-disable-next-line @typescript-eslint/no-var-requires
+    const pathModule = require('path');
+
+    let dir: string;
+    let fileA: string;
+    let fileB: string;
+
+    beforeAll(() => {
+      dir = fs.mkdtempSync(pathModule.join(os.tmpdir(), 'sha256-'));
+      fileA = pathModule.join(dir, 'a.txt');
+      fileB = pathModule.join(dir, 'b.txt');
+      fs.writeFileSync(fileA, 'hello');
+      fs.writeFileSync(fileB, '');
+    });
+
+    afterAll(() => {
+      fs.rmSync(dir, { recursive: true, force: true });
+    });
+
+    it('hashes a file as hex', async () => {
+      expect(await sha256File(fileA)).toBe(sha256('hello'));
+    });
+
+    it('hashes a file as raw bytes', async () => {
+      const bytes = await sha256FileBytes(fileA);
+      expect(bytes.length).toBe(32);
+      expect(bytes[0]).toBe(0x2c);
+    });
+
+    it('hashes several files in order', async () => {
+      expect(await sha256Files([fileB, fileA])).toEqual([
+        sha256(''),
+        sha256('hello'),
+      ]);
+      const raw = await sha256FilesBytes([fileA, fileB]);
+      expect(raw.map((d) => d.length)).toEqual([32, 32]);
+    });
+  });
 });
@@ -7,7 +7,7 @@ const HybridBase64 = NitroModules.createHybridObject<Base64>('Base64');
  * Encodes Uint8Array to base64 string using native C++ implementation.
  *
  * @param data - Binary data to encode
- * @param urlSafe - Use URL-safe encoding (Not yet supported in native, falls back to standard)
+ * @param urlSafe - Use the URL-safe alphabet ("-_") without padding
  * @returns Base64 encoded string
  */
 export function encodeBase64(data: Uint8Array, urlSafe = false): string {
@@ -18,13 +18,45 @@ export function encodeBase64(data: Uint8Array, urlSafe = false): string {
  * Decodes base64 string to Uint8Array using native C++ implementation.
  *
  * @param base64 - Base64 encoded string
+ * @param urlSafe - Decode the URL-safe alphabet ("-_") instead of "+/"
  * @returns Decoded binary data
  */
-export function decodeBase64(base64: string): Uint8Array {
-  const buffer = HybridBase64.decode(base64);
+export function decodeBase64(base64: string, urlSafe = false): Uint8Array {
+  const buffer = HybridBase64.decode(base64, urlSafe);
   return new Uint8Array(buffer);
 }
 
+/**
+ * Decodes base64 string into an existing Uint8Array without allocating.
+ * Use `base64DecodedLength` to size the target up front.
+ *
+ * @param base64 - Base64 encoded string
+ * @param target - Destination view; bytes are written from its start
+ * @param urlSafe - Decode the URL-safe alphabet ("-_") instead of "+/"
+ * @returns Number of bytes written
+ * @throws If `target` is too small for the decoded data
+ */
+export function decodeBase64Into(
+  base64: string,
+  target: Uint8Array,
+  urlSafe = false
+): number {
+  return HybridBase64.decodeInto(
+    base64,
+    target.buffer as ArrayBuffer,
+    target.byteOffset,
+    target.byteLength,
+    urlSafe
+  );
+}
+
+/**
+ * Returns the exact number of bytes a base64 string decodes to.
+ */
+export function base64DecodedLength(base64: string): number {
+  return HybridBase64.decodedLength(base64);
+}
+
 /**
  * Converts Uint8Array to UTF-8 string.
  */
@@ -0,0 +1,77 @@
+import type { GrpcClient as HybridGrpcClient } from '../specs/GrpcClient.nitro';
+import type { CallTiming } from '../types/call-timing';
+
+type NativeCallTiming = Omit<
+  CallTiming,
+  'method' | 'ok' | 'totalMs' | 'jsResolutionMs'
+> & { nativeTotalMs: number | null };
+
+const listeners = new WeakMap<HybridGrpcClient, (t: CallTiming) => void>();
+
+const clock = (globalThis as { performance?: { now(): number } }).performance;
+
+/**
+ * Milliseconds from a monotonic clock where the runtime has one.
+ */
+export function timingNow(): number {
+  return clock ? clock.now() : Date.now();
+}
+
+/**
+ * Sets (or with `undefined` removes) the call timing listener of a native
+ * client and turns native timing on or off accordingly.
+ */
+export function setCallTimingListener(
+  hybrid: HybridGrpcClient,
+  listener: ((timing: CallTiming) => void) | undefined
+): void {
+  if (listener) {
+    listeners.set(hybrid, listener);
+  } else {
+    listeners.delete(hybrid);
+  }
+  hybrid.setCallTimingEnabled(listener !== undefined);
+}
+
+export function hasCallTimingListener(hybrid: HybridGrpcClient): boolean {
+  return listeners.has(hybrid);
+}
+
+/**
+ * Takes the native timing of a settled call and reports it together with the
+ * JS-observed total. Listener errors are swallowed: they must not change the
+ * outcome of the call.
+ */
+export function reportCallTiming(
+  hybrid: HybridGrpcClient,
+  callId: string,
+  method: string,
+  ok: boolean,
+  totalMs: number
+): void {
+  const listener = listeners.get(hybrid);
+  if (!listener) {
+    return;
+  }
+  const json = hybrid.takeCallTiming(callId);
+  const native: Partial<NativeCallTiming> = json ? JSON.parse(json) : {};
+  const nativeTotalMs = native.nativeTotalMs ?? null;
+  try {
+    listener({
+      method,
+      ok,
+      totalMs,
+      queuedMs: native.queuedMs ?? null,
+      metadataMs: native.metadataMs ?? null,
+      firstByteSentMs: native.firstByteSentMs ?? null,
+      initialMetadataMs: native.initialMetadataMs ?? null,
+      responseMs: native.responseMs ?? null,
+      settleMs: native.settleMs ?? null,
+      // An estimate: the two totals come from different clocks (see CallTiming)
+      jsResolutionMs:
+        nativeTotalMs === null ? null : Math.max(0, totalMs - nativeTotalMs),
+    });
+  } catch {
+    // Ignored, see above
+  }
+}
@@ -0,0 +1,90 @@
+import type { GrpcClient as HybridGrpcClient } from '../specs/GrpcClient.nitro';
+import type {
+  ChannelStats,
+  MessageSizePercentiles,
+  PercentileSummary,
+} from '../types/channel-stats';
+
+interface NativeSummary {
+  count: number;
+  max: number;
+  values: number[];
+}
+
+// Retries happen in JS interceptors, so they are counted here, per method
+const retries = new WeakMap<HybridGrpcClient, Map<string, number>>();
+
+/**
+ * Counts a unary call that was issued again by an interceptor.
+ */
+export function recordRetry(hybrid: HybridGrpcClient, method: string): void {
+  let counts = retries.get(hybrid);
+  if (!counts) {
+    counts = new Map();
+    retries.set(hybrid, counts);
+  }
+  counts.set(method, (counts.get(method) ?? 0) + 1);
+}
+
+/**
+ * Reads the native stats and adds the retries counted in JS.
+ */
+export function getChannelStats(
+  hybrid: HybridGrpcClient,
+  reset: boolean
+): ChannelStats {
+  const stats = JSON.parse(hybrid.getStats(reset)) as ChannelStats;
+  const counts = retries.get(hybrid);
+
+  stats.retries = 0;
+  for (const [path, method] of Object.entries(stats.methods)) {
+    method.retries = counts?.get(path) ?? 0;
+    stats.retries += method.retries;
+  }
+  if (reset) {
+    retries.delete(hybrid);
+  }
+  return stats;
+}
+
+function toSummary(
+  native: NativeSummary,
+  percentiles: number[]
+): PercentileSummary {
+  const values: Record<number, number> = {};
+  percentiles.forEach((p, i) => {
+    values[p] = native.values[i] ?? 0;
+  });
+  return { count: native.count, max: native.max, percentiles: values };
+}
+
+/**
+ * Reads the call duration percentiles of a method, in milliseconds.
+ */
+export function getLatencyPercentiles(
+  hybrid: HybridGrpcClient,
+  method: string,
+  percentiles: number[]
+): PercentileSummary {
+  const native = JSON.parse(
+    hybrid.getLatencyPercentiles(method, percentiles)
+  ) as NativeSummary;
+  return toSummary(native, percentiles);
+}
+
+/**
+ * Reads the message size percentiles of a method, in bytes.
+ */
+export function getMessageSizePercentiles(
+  hybrid: HybridGrpcClient,
+  method: string,
+  percentiles: number[]
+): MessageSizePercentiles {
+  const native = JSON.parse(
+    hybrid.getMessageSizePercentiles(method, percentiles)
+  ) as { sent: NativeSummary; received: NativeSummary };
+  return {
+    sent: toSummary(native.sent, percentiles),
+    received: toSummary(native.received, percentiles),
+  };
+}
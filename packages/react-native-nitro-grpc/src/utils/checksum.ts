@@ -0,0 +1,127 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import type { Checksum } from '../specs/Checksum.nitro';
+import type { ChecksumHasher as HybridChecksumHasherSpec } from '../specs/ChecksumHasher.nitro';
+
+const HybridChecksum = NitroModules.createHybridObject<Checksum>('Checksum');
+
+/**
+ * Supported non-cryptographic checksum algorithms.
+ */
+export type ChecksumAlgorithm = 'crc32c' | 'xxh3' | 'xxh128';
+
+/**
+ * Computes the CRC32C (Castagnoli) checksum using the CPU's CRC
+ * instructions when available.
+ * @param data Bytes (views are read in place) or a string hashed as UTF-8.
+ * @returns The CRC as an unsigned 32-bit integer.
+ */
+export function crc32c(data: Uint8Array | string): number {
+  if (typeof data === 'string') {
+    return HybridChecksum.crc32cString(data);
+  }
+  return HybridChecksum.crc32c(
+    data.buffer as ArrayBuffer,
+    data.byteOffset,
+    data.byteLength
+  );
+}
+
+/**
+ * Computes the XXH3 64-bit hash.
+ * @param data Bytes (views are read in place) or a string hashed as UTF-8.
+ * @returns The hash as a 16-character hex string.
+ */
+export function xxh3(data: Uint8Array | string): string {
+  if (typeof data === 'string') {
+    return HybridChecksum.xxh3String(data);
+  }
+  return HybridChecksum.xxh3(
+    data.buffer as ArrayBuffer,
+    data.byteOffset,
+    data.byteLength
+  );
+}
+
+/**
+ * Computes the XXH3 128-bit hash.
+ * @param data Bytes (views are read in place) or a string hashed as UTF-8.
+ * @returns The hash as a 32-character hex string.
+ */
+export function xxh128(data: Uint8Array | string): string {
+  if (typeof data === 'string') {
+    return HybridChecksum.xxh128String(data);
+  }
+  return HybridChecksum.xxh128(
+    data.buffer as ArrayBuffer,
+    data.byteOffset,
+    data.byteLength
+  );
+}
+
+/**
+ * Incremental checksum for data that arrives in chunks.
+ *
+ * @example
+ * ```typescript
+ * const hasher = new ChecksumHasher('xxh3');
+ * for (const chunk of chunks) hasher.update(chunk);
+ * const fingerprint = hasher.digest();
+ * ```
+ */
+export class ChecksumHasher {
+  private _hybrid: HybridChecksumHasherSpec;
+
+  /**
+   * @param algorithm The checksum to compute.
+   */
+  constructor(algorithm: ChecksumAlgorithm) {
+    this._hybrid = HybridChecksum.createHasher(algorithm);
+  }
+
+  /**
+   * The algorithm this hasher computes.
+   */
+  get algorithm(): ChecksumAlgorithm {
+    return this._hybrid.algorithm as ChecksumAlgorithm;
+  }
+
+  /**
+   * Absorbs the next chunk of input. Byte views are read in place.
+   * @returns This hasher, for chaining.
+   */
+  update(data: Uint8Array | string): this {
+    if (typeof data === 'string') {
+      this._hybrid.updateString(data);
+    } else {
+      this._hybrid.update(
+        data.buffer as ArrayBuffer,
+        data.byteOffset,
+        data.byteLength
+      );
+    }
+    return this;
+  }
+
+  /**
+   * Finishes the checksum and resets the hasher for reuse.
+   * @returns The checksum as a big-endian hex string.
+   */
+  digest(): string {
+    return this._hybrid.digest();
+  }
+
+  /**
+   * Finishes the checksum and resets the hasher for reuse.
+   * @returns The checksum as big-endian bytes (4, 8 or 16 bytes).
+   */
+  digestBytes(): Uint8Array {
+    return new Uint8Array(this._hybrid.digestBytes());
+  }
+
+  /**
+   * Discards all absorbed input.
+   */
+  reset(): void {
+    this._hybrid.reset();
+  }
+}
@@ -0,0 +1,296 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import type { AnyMap } from 'react-native-nitro-modules';
+import type { LazyMessage as HybridLazyMessageSpec } from '../specs/LazyMessage.nitro';
+import type { ProtobufCodec as HybridProtobufCodecSpec } from '../specs/ProtobufCodec.nitro';
+import type { MethodDefinition } from '../types/method';
+
+/**
+ * Streaming flags for {@link ProtobufCodec.method}.
+ */
+export interface ProtobufMethodOptions {
+  requestStream?: boolean;
+  responseStream?: boolean;
+}
+
+const toBytes = (data: Uint8Array | ArrayBuffer): Uint8Array =>
+  data instanceof Uint8Array ? data : new Uint8Array(data);
+
+type FieldName<T> = keyof T & string;
+type ElementOf<V> = V extends readonly (infer E)[] ? E : never;
+
+/**
+ * Number of elements {@link LazyMessage.values} decodes per native call.
+ */
+const VALUES_CHUNK_SIZE = 64;
+
+/**
+ * View of a serialized message that decodes fields only when they are read.
+ *
+ * Field offsets are indexed natively on first access; repeated fields can be
+ * iterated without decoding the whole array.
+ *
+ * @example
+ * ```typescript
+ * const page = codec.decodeLazy<ListReply>('app.ListReply', bytes);
+ * const stamp = page.get('timestamp');
+ * for (const item of page.messages<Item>('items')) {
+ *   ids.push(item.get('id'));
+ * }
+ * ```
+ */
+export class LazyMessage<T extends object = Record<string, unknown>> {
+  private _hybrid: HybridLazyMessageSpec;
+
+  /**
+   * @internal Use {@link ProtobufCodec.decodeLazy}.
+   */
+  constructor(hybrid: HybridLazyMessageSpec) {
+    this._hybrid = hybrid;
+  }
+
+  /**
+   * Fully qualified message type name.
+   */
+  get typeName(): string {
+    return this._hybrid.typeName;
+  }
+
+  /**
+   * Size of the serialized message in bytes.
+   */
+  get byteLength(): number {
+    return this._hybrid.byteLength;
+  }
+
+  /**
+   * Whether the field is present on the wire.
+   */
+  has(field: FieldName<T>): boolean {
+    return this._hybrid.has(field);
+  }
+
+  /**
+   * Number of elements of a repeated field, entries of a map field, or
+   * 0/1 for a singular field.
+   */
+  count(field: FieldName<T>): number {
+    return this._hybrid.count(field);
+  }
+
+  /**
+   * Decodes a single field.
+   * @returns `undefined` if the field is absent.
+   */
+  get<K extends FieldName<T>>(field: K): T[K] | undefined {
+    return (this._hybrid.pick([field]) as unknown as Partial<T>)[field];
+  }
+
+  /**
+   * Decodes only the given fields. Absent fields are left out.
+   */
+  pick<K extends FieldName<T>>(...fields: K[]): Partial<Pick<T, K>> {
+    return this._hybrid.pick(fields) as unknown as Partial<Pick<T, K>>;
+  }
+
+  /**
+   * Decodes elements `[start, end)` of a repeated field.
+   */
+  slice<K extends FieldName<T>>(
+    field: K,
+    start = 0,
+    end = Infinity
+  ): ElementOf<T[K]>[] {
+    const result = this._hybrid.slice(field, start, end);
+    return (result[field] ?? []) as ElementOf<T[K]>[];
+  }
+
+  /**
+   * Iterates the elements of a repeated field, decoding them in chunks.
+   */
+  *values<K extends FieldName<T>>(field: K): IterableIterator<ElementOf<T[K]>> {
+    const total = this.count(field);
+    for (let start = 0; start < total; start += VALUES_CHUNK_SIZE) {
+      yield* this.slice(field, start, start + VALUES_CHUNK_SIZE);
+    }
+  }
+
+  /**
+   * A lazy view of a message field, or of element `index` of a repeated
+   * message field.
+   * @returns `undefined` if the field or element is absent.
+   */
+  message<U extends object = Record<string, unknown>>(
+    field: FieldName<T>,
+    index = 0
+  ): LazyMessage<U> | undefined {
+    const hybrid = this._hybrid.getMessage(field, index);
+    return hybrid ? new LazyMessage<U>(hybrid) : undefined;
+  }
+
+  /**
+   * Iterates the elements of a repeated message field as lazy views.
+   */
+  *messages<U extends object = Record<string, unknown>>(
+    field: FieldName<T>
+  ): IterableIterator<LazyMessage<U>> {
+    const total = this.count(field);
+    for (let index = 0; index < total; index++) {
+      yield this.message<U>(field, index)!;
+    }
+  }
+
+  /**
+   * Decodes the whole message.
+   */
+  decode(): T {
+    return this._hybrid.decode() as unknown as T;
+  }
+}
+
+/**
+ * Native protobuf codec driven by a descriptor set.
+ *
+ * Messages are plain objects in the proto3 JSON mapping: fields use their
+ * lowerCamelCase JSON names, 64-bit integers decode to strings, `bytes` are
+ * Base64 strings and enums decode to value names.
+ *
+ * @example
+ * ```typescript
+ * // protoc --include_imports --descriptor_set_out=app.pb app.proto
+ * const codec = new ProtobufCodec(descriptorSetBytes);
+ * const sayHello = codec.method<HelloRequest, HelloReply>(
+ *   '/helloworld.Greeter/SayHello',
+ *   'helloworld.HelloRequest',
+ *   'helloworld.HelloReply'
+ * );
+ * const reply = await client.unaryCall(sayHello, { name: 'Nitro' });
+ * ```
+ */
+export class ProtobufCodec {
+  private _hybrid: HybridProtobufCodecSpec;
+
+  /**
+   * @param descriptorSet A serialized `google.protobuf.FileDescriptorSet`.
+   */
+  constructor(descriptorSet?: Uint8Array | ArrayBuffer) {
+    this._hybrid = NitroModules.createHybridObject<HybridProtobufCodecSpec>(
+      'ProtobufCodec'
+    );
+    if (descriptorSet) {
+      this.load(descriptorSet);
+    }
+  }
+
+  /**
+   * Loads the message types of another descriptor set.
+   */
+  load(descriptorSet: Uint8Array | ArrayBuffer): void {
+    const bytes = toBytes(descriptorSet);
+    // The native side parses the whole buffer, so views are copied out
+    const buffer =
+      bytes.byteOffset === 0 && bytes.byteLength === bytes.buffer.byteLength
+        ? bytes.buffer
+        : bytes.slice().buffer;
+    this._hybrid.loadDescriptorSet(buffer as ArrayBuffer);
+  }
+
+  /**
+   * Whether a message type has been loaded.
+   * @param typeName Fully qualified name, e.g. `helloworld.HelloRequest`.
+   */
+  hasType(typeName: string): boolean {
+    return this._hybrid.hasMessageType(typeName);
+  }
+
+  /**
+   * Encodes a message of the given type.
+   * @throws If the type is unknown or a field has the wrong type.
+   */
+  encode<T extends object>(typeName: string, message: T): ArrayBuffer {
+    return this._hybrid.encode(typeName, message as unknown as AnyMap);
+  }
+
+  /**
+   * Decodes a message of the given type. Views are read in place.
+   * @throws If the type is unknown or the bytes are malformed.
+   */
+  decode<T extends object>(
+    typeName: string,
+    data: Uint8Array | ArrayBuffer
+  ): T {
+    const bytes = toBytes(data);
+    return this._hybrid.decode(
+      typeName,
+      bytes.buffer as ArrayBuffer,
+      bytes.byteOffset,
+      bytes.byteLength
+    ) as unknown as T;
+  }
+
+  /**
+   * Creates a lazy view of a message of the given type. The bytes are
+   * referenced, not copied, so they must not be modified while in use.
+   * @throws If the type is unknown.
+   */
+  decodeLazy<T extends object>(
+    typeName: string,
+    data: Uint8Array | ArrayBuffer
+  ): LazyMessage<T> {
+    const bytes = toBytes(data);
+    return new LazyMessage<T>(
+      this._hybrid.decodeLazy(
+        typeName,
+        bytes.buffer as ArrayBuffer,
+        bytes.byteOffset,
+        bytes.byteLength
+      )
+    );
+  }
+
+  /**
+   * Creates a method definition that encodes requests and decodes
+   * responses with this codec.
+   */
+  method<Req extends object, Res extends object>(
+    path: string,
+    requestType: string,
+    responseType: string,
+    options: ProtobufMethodOptions = {}
+  ): MethodDefinition<Req, Res> {
+    for (const typeName of [requestType, responseType]) {
+      if (!this.hasType(typeName)) {
+        throw new Error(`Unknown message type: ${typeName}`);
+      }
+    }
+    return {
+      path,
+      requestStream: options.requestStream ?? false,
+      responseStream: options.responseStream ?? false,
+      requestSerialize: (value) => this.encode(requestType, value),
+      responseDeserialize: (bytes) => this.decode<Res>(responseType, bytes),
+    };
+  }
+
+  /**
+   * Like {@link ProtobufCodec.method}, but responses are returned as
+   * {@link LazyMessage} views, for large responses of which only a few
+   * fields are read.
+   */
+  lazyMethod<Req extends object, Res extends object>(
+    path: string,
+    requestType: string,
+    responseType: string,
+    options: ProtobufMethodOptions = {}
+  ): MethodDefinition<Req, LazyMessage<Res>> {
+    const definition = this.method<Req, Res>(
+      path,
+      requestType,
+      responseType,
+      options
+    );
+    return {
+      ...definition,
+      responseDeserialize: (bytes) => this.decodeLazy<Res>(responseType, bytes),
+    };
+  }
+}
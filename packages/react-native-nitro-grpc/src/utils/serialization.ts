@@ -1,10 +1,11 @@
 /**
  * Serializes a message to ArrayBuffer.
+ * Used for methods called by path; use a MethodDefinition from
+ * `ProtobufCodec.method()` for protobuf encoding.
  * @internal
  */
 export function serializeMessage<T>(message: T): ArrayBuffer {
-  // TODO: Implement proper protobuf serialization
-  // For now, use JSON as placeholder
+  // Raw bytes pass through; anything else is sent as JSON
   if (message instanceof Uint8Array) {
     // Create a copy of the buffer to ensure we only send the valid range
     // and not the entire underlying buffer if it's a view.
@@ -19,11 +20,11 @@ export function serializeMessage<T>(message: T): ArrayBuffer {
 
 /**
  * Deserializes a message from ArrayBuffer.
+ * Used for methods called by path; see {@link serializeMessage}.
  * @internal
  */
 export function deserializeMessage<T>(buffer: ArrayBuffer): T {
-  // TODO: Implement proper protobuf deserialization
-  // For now, try JSON, fallback to buffer
+  // Try JSON, fall back to the raw buffer
   try {
     const decoder = new TextDecoder();
     const json = decoder.decode(buffer);
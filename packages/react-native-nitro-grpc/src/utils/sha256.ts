@@ -1,5 +1,6 @@
 import { NitroModules } from 'react-native-nitro-modules';
 import type { Sha256 } from '../specs/Sha256.nitro';
+import type { Sha256Hasher as HybridSha256HasherSpec } from '../specs/Sha256Hasher.nitro';
 
 const HybridSha256 = NitroModules.createHybridObject<Sha256>('Sha256');
 
@@ -20,3 +21,108 @@ export function sha256(data: string): string {
 export function sha256Bytes(data: Uint8Array): string {
   return HybridSha256.hashBytes(data.buffer as ArrayBuffer);
 }
+
+/**
+ * Computes the SHA256 hash of a file on disk.
+ * The file is memory-mapped natively and never copied into JS.
+ * @param path Absolute file path or `file://` URI.
+ * @returns The SHA256 hash as a hex string.
+ */
+export function sha256File(path: string): Promise<string> {
+  return HybridSha256.hashFile(path);
+}
+
+/**
+ * Computes the raw SHA256 digest of a file on disk.
+ * @param path Absolute file path or `file://` URI.
+ * @returns The 32-byte digest.
+ */
+export async function sha256FileBytes(path: string): Promise<Uint8Array> {
+  return new Uint8Array(await HybridSha256.hashFileBytes(path));
+}
+
+/**
+ * Hashes several files in parallel on a native worker pool.
+ * @param paths Absolute file paths or `file://` URIs.
+ * @returns Hex digests in the same order as `paths`.
+ */
+export function sha256Files(paths: string[]): Promise<string[]> {
+  return HybridSha256.hashFiles(paths);
+}
+
+/**
+ * Hashes several files in parallel and returns the raw digests.
+ * @param paths Absolute file paths or `file://` URIs.
+ * @returns 32-byte digests in the same order as `paths`.
+ */
+export async function sha256FilesBytes(
+  paths: string[]
+): Promise<Uint8Array[]> {
+  const digests = await HybridSha256.hashFilesBytes(paths);
+  return digests.map((digest) => new Uint8Array(digest));
+}
+
+/**
+ * Incremental SHA256 hasher for data that arrives in chunks.
+ * Each chunk is hashed natively as it arrives, so large payloads never
+ * need to be buffered in JS.
+ *
+ * @example
+ * ```typescript
+ * const hasher = new Sha256Hasher();
+ * stream.on('data', (chunk) => hasher.update(chunk));
+ * stream.on('end', () => console.log(hasher.digest()));
+ * ```
+ */
+export class Sha256Hasher {
+  private _hybrid: HybridSha256HasherSpec =
+    NitroModules.createHybridObject<HybridSha256HasherSpec>('Sha256Hasher');
+
+  /**
+   * Absorbs the next chunk of input.
+   * @param data Bytes, or a string hashed as UTF-8.
+   * @returns This hasher, for chaining.
+   */
+  update(data: Uint8Array | string): this {
+    if (typeof data === 'string') {
+      this._hybrid.updateString(data);
+    } else {
+      this._hybrid.update(toExactArrayBuffer(data));
+    }
+    return this;
+  }
+
+  /**
+   * Finishes the hash and resets the hasher for reuse.
+   * @returns The SHA256 hash as a hex string.
+   */
+  digest(): string {
+    return this._hybrid.digest();
+  }
+
+  /**
+   * Finishes the hash and resets the hasher for reuse.
+   * @returns The raw 32-byte digest.
+   */
+  digestBytes(): Uint8Array {
+    return new Uint8Array(this._hybrid.digestBytes());
+  }
+
+  /**
+   * Discards all absorbed input.
+   */
+  reset(): void {
+    this._hybrid.reset();
+  }
+}
+
+/**
+ * Returns an ArrayBuffer covering exactly the bytes of `view`.
+ * Only copies when the view is a window into a larger buffer.
+ */
+function toExactArrayBuffer(view: Uint8Array): ArrayBuffer {
+  if (view.byteOffset === 0 && view.byteLength === view.buffer.byteLength) {
+    return view.buffer as ArrayBuffer;
+  }
+  return view.slice().buffer as ArrayBuffer;
+}